@@ -399,6 +399,9 @@ DLL_EXPORT const char *tmq_get_topic_name(TAOS_RES *res);
 DLL_EXPORT const char *tmq_get_db_name(TAOS_RES *res);
 DLL_EXPORT int32_t     tmq_get_vgroup_id(TAOS_RES *res);
 DLL_EXPORT int64_t     tmq_get_vgroup_offset(TAOS_RES *res);
+// Move to the next block of a data result and return it in the raw block format accepted by taos_write_raw_block,
+// without building the row view. *numOfRows is 0 when no block is left. Do not mix with taos_fetch_row/block.
+DLL_EXPORT int32_t     tmq_get_raw_block(TAOS_RES *res, int32_t *numOfRows, void **pData);
 DLL_EXPORT const char *tmq_err2str(int32_t code);
 
 /* ------------------------------ TAOSX INTERFACE -----------------------------------*/
@@ -16,6 +16,9 @@ int32_t startRsync();
 int32_t uploadByRsync(const char* id, const char* path, int64_t checkpointId);
 int32_t downloadByRsync(const char* id, const char* path, int64_t checkpointId);
 int32_t deleteRsync(const char* id);
+int32_t uploadDeltaByRsync(const char* id, const char* path, bool base);
+int32_t deleteFilesByRsync(const char* id, SArray* pNames);
+int32_t downloadDeltaByRsync(const char* id, const char* path);
 
 #ifdef __cplusplus
 }
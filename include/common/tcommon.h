@@ -362,8 +362,16 @@ typedef struct SSortExecInfo {
   int32_t loops;       // loop count
   int32_t writeBytes;  // write io bytes
   int32_t readBytes;   // read io bytes
+  int64_t rawWriteBytes;  // write bytes before compression
+  int64_t stallTime;      // time blocked by the spill io, in us
 } SSortExecInfo;
 
+typedef struct SSpillExecInfo {
+  int64_t writeBytes;     // write io bytes
+  int64_t rawWriteBytes;  // write bytes before compression
+  int64_t stallTime;      // time blocked by the spill io, in us
+} SSpillExecInfo;
+
 typedef struct SNonSortExecInfo {
   int32_t blkNums;
 } SNonSortExecInfo;
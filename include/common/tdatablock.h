@@ -35,6 +35,11 @@ typedef struct SBlockOrderInfo {
 #define BLOCK_VERSION_1 1
 #define BLOCK_VERSION_2 2
 
+// how the encoded blocks of a fetch rsp are compressed, see SRetrieveTableRsp::compressed
+#define BLOCK_COMPRESS_NONE     0
+#define BLOCK_COMPRESS_LZ4      1
+#define BLOCK_COMPRESS_COLUMNAR 2
+
 #define NBIT                     (3u)
 #define BitPos(_n)               ((_n) & ((1 << NBIT) - 1))
 #define CharPos(r_)              ((r_) >> NBIT)
@@ -273,6 +278,9 @@ int32_t         bdGetColumnInfoData(const SSDataBlock* pBlock, int32_t index, SC
 int32_t blockGetEncodeSize(const SSDataBlock* pBlock);
 int32_t blockEncode(const SSDataBlock* pBlock, char* data, size_t dataLen, int32_t numOfCols);
 int32_t blockDecode(SSDataBlock* pBlock, const char* pData, const char** pEndPos);
+int32_t blockCompressEncoded(const char* pRaw, int32_t rawLen, char* pOut, int32_t outLen);
+int32_t blockDecompressEncoded(const char* pIn, int32_t compLen, char* pRaw, int32_t rawLen);
+int32_t blockDecompress(int8_t compressed, const char* pIn, int32_t compLen, char* pRaw, int32_t rawLen);
 
 // for debug
 int32_t dumpBlockData(SSDataBlock* pDataBlock, const char* flag, char** dumpBuf, const char* taskIdStr);
@@ -62,6 +62,7 @@ extern char tsEncryptKey[];
 extern int32_t tsMaxShellConns;
 extern int32_t tsShellActivityTimer;
 extern int32_t tsCompressMsgSize;
+extern bool    tsCompressMsgByColumn;
 extern int64_t tsTickPerMin[3];
 extern int64_t tsTickPerHour[3];
 extern int32_t tsCountAlwaysReturnValue;
@@ -173,7 +174,16 @@ extern int32_t tsQueryRspPolicy;
 extern int64_t tsQueryMaxConcurrentTables;
 extern int32_t tsQuerySmaOptimize;
 extern int32_t tsQueryRsmaTolerance;
+extern bool    tsQueryAsyncSpill;  // flush the evicted pages of query buffers in background threads
+extern bool    tsQuerySpillCompress;  // compress the query buffer pages spilled to disk
+extern int32_t tsNumOfSortThreads;  // threads used to generate sorted runs of one external sort
+extern int32_t tsNumOfScanThreads;  // file set ranges one single table scan is split into, read ahead in the scan pool
+extern int32_t tsQueryMaxHeavyTasks;  // heavy query tasks running at the same time on a dnode, 0 disables the admission
+extern int32_t tsQueryHeavyTaskMemSize;  // estimated memory in MB from which a query task is heavy
+extern int32_t tsQueryHeavyMemBudget;  // estimated memory in MB shared by the running heavy tasks, 0 is unlimited
 extern bool    tsQueryPlannerTrace;
+extern bool    tsQueryCostBasedJoin;  // choose the hash join by the estimated input rows without the hint
+extern int32_t tsQueryPlanCacheSize;
 extern int32_t tsQueryNodeChunkSize;
 extern bool    tsQueryUseNodeAllocator;
 extern bool    tsKeepColumnName;
@@ -199,6 +209,7 @@ extern bool    tsMultiResultFunctionStarReturnTags;
 extern int32_t tsMinSlidingTime;
 extern int32_t tsMinIntervalTime;
 extern int32_t tsMaxInsertBatchRows;
+extern int32_t tsCsvParseThreads;
 
 // build info
 extern char td_version[];
@@ -231,6 +242,8 @@ extern char tsSmlAutoChildTableNameDelimiter[];
 extern char tsSmlTagName[];
 extern bool tsSmlDot2Underline;
 extern char tsSmlTsDefaultName[];
+extern int32_t tsSmlParseThreads;
+extern int32_t tsStmt2PipelineDepth;
 // extern bool    tsSmlDataFormat;
 // extern int32_t tsSmlBatchSize;
 
@@ -242,12 +255,15 @@ extern int64_t tsmaDataDeleteMark;
 
 // wal
 extern int64_t tsWalFsyncDataSizeLimit;
+extern bool    tsEnableWriteStat;  // time the wal append and memtable insert of each vnode, for write path profiling
 
 // internal
 extern int32_t tsTransPullupInterval;
 extern int32_t tsCompactPullupInterval;
 extern int32_t tsMqRebalanceInterval;
 extern int32_t tsStreamCheckpointInterval;
+extern bool    tsStreamIncrementalCheckpoint;
+extern bool    tsStreamStateAsyncFlush;
 extern float   tsSinkDataRate;
 extern int32_t tsStreamNodeCheckInterval;
 extern int32_t tsMaxConcurrentCheckpoint;
@@ -2326,6 +2326,8 @@ typedef struct STableScanAnalyzeInfo {
   uint32_t filterOutBlocks;
   double   elapsedTime;
   double   filterTime;
+  uint32_t rtFilterOutBlocks;  // blocks dropped by the join runtime filter
+  uint64_t rtFilterOutRows;    // rows dropped by the join runtime filter
 } STableScanAnalyzeInfo;
 
 int32_t tSerializeSExplainRsp(void* buf, int32_t bufLen, SExplainRsp* pRsp);
@@ -2733,6 +2735,8 @@ typedef struct {
   uint64_t        taskId;
   int32_t         execId;
   SOperatorParam* pOpParam;
+  int32_t         creditRows;      // max rows the requester accepts in one rsp, 0 for the server default
+  int8_t          acceptColumnar;  // the requester decodes the blocks compressed column by column
 } SResFetchReq;
 
 int32_t tSerializeSResFetchReq(void* buf, int32_t bufLen, SResFetchReq* pReq);
@@ -2750,6 +2754,8 @@ typedef struct {
   int64_t  refId;
   int32_t  execId;
   int8_t   status;
+  int8_t   admitState;   // ETaskAdmitState
+  int64_t  queueWaitMs;  // time waited for admission in the qworker
 } STaskStatus;
 
 typedef struct {
@@ -4156,6 +4162,7 @@ typedef struct {
   SArray*      blockData;
   SArray*      blockTbName;
   SArray*      blockSchema;
+  void*        pRspBuf;  // not serialize, if set, blockData refers into this buffer instead of owning copies
 
   union {
     struct {
@@ -4432,6 +4439,8 @@ typedef struct {
 
 int32_t tEncodeSubmitReq(SEncoder* pCoder, const SSubmitReq2* pReq);
 int32_t tDecodeSubmitReq(SDecoder* pCoder, SSubmitReq2* pReq);
+// decode only the tables whose uid is in pUidFilter, the others are skipped by their encoded length
+int32_t tDecodeSubmitReqWithFilter(SDecoder* pCoder, SSubmitReq2* pReq, SHashObj* pUidFilter);
 void    tDestroySubmitTbData(SSubmitTbData* pTbData, int32_t flag);
 void    tDestroySubmitReq(SSubmitReq2* pReq, int32_t flag);
 
@@ -22,6 +22,8 @@
 extern "C" {
 #endif
 
+struct SVnodeWriteStat;
+
 /**
  * @brief Initialize the dnode
  *
@@ -49,6 +51,11 @@ void dmStop();
  */
 bool dmReadyForTest();
 
+/**
+ * @brief Sum the write path counters of the vnodes in this process, they are only updated when enableWriteStat is set.
+ */
+void dmGetVnodeWriteStat(struct SVnodeWriteStat *pStat);
+
 #ifdef __cplusplus
 }
 #endif
@@ -212,6 +212,8 @@ int32_t catalogGetHandle(int64_t clusterId, SCatalog** catalogHandle);
 
 int32_t catalogGetDBVgVersion(SCatalog* pCtg, const char* dbFName, int32_t* version, int64_t* dbId, int32_t* tableNum, int64_t* stateTs);
 
+int32_t catalogGetDBCfgVersion(SCatalog* pCtg, const char* dbFName, int32_t* pCfgVersion);
+
 /**
  * Get a DB's all vgroup info.
  * @param pCatalog (input, got with catalogGetHandle)
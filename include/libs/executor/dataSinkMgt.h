@@ -107,6 +107,20 @@ void dsReset(DataSinkHandle handle);
  */
 void dsGetDataLength(DataSinkHandle handle, int64_t* pLen, int64_t* pRawLen, bool* pQueryEnd);
 
+/**
+ * Set how the blocks put afterwards are compressed, as the requester of the results asks for.
+ * @param handle
+ * @param compressMode BLOCK_COMPRESS_LZ4 or BLOCK_COMPRESS_COLUMNAR
+ */
+void dsSetCompressMode(DataSinkHandle handle, int8_t compressMode);
+
+/**
+ * Get the compression of the data returned by the next call to dsGetDataBlock, valid after dsGetDataLength.
+ * @param handle
+ * @return BLOCK_COMPRESS_NONE if the data is not compressed
+ */
+int8_t dsGetDataCompressed(DataSinkHandle handle);
+
 /**
  * Get data, the caller needs to allocate data memory.
  * @param handle
@@ -187,6 +187,8 @@ typedef struct TsdReader {
   int32_t      (*tsdReaderResetStatus)();
   int32_t      (*tsdReaderGetDataBlockDistInfo)();
   int64_t      (*tsdReaderGetNumOfInMemRows)();
+  int32_t      (*tsdReaderGetFilesetKeys)();  // start keys of the file sets overlapped with the query window
+  uint64_t     (*tsdReaderGetMaxVersion)();   // the max version of the data the reader returns
   void         (*tsdReaderNotifyClosing)();
 
   void         (*tsdSetFilesetDelimited)(void* pReader);
@@ -348,6 +350,7 @@ typedef struct SStateStore {
   int32_t (*streamStatePut)(SStreamState* pState, const SWinKey* key, const void* value, int32_t vLen);
   int32_t (*streamStateGet)(SStreamState* pState, const SWinKey* key, void** pVal, int32_t* pVLen, int32_t* pWinCode);
   bool (*streamStateCheck)(SStreamState* pState, const SWinKey* key);
+  int32_t (*streamStatePrefetch)(SStreamState* pState, const SWinKey* pKeys, int32_t num);
   int32_t (*streamStateGetByPos)(SStreamState* pState, void* pos, void** pVal);
   void (*streamStateDel)(SStreamState* pState, const SWinKey* key);
   void (*streamStateClear)(SStreamState* pState);
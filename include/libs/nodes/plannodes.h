@@ -160,6 +160,8 @@ typedef struct SJoinLogicNode {
   STimeWindow    timeRange;        //table onCond filter
   SNode*         pLeftOnCond;      //table onCond filter
   SNode*         pRightOnCond;     //table onCond filter
+
+  SQueryStat     inputStat[2];     //estimated inputs
 } SJoinLogicNode;
 
 typedef struct SAggLogicNode {
@@ -175,6 +177,8 @@ typedef struct SAggLogicNode {
   bool       isPartTb;  // true if partition keys has tbname
   bool       hasGroup;
   SNodeList *pTsmaSubplans;
+  SNodeList* pTopNKeys;  // group keys the parent sort is ordered by, only the top N groups of them are needed
+  int64_t    topN;
 } SAggLogicNode;
 
 typedef struct SProjectLogicNode {
@@ -623,6 +627,8 @@ typedef struct SAggPhysiNode {
   bool       mergeDataBlock;
   bool       groupKeyOptimized;
   bool       hasCountLikeFunc;
+  SNodeList* pTopNKeys;  // element is SOrderByExprNode, and SOrderByExprNode::pExpr is SColumnNode of the output
+  int64_t    topN;       // only the first topN groups ordered by pTopNKeys are kept if greater than 0
 } SAggPhysiNode;
 
 typedef struct SDownstreamSourceNode {
@@ -835,6 +841,8 @@ typedef struct SSubplan {
   bool           isAudit;
   bool           dynamicRowThreshold;
   int32_t        rowsThreshold;
+  int64_t        estMemSize;  // estimated bytes held by the blocking operators, used by the qworker admission
+  int64_t        estCpuCost;  // estimated rows processed
 } SSubplan;
 
 typedef enum EExplainMode { EXPLAIN_MODE_DISABLE = 1, EXPLAIN_MODE_STATIC, EXPLAIN_MODE_ANALYZE } EExplainMode;
@@ -629,6 +629,7 @@ typedef struct SQuery {
   SArray*         pPlaceholderValues;
   SNode*          pPrepareRoot;
   bool            stableQuery;
+  bool            nonDeterministic;  // now(), today() or rand() were folded in, the plan is only valid once
 } SQuery;
 
 void nodesWalkSelectStmtImpl(SSelectStmt* pSelect, ESqlClause clause, FNodeWalker walker, void* pContext);
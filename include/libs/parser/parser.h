@@ -106,6 +106,9 @@ typedef struct SParseContext {
 int32_t qParseSql(SParseContext* pCxt, SQuery** pQuery);
 bool    qIsInsertValuesSql(const char* pStr, size_t length);
 bool    qParseDbName(const char* pStr, size_t length, char** pDbName);
+// Replace the literals of the sql with '?'. @ppLiterals gets the text of each literal in order.
+int32_t qGetSqlTemplate(const char* pStr, int32_t length, char** ppTemplate, int32_t* pTemplateLen,
+                        SArray** ppLiterals);
 
 // for async mode
 int32_t qParseSqlSyntax(SParseContext* pCxt, SQuery** pQuery, struct SCatalogReq* pCatalogReq);
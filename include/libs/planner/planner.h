@@ -70,6 +70,16 @@ int32_t qMsgToSubplan(const char* pStr, int32_t len, SSubplan** pSubplan);
 
 SQueryPlan* qStringToQueryPlan(const char* pStr);
 
+// Convert a whole query plan, including the links between subplans, to msg so it can be kept and
+// rebuilt later. The rebuilt plan gets @queryId, explain and post plans are not supported.
+int32_t qQueryPlanToMsg(const SQueryPlan* pPlan, char** pStr, int32_t* pLen);
+int32_t qMsgToQueryPlan(const char* pStr, int32_t len, uint64_t queryId, SQueryPlan** pPlan);
+
+// The time range shared by all table scans of the plan, and the rebinding of it. Every time window in the plan
+// that equals @pOld is set to @pNew.
+int32_t qQueryPlanGetTimeRange(const SQueryPlan* pPlan, STimeWindow* pRange);
+void    qQueryPlanSetTimeRange(SQueryPlan* pPlan, const STimeWindow* pOld, const STimeWindow* pNew);
+
 void qDestroyQueryPlan(SQueryPlan* pPlan);
 
 #ifdef __cplusplus
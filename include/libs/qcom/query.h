@@ -41,6 +41,13 @@ typedef enum {
   JOB_TASK_STATUS_MAX,
 } EJobTaskType;
 
+typedef enum {
+  TASK_ADMIT_DIRECT = 0,  // light task, or heavy task admitted without waiting
+  TASK_ADMIT_QUEUED,      // heavy task waiting for a heavy task slot
+  TASK_ADMIT_WAITED,      // heavy task admitted after waiting in the queue
+  TASK_ADMIT_ALONE,       // heavy task over the memory budget, admitted when no other heavy task runs
+} ETaskAdmitState;
+
 typedef enum {
   TASK_TYPE_PERSISTENT = 1,
   TASK_TYPE_TEMP,
@@ -332,6 +339,7 @@ int32_t queryCreateCTableMetaFromMsg(STableMetaRsp* msg, SCTableMeta* pMeta);
 int32_t queryCreateTableMetaFromMsg(STableMetaRsp* msg, bool isSuperTable, STableMeta** pMeta);
 int32_t queryCreateTableMetaExFromMsg(STableMetaRsp* msg, bool isSuperTable, STableMeta** pMeta);
 char*   jobTaskStatusStr(int32_t status);
+char*   taskAdmitStateStr(int32_t state);
 
 SSchema createSchema(int8_t type, int32_t bytes, col_id_t colId, const char* name);
 
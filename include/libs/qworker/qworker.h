@@ -58,10 +58,12 @@ typedef struct {
 } SQWorkerStat;
 
 typedef struct SQWMsgInfo {
-  int8_t taskType;
-  int8_t explain;
-  int8_t needFetch;
-  int8_t compressMsg;
+  int8_t  taskType;
+  int8_t  explain;
+  int8_t  needFetch;
+  int8_t  compressMsg;
+  int32_t fetchCreditRows;
+  int8_t  fetchColumnar;
 } SQWMsgInfo;
 
 typedef struct SQWMsg {
@@ -43,6 +43,7 @@ int32_t streamStateFuncGet(SStreamState* pState, const SWinKey* key, void** ppVa
 int32_t streamStatePut(SStreamState* pState, const SWinKey* key, const void* value, int32_t vLen);
 int32_t streamStateGet(SStreamState* pState, const SWinKey* key, void** pVal, int32_t* pVLen, int32_t* pWinCode);
 bool    streamStateCheck(SStreamState* pState, const SWinKey* key);
+int32_t streamStatePrefetch(SStreamState* pState, const SWinKey* pKeys, int32_t num);
 int32_t streamStateGetByPos(SStreamState* pState, void* pos, void** pVal);
 void    streamStateDel(SStreamState* pState, const SWinKey* key);
 void    streamStateClear(SStreamState* pState);
@@ -117,6 +117,12 @@ enum {
   TASK_TRIGGER_STATUS__MAY_ACTIVE,
 };
 
+enum {
+  TASK_CHKPT_BACKUP__NONE = 0,
+  TASK_CHKPT_BACKUP__FULL,
+  TASK_CHKPT_BACKUP__INCREMENTAL,
+};
+
 typedef enum {
   TASK_LEVEL__SOURCE = 1,
   TASK_LEVEL__AGG,
@@ -271,6 +277,11 @@ typedef struct SCheckpointInfo {
   int64_t                processedVer;
   int64_t                nextProcessVer;  // current offset in WAL, not serialize it
   int64_t                msgVer;
+  int64_t                latestSize;     // bytes of the latest checkpoint shipped to remote, not serialize it
+  int64_t                latestElapsed;  // elapsed time (ms) of the latest checkpoint, not serialize it
+  int8_t                 remoteBackup;   // backup type of the latest checkpoint, not serialize it
+  int64_t                remoteChkpId;   // latest checkpoint merged into the remote data dir, not serialize it
+  SArray*                pRemoteDel;     // SRemoteChkpDelFiles, remote files to remove once their checkpoint commits
   SActiveCheckpointInfo* pActiveInfo;
 } SCheckpointInfo;
 
@@ -338,6 +349,8 @@ typedef struct SDispatchMsgInfo {
   TdThreadMutex lock;
   int8_t        inMonitor;
   SArray*       pSendInfo;  //  SArray<SDispatchEntry>
+  int32_t       credit;     // min credit (KiB) of the downstream tasks in the latest completed dispatch, -1 if unknown
+  int32_t       rspCredit;  // min credit (KiB) collected from the rsp of current dispatch msg
 } SDispatchMsgInfo;
 
 typedef struct STaskQueue {
@@ -358,6 +371,18 @@ typedef struct SSinkRecorder {
   int64_t dataSize;
 } SSinkRecorder;
 
+#define STREAM_EXEC_BATCH_HIST_BUCKETS 10  // number of blocks in one batch: 1, 2-3, 4-7, ..., 512-
+#define STREAM_EXEC_LAG_HIST_BUCKETS   24  // lag in ms: 0-1, 2-3, 4-7, ...
+
+typedef struct SStreamExecBatchInfo {
+  int32_t limit;         // adaptive maximum number of input blocks merged into one batch
+  int64_t inputTs;       // enqueue time(us) of the first input block of the batch in process
+  double  costPerBlock;  // moving average of the exec time(us) of one input block
+  double  avgBlocks;     // moving average of the number of input blocks in one batch
+  int64_t batchHist[STREAM_EXEC_BATCH_HIST_BUCKETS];
+  int64_t lagHist[STREAM_EXEC_LAG_HIST_BUCKETS];
+} SStreamExecBatchInfo;
+
 typedef struct STaskExecStatisInfo {
   int64_t created;
   int64_t checkTs;
@@ -379,8 +404,9 @@ typedef struct STaskExecStatisInfo {
   double        outputThroughput;
   int32_t       dispatch;
   int64_t       dispatchDataSize;
-  int32_t       checkpoint;
-  SSinkRecorder sink;
+  int32_t              checkpoint;
+  SSinkRecorder        sink;
+  SStreamExecBatchInfo batch;
 } STaskExecStatisInfo;
 
 typedef struct SHistoryTaskInfo {
@@ -574,6 +600,7 @@ typedef struct {
   int32_t msgId;
   int8_t  inputStatus;
   int64_t stage;
+  int32_t credit;  // free capacity (KiB) of the downstream inputQ, -1 if unknown. Absent in rsp of old version
 } SStreamDispatchRsp;
 
 typedef struct {
@@ -596,6 +623,7 @@ typedef struct STaskCkptInfo {
   int64_t latestTime;        // latest checkpoint time
   int64_t latestSize;        // latest checkpoint size
   int8_t  remoteBackup;      // latest checkpoint backup done
+  int64_t latestElapsed;     // elapsed time (ms) of the latest checkpoint
   int64_t activeId;          // current active checkpoint id
   int32_t activeTransId;     // checkpoint trans id
   int8_t  failed;            // denote if the checkpoint is failed or not
@@ -624,6 +652,13 @@ typedef struct STaskStatusEntry {
   int64_t       startCheckpointVer;
   int64_t       hTaskId;
   STaskCkptInfo checkpointInfo;
+  int64_t       stateIoTime;     // time (us) spent on reading/writing window states in backend
+  int64_t       stateStallTime;  // time (us) blocked by the async window state writer
+  int32_t       execBatchLimit;  // current adaptive limit of input blocks in one exec batch
+  double        execBatchAvg;    // average number of input blocks in one exec batch
+  int32_t       execBatchP99;    // p99 of the number of input blocks in one exec batch
+  int64_t       execLagP50;      // p50 of the end-to-end lag (ms) from input queue to exec completed
+  int64_t       execLagP99;      // p99 of the end-to-end lag (ms) from input queue to exec completed
 } STaskStatusEntry;
 
 typedef struct SNodeUpdateInfo {
@@ -97,6 +97,13 @@ typedef struct {
 #pragma pack(pop)
 
 typedef void (*stopDnodeFn)();
+// counters of the log append path, only updated when enableWriteStat is set
+typedef struct {
+  int64_t appendNum;
+  int64_t appendBytes;
+  int64_t appendUs;
+} SWalWriteStat;
+
 typedef struct SWal {
   // cfg
   SWalCfg cfg;
@@ -124,6 +131,8 @@ typedef struct SWal {
 
   // reusable write head
   SWalCkHead writeHead;
+
+  SWalWriteStat writeStat;
 } SWal;
 
 typedef struct {
@@ -170,6 +179,7 @@ void    walClose(SWal *);
 // By assigning index by the caller, wal gurantees linearizability
 int32_t walAppendLog(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body, int32_t bodyLen);
 int32_t walFsync(SWal *, bool force);
+void    walGetWriteStat(SWal *, SWalWriteStat *pStat);
 
 // apis for lifecycle management
 int32_t walCommit(SWal *, int64_t ver);
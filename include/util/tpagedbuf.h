@@ -39,6 +39,9 @@ typedef struct SDiskbasedBufStatis {
   int32_t getPages;
   int32_t releasePages;
   int32_t flushPages;
+  int64_t rawFlushBytes;   // flushed bytes before compression
+  int64_t stallTime;       // time waiting for the spilled pages in flight, in us
+  int32_t readAheadPages;  // pages loaded from the read-ahead buffer
 } SDiskbasedBufStatis;
 
 /**
@@ -151,6 +154,13 @@ void setBufPageDirty(void* pPage, bool dirty);
  */
 int32_t setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp);
 
+/**
+ * Flush the evicted pages to disk in a background thread, it takes effect only before any page is flushed.
+ * @param pBuf
+ * @param async
+ */
+int32_t setBufPageAsyncFlush(SDiskbasedBuf* pBuf, bool async);
+
 /**
  * Set the pageId page buffer is not need
  * @param pBuf
@@ -176,6 +176,19 @@ typedef struct SQueryAutoQWorkerPoolCB {
   int32_t (*afterRecoverFromBlocking)(void *pPool);
 } SQueryAutoQWorkerPoolCB;
 
+typedef void (*FQueryJob)(void *param);
+
+// The background jobs of queries, such as sorting runs, writing spilled pages and reading ahead, share one query auto
+// worker pool of the process, which is created by the first job. The queue is unbounded so that submitting never
+// blocks, and the jobs still queued when the process exits are run by the exiting thread.
+int32_t tQueryJobSubmit(FQueryJob fp, void *param);
+int32_t tQueryJobPending();
+int32_t tQueryJobThreads();
+// A job that waits for the query thread, e.g. for free space of its output, brackets the wait with the two calls, so
+// that the pool lends its slot to another thread and the jobs queued behind it are not stuck.
+int32_t tQueryJobBeforeBlocking();
+int32_t tQueryJobAfterBlocking();
+
 #ifdef __cplusplus
 }
 #endif
@@ -175,6 +175,8 @@ typedef struct STscObj {
   SPassInfo      passInfo;
   SWhiteListInfo whiteListInfo;
   STscNotifyInfo userDroppedInfo;
+  void*          pSmlCache;  // SSmlCache, schemaless meta kept across insert calls, created on first use
+  void*          pPlanCache;  // SPlanCache, physical plans of repeated queries, created on first use
 } STscObj;
 
 typedef struct STscDbg {
@@ -278,6 +280,7 @@ typedef struct SRequestObj {
   bool                 inCallback;
   bool                 isStmtBind;  // is statement bind parameter
   bool                 isQuery;
+  bool                 planFromCache;  // the plan was taken from the plan cache of the connection
   uint32_t             prevCode;  // previous error code: todo refactor, add update flag for catalog
   uint32_t             retry;
   int64_t              allocatorRefId;
@@ -346,6 +349,8 @@ SMsgSendInfo* buildMsgInfoImpl(SRequestObj* pReqObj);
 int32_t  createTscObj(const char* user, const char* auth, const char* db, int32_t connType, SAppInstInfo* pAppInfo,
                       STscObj** p);
 void     destroyTscObj(void* pObj);
+void     smlDestroyCache(void* pCache);
+void     planCacheDestroy(void* pCache);
 STscObj* acquireTscObj(int64_t rid);
 void     releaseTscObj(int64_t rid);
 void     destroyAppInst(void* pAppInfo);
@@ -437,6 +442,12 @@ void    stopAllQueries(SRequestObj* pRequest);
 void    doRequestCallback(SRequestObj* pRequest, int32_t code);
 void    freeQueryParam(SSyncQueryParam* param);
 
+// --- plan cache
+void    planCachePut(SRequestObj* pRequest, SQuery* pQuery, SQueryPlan* pDag, SArray* pMnodeList);
+int32_t planCacheGet(SRequestObj* pRequest, SQueryPlan** ppDag, SArray** ppMnodeList);
+void    planCacheRemove(SRequestObj* pRequest);
+bool    launchAsyncQueryFromPlanCache(SRequestObj* pRequest);
+
 #ifdef TD_ENTERPRISE
 int32_t clientParseSqlImpl(void* param, const char* dbName, const char* sql, bool parseOnly, const char* effeciveUser,
                            SParseSqlRes* pRes);
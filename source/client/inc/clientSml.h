@@ -54,6 +54,8 @@ extern "C" {
 #define QUOTE '"'
 #define SLASH '\\'
 
+#define SML_PARSE_LINES_PER_THREAD 10000  // min lines parsed by one thread, see smlParseInfluxParallel
+
 #define JUMP_SPACE(sql, sqlEnd) \
   while (sql < sqlEnd) {        \
     if (unlikely(*sql == SPACE))          \
@@ -166,6 +168,24 @@ typedef struct {
   char   *buf;
 } SSmlMsgBuf;
 
+#define SML_CACHE_MAX_CTABLES 100000
+
+typedef struct {
+  char    childTableName[TSDB_TABLE_NAME_LEN];
+  int32_t tbnameTagIdx;  // index of the tag consumed as table name, -1 if none
+} SSmlCTableName;
+
+// per connection cache of child table names, lives in STscObj and is shared by all schemaless calls on it. The stable
+// meta is not cached here, catalogGetSTableMeta already keeps it up to date with the schema versions.
+typedef struct {
+  TdThreadMutex lock;
+  SHashObj     *pCTables;  // <protocol + db + tbnameKey + measureTag, SSmlCTableName>
+  // naming config the cached child table names were generated with
+  bool          dot2Underline;
+  char          childTableName[TSDB_TABLE_NAME_LEN];
+  char          delimiter[TSDB_TABLE_NAME_LEN];
+} SSmlCache;
+
 typedef struct {
   int32_t code;
   int32_t lineNum;
@@ -200,6 +220,7 @@ typedef struct {
   SHashObj *pVgHash;
 
   STscObj     *taos;
+  SSmlCache   *pCache;
   SCatalog    *pCatalog;
   SRequestObj *pRequest;
   SQuery      *pQuery;
@@ -241,6 +262,7 @@ int32_t           smlBuildSTableMeta(bool isDataFormat, SSmlSTableMeta** sMeta);
 int32_t           smlSetCTableName(SSmlTableInfo *oneTable, char *tbnameKey);
 int32_t           getTableUid(SSmlHandle *info, SSmlLineInfo *currElement, SSmlTableInfo *tinfo);
 int32_t           smlGetMeta(SSmlHandle *info, const void* measure, int32_t measureLen, STableMeta **pTableMeta);
+int32_t           smlCreateCache(SSmlCache **ppCache);
 int32_t           is_same_child_table_telnet(const void *a, const void *b);
 int64_t           smlParseOpenTsdbTime(SSmlHandle *info, const char *data, int32_t len);
 int32_t           smlClearForRerun(SSmlHandle *info);
@@ -250,8 +272,11 @@ void              smlDestroyTableInfo(void *para);
 
 void    freeSSmlKv(void* data);
 int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLineInfo *elements);
+int32_t smlPreParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLineInfo *elements);
+int32_t smlParseInfluxTags(SSmlHandle *info, char *sqlEnd, SSmlLineInfo *elements);
 int32_t smlParseTelnetString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLineInfo *elements);
 int32_t smlParseJSONExt(SSmlHandle *info, char *payload);
+int32_t smlParseStart(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines);
 
 int32_t         smlBuildSuperTableInfo(SSmlHandle *info, SSmlLineInfo *currElement, SSmlSTableMeta** sMeta);
 bool            isSmlTagAligned(SSmlHandle *info, int cnt, SSmlKv *kv);
@@ -154,6 +154,9 @@ typedef struct {
   int32_t       errCode;
   tsem_t        asyncQuerySem;
   bool          semWaited;
+  int32_t       pipelineDepth;  // max async execs in flight, 1 means each exec waits for the previous one
+  tsem_t        inflightSem;
+  int32_t       pipelineCode;   // set by a failed pipelined exec, the cached tables are dropped on the next exec
   SStmtStatInfo stat;
 } STscStmt2;
 /*
@@ -1337,6 +1337,55 @@ void launchQueryImpl(SRequestObj* pRequest, SQuery* pQuery, bool keepQuery, void
   }
 }
 
+static int32_t asyncExecSchPlan(SRequestObj* pRequest, SQueryPlan* pDag, SArray* pMnodeList, SMetaData* pResultMeta,
+                                SSqlCallbackWrapper* pWrapper, bool needNodeList, int32_t code) {
+  if (TSDB_CODE_SUCCESS == code && !pRequest->validateOnly) {
+    SArray* pNodeList = NULL;
+    if (needNodeList) {
+      code = buildAsyncExecNodeList(pRequest, &pNodeList, pMnodeList, pResultMeta);
+    }
+
+    SRequestConnInfo conn = {.pTrans = getAppInfo(pRequest)->pTransporter,
+                             .requestId = pRequest->requestId,
+                             .requestObjRefId = pRequest->self};
+    SSchedulerReq    req = {
+           .syncReq = false,
+           .localReq = (tsQueryPolicy == QUERY_POLICY_CLIENT),
+           .pConn = &conn,
+           .pNodeList = pNodeList,
+           .pDag = pDag,
+           .allocatorRefId = pRequest->allocatorRefId,
+           .sql = pRequest->sqlstr,
+           .startTs = pRequest->metric.start,
+           .execFp = schedulerExecCb,
+           .cbParam = pWrapper,
+           .chkKillFp = chkRequestKilled,
+           .chkKillParam = (void*)pRequest->self,
+           .pExecRes = NULL,
+           .source = pRequest->source,
+           .pWorkerCb = getTaskPoolWorkerCb(),
+    };
+    if (TSDB_CODE_SUCCESS == code) {
+      code = schedulerExecJob(&req, &pRequest->body.queryJob);
+    }
+
+    taosArrayDestroy(pNodeList);
+  } else {
+    qDestroyQueryPlan(pDag);
+    tscDebug("0x%" PRIx64 " plan not executed, code:%s 0x%" PRIx64, pRequest->self, tstrerror(code),
+             pRequest->requestId);
+    destorySqlCallbackWrapper(pWrapper);
+    pRequest->pWrapper = NULL;
+    if (TSDB_CODE_SUCCESS != code) {
+      pRequest->code = terrno;
+    }
+
+    doRequestCallback(pRequest, code);
+  }
+
+  return code;
+}
+
 static int32_t asyncExecSchQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaData* pResultMeta,
                                  SSqlCallbackWrapper* pWrapper) {
   int32_t code = TSDB_CODE_SUCCESS;
@@ -1371,60 +1420,62 @@ static int32_t asyncExecSchQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaDat
     } else {
       pRequest->body.subplanNum = pDag->numOfSubplans;
       TSWAP(pRequest->pPostPlan, pDag->pPostPlan);
+      // the scheduler fills the plan in while running it, so it is kept before being handed over
+      if (!pRequest->validateOnly) {
+        planCachePut(pRequest, pQuery, pDag, pMnodeList);
+      }
     }
   }
 
   pRequest->metric.execStart = taosGetTimestampUs();
   pRequest->metric.planCostUs = pRequest->metric.execStart - st;
 
-  if (TSDB_CODE_SUCCESS == code && !pRequest->validateOnly) {
-    SArray* pNodeList = NULL;
-    if (QUERY_NODE_VNODE_MODIFY_STMT != nodeType(pQuery->pRoot)) {
-      code = buildAsyncExecNodeList(pRequest, &pNodeList, pMnodeList, pResultMeta);
-    }
+  code = asyncExecSchPlan(pRequest, pDag, pMnodeList, pResultMeta, pWrapper,
+                          QUERY_NODE_VNODE_MODIFY_STMT != nodeType(pQuery->pRoot), code);
 
-    SRequestConnInfo conn = {.pTrans = getAppInfo(pRequest)->pTransporter,
-                             .requestId = pRequest->requestId,
-                             .requestObjRefId = pRequest->self};
-    SSchedulerReq    req = {
-           .syncReq = false,
-           .localReq = (tsQueryPolicy == QUERY_POLICY_CLIENT),
-           .pConn = &conn,
-           .pNodeList = pNodeList,
-           .pDag = pDag,
-           .allocatorRefId = pRequest->allocatorRefId,
-           .sql = pRequest->sqlstr,
-           .startTs = pRequest->metric.start,
-           .execFp = schedulerExecCb,
-           .cbParam = pWrapper,
-           .chkKillFp = chkRequestKilled,
-           .chkKillParam = (void*)pRequest->self,
-           .pExecRes = NULL,
-           .source = pRequest->source,
-           .pWorkerCb = getTaskPoolWorkerCb(),
-    };
-    if (TSDB_CODE_SUCCESS == code) {
-      code = schedulerExecJob(&req, &pRequest->body.queryJob);
-    }
+  // todo not to be released here
+  taosArrayDestroy(pMnodeList);
 
-    taosArrayDestroy(pNodeList);
-  } else {
-    qDestroyQueryPlan(pDag);
-    tscDebug("0x%" PRIx64 " plan not executed, code:%s 0x%" PRIx64, pRequest->self, tstrerror(code),
-             pRequest->requestId);
-    destorySqlCallbackWrapper(pWrapper);
-    pRequest->pWrapper = NULL;
+  return code;
+}
+
+bool launchAsyncQueryFromPlanCache(SRequestObj* pRequest) {
+  SQueryPlan* pDag = NULL;
+  SArray*     pMnodeList = NULL;
+  int64_t     st = taosGetTimestampUs();
+  int32_t     code = planCacheGet(pRequest, &pDag, &pMnodeList);
+  if (TSDB_CODE_SUCCESS != code || NULL == pDag) {
     if (TSDB_CODE_SUCCESS != code) {
-      pRequest->code = terrno;
+      tscDebug("0x%" PRIx64 " failed to get cached plan, code:%s, QID:0x%" PRIx64, pRequest->self, tstrerror(code),
+               pRequest->requestId);
     }
+    return false;
+  }
 
-    doRequestCallback(pRequest, code);
+  SSqlCallbackWrapper* pWrapper = taosMemoryCalloc(1, sizeof(SSqlCallbackWrapper));
+  if (NULL == pWrapper) {
+    qDestroyQueryPlan(pDag);
+    taosArrayDestroy(pMnodeList);
+    qDestroyQuery(pRequest->pQuery);
+    pRequest->pQuery = NULL;
+    return false;
   }
+  pWrapper->pRequest = pRequest;
+  pRequest->pWrapper = pWrapper;
+  pRequest->body.subplanNum = pDag->numOfSubplans;
+  pRequest->planFromCache = true;
 
-  // todo not to be released here
-  taosArrayDestroy(pMnodeList);
+  if (!pRequest->inRetry) {
+    SAppClusterSummary* pActivity = &pRequest->pTscObj->pAppInfo->summary;
+    (void)atomic_add_fetch_64((int64_t*)&pActivity->numOfQueryReq, 1);
+  }
 
-  return code;
+  pRequest->metric.execStart = taosGetTimestampUs();
+  pRequest->metric.planCostUs = pRequest->metric.execStart - st;
+  (void)asyncExecSchPlan(pRequest, pDag, pMnodeList, NULL, pWrapper, true, TSDB_CODE_SUCCESS);
+
+  taosArrayDestroy(pMnodeList);
+  return true;
 }
 
 void launchAsyncQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaData* pResultMeta, SSqlCallbackWrapper* pWrapper) {
@@ -2553,14 +2604,11 @@ int32_t setQueryResultFromRsp(SReqResultInfo* pResultInfo, const SRetrieveTableR
     char* pStart = (char*)pRsp->data + sizeof(int32_t) * 2;
 
     if (pRsp->compressed && compLen < rawLen) {
-      int32_t len = tsDecompressString(pStart, compLen, 1, pResultInfo->decompBuf, rawLen, ONE_STAGE_COMP, NULL, 0);
-      if (len < 0) {
-        tscError("tsDecompressString failed");
-        return terrno ? terrno : TSDB_CODE_FAILED;
-      }
-      if (len != rawLen) {
-        tscError("tsDecompressString failed, len:%d != rawLen:%d", len, rawLen);
-        return TSDB_CODE_TSC_INTERNAL_ERROR;
+      int32_t code = blockDecompress(pRsp->compressed, pStart, compLen, pResultInfo->decompBuf, rawLen);
+      if (code != TSDB_CODE_SUCCESS) {
+        tscError("failed to decompress block, compressed:%d, compLen:%d, rawLen:%d, code:%s", pRsp->compressed, compLen,
+                 rawLen, tstrerror(code));
+        return code;
       }
       pResultInfo->pData = pResultInfo->decompBuf;
       pResultInfo->payloadLen = rawLen;
@@ -1302,6 +1302,13 @@ void doAsyncQuery(SRequestObj *pRequest, bool updateMetaForce) {
     return;
   }
 
+  // a retry means the cached meta was stale, so the plan built from it is dropped as well
+  if (updateMetaForce) {
+    planCacheRemove(pRequest);
+  } else if (launchAsyncQueryFromPlanCache(pRequest)) {
+    return;
+  }
+
   if (TSDB_CODE_SUCCESS == code) {
     code = prepareAndParseSqlSyntax(&pWrapper, pRequest, updateMetaForce);
   }
@@ -0,0 +1,614 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catalog.h"
+#include "clientInt.h"
+#include "clientLog.h"
+#include "parser.h"
+#include "planner.h"
+#include "tglobal.h"
+#include "ttime.h"
+
+// planner inputs that come from the client config rather than from the sql or the catalog
+typedef struct SPlanCacheCfg {
+  int32_t queryPolicy;
+  int32_t minSlidingTime;
+  int32_t minIntervalTime;
+  int8_t  keepColumnName;
+  int8_t  starReturnTags;
+  int8_t  costBasedJoin;
+  int8_t  daylight;
+  char    timezone[TD_TIMEZONE_LEN];  // string time literals are converted with it
+} SPlanCacheCfg;
+
+typedef struct SPlanCacheDb {
+  char    dbFName[TSDB_DB_FNAME_LEN];
+  int64_t dbId;
+  int32_t vgVersion;
+  int32_t cfgVersion;  // db options such as cachemodel change the plan
+} SPlanCacheDb;
+
+typedef struct SPlanCacheTable {
+  SName    name;
+  uint64_t uid;
+  int32_t  sversion;
+  int32_t  tversion;
+} SPlanCacheTable;
+
+typedef struct SPlanCacheEntry {
+  char*         pPlanMsg;
+  int32_t       planMsgLen;
+  int32_t       msgType;
+  int32_t       numOfResCols;
+  SSchema*      pResSchema;
+  int8_t        precision;
+  bool          stableQuery;
+  int32_t       authVer;
+  SPlanCacheCfg cfg;
+  SArray*       pDbs;        // SPlanCacheDb
+  SArray*       pTables;     // SPlanCacheTable
+  SArray*       pMnodeList;  // SQueryNodeLoad
+  SArray*       pLiterals;   // char*, the literals of the sql the plan was built for
+  bool          hasTimeRange;
+  STimeWindow   timeRange;  // the scan range of the plan
+  // the literals that only set the ends of the time range, as key = literal + delta, or -1 if not known yet
+  int32_t startSlot;
+  int32_t endSlot;
+  int8_t  startDelta;
+  int8_t  endDelta;
+} SPlanCacheEntry;
+
+typedef struct SPlanCache {
+  TdThreadMutex lock;
+  SHashObj*     pEntries;  // key is the current db and the sql text with its literals replaced by '?'
+} SPlanCache;
+
+static void planCacheGetCfg(SPlanCacheCfg* pCfg) {
+  (void)memset(pCfg, 0, sizeof(SPlanCacheCfg));
+  pCfg->queryPolicy = tsQueryPolicy;
+  pCfg->minSlidingTime = tsMinSlidingTime;
+  pCfg->minIntervalTime = tsMinIntervalTime;
+  pCfg->keepColumnName = tsKeepColumnName;
+  pCfg->starReturnTags = tsMultiResultFunctionStarReturnTags;
+  pCfg->costBasedJoin = tsQueryCostBasedJoin;
+  pCfg->daylight = tsDaylight;
+  tstrncpy(pCfg->timezone, tsTimezoneStr, TD_TIMEZONE_LEN);
+}
+
+static void planCacheFreeEntry(void* p) {
+  SPlanCacheEntry* pEntry = *(SPlanCacheEntry**)p;
+  if (NULL == pEntry) {
+    return;
+  }
+  taosMemoryFree(pEntry->pPlanMsg);
+  taosMemoryFree(pEntry->pResSchema);
+  taosArrayDestroy(pEntry->pDbs);
+  taosArrayDestroy(pEntry->pTables);
+  taosArrayDestroy(pEntry->pMnodeList);
+  taosArrayDestroyP(pEntry->pLiterals, taosMemoryFree);
+  taosMemoryFree(pEntry);
+}
+
+void planCacheDestroy(void* p) {
+  SPlanCache* pCache = (SPlanCache*)p;
+  if (NULL == pCache) {
+    return;
+  }
+  taosHashCleanup(pCache->pEntries);
+  (void)taosThreadMutexDestroy(&pCache->lock);
+  taosMemoryFree(pCache);
+}
+
+static int32_t planCacheAcquire(STscObj* pTscObj, SPlanCache** ppCache) {
+  SPlanCache* pCache = (SPlanCache*)atomic_load_ptr(&pTscObj->pPlanCache);
+  if (NULL == pCache) {
+    pCache = taosMemoryCalloc(1, sizeof(SPlanCache));
+    if (NULL == pCache) {
+      return terrno;
+    }
+    if (taosThreadMutexInit(&pCache->lock, NULL) != 0) {
+      taosMemoryFree(pCache);
+      return TAOS_SYSTEM_ERROR(errno);
+    }
+    pCache->pEntries = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+    if (NULL == pCache->pEntries) {
+      planCacheDestroy(pCache);
+      return terrno;
+    }
+    taosHashSetFreeFp(pCache->pEntries, planCacheFreeEntry);
+
+    SPlanCache* pOld = (SPlanCache*)atomic_val_compare_exchange_ptr(&pTscObj->pPlanCache, NULL, pCache);
+    if (NULL != pOld) {
+      planCacheDestroy(pCache);
+      pCache = pOld;
+    }
+  }
+  *ppCache = pCache;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t planCacheBuildKey(SRequestObj* pRequest, char** ppKey, int32_t* pKeyLen, SArray** ppLiterals) {
+  char*   pTemplate = NULL;
+  int32_t templateLen = 0;
+  SArray* pLiterals = NULL;
+  int32_t code = qGetSqlTemplate(pRequest->sqlstr, pRequest->sqlLen, &pTemplate, &templateLen, &pLiterals);
+  if (TSDB_CODE_SUCCESS != code) {
+    return code;
+  }
+
+  const char* db = (NULL != pRequest->pDb) ? pRequest->pDb : "";
+  int32_t     dbLen = strlen(db);
+  int32_t     keyLen = dbLen + 1 + templateLen;
+  char*       pKey = taosMemoryMalloc(keyLen);
+  if (NULL == pKey) {
+    taosMemoryFree(pTemplate);
+    taosArrayDestroyP(pLiterals, taosMemoryFree);
+    return terrno;
+  }
+  (void)memcpy(pKey, db, dbLen + 1);
+  (void)memcpy(pKey + dbLen + 1, pTemplate, templateLen);
+  taosMemoryFree(pTemplate);
+  *ppKey = pKey;
+  *pKeyLen = keyLen;
+  if (NULL != ppLiterals) {
+    *ppLiterals = pLiterals;
+  } else {
+    taosArrayDestroyP(pLiterals, taosMemoryFree);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static bool planCacheUsable(SRequestObj* pRequest) {
+  return tsQueryPlanCacheSize > 0 && 0 == tsQuerySmaOptimize && NULL != pRequest->sqlstr && pRequest->sqlLen > 0 &&
+         !pRequest->validateOnly && !pRequest->parseOnly && !pRequest->isStmtBind && !pRequest->isSubReq &&
+         0 == pRequest->relation.prevRefId && 0 == pRequest->relation.nextRefId;
+}
+
+// the plan is only valid as long as everything the parser and planner looked up is still the same
+static bool planCacheCheckVersions(SCatalog* pCtg, SPlanCacheEntry* pEntry) {
+  for (int32_t i = 0; i < taosArrayGetSize(pEntry->pDbs); ++i) {
+    SPlanCacheDb* pDb = taosArrayGet(pEntry->pDbs, i);
+    int32_t       vgVersion = -1;
+    int64_t       dbId = 0;
+    int32_t       tableNum = 0;
+    int64_t       stateTs = 0;
+    int32_t       cfgVersion = -1;
+    if (TSDB_CODE_SUCCESS != catalogGetDBVgVersion(pCtg, pDb->dbFName, &vgVersion, &dbId, &tableNum, &stateTs) ||
+        vgVersion != pDb->vgVersion || dbId != pDb->dbId ||
+        TSDB_CODE_SUCCESS != catalogGetDBCfgVersion(pCtg, pDb->dbFName, &cfgVersion) ||
+        cfgVersion != pDb->cfgVersion) {
+      return false;
+    }
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pEntry->pTables); ++i) {
+    SPlanCacheTable* pTable = taosArrayGet(pEntry->pTables, i);
+    STableMeta*      pMeta = NULL;
+    if (TSDB_CODE_SUCCESS != catalogGetCachedTableMeta(pCtg, &pTable->name, &pMeta) || NULL == pMeta) {
+      return false;
+    }
+    bool same = pMeta->uid == pTable->uid && pMeta->sversion == pTable->sversion &&
+                pMeta->tversion == pTable->tversion;
+    taosMemoryFree(pMeta);
+    if (!same) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool planCacheGetLiteralTs(const char* pLiteral, int8_t precision, int64_t* pTs) {
+  int32_t len = strlen(pLiteral);
+  if ('\'' == pLiteral[0] || '"' == pLiteral[0]) {
+    if (len < 2 || TSDB_CODE_SUCCESS != taosParseTime(pLiteral + 1, pTs, len - 2, precision, tsDaylight)) {
+      return false;
+    }
+  } else {
+    char* pEnd = NULL;
+    errno = 0;
+    *pTs = taosStr2Int64(pLiteral, &pEnd, 10);
+    if (0 != errno || pEnd != pLiteral + len) {
+      return false;
+    }
+  }
+  return INT64_MIN != *pTs && INT64_MAX != *pTs;
+}
+
+static bool planCacheLiteralChanged(SArray* pOld, SArray* pNew, int32_t slot) {
+  return 0 != strcmp(taosArrayGetP(pOld, slot), taosArrayGetP(pNew, slot));
+}
+
+// find the changed literal that moved one end of the time range from @oldKey to @newKey
+static bool planCacheMatchTimeKey(SPlanCacheEntry* pOld, SPlanCacheEntry* pNew, int64_t oldKey, int64_t newKey,
+                                  int8_t delta, int32_t* pSlot, int8_t* pDelta) {
+  if (INT64_MIN == oldKey || INT64_MAX == oldKey || INT64_MIN == newKey || INT64_MAX == newKey) {
+    return false;
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(pOld->pLiterals); ++i) {
+    int64_t oldTs = 0;
+    int64_t newTs = 0;
+    if (!planCacheLiteralChanged(pOld->pLiterals, pNew->pLiterals, i) ||
+        !planCacheGetLiteralTs(taosArrayGetP(pOld->pLiterals, i), pOld->precision, &oldTs) ||
+        !planCacheGetLiteralTs(taosArrayGetP(pNew->pLiterals, i), pNew->precision, &newTs)) {
+      continue;
+    }
+    if (oldKey == oldTs && newKey == newTs) {
+      *pSlot = i;
+      *pDelta = 0;
+      return true;
+    }
+    if (oldKey == oldTs + delta && newKey == newTs + delta) {
+      *pSlot = i;
+      *pDelta = delta;
+      return true;
+    }
+  }
+  return false;
+}
+
+// A plan of the same sql template was built again for other literals. If the literals that changed only moved the
+// ends of the time range, and the old plan with the new time range is the new plan, later literals of those slots
+// can be bound into the cached plan without planning again.
+static void planCacheLearnTimeRange(SPlanCacheEntry* pOld, SPlanCacheEntry* pNew, uint64_t queryId) {
+  if (!pOld->hasTimeRange || !pNew->hasTimeRange || pOld->precision != pNew->precision ||
+      taosArrayGetSize(pOld->pLiterals) != taosArrayGetSize(pNew->pLiterals)) {
+    return;
+  }
+
+  int32_t startSlot = -1;
+  int32_t endSlot = -1;
+  int8_t  startDelta = 0;
+  int8_t  endDelta = 0;
+  if (pOld->timeRange.skey == pNew->timeRange.skey) {
+    startSlot = pOld->startSlot;
+    startDelta = pOld->startDelta;
+  } else if (!planCacheMatchTimeKey(pOld, pNew, pOld->timeRange.skey, pNew->timeRange.skey, 1, &startSlot,
+                                    &startDelta)) {
+    return;
+  }
+  if (pOld->timeRange.ekey == pNew->timeRange.ekey) {
+    endSlot = pOld->endSlot;
+    endDelta = pOld->endDelta;
+  } else if (!planCacheMatchTimeKey(pOld, pNew, pOld->timeRange.ekey, pNew->timeRange.ekey, -1, &endSlot,
+                                    &endDelta)) {
+    return;
+  }
+
+  bool changed = false;
+  for (int32_t i = 0; i < taosArrayGetSize(pOld->pLiterals); ++i) {
+    if (!planCacheLiteralChanged(pOld->pLiterals, pNew->pLiterals, i)) {
+      continue;
+    }
+    // a slot kept from the old entry must not change when its end of the range did not
+    if ((i != startSlot && i != endSlot) ||
+        (i == startSlot && pOld->timeRange.skey == pNew->timeRange.skey) ||
+        (i == endSlot && pOld->timeRange.ekey == pNew->timeRange.ekey)) {
+      return;
+    }
+    changed = true;
+  }
+  if (!changed) {
+    return;
+  }
+
+  SQueryPlan* pPlan = NULL;
+  char*       pMsg = NULL;
+  int32_t     len = 0;
+  int32_t     code = qMsgToQueryPlan(pOld->pPlanMsg, pOld->planMsgLen, queryId, &pPlan);
+  if (TSDB_CODE_SUCCESS == code) {
+    qQueryPlanSetTimeRange(pPlan, &pOld->timeRange, &pNew->timeRange);
+    code = qQueryPlanToMsg(pPlan, &pMsg, &len);
+  }
+  if (TSDB_CODE_SUCCESS == code && len == pNew->planMsgLen && 0 == memcmp(pMsg, pNew->pPlanMsg, len)) {
+    pNew->startSlot = startSlot;
+    pNew->startDelta = startDelta;
+    pNew->endSlot = endSlot;
+    pNew->endDelta = endDelta;
+  }
+  qDestroyQueryPlan(pPlan);
+  taosMemoryFree(pMsg);
+}
+
+// literals that differ from the cached ones may only be the learned ends of the time range
+static bool planCacheBindTimeRange(SPlanCacheEntry* pEntry, SArray* pLiterals, STimeWindow* pRange, bool* pRebind) {
+  *pRange = pEntry->timeRange;
+  *pRebind = false;
+  if (taosArrayGetSize(pEntry->pLiterals) != taosArrayGetSize(pLiterals)) {
+    return false;
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(pLiterals); ++i) {
+    if (!planCacheLiteralChanged(pEntry->pLiterals, pLiterals, i)) {
+      continue;
+    }
+    int64_t ts = 0;
+    if ((i != pEntry->startSlot && i != pEntry->endSlot) ||
+        !planCacheGetLiteralTs(taosArrayGetP(pLiterals, i), pEntry->precision, &ts)) {
+      return false;
+    }
+    if (i == pEntry->startSlot) {
+      pRange->skey = ts + pEntry->startDelta;
+    }
+    if (i == pEntry->endSlot) {
+      pRange->ekey = ts + pEntry->endDelta;
+    }
+    *pRebind = true;
+  }
+  return !*pRebind || pRange->skey <= pRange->ekey;
+}
+
+static int32_t planCacheBuildEntry(SRequestObj* pRequest, SQuery* pQuery, SQueryPlan* pDag, SArray* pMnodeList,
+                                   SArray* pLiterals, SPlanCacheEntry** ppEntry) {
+  SCatalog* pCtg = NULL;
+  int32_t   code = catalogGetHandle(pRequest->pTscObj->pAppInfo->clusterId, &pCtg);
+  if (TSDB_CODE_SUCCESS != code) {
+    return code;
+  }
+
+  SPlanCacheEntry* pEntry = taosMemoryCalloc(1, sizeof(SPlanCacheEntry));
+  if (NULL == pEntry) {
+    return terrno;
+  }
+  pEntry->msgType = pQuery->msgType;
+  pEntry->numOfResCols = pQuery->numOfResCols;
+  pEntry->precision = pQuery->precision;
+  pEntry->stableQuery = pQuery->stableQuery;
+  pEntry->authVer = pRequest->pTscObj->authVer;
+  pEntry->pLiterals = pLiterals;
+  pEntry->hasTimeRange = (TSDB_CODE_SUCCESS == qQueryPlanGetTimeRange(pDag, &pEntry->timeRange));
+  pEntry->startSlot = -1;
+  pEntry->endSlot = -1;
+  planCacheGetCfg(&pEntry->cfg);
+
+  code = qQueryPlanToMsg(pDag, &pEntry->pPlanMsg, &pEntry->planMsgLen);
+  if (TSDB_CODE_SUCCESS == code) {
+    pEntry->pResSchema = taosMemoryMalloc(pQuery->numOfResCols * sizeof(SSchema));
+    if (NULL == pEntry->pResSchema) {
+      code = terrno;
+    } else {
+      (void)memcpy(pEntry->pResSchema, pQuery->pResSchema, pQuery->numOfResCols * sizeof(SSchema));
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    pEntry->pMnodeList = taosArrayDup(pMnodeList, NULL);
+    pEntry->pDbs = taosArrayInit(TMAX(taosArrayGetSize(pRequest->dbList), 1), sizeof(SPlanCacheDb));
+    pEntry->pTables = taosArrayInit(TMAX(taosArrayGetSize(pRequest->tableList), 1), sizeof(SPlanCacheTable));
+    if ((NULL != pMnodeList && NULL == pEntry->pMnodeList) || NULL == pEntry->pDbs || NULL == pEntry->pTables) {
+      code = terrno;
+    }
+  }
+
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < taosArrayGetSize(pRequest->dbList); ++i) {
+    SPlanCacheDb db = {0};
+    int32_t      tableNum = 0;
+    int64_t      stateTs = 0;
+    tstrncpy(db.dbFName, taosArrayGet(pRequest->dbList, i), TSDB_DB_FNAME_LEN);
+    code = catalogGetDBVgVersion(pCtg, db.dbFName, &db.vgVersion, &db.dbId, &tableNum, &stateTs);
+    if (TSDB_CODE_SUCCESS == code && db.vgVersion < 0) {
+      code = TSDB_CODE_OPS_NOT_SUPPORT;
+    }
+    if (TSDB_CODE_SUCCESS == code) {
+      code = catalogGetDBCfgVersion(pCtg, db.dbFName, &db.cfgVersion);
+    }
+    if (TSDB_CODE_SUCCESS == code && NULL == taosArrayPush(pEntry->pDbs, &db)) {
+      code = terrno;
+    }
+  }
+
+  // system tables are not kept in the catalog cache, so queries on them are never cached
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < taosArrayGetSize(pRequest->tableList); ++i) {
+    SPlanCacheTable table = {.name = *(SName*)taosArrayGet(pRequest->tableList, i)};
+    STableMeta*     pMeta = NULL;
+    code = catalogGetCachedTableMeta(pCtg, &table.name, &pMeta);
+    if (TSDB_CODE_SUCCESS == code && NULL == pMeta) {
+      code = TSDB_CODE_OPS_NOT_SUPPORT;
+    }
+    if (TSDB_CODE_SUCCESS == code) {
+      table.uid = pMeta->uid;
+      table.sversion = pMeta->sversion;
+      table.tversion = pMeta->tversion;
+      if (NULL == taosArrayPush(pEntry->pTables, &table)) {
+        code = terrno;
+      }
+    }
+    taosMemoryFree(pMeta);
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    *ppEntry = pEntry;
+  } else {
+    pEntry->pLiterals = NULL;
+    planCacheFreeEntry(&pEntry);
+  }
+  return code;
+}
+
+void planCachePut(SRequestObj* pRequest, SQuery* pQuery, SQueryPlan* pDag, SArray* pMnodeList) {
+  if (!planCacheUsable(pRequest) || NULL == pQuery->pRoot || pQuery->nonDeterministic || !pQuery->haveResultSet ||
+      NULL != pRequest->pPostPlan ||
+      (QUERY_NODE_SELECT_STMT != nodeType(pQuery->pRoot) && QUERY_NODE_SET_OPERATOR != nodeType(pQuery->pRoot))) {
+    return;
+  }
+
+  SPlanCache*      pCache = NULL;
+  SPlanCacheEntry* pEntry = NULL;
+  char*            pKey = NULL;
+  int32_t          keyLen = 0;
+  SArray*          pLiterals = NULL;
+  int32_t          code = planCacheAcquire(pRequest->pTscObj, &pCache);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = planCacheBuildKey(pRequest, &pKey, &keyLen, &pLiterals);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = planCacheBuildEntry(pRequest, pQuery, pDag, pMnodeList, pLiterals, &pEntry);
+    if (TSDB_CODE_SUCCESS != code) {
+      taosArrayDestroyP(pLiterals, taosMemoryFree);
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    (void)taosThreadMutexLock(&pCache->lock);
+    SPlanCacheEntry** ppOld = (SPlanCacheEntry**)taosHashGet(pCache->pEntries, pKey, keyLen);
+    if (NULL != ppOld) {
+      planCacheLearnTimeRange(*ppOld, pEntry, pDag->queryId);
+    } else if (taosHashGetSize(pCache->pEntries) >= tsQueryPlanCacheSize) {
+      taosHashClear(pCache->pEntries);
+    }
+    code = taosHashPut(pCache->pEntries, pKey, keyLen, &pEntry, POINTER_BYTES);
+    (void)taosThreadMutexUnlock(&pCache->lock);
+    if (TSDB_CODE_SUCCESS != code) {
+      planCacheFreeEntry(&pEntry);
+    }
+  }
+
+  if (TSDB_CODE_SUCCESS != code && TSDB_CODE_OPS_NOT_SUPPORT != code) {
+    tscDebug("0x%" PRIx64 " plan not cached, code:%s, QID:0x%" PRIx64, pRequest->self, tstrerror(code),
+             pRequest->requestId);
+  }
+  taosMemoryFree(pKey);
+}
+
+static int32_t planCacheSetRequest(SRequestObj* pRequest, SPlanCacheEntry* pEntry) {
+  SQuery* pQuery = NULL;
+  int32_t code = nodesMakeNode(QUERY_NODE_QUERY, (SNode**)&pQuery);
+  if (TSDB_CODE_SUCCESS != code) {
+    return code;
+  }
+  pQuery->execMode = QUERY_EXEC_MODE_SCHEDULE;
+  pQuery->msgType = pEntry->msgType;
+  pQuery->haveResultSet = true;
+  pQuery->stableQuery = pEntry->stableQuery;
+  pQuery->precision = pEntry->precision;
+  pRequest->pQuery = pQuery;
+
+  pRequest->type = pEntry->msgType;
+  pRequest->stmtType = QUERY_NODE_SELECT_STMT;
+  pRequest->stableQuery = pEntry->stableQuery;
+  pRequest->body.execMode = QUERY_EXEC_MODE_SCHEDULE;
+
+  taosArrayDestroy(pRequest->dbList);
+  pRequest->dbList = taosArrayInit(TMAX(taosArrayGetSize(pEntry->pDbs), 1), TSDB_DB_FNAME_LEN);
+  taosArrayDestroy(pRequest->tableList);
+  pRequest->tableList = taosArrayInit(TMAX(taosArrayGetSize(pEntry->pTables), 1), sizeof(SName));
+  if (NULL == pRequest->dbList || NULL == pRequest->tableList) {
+    return terrno;
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(pEntry->pDbs); ++i) {
+    SPlanCacheDb* pDb = taosArrayGet(pEntry->pDbs, i);
+    if (NULL == taosArrayPush(pRequest->dbList, pDb->dbFName)) {
+      return terrno;
+    }
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(pEntry->pTables); ++i) {
+    SPlanCacheTable* pTable = taosArrayGet(pEntry->pTables, i);
+    if (NULL == taosArrayPush(pRequest->tableList, &pTable->name)) {
+      return terrno;
+    }
+  }
+
+  code = setResSchemaInfo(&pRequest->body.resInfo, pEntry->pResSchema, pEntry->numOfResCols);
+  if (TSDB_CODE_SUCCESS == code) {
+    setResPrecision(&pRequest->body.resInfo, pEntry->precision);
+  }
+  return code;
+}
+
+int32_t planCacheGet(SRequestObj* pRequest, SQueryPlan** ppDag, SArray** ppMnodeList) {
+  *ppDag = NULL;
+  *ppMnodeList = NULL;
+  SPlanCache* pCache = (SPlanCache*)atomic_load_ptr(&pRequest->pTscObj->pPlanCache);
+  if (NULL == pCache || !planCacheUsable(pRequest) || NULL != pRequest->pQuery) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SCatalog* pCtg = NULL;
+  char*     pKey = NULL;
+  int32_t   keyLen = 0;
+  SArray*   pLiterals = NULL;
+  int32_t   code = catalogGetHandle(pRequest->pTscObj->pAppInfo->clusterId, &pCtg);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = planCacheBuildKey(pRequest, &pKey, &keyLen, &pLiterals);
+  }
+  if (TSDB_CODE_SUCCESS != code) {
+    return code;
+  }
+
+  SPlanCacheCfg cfg = {0};
+  planCacheGetCfg(&cfg);
+
+  (void)taosThreadMutexLock(&pCache->lock);
+  SPlanCacheEntry** ppEntry = (SPlanCacheEntry**)taosHashGet(pCache->pEntries, pKey, keyLen);
+  STimeWindow       timeRange = {0};
+  bool              rebind = false;
+  if (NULL != ppEntry) {
+    SPlanCacheEntry* pEntry = *ppEntry;
+    if (pEntry->authVer != pRequest->pTscObj->authVer || 0 != memcmp(&pEntry->cfg, &cfg, sizeof(cfg)) ||
+        !planCacheCheckVersions(pCtg, pEntry)) {
+      (void)taosHashRemove(pCache->pEntries, pKey, keyLen);
+    } else if (planCacheBindTimeRange(pEntry, pLiterals, &timeRange, &rebind)) {
+      code = nodesAcquireAllocator(pRequest->allocatorRefId);
+      if (TSDB_CODE_SUCCESS == code) {
+        code = qMsgToQueryPlan(pEntry->pPlanMsg, pEntry->planMsgLen, pRequest->requestId, ppDag);
+        if (TSDB_CODE_SUCCESS == code && rebind) {
+          qQueryPlanSetTimeRange(*ppDag, &pEntry->timeRange, &timeRange);
+        }
+        int32_t tcode = nodesReleaseAllocator(pRequest->allocatorRefId);
+        if (TSDB_CODE_SUCCESS == code) {
+          code = tcode;
+        }
+      }
+      if (TSDB_CODE_SUCCESS == code) {
+        *ppMnodeList = taosArrayDup(pEntry->pMnodeList, NULL);
+        if (NULL != pEntry->pMnodeList && NULL == *ppMnodeList) {
+          code = terrno;
+        }
+      }
+      if (TSDB_CODE_SUCCESS == code) {
+        code = planCacheSetRequest(pRequest, pEntry);
+      }
+    }
+  }
+  (void)taosThreadMutexUnlock(&pCache->lock);
+  taosMemoryFree(pKey);
+  taosArrayDestroyP(pLiterals, taosMemoryFree);
+
+  if (TSDB_CODE_SUCCESS != code) {
+    qDestroyQueryPlan(*ppDag);
+    *ppDag = NULL;
+    taosArrayDestroy(*ppMnodeList);
+    *ppMnodeList = NULL;
+    qDestroyQuery(pRequest->pQuery);
+    pRequest->pQuery = NULL;
+  } else if (NULL != *ppDag) {
+    tscDebug("0x%" PRIx64 " plan cache hit, subplans:%d, rebind:%d, QID:0x%" PRIx64, pRequest->self,
+             (*ppDag)->numOfSubplans, rebind, pRequest->requestId);
+  }
+  return code;
+}
+
+void planCacheRemove(SRequestObj* pRequest) {
+  SPlanCache* pCache = (SPlanCache*)atomic_load_ptr(&pRequest->pTscObj->pPlanCache);
+  if (NULL == pCache || NULL == pRequest->sqlstr) {
+    return;
+  }
+
+  char*   pKey = NULL;
+  int32_t keyLen = 0;
+  if (TSDB_CODE_SUCCESS != planCacheBuildKey(pRequest, &pKey, &keyLen, NULL)) {
+    return;
+  }
+  (void)taosThreadMutexLock(&pCache->lock);
+  (void)taosHashRemove(pCache->pEntries, pKey, keyLen);
+  (void)taosThreadMutexUnlock(&pCache->lock);
+  taosMemoryFree(pKey);
+}
@@ -372,41 +372,6 @@ int32_t smlProcessSuperTable(SSmlHandle *info, SSmlLineInfo *elements) {
   return 0;
 }
 
-int32_t smlProcessChildTable(SSmlHandle *info, SSmlLineInfo *elements) {
-  int32_t         code = TSDB_CODE_SUCCESS;
-  int32_t         lino = 0;
-  SSmlTableInfo **oneTable = (SSmlTableInfo **)taosHashGet(info->childTables, elements->measureTag, elements->measureTagsLen);
-  SSmlTableInfo *tinfo = NULL;
-  if (unlikely(oneTable == NULL)) {
-    SML_CHECK_CODE(smlBuildTableInfo(1, elements->measure, elements->measureLen, &tinfo));
-    SML_CHECK_CODE(taosHashPut(info->childTables, elements->measureTag, elements->measureTagsLen, &tinfo, POINTER_BYTES));
-
-    tinfo->tags = taosArrayDup(info->preLineTagKV, NULL);
-    SML_CHECK_NULL(tinfo->tags);
-    for (size_t i = 0; i < taosArrayGetSize(info->preLineTagKV); i++) {
-      SSmlKv *kv = (SSmlKv *)taosArrayGet(info->preLineTagKV, i);
-      SML_CHECK_NULL(kv);
-      if (kv->keyEscaped) kv->key = NULL;
-      if (kv->valueEscaped) kv->value = NULL;
-    }
-
-    SML_CHECK_CODE(smlSetCTableName(tinfo, info->tbnameKey));
-    SML_CHECK_CODE(getTableUid(info, elements, tinfo));
-    if (info->dataFormat) {
-      info->currSTableMeta->uid = tinfo->uid;
-      SML_CHECK_CODE(smlInitTableDataCtx(info->pQuery, info->currSTableMeta, &tinfo->tableDataCtx));
-    }
-  } else {
-    tinfo = *oneTable;
-  }
-  if (info->dataFormat) info->currTableDataCtx = tinfo->tableDataCtx;
-  return TSDB_CODE_SUCCESS;
-
-END:
-  smlDestroyTableInfo(&tinfo);
-  RETURN
-}
-
 int32_t smlParseEndTelnetJsonFormat(SSmlHandle *info, SSmlLineInfo *elements, SSmlKv *kvTs, SSmlKv *kv) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -458,11 +423,12 @@ int32_t smlParseEndLine(SSmlHandle *info, SSmlLineInfo *elements, SSmlKv *kvTs)
   return TSDB_CODE_SUCCESS;
 }
 
-static int32_t smlParseTableName(SArray *tags, char *childTableName, char *tbnameKey) {
+static int32_t smlParseTableName(SArray *tags, char *childTableName, char *tbnameKey, int32_t *tbnameTagIdx) {
   int32_t code = 0;
   int32_t lino = 0;
   bool    autoChildName = false;
   size_t  delimiter = strlen(tsSmlAutoChildTableNameDelimiter);
+  *tbnameTagIdx = -1;
   if (delimiter > 0 && tbnameKey == NULL) {
     size_t totalNameLen = delimiter * (taosArrayGetSize(tags) - 1);
     for (int i = 0; i < taosArrayGetSize(tags); i++) {
@@ -504,6 +470,7 @@ static int32_t smlParseTableName(SArray *tags, char *childTableName, char *tbnam
           smlStrReplace(childTableName, strlen(childTableName));
         }
         taosArrayRemove(tags, i);
+        *tbnameTagIdx = i;
         break;
       }
     }
@@ -513,11 +480,11 @@ END:
   RETURN
 }
 
-int32_t smlSetCTableName(SSmlTableInfo *oneTable, char *tbnameKey) {
+static int32_t smlSetCTableNameImpl(SSmlTableInfo *oneTable, char *tbnameKey, int32_t *tbnameTagIdx) {
   int32_t code = 0;
   int32_t lino = 0;
   SArray *dst  = NULL;
-  SML_CHECK_CODE(smlParseTableName(oneTable->tags, oneTable->childTableName, tbnameKey));
+  SML_CHECK_CODE(smlParseTableName(oneTable->tags, oneTable->childTableName, tbnameKey, tbnameTagIdx));
 
   if (strlen(oneTable->childTableName) == 0) {
     dst = taosArrayDup(oneTable->tags, NULL);
@@ -543,6 +510,85 @@ END:
   RETURN
 }
 
+int32_t smlSetCTableName(SSmlTableInfo *oneTable, char *tbnameKey) {
+  int32_t tbnameTagIdx = -1;
+  return smlSetCTableNameImpl(oneTable, tbnameKey, &tbnameTagIdx);
+}
+
+static int32_t smlBuildCTableCacheKey(SSmlHandle *info, SSmlLineInfo *elements, char **pKey, int32_t *pKeyLen) {
+  const char *tbnameKey = info->tbnameKey ? info->tbnameKey : "";
+  size_t      dbLen = strlen(info->pRequest->pDb);
+  size_t      tbnameKeyLen = strlen(tbnameKey);
+  int32_t     keyLen = 1 + dbLen + 1 + tbnameKeyLen + 1 + elements->measureTagsLen;
+  char       *key = taosMemoryMalloc(keyLen);
+  if (key == NULL) {
+    return terrno;
+  }
+
+  char *p = key;
+  *p++ = (char)info->protocol;
+  (void)memcpy(p, info->pRequest->pDb, dbLen + 1);
+  p += dbLen + 1;
+  (void)memcpy(p, tbnameKey, tbnameKeyLen + 1);
+  p += tbnameKeyLen + 1;
+  (void)memcpy(p, elements->measureTag, elements->measureTagsLen);
+
+  *pKey = key;
+  *pKeyLen = keyLen;
+  return TSDB_CODE_SUCCESS;
+}
+
+// child table names only depend on the tags, so they are reused across calls instead of hashing the tags again
+static int32_t smlCacheSetCTableName(SSmlHandle *info, SSmlLineInfo *elements, SSmlTableInfo *tinfo) {
+  SSmlCache *pCache = info->pCache;
+  if (pCache == NULL || info->pRequest == NULL || info->pRequest->pDb == NULL) {
+    return smlSetCTableName(tinfo, info->tbnameKey);
+  }
+
+  int32_t code = 0;
+  int32_t lino = 0;
+  char   *key = NULL;
+  int32_t keyLen = 0;
+  SML_CHECK_CODE(smlBuildCTableCacheKey(info, elements, &key, &keyLen));
+
+  SSmlCTableName cached = {0};
+  bool           hit = false;
+  (void)taosThreadMutexLock(&pCache->lock);
+  SSmlCTableName *pName = (SSmlCTableName *)taosHashGet(pCache->pCTables, key, keyLen);
+  if (pName != NULL) {
+    cached = *pName;
+    hit = true;
+  }
+  (void)taosThreadMutexUnlock(&pCache->lock);
+
+  if (hit && cached.tbnameTagIdx < (int32_t)taosArrayGetSize(tinfo->tags)) {
+    tstrncpy(tinfo->childTableName, cached.childTableName, TSDB_TABLE_NAME_LEN);
+    if (cached.tbnameTagIdx >= 0) {
+      taosArrayRemove(tinfo->tags, cached.tbnameTagIdx);
+    }
+    goto END;
+  }
+
+  SML_CHECK_CODE(smlSetCTableNameImpl(tinfo, info->tbnameKey, &cached.tbnameTagIdx));
+  tstrncpy(cached.childTableName, tinfo->childTableName, TSDB_TABLE_NAME_LEN);
+
+  (void)taosThreadMutexLock(&pCache->lock);
+  if (taosHashGetSize(pCache->pCTables) >= SML_CACHE_MAX_CTABLES) {
+    taosHashClear(pCache->pCTables);
+  }
+  code = taosHashPut(pCache->pCTables, key, keyLen, &cached, sizeof(SSmlCTableName));
+  (void)taosThreadMutexUnlock(&pCache->lock);
+  if (code != TSDB_CODE_SUCCESS) {
+    uWarn("SML:0x%" PRIx64 " %s failed to cache child table name:%s, code:%d", info->id, __FUNCTION__,
+          tinfo->childTableName, code);
+    code = TSDB_CODE_SUCCESS;
+  }
+
+END:
+  taosMemoryFree(key);
+  RETURN
+}
+
 int32_t getTableUid(SSmlHandle *info, SSmlLineInfo *currElement, SSmlTableInfo *tinfo) {
   char   key[TSDB_TABLE_NAME_LEN * 2 + 1] = {0};
   size_t nLen = strlen(tinfo->childTableName);
@@ -563,6 +609,41 @@ int32_t getTableUid(SSmlHandle *info, SSmlLineInfo *currElement, SSmlTableInfo *
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t smlProcessChildTable(SSmlHandle *info, SSmlLineInfo *elements) {
+  int32_t         code = TSDB_CODE_SUCCESS;
+  int32_t         lino = 0;
+  SSmlTableInfo **oneTable = (SSmlTableInfo **)taosHashGet(info->childTables, elements->measureTag, elements->measureTagsLen);
+  SSmlTableInfo *tinfo = NULL;
+  if (unlikely(oneTable == NULL)) {
+    SML_CHECK_CODE(smlBuildTableInfo(1, elements->measure, elements->measureLen, &tinfo));
+    SML_CHECK_CODE(taosHashPut(info->childTables, elements->measureTag, elements->measureTagsLen, &tinfo, POINTER_BYTES));
+
+    tinfo->tags = taosArrayDup(info->preLineTagKV, NULL);
+    SML_CHECK_NULL(tinfo->tags);
+    for (size_t i = 0; i < taosArrayGetSize(info->preLineTagKV); i++) {
+      SSmlKv *kv = (SSmlKv *)taosArrayGet(info->preLineTagKV, i);
+      SML_CHECK_NULL(kv);
+      if (kv->keyEscaped) kv->key = NULL;
+      if (kv->valueEscaped) kv->value = NULL;
+    }
+
+    SML_CHECK_CODE(smlCacheSetCTableName(info, elements, tinfo));
+    SML_CHECK_CODE(getTableUid(info, elements, tinfo));
+    if (info->dataFormat) {
+      info->currSTableMeta->uid = tinfo->uid;
+      SML_CHECK_CODE(smlInitTableDataCtx(info->pQuery, info->currSTableMeta, &tinfo->tableDataCtx));
+    }
+  } else {
+    tinfo = *oneTable;
+  }
+  if (info->dataFormat) info->currTableDataCtx = tinfo->tableDataCtx;
+  return TSDB_CODE_SUCCESS;
+
+END:
+  smlDestroyTableInfo(&tinfo);
+  RETURN
+}
+
 int32_t smlBuildSTableMeta(bool isDataFormat, SSmlSTableMeta **sMeta) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -663,6 +744,69 @@ int32_t smlParseNumber(SSmlKv *kvVal, SSmlMsgBuf *msg) {
   return true;
 }
 
+void smlDestroyCache(void *p) {
+  SSmlCache *pCache = (SSmlCache *)p;
+  if (pCache == NULL) {
+    return;
+  }
+  taosHashCleanup(pCache->pCTables);
+  (void)taosThreadMutexDestroy(&pCache->lock);
+  taosMemoryFree(pCache);
+}
+
+int32_t smlCreateCache(SSmlCache **ppCache) {
+  int32_t    code = 0;
+  int32_t    lino = 0;
+  SSmlCache *pCache = (SSmlCache *)taosMemoryCalloc(1, sizeof(SSmlCache));
+  SML_CHECK_NULL(pCache);
+  if (taosThreadMutexInit(&pCache->lock, NULL) != 0) {
+    taosMemoryFree(pCache);
+    return TAOS_SYSTEM_ERROR(errno);
+  }
+  pCache->pCTables = taosHashInit(128, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  SML_CHECK_NULL(pCache->pCTables);
+  pCache->dot2Underline = tsSmlDot2Underline;
+  tstrncpy(pCache->childTableName, tsSmlChildTableName, TSDB_TABLE_NAME_LEN);
+  tstrncpy(pCache->delimiter, tsSmlAutoChildTableNameDelimiter, TSDB_TABLE_NAME_LEN);
+  *ppCache = pCache;
+  return TSDB_CODE_SUCCESS;
+
+END:
+  smlDestroyCache(pCache);
+  RETURN
+}
+
+// child table names depend on the naming config, which can be changed at runtime
+static void smlCacheCheckNamingCfg(SSmlCache *pCache) {
+  (void)taosThreadMutexLock(&pCache->lock);
+  if (pCache->dot2Underline != tsSmlDot2Underline || strcmp(pCache->childTableName, tsSmlChildTableName) != 0 ||
+      strcmp(pCache->delimiter, tsSmlAutoChildTableNameDelimiter) != 0) {
+    taosHashClear(pCache->pCTables);
+    pCache->dot2Underline = tsSmlDot2Underline;
+    tstrncpy(pCache->childTableName, tsSmlChildTableName, TSDB_TABLE_NAME_LEN);
+    tstrncpy(pCache->delimiter, tsSmlAutoChildTableNameDelimiter, TSDB_TABLE_NAME_LEN);
+  }
+  (void)taosThreadMutexUnlock(&pCache->lock);
+}
+
+static int32_t smlAcquireCache(STscObj *pTscObj, SSmlCache **ppCache) {
+  SSmlCache *pCache = (SSmlCache *)atomic_load_ptr(&pTscObj->pSmlCache);
+  if (pCache == NULL) {
+    int32_t code = smlCreateCache(&pCache);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    SSmlCache *pOld = (SSmlCache *)atomic_val_compare_exchange_ptr(&pTscObj->pSmlCache, NULL, pCache);
+    if (pOld != NULL) {
+      smlDestroyCache(pCache);
+      pCache = pOld;
+    }
+  }
+  smlCacheCheckNamingCfg(pCache);
+  *ppCache = pCache;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t smlGetMeta(SSmlHandle *info, const void *measure, int32_t measureLen, STableMeta **pTableMeta) {
   *pTableMeta = NULL;
 
@@ -1297,6 +1441,7 @@ int32_t smlBuildSmlInfo(TAOS *taos, SSmlHandle **handle) {
     info->taos = acquireTscObj(*(int64_t *)taos);
     SML_CHECK_NULL(info->taos);
     SML_CHECK_CODE(catalogGetHandle(info->taos->pAppInfo->clusterId, &info->pCatalog));
+    SML_CHECK_CODE(smlAcquireCache(info->taos, &info->pCache));
   }
 
   info->pVgHash = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_INT), true, HASH_NO_LOCK);
@@ -1576,11 +1721,14 @@ static bool getLine(SSmlHandle *info, char *lines[], char **rawLine, char *rawLi
     *len = strlen(*tmp);
   } else if (*rawLine) {
     *tmp = *rawLine;
-    while (*rawLine < rawLineEnd) {
-      if (*((*rawLine)++) == '\n') {
-        break;
-      }
-      (*len)++;
+    // memchr is vectorized by libc, much faster than checking the raw lines byte by byte
+    char *lineEnd = (*rawLine < rawLineEnd) ? memchr(*rawLine, '\n', rawLineEnd - *rawLine) : NULL;
+    if (lineEnd == NULL) {
+      *len += (int)(rawLineEnd > *rawLine ? rawLineEnd - *rawLine : 0);
+      *rawLine = TMAX(*rawLine, rawLineEnd);
+    } else {
+      *len += (int)(lineEnd - *rawLine);
+      *rawLine = lineEnd + 1;
     }
     if (IS_COMMENT(info->protocol,(*tmp)[0])) {  // this line is comment
       return false;
@@ -1609,13 +1757,157 @@ static int32_t smlParseJson(SSmlHandle *info, char *lines[], char *rawLine) {
   return code;
 }
 
-static int32_t smlParseStart(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
+typedef struct {
+  SSmlHandle *info;
+  char      **lineStart;
+  int32_t    *lineLen;
+  int32_t     start;
+  int32_t     end;
+  int32_t     code;
+} SSmlParseTask;
+
+static void *smlPreParseInfluxFn(void *param) {
+  SSmlParseTask *pTask = (SSmlParseTask *)param;
+  SSmlHandle     handle = *pTask->info;
+  char           msg[ERROR_MSG_BUF_DEFAULT_SIZE] = {0};
+
+  // the msg is dropped, the failed batch is parsed again by smlParseStart to report it
+  handle.msgBuf.buf = msg;
+  handle.msgBuf.len = sizeof(msg);
+  for (int32_t i = pTask->start; i < pTask->end; ++i) {
+    pTask->code = smlPreParseInfluxString(&handle, pTask->lineStart[i], pTask->lineStart[i] + pTask->lineLen[i],
+                                          pTask->info->lines + i);
+    if (pTask->code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+  }
+  return NULL;
+}
+
+static int32_t smlGetParseThreads(SSmlHandle *info, int numLines) {
+  if (info->protocol != TSDB_SML_LINE_PROTOCOL || tsSmlParseThreads <= 1) {
+    return 1;
+  }
+  return TMAX(TMIN(tsSmlParseThreads, numLines / SML_PARSE_LINES_PER_THREAD), 1);
+}
+
+// Split the lines into chunks parsed by a group of threads, then resolve the tags and child tables in line order.
+// Only the dataFormat false mode keeps every line apart, so the batch is switched to it. If a line fails, the
+// parsed results are dropped and *fallback is set, the caller parses the batch again in the calling thread.
+static int32_t smlParseInfluxParallel(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines,
+                                      int32_t numOfThreads, bool *fallback) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  int32_t        lino = 0;
+  char         **lineStart = NULL;
+  int32_t       *lineLen = NULL;
+  SSmlParseTask *pTasks = NULL;
+  TdThread      *pThreads = NULL;
+  bool          *started = NULL;
+
+  *fallback = false;
+  lineStart = taosMemoryCalloc(numLines, POINTER_BYTES);
+  SML_CHECK_NULL(lineStart);
+  lineLen = taosMemoryCalloc(numLines, sizeof(int32_t));
+  SML_CHECK_NULL(lineLen);
+  pTasks = taosMemoryCalloc(numOfThreads, sizeof(SSmlParseTask));
+  SML_CHECK_NULL(pTasks);
+  pThreads = taosMemoryCalloc(numOfThreads, sizeof(TdThread));
+  SML_CHECK_NULL(pThreads);
+  started = taosMemoryCalloc(numOfThreads, sizeof(bool));
+  SML_CHECK_NULL(started);
+
+  int32_t i = 0;
+  while (i < numLines) {
+    char *tmp = NULL;
+    int   len = 0;
+    if (!getLine(info, lines, &rawLine, rawLineEnd, numLines, i, &tmp, &len)) {
+      continue;
+    }
+    lineStart[i] = tmp;
+    lineLen[i] = len;
+    i++;
+  }
+
+  if (info->dataFormat) {
+    info->dataFormat = false;
+    info->lines = (SSmlLineInfo *)taosMemoryCalloc(info->lineNum, sizeof(SSmlLineInfo));
+    SML_CHECK_NULL(info->lines);
+  }
+
+  int32_t step = numLines / numOfThreads;
+  for (int32_t t = 0; t < numOfThreads; ++t) {
+    SSmlParseTask *pTask = &pTasks[t];
+    pTask->info = info;
+    pTask->lineStart = lineStart;
+    pTask->lineLen = lineLen;
+    pTask->start = t * step;
+    pTask->end = (t == numOfThreads - 1) ? numLines : (t + 1) * step;
+  }
+
+  // the calling thread takes the last chunk
+  for (int32_t t = 0; t < numOfThreads - 1; ++t) {
+    started[t] = (taosThreadCreate(&pThreads[t], NULL, smlPreParseInfluxFn, &pTasks[t]) == 0);
+  }
+  (void)smlPreParseInfluxFn(&pTasks[numOfThreads - 1]);
+  for (int32_t t = 0; t < numOfThreads - 1; ++t) {
+    if (started[t]) {
+      (void)taosThreadJoin(pThreads[t], NULL);
+    } else {
+      (void)smlPreParseInfluxFn(&pTasks[t]);
+    }
+  }
+
+  for (int32_t t = 0; t < numOfThreads; ++t) {
+    if (pTasks[t].code != TSDB_CODE_SUCCESS) {
+      uDebug("SML:0x%" PRIx64 " parallel parse failed at chunk %d, code:%s, parse again", info->id, t,
+             tstrerror(pTasks[t].code));
+      for (int32_t j = 0; j < numLines; ++j) {
+        taosArrayDestroyEx(info->lines[j].colArray, freeSSmlKv);
+      }
+      (void)memset(info->lines, 0, info->lineNum * sizeof(SSmlLineInfo));
+      *fallback = true;
+      goto END;
+    }
+  }
+
+  for (i = 0; i < numLines; ++i) {
+    code = smlParseInfluxTags(info, lineStart[i] + lineLen[i], info->lines + i);
+    if (code != TSDB_CODE_SUCCESS) {
+      if (rawLine != NULL) {
+        printRaw(info->id, i, numLines, DEBUG_ERROR, lineStart[i], lineLen[i]);
+      } else {
+        uError("SML:0x%" PRIx64 " %s failed. line %d : %s", info->id, __FUNCTION__, i, lineStart[i]);
+      }
+      goto END;
+    }
+  }
+
+END:
+  taosMemoryFree(started);
+  taosMemoryFree(pThreads);
+  taosMemoryFree(pTasks);
+  taosMemoryFree(lineLen);
+  taosMemoryFree(lineStart);
+  RETURN
+}
+
+int32_t smlParseStart(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
   uDebug("SML:0x%" PRIx64 " %s start", info->id, __FUNCTION__);
   int32_t code = TSDB_CODE_SUCCESS;
   if (info->protocol == TSDB_SML_JSON_PROTOCOL) {
     return smlParseJson(info, lines, rawLine);
   }
 
+  int32_t numOfThreads = smlGetParseThreads(info, numLines);
+  if (numOfThreads > 1) {
+    bool fallback = false;
+    code = smlParseInfluxParallel(info, lines, rawLine, rawLineEnd, numLines, numOfThreads, &fallback);
+    if (code != TSDB_CODE_SUCCESS || !fallback) {
+      uDebug("SML:0x%" PRIx64 " %s end, parsed by %d threads", info->id, __FUNCTION__, numOfThreads);
+      return code;
+    }
+  }
+
   char   *oldRaw = rawLine;
   int32_t i = 0;
   while (i < numLines) {
@@ -474,8 +474,8 @@ static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLineInfo *elements) {
-  if (!sql) return TSDB_CODE_SML_INVALID_DATA;
+static int32_t smlParseInfluxMeasure(SSmlHandle *info, char **pSql, char *sqlEnd, SSmlLineInfo *elements) {
+  char *sql = *pSql;
   JUMP_SPACE(sql, sqlEnd)
   if (unlikely(*sql == COMMA)) return TSDB_CODE_SML_INVALID_DATA;
   elements->measure = sql;
@@ -518,23 +518,19 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   // parse tag
   if (*sql == COMMA) sql++;
   elements->tags = sql;
+  *pSql = sql;
+  return TSDB_CODE_SUCCESS;
+}
 
-  int ret = smlParseTagLine(info, &sql, sqlEnd, elements);
-  if (unlikely(ret != TSDB_CODE_SUCCESS)) {
-    return ret;
-  }
-  if (unlikely(info->reRun)) {
-    return TSDB_CODE_SUCCESS;
-  }
-
-  sql = elements->measure + elements->measureTagsLen;
+static int32_t smlParseInfluxColsAndTs(SSmlHandle *info, char *sqlEnd, SSmlLineInfo *elements, SSmlKv *kvTs) {
+  char *sql = elements->measure + elements->measureTagsLen;
   elements->tagsLen = sql - elements->tags;
 
   // parse cols
   JUMP_SPACE(sql, sqlEnd)
   elements->cols = sql;
 
-  ret = smlParseColLine(info, &sql, sqlEnd, elements);
+  int ret = smlParseColLine(info, &sql, sqlEnd, elements);
   if (unlikely(ret != TSDB_CODE_SUCCESS)) {
     return ret;
   }
@@ -566,8 +562,64 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
     return TSDB_CODE_INVALID_TIMESTAMP;
   }
 
+  smlBuildTsKv(kvTs, ts);
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLineInfo *elements) {
+  if (!sql) return TSDB_CODE_SML_INVALID_DATA;
+  int ret = smlParseInfluxMeasure(info, &sql, sqlEnd, elements);
+  if (unlikely(ret != TSDB_CODE_SUCCESS)) {
+    return ret;
+  }
+
+  ret = smlParseTagLine(info, &sql, sqlEnd, elements);
+  if (unlikely(ret != TSDB_CODE_SUCCESS)) {
+    return ret;
+  }
+  if (unlikely(info->reRun)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
   SSmlKv kvTs = {0};
-  smlBuildTsKv(&kvTs, ts);
+  ret = smlParseInfluxColsAndTs(info, sqlEnd, elements, &kvTs);
+  if (unlikely(ret != TSDB_CODE_SUCCESS)) {
+    return ret;
+  }
+  if (unlikely(info->reRun)) {
+    return TSDB_CODE_SUCCESS;
+  }
 
   return smlParseEndLine(info, elements, &kvTs);
 }
+
+// Parse everything of a line that does not depend on the lines before it. Only for dataFormat false, different
+// lines can be parsed concurrently as long as each caller has its own msgBuf.
+int32_t smlPreParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLineInfo *elements) {
+  if (!sql) return TSDB_CODE_SML_INVALID_DATA;
+  int ret = smlParseInfluxMeasure(info, &sql, sqlEnd, elements);
+  if (unlikely(ret != TSDB_CODE_SUCCESS)) {
+    return ret;
+  }
+
+  SSmlKv kvTs = {0};
+  ret = smlParseInfluxColsAndTs(info, sqlEnd, elements, &kvTs);
+  if (unlikely(ret != TSDB_CODE_SUCCESS)) {
+    return ret;
+  }
+
+  taosArraySet(elements->colArray, 0, &kvTs);
+  return TSDB_CODE_SUCCESS;
+}
+
+// the second half of smlPreParseInfluxString, resolves the tags and child table in line order
+int32_t smlParseInfluxTags(SSmlHandle *info, char *sqlEnd, SSmlLineInfo *elements) {
+  char *sql = elements->tags;
+  int   ret = smlParseTagLine(info, &sql, sqlEnd, elements);
+  if (unlikely(ret != TSDB_CODE_SUCCESS)) {
+    return ret;
+  }
+
+  info->preLine = *elements;
+  return TSDB_CODE_SUCCESS;
+}
@@ -1,6 +1,7 @@
 #include "clientInt.h"
 #include "clientLog.h"
 #include "tdef.h"
+#include "tglobal.h"
 
 #include "clientStmt.h"
 #include "clientStmt2.h"
@@ -823,12 +824,19 @@ TAOS_STMT2* stmtInit2(STscObj* taos, TAOS_STMT2_OPTION* pOptions) {
   }
 
   pStmt->sql.siInfo.tableColsReady = true;
+  pStmt->pipelineDepth = 1;
   if (pStmt->options.asyncExecFn) {
     if (tsem_init(&pStmt->asyncQuerySem, 0, 1) != 0) {
       terrno = TAOS_SYSTEM_ERROR(errno);
       (void)stmtClose(pStmt);
       return NULL;
     }
+    pStmt->pipelineDepth = tsStmt2PipelineDepth;
+    if (tsem_init(&pStmt->inflightSem, 0, pStmt->pipelineDepth) != 0) {
+      terrno = TAOS_SYSTEM_ERROR(errno);
+      (void)stmtClose(pStmt);
+      return NULL;
+    }
   }
   pStmt->semWaited = false;
 
@@ -1642,6 +1650,69 @@ static void asyncQueryCb(void* userdata, TAOS_RES* res, int code) {
   }
 }
 
+static void asyncPipelineQueryCb(void* userdata, TAOS_RES* res, int code) {
+  STscStmt2*        pStmt = userdata;
+  __taos_async_fn_t fp = pStmt->options.asyncExecFn;
+
+  int32_t affectedRows = taos_affected_rows(res);
+  atomic_store_32(&pStmt->exec.affectedRows, affectedRows);
+  (void)atomic_add_fetch_32(&pStmt->affectedRows, affectedRows);
+
+  fp(pStmt->options.userdata, res, code);
+
+  taos_free_result(res);
+
+  // the next batch may be bound already, so the exec info is cleaned by the exec thread with the same rule as
+  // asyncQueryCb, i.e. the cached tables are dropped after a failure.
+  if (code) {
+    (void)atomic_val_compare_exchange_32(&pStmt->pipelineCode, 0, code);
+  }
+
+  if (tsem_post(&pStmt->inflightSem) != 0) {
+    tscError("failed to post inflightSem");
+  }
+}
+
+/*
+ * Once launchAsyncQuery returns, the built vgroup data blocks have been moved into the query plan, so the stmt
+ * can be reset for the next batch right away instead of in the rsp callback. The in-flight request is owned by
+ * the callback from then on, and at most pipelineDepth of them are outstanding at a time, so each vgroup sees
+ * at most pipelineDepth submit batches from this stmt. The cached tables are kept unless an earlier exec has
+ * failed, whose error is reported to the user by its own callback.
+ */
+static int32_t stmtPipelineExec(STscStmt2* pStmt, SSqlCallbackWrapper* pWrapper) {
+  SRequestObj* pRequest = pStmt->exec.pRequest;
+  int64_t      startTs = taosGetTimestampUs();
+
+  if (tsem_wait(&pStmt->inflightSem) != 0) {
+    tscError("failed to wait inflightSem");
+  }
+  pStmt->stat.execWaitUs += taosGetTimestampUs() - startTs;
+
+  pRequest->syncQuery = false;
+  pRequest->body.queryFp = asyncPipelineQueryCb;
+  ((SSyncQueryParam*)(pRequest)->body.interParam)->userParam = pStmt;
+
+  pStmt->exec.pRequest = NULL;
+  launchAsyncQuery(pRequest, pStmt->sql.pQuery, NULL, pWrapper);
+
+  while (0 == atomic_load_8((int8_t*)&pStmt->sql.siInfo.tableColsReady)) {
+    taosUsleep(1);
+  }
+  int32_t code = atomic_exchange_32(&pStmt->pipelineCode, 0);
+  STMT_ERR_RET(stmtCleanExecInfo(pStmt, (code ? false : true), false));
+  ++pStmt->sql.runTimes;
+
+  if (pStmt->semWaited) {
+    pStmt->semWaited = false;
+    if (tsem_post(&pStmt->asyncQuerySem) != 0) {
+      tscError("failed to post asyncQuerySem");
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int stmtExec2(TAOS_STMT2* stmt, int* affected_rows) {
   STscStmt2* pStmt = (STscStmt2*)stmt;
   int32_t    code = 0;
@@ -1723,6 +1794,11 @@ int stmtExec2(TAOS_STMT2* stmt, int* affected_rows) {
     if (TSDB_CODE_SUCCESS == code) {
       code = createParseContext(pRequest, &pWrapper->pParseCtx, pWrapper);
     }
+    if (pStmt->pipelineDepth > 1 && STMT_TYPE_QUERY != pStmt->sql.type) {
+      STMT_ERR_JRET(code);
+      STMT_ERR_JRET(stmtPipelineExec(pStmt, pWrapper));
+      goto _return;
+    }
     pRequest->syncQuery = false;
     pRequest->body.queryFp = asyncQueryCb;
     ((SSyncQueryParam*)(pRequest)->body.interParam)->userParam = pStmt;
@@ -1755,6 +1831,13 @@ int stmtClose2(TAOS_STMT2* stmt) {
     }
   }
 
+  // drain the pipelined execs still in flight
+  for (int32_t i = 0; pStmt->options.asyncExecFn && i < pStmt->pipelineDepth; ++i) {
+    if (tsem_wait(&pStmt->inflightSem) != 0) {
+      tscError("failed to wait inflightSem");
+    }
+  }
+
   STMT_DLOG("stmt %p closed, stbInterlaceMode: %d, statInfo: ctgGetTbMetaNum=>%" PRId64 ", getCacheTbInfo=>%" PRId64
             ", parseSqlNum=>%" PRId64 ", pStmt->stat.bindDataNum=>%" PRId64
             ", settbnameAPI:%u, bindAPI:%u, addbatchAPI:%u, execAPI:%u"
@@ -1772,6 +1855,9 @@ int stmtClose2(TAOS_STMT2* stmt) {
     if (tsem_destroy(&pStmt->asyncQuerySem) != 0) {
       tscError("failed to destroy asyncQuerySem");
     }
+    if (tsem_destroy(&pStmt->inflightSem) != 0) {
+      tscError("failed to destroy inflightSem");
+    }
   }
   taosMemoryFree(stmt);
 
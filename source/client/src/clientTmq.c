@@ -101,6 +101,7 @@ struct tmq_conf_t {
   tmq_commit_cb* commitCb;
   void*          commitCbUserParam;
   int8_t         enableBatchMeta;
+  int8_t         rawBlock;
 };
 
 struct tmq_t {
@@ -123,6 +124,7 @@ struct tmq_t {
   tmq_commit_cb* commitCb;
   void*          commitCbUserParam;
   int8_t         enableBatchMeta;
+  int8_t         rawBlock;  // keep poll rsp blocks in the rsp msg, see tmq_get_raw_block
 
   // status
   SRWLatch lock;
@@ -297,6 +299,7 @@ tmq_conf_t* tmq_conf_new() {
   conf->autoCommitInterval = DEFAULT_AUTO_COMMIT_INTERVAL;
   conf->resetOffset = TMQ_OFFSET__RESET_LATEST;
   conf->enableBatchMeta = false;
+  conf->rawBlock = false;
   conf->heartBeatIntervalMs = DEFAULT_HEARTBEAT_INTERVAL;
   conf->maxPollIntervalMs = DEFAULT_MAX_POLL_INTERVAL;
   conf->sessionTimeoutMs = DEFAULT_SESSION_TIMEOUT;
@@ -506,6 +509,13 @@ tmq_conf_res_t tmq_conf_set(tmq_conf_t* conf, const char* key, const char* value
     return TMQ_CONF_OK;
   }
 
+  if (strcasecmp(key, "msg.consume.rawblock") == 0) {
+    int64_t tmp;
+    code = taosStr2int64(value, &tmp);
+    conf->rawBlock = (0 == code && tmp != 0) ? true : false;
+    return TMQ_CONF_OK;
+  }
+
   tqErrorC("unknown key: %s", key);
   return TMQ_CONF_UNKNOWN;
 }
@@ -1659,6 +1669,7 @@ tmq_t* tmq_consumer_new(tmq_conf_t* conf, char* errstr, int32_t errstrLen) {
   pTmq->replayEnable = conf->replayEnable;
   pTmq->sourceExcluded = conf->sourceExcluded;
   pTmq->enableBatchMeta = conf->enableBatchMeta;
+  pTmq->rawBlock = conf->rawBlock;
   tstrncpy(pTmq->user, user, TSDB_USER_LEN);
   if (taosGetFqdn(pTmq->fqdn) != 0) {
     tstrncpy(pTmq->fqdn, "localhost", TSDB_FQDN_LEN);
@@ -1976,6 +1987,11 @@ int32_t tmqPollCb(void* param, SDataBuf* pMsg, int32_t code) {
   }
   rspType = ((SMqRspHead*)pMsg->pData)->mqMsgType;
   tqDebugC("consumer:0x%" PRIx64 " recv poll rsp, vgId:%d, type %d,QID:0x%" PRIx64, tmq->consumerId, vgId, rspType, requestId);
+  bool isDataRsp = (rspType == TMQ_MSG_TYPE__POLL_DATA_RSP || rspType == TMQ_MSG_TYPE__POLL_DATA_META_RSP);
+  if (isDataRsp && tmq->rawBlock) {
+    // decode the blocks in place, the rsp msg is released together with the rsp object
+    pRspWrapper->pollRsp.dataRsp.pRspBuf = pMsg->pData;
+  }
   if (rspType == TMQ_MSG_TYPE__POLL_DATA_RSP) {
     PROCESS_POLL_RSP(tDecodeMqDataRsp, &pRspWrapper->pollRsp.dataRsp)
   } else if (rspType == TMQ_MSG_TYPE__POLL_META_RSP) {
@@ -1993,6 +2009,9 @@ int32_t tmqPollCb(void* param, SDataBuf* pMsg, int32_t code) {
   pRspWrapper->pollRsp.reqId = requestId;
   pRspWrapper->pollRsp.pEpset = pMsg->pEpSet;
   pMsg->pEpSet = NULL;
+  if (isDataRsp && pRspWrapper->pollRsp.dataRsp.pRspBuf != NULL) {
+    pMsg->pData = NULL;  // owned by the rsp now
+  }
 
 END:
   if (pRspWrapper) {
@@ -2847,41 +2866,78 @@ end:
   }
 }
 
-int32_t tmqGetNextResInfo(TAOS_RES* res, bool convertUcs4, SReqResultInfo** pResInfo) {
-  SMqRspObj*  pRspObj = (SMqRspObj*)res;
+static int32_t tmqMoveToNextBlock(SMqRspObj* pRspObj) {
   SMqDataRsp* data = &pRspObj->dataRsp;
 
   pRspObj->resIter++;
-  if (pRspObj->resIter < data->blockNum) {
-    if (data->withSchema) {
-      doFreeReqResultInfo(&pRspObj->resInfo);
-      SSchemaWrapper* pSW = (SSchemaWrapper*)taosArrayGetP(data->blockSchema, pRspObj->resIter);
-      if (pSW) {
-        TAOS_CHECK_RETURN(setResSchemaInfo(&pRspObj->resInfo, pSW->pSchema, pSW->nCols));
-      }
+  if (pRspObj->resIter >= data->blockNum) {
+    return TSDB_CODE_TSC_INTERNAL_ERROR;
+  }
+
+  if (data->withSchema) {
+    doFreeReqResultInfo(&pRspObj->resInfo);
+    SSchemaWrapper* pSW = (SSchemaWrapper*)taosArrayGetP(data->blockSchema, pRspObj->resIter);
+    if (pSW) {
+      TAOS_CHECK_RETURN(setResSchemaInfo(&pRspObj->resInfo, pSW->pSchema, pSW->nCols));
     }
+  }
 
-    void*   pRetrieve = taosArrayGetP(data->blockData, pRspObj->resIter);
-    void*   rawData = NULL;
-    int64_t rows = 0;
-    int32_t precision = 0;
-    tmqGetRawDataRowsPrecisionFromRes(pRetrieve, &rawData, &rows, &precision);
+  void*   pRetrieve = taosArrayGetP(data->blockData, pRspObj->resIter);
+  void*   rawData = NULL;
+  int64_t rows = 0;
+  int32_t precision = 0;
+  tmqGetRawDataRowsPrecisionFromRes(pRetrieve, &rawData, &rows, &precision);
 
-    pRspObj->resInfo.pData = rawData;
-    pRspObj->resInfo.numOfRows = rows;
-    pRspObj->resInfo.current = 0;
-    pRspObj->resInfo.precision = precision;
+  pRspObj->resInfo.pData = rawData;
+  pRspObj->resInfo.numOfRows = rows;
+  pRspObj->resInfo.current = 0;
+  pRspObj->resInfo.precision = precision;
 
-    pRspObj->resInfo.totalRows += pRspObj->resInfo.numOfRows;
-    int32_t code = setResultDataPtr(&pRspObj->resInfo, convertUcs4);
-    if (code != 0) {
-      return code;
-    }
-    *pResInfo = &pRspObj->resInfo;
+  pRspObj->resInfo.totalRows += pRspObj->resInfo.numOfRows;
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t tmqGetNextResInfo(TAOS_RES* res, bool convertUcs4, SReqResultInfo** pResInfo) {
+  SMqRspObj* pRspObj = (SMqRspObj*)res;
+
+  int32_t code = tmqMoveToNextBlock(pRspObj);
+  if (code != 0) {
+    return code;
+  }
+
+  code = setResultDataPtr(&pRspObj->resInfo, convertUcs4);
+  if (code != 0) {
+    return code;
+  }
+  *pResInfo = &pRspObj->resInfo;
+  return code;
+}
+
+int32_t tmq_get_raw_block(TAOS_RES* res, int32_t* numOfRows, void** pData) {
+  if (res == NULL || numOfRows == NULL || pData == NULL) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  *numOfRows = 0;
+  *pData = NULL;
+  if (!TD_RES_TMQ(res) && !TD_RES_TMQ_METADATA(res)) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  // hand out the encoded columnar block as is, no column pointer setup and no ucs4 conversion
+  SMqRspObj* pRspObj = (SMqRspObj*)res;
+  if (pRspObj->resIter + 1 >= pRspObj->dataRsp.blockNum) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = tmqMoveToNextBlock(pRspObj);
+  if (code != 0) {
     return code;
   }
 
-  return TSDB_CODE_TSC_INTERNAL_ERROR;
+  *numOfRows = (int32_t)pRspObj->resInfo.numOfRows;
+  *pData = (void*)pRspObj->resInfo.pData;
+  return TSDB_CODE_SUCCESS;
 }
 
 static int32_t tmqGetWalInfoCb(void* param, SDataBuf* pMsg, int32_t code) {
@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <vector>
 #include "clientInt.h"
 #include "osSemaphore.h"
 #include "taoserror.h"
@@ -1205,6 +1206,68 @@ TEST(clientCase, tmq_commit) {
   taos_close(pConn);
   (void)fprintf(stderr, "%d msg consumed, include %d rows\n", msgCnt, totalRows);
 }
+
+TEST(clientCase, tmq_get_raw_block_Test) {
+  TAOS* pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
+  ASSERT_NE(pConn, nullptr);
+
+  tmq_conf_t* conf = tmq_conf_new();
+  (void)tmq_conf_set(conf, "enable.auto.commit", "false");
+  (void)tmq_conf_set(conf, "group.id", "cgrpNameRaw");
+  (void)tmq_conf_set(conf, "td.connect.user", "root");
+  (void)tmq_conf_set(conf, "td.connect.pass", "taosdata");
+  (void)tmq_conf_set(conf, "auto.offset.reset", "earliest");
+  (void)tmq_conf_set(conf, "msg.with.table.name", "true");
+  (void)tmq_conf_set(conf, "msg.consume.rawblock", "1");
+
+  tmq_t* tmq = tmq_consumer_new(conf, NULL, 0);
+  tmq_conf_destroy(conf);
+  ASSERT_NE(tmq, nullptr);
+
+  tmq_list_t* topicList = tmq_list_new();
+  (void)tmq_list_append(topicList, "topic_t1");
+  (void)tmq_subscribe(tmq, topicList);
+  tmq_list_destroy(topicList);
+
+  int32_t numOfRows = 0;
+  void*   pData = NULL;
+  ASSERT_EQ(tmq_get_raw_block(NULL, &numOfRows, &pData), TSDB_CODE_INVALID_PARA);
+
+  int32_t totalRows = 0;
+  int32_t msgCnt = 0;
+  int32_t timeout = 5000;
+
+  while (1) {
+    TAOS_RES* pRes = tmq_consumer_poll(tmq, timeout);
+    if (pRes == NULL) {
+      break;
+    }
+
+    msgCnt += 1;
+    while (1) {
+      int32_t code = tmq_get_raw_block(pRes, &numOfRows, &pData);
+      ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+      if (numOfRows == 0) {
+        ASSERT_EQ(pData, nullptr);
+        break;
+      }
+
+      ASSERT_NE(pData, nullptr);
+      ASSERT_GT(taos_num_fields(pRes), 0);
+      totalRows += numOfRows;
+    }
+
+    // all blocks are handed out, the next call still reports the end
+    ASSERT_EQ(tmq_get_raw_block(pRes, &numOfRows, &pData), TSDB_CODE_SUCCESS);
+    ASSERT_EQ(numOfRows, 0);
+    taos_free_result(pRes);
+  }
+
+  (void)tmq_consumer_close(tmq);
+  taos_close(pConn);
+  (void)fprintf(stderr, "%d msg consumed, include %d rows\n", msgCnt, totalRows);
+}
+
 namespace {
 void doPrintInfo(tmq_topic_assignment* pa, int32_t index) {
   std::cout << "assign i:" << index << ", vgId:" << pa->vgId << ", offset:%" << pa->currentOffset << ", start:%"
@@ -1616,4 +1679,269 @@ TEST(clientCase, timezone_Test) {
   }
 }
 
+static int32_t queryPlanCacheRows(TAOS* pConn, const char* sql, bool* pFromCache, int32_t* pNumOfFields) {
+  TAOS_RES* pRes = taos_query(pConn, sql);
+  if (taos_errno(pRes) != 0) {
+    (void)printf("failed to query, reason:%s\n", taos_errstr(pRes));
+    taos_free_result(pRes);
+    return -1;
+  }
+
+  int32_t rows = 0;
+  while (taos_fetch_row(pRes) != NULL) {
+    rows++;
+  }
+  *pFromCache = ((SRequestObj*)pRes)->planFromCache;
+  if (NULL != pNumOfFields) {
+    *pNumOfFields = taos_num_fields(pRes);
+  }
+  taos_free_result(pRes);
+  return rows;
+}
+
+TEST(clientCase, plan_cache_Test) {
+  int32_t cacheSize = tsQueryPlanCacheSize;
+  tsQueryPlanCacheSize = 16;
+
+  TAOS* pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
+  ASSERT_NE(pConn, nullptr);
+
+  const char* setup[] = {"drop database if exists pcdb", "create database pcdb",
+                         "create table pcdb.t1 (ts timestamp, v int)",
+                         "insert into pcdb.t1 values(1700000000000, 1)(1700000001000, 2)(1700000002000, 3)"};
+  for (int32_t i = 0; i < sizeof(setup) / sizeof(setup[0]); ++i) {
+    TAOS_RES* pRes = taos_query(pConn, setup[i]);
+    ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS);
+    taos_free_result(pRes);
+  }
+
+  bool    fromCache = false;
+  int32_t numOfFields = 0;
+
+  // the same sql hits
+  const char* sql = "select v from pcdb.t1 where ts >= 1700000000000 and ts < 1700000001500";
+  ASSERT_EQ(queryPlanCacheRows(pConn, sql, &fromCache, NULL), 2);
+  ASSERT_FALSE(fromCache);
+  ASSERT_EQ(queryPlanCacheRows(pConn, sql, &fromCache, NULL), 2);
+  ASSERT_TRUE(fromCache);
+
+  // the time range literals are learned from the second set of literals and bound from then on
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select v from pcdb.t1 where ts >= 1700000001000 and ts < 1700000003000",
+                               &fromCache, NULL),
+            2);
+  ASSERT_FALSE(fromCache);
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select v from pcdb.t1 where ts >= 1700000000000 and ts < 1700000000500",
+                               &fromCache, NULL),
+            1);
+  ASSERT_TRUE(fromCache);
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select v from pcdb.t1 where ts >= 1700000000500 and ts < 1700000005000",
+                               &fromCache, NULL),
+            2);
+  ASSERT_TRUE(fromCache);
+
+  // other literals are never bound
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select v from pcdb.t1 where v > 1 limit 1", &fromCache, NULL), 1);
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select v from pcdb.t1 where v > 1 limit 2", &fromCache, NULL), 2);
+  ASSERT_FALSE(fromCache);
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select v from pcdb.t1 where v > 2 limit 2", &fromCache, NULL), 1);
+  ASSERT_FALSE(fromCache);
+
+  // a schema change drops the plan
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select * from pcdb.t1", &fromCache, &numOfFields), 3);
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select * from pcdb.t1", &fromCache, &numOfFields), 3);
+  ASSERT_TRUE(fromCache);
+  TAOS_RES* pRes = taos_query(pConn, "alter table pcdb.t1 add column v2 int");
+  ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS);
+  taos_free_result(pRes);
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select * from pcdb.t1", &fromCache, &numOfFields), 3);
+  ASSERT_FALSE(fromCache);
+  ASSERT_EQ(numOfFields, 3);
+
+  // so does a change of the db options the planner reads
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select last(v) from pcdb.t1", &fromCache, NULL), 1);
+  ASSERT_EQ(queryPlanCacheRows(pConn, "select last(v) from pcdb.t1", &fromCache, NULL), 1);
+  ASSERT_TRUE(fromCache);
+  pRes = taos_query(pConn, "alter database pcdb cachemodel 'last_value'");
+  ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS);
+  taos_free_result(pRes);
+  // the new db options reach the catalog with the heartbeat
+  for (int32_t i = 0; i < 10 && fromCache; ++i) {
+    taosMsleep(1000);
+    ASSERT_EQ(queryPlanCacheRows(pConn, "select last(v) from pcdb.t1", &fromCache, NULL), 1);
+  }
+  ASSERT_FALSE(fromCache);
+
+  pRes = taos_query(pConn, "drop database if exists pcdb");
+  taos_free_result(pRes);
+  taos_close(pConn);
+  tsQueryPlanCacheSize = cacheSize;
+}
+
+typedef struct SStmt2PipelineCtx {
+  int32_t launched;
+  int32_t completed;
+  int32_t failed;
+  int32_t lastCode;
+  int32_t affectedRows;
+} SStmt2PipelineCtx;
+
+static void stmt2PipelineCb(void* param, TAOS_RES* pRes, int code) {
+  SStmt2PipelineCtx* pCtx = (SStmt2PipelineCtx*)param;
+  if (code != TSDB_CODE_SUCCESS) {
+    (void)atomic_add_fetch_32(&pCtx->failed, 1);
+    atomic_store_32(&pCtx->lastCode, code);
+  } else {
+    (void)atomic_add_fetch_32(&pCtx->affectedRows, taos_affected_rows(pRes));
+  }
+  (void)atomic_add_fetch_32(&pCtx->completed, 1);
+}
+
+static void execStmt2Sql(TAOS* pConn, const char* sql) {
+  TAOS_RES* pRes = taos_query(pConn, sql);
+  ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS) << sql << ": " << taos_errstr(pRes);
+  taos_free_result(pRes);
+}
+
+// bind and exec one batch of numOfRows rows into the table, the exec returns once the batch is in flight
+static int32_t execStmt2Batch(TAOS_STMT2* pStmt, SStmt2PipelineCtx* pCtx, int64_t startTs, int32_t numOfRows) {
+  std::vector<int64_t> ts(numOfRows);
+  std::vector<int32_t> v(numOfRows);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    ts[i] = startTs + i;
+    v[i] = i;
+  }
+
+  TAOS_STMT2_BIND  cols[2] = {{TSDB_DATA_TYPE_TIMESTAMP, ts.data(), NULL, NULL, numOfRows},
+                              {TSDB_DATA_TYPE_INT, v.data(), NULL, NULL, numOfRows}};
+  TAOS_STMT2_BIND* pCols = cols;
+  TAOS_STMT2_BINDV bindv = {1, NULL, NULL, &pCols};
+
+  int32_t code = taos_stmt2_bind_param(pStmt, &bindv, -1);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  (void)atomic_add_fetch_32(&pCtx->launched, 1);
+  code = taos_stmt2_exec(pStmt, NULL);
+  if (code != TSDB_CODE_SUCCESS) {
+    (void)atomic_sub_fetch_32(&pCtx->launched, 1);
+  }
+  return code;
+}
+
+class Stmt2PipelineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    depth = tsStmt2PipelineDepth;
+    tsStmt2PipelineDepth = 4;
+
+    pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
+    ASSERT_NE(pConn, nullptr);
+    execStmt2Sql(pConn, "drop database if exists s2pdb");
+    execStmt2Sql(pConn, "create database s2pdb vgroups 2");
+    execStmt2Sql(pConn, "create table s2pdb.t1 (ts timestamp, v int)");
+  }
+
+  void TearDown() override {
+    if (pConn != NULL) {
+      TAOS_RES* pRes = taos_query(pConn, "drop database if exists s2pdb");
+      taos_free_result(pRes);
+      taos_close(pConn);
+    }
+    tsStmt2PipelineDepth = depth;
+  }
+
+  TAOS_STMT2* prepare(SStmt2PipelineCtx* pCtx) {
+    TAOS_STMT2_OPTION option = {0, false, false, stmt2PipelineCb, pCtx};
+    TAOS_STMT2*       pStmt = taos_stmt2_init(pConn, &option);
+    if (pStmt == NULL) {
+      return NULL;
+    }
+
+    const char* sql = "insert into s2pdb.t1 values(?,?)";
+    if (taos_stmt2_prepare(pStmt, sql, 0) != TSDB_CODE_SUCCESS) {
+      (void)taos_stmt2_close(pStmt);
+      return NULL;
+    }
+    return pStmt;
+  }
+
+  int64_t countRows() {
+    TAOS_RES* pRes = taos_query(pConn, "select count(*) from s2pdb.t1");
+    EXPECT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS);
+    TAOS_ROW row = taos_fetch_row(pRes);
+    int64_t  rows = (row != NULL) ? *(int64_t*)row[0] : -1;
+    taos_free_result(pRes);
+    return rows;
+  }
+
+  int32_t depth = 1;
+  TAOS*   pConn = NULL;
+};
+
+TEST_F(Stmt2PipelineTest, pipelinedWindow) {
+  SStmt2PipelineCtx ctx = {0};
+  TAOS_STMT2*       pStmt = prepare(&ctx);
+  ASSERT_NE(pStmt, nullptr);
+
+  const int32_t numOfBatches = 64;
+  const int32_t numOfRows = 100;
+  for (int32_t i = 0; i < numOfBatches; ++i) {
+    ASSERT_EQ(execStmt2Batch(pStmt, &ctx, 1700000000000 + (int64_t)i * numOfRows, numOfRows), TSDB_CODE_SUCCESS);
+  }
+
+  // the close drains every batch still in flight
+  ASSERT_EQ(taos_stmt2_close(pStmt), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(ctx.completed, numOfBatches);
+  EXPECT_EQ(ctx.failed, 0);
+  EXPECT_EQ(ctx.affectedRows, numOfBatches * numOfRows);
+  EXPECT_EQ(countRows(), numOfBatches * numOfRows);
+}
+
+TEST_F(Stmt2PipelineTest, inflightBound) {
+  SStmt2PipelineCtx ctx = {0};
+  TAOS_STMT2*       pStmt = prepare(&ctx);
+  ASSERT_NE(pStmt, nullptr);
+
+  // an exec waits for a free slot before it launches, so no more than the depth of batches are ever in flight
+  int32_t maxInflight = 0;
+  for (int32_t i = 0; i < 128; ++i) {
+    ASSERT_EQ(execStmt2Batch(pStmt, &ctx, 1700000000000 + (int64_t)i * 10, 10), TSDB_CODE_SUCCESS);
+    int32_t inflight = atomic_load_32(&ctx.launched) - atomic_load_32(&ctx.completed);
+    EXPECT_LE(inflight, tsStmt2PipelineDepth);
+    maxInflight = TMAX(maxInflight, inflight);
+  }
+
+  ASSERT_EQ(taos_stmt2_close(pStmt), TSDB_CODE_SUCCESS);
+  EXPECT_GE(maxInflight, 1);
+  EXPECT_EQ(ctx.completed, ctx.launched);
+  EXPECT_EQ(countRows(), 128 * 10);
+}
+
+TEST_F(Stmt2PipelineTest, errorPropagation) {
+  SStmt2PipelineCtx ctx = {0};
+  TAOS_STMT2*       pStmt = prepare(&ctx);
+  ASSERT_NE(pStmt, nullptr);
+
+  for (int32_t i = 0; i < 8; ++i) {
+    ASSERT_EQ(execStmt2Batch(pStmt, &ctx, 1700000000000 + (int64_t)i * 10, 10), TSDB_CODE_SUCCESS);
+  }
+
+  // the table is gone while the stmt still holds its meta, so the batches launched from now on fail in the vnode and
+  // the error reaches the user through the callback of each of them
+  execStmt2Sql(pConn, "drop table s2pdb.t1");
+  int32_t numOfLaunched = atomic_load_32(&ctx.launched);
+  for (int32_t i = 8; i < 16; ++i) {
+    if (execStmt2Batch(pStmt, &ctx, 1700000000000 + (int64_t)i * 10, 10) != TSDB_CODE_SUCCESS) {
+      break;
+    }
+  }
+
+  (void)taos_stmt2_close(pStmt);
+  EXPECT_GT(ctx.launched, numOfLaunched);
+  EXPECT_EQ(ctx.completed, ctx.launched);
+  EXPECT_GT(ctx.failed, 0);
+  EXPECT_NE(ctx.lastCode, TSDB_CODE_SUCCESS);
+}
+
 #pragma GCC diagnostic pop
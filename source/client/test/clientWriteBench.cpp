@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Write path benchmark. Starts a dnode in this process (or connects to an external one with -h) and drives the
+ * same data through taos_query inserts, stmt2, schemaless and raw block writes, reporting rows/s, p50/p99 batch
+ * latency and the per batch cost of each stage:
+ *   parse    client parse
+ *   schema   catalog and schema checks (sql)
+ *   bind     stmt2 bind
+ *   rpc      from sending the submit to its response
+ *   wal      wal append on the vnode side       (in-process dnode only)
+ *   memtable memtable insert on the vnode side  (in-process dnode only)
+ * The sml stages are printed by the client log of each schemaless request.
+ *
+ * usage: clientWriteBench [-m sql|stmt2|sml|raw|all] [-t tables] [-r rows per table] [-b batches]
+ *                         [-h external fqdn] [-P port] [-d data dir]
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "dnode.h"
+#include "sut.h"
+#include "tdatablock.h"
+#include "vnode.h"
+
+#include "clientInt.h"
+#include "clientStmt.h"
+#include "clientStmt2.h"
+#include "taos.h"
+
+namespace {
+
+const char *benchDb = "wbench";
+
+struct SBenchCfg {
+  std::string mode = "all";
+  int32_t     tables = 100;
+  int32_t     rows = 100;
+  int32_t     batches = 100;
+  std::string host;
+  uint16_t    port = 7100;
+  std::string dataDir = TD_TMP_DIR_PATH "wbench";
+};
+
+struct SBenchStage {
+  int64_t parseUs = 0;
+  int64_t schemaUs = 0;
+  int64_t bindUs = 0;
+  int64_t rpcUs = 0;
+};
+
+struct SBenchResult {
+  int64_t              rows = 0;
+  int64_t              totalUs = 0;
+  std::vector<int64_t> latencyUs;
+  SBenchStage          stage;
+  SVnodeWriteStat      vnode = {0};
+};
+
+int64_t benchTs(const SBenchCfg &cfg, int32_t batch, int32_t row) {
+  return 1700000000000LL + (int64_t)batch * cfg.rows + row;
+}
+
+bool benchExec(TAOS *taos, const char *sql) {
+  TAOS_RES *res = taos_query(taos, sql);
+  int32_t   code = taos_errno(res);
+  if (code != 0) {
+    printf("failed to exec %s since %s\n", sql, taos_errstr(res));
+  }
+  taos_free_result(res);
+  return code == 0;
+}
+
+bool benchPrepareTables(TAOS *taos, const SBenchCfg &cfg, const char *stb) {
+  char sql[256];
+  snprintf(sql, sizeof(sql),
+           "create stable if not exists %s (ts timestamp, c1 int, c2 double, c3 binary(16)) tags (t1 int)", stb);
+  if (!benchExec(taos, sql)) return false;
+  for (int32_t i = 0; i < cfg.tables; ++i) {
+    snprintf(sql, sizeof(sql), "create table if not exists %s_%d using %s tags (%d)", stb, i, stb, i);
+    if (!benchExec(taos, sql)) return false;
+  }
+  return true;
+}
+
+void benchAddStage(SBenchResult &result, SRequestObj *pRequest) {
+  result.stage.parseUs += pRequest->metric.parseCostUs;
+  result.stage.schemaUs += pRequest->metric.ctgCostUs;
+  result.stage.bindUs += pRequest->metric.planCostUs;
+  result.stage.rpcUs += pRequest->metric.execCostUs;
+}
+
+bool benchSql(TAOS *taos, const SBenchCfg &cfg, SBenchResult &result) {
+  if (!benchPrepareTables(taos, cfg, "sql_st")) return false;
+
+  std::string sql;
+  char        buf[128];
+  for (int32_t b = 0; b < cfg.batches; ++b) {
+    sql = "insert into";
+    for (int32_t t = 0; t < cfg.tables; ++t) {
+      snprintf(buf, sizeof(buf), " sql_st_%d values", t);
+      sql += buf;
+      for (int32_t r = 0; r < cfg.rows; ++r) {
+        snprintf(buf, sizeof(buf), "(%" PRId64 ",%d,%d.5,'v%d')", benchTs(cfg, b, r), r, r, r);
+        sql += buf;
+      }
+    }
+
+    int64_t   startUs = taosGetTimestampUs();
+    TAOS_RES *res = taos_query(taos, sql.c_str());
+    int64_t   costUs = taosGetTimestampUs() - startUs;
+    if (taos_errno(res) != 0) {
+      printf("sql insert failed since %s\n", taos_errstr(res));
+      taos_free_result(res);
+      return false;
+    }
+    benchAddStage(result, (SRequestObj *)res);
+    result.rows += taos_affected_rows(res);
+    result.latencyUs.push_back(costUs);
+    taos_free_result(res);
+  }
+  return true;
+}
+
+bool benchStmt2(TAOS *taos, const SBenchCfg &cfg, SBenchResult &result) {
+  if (!benchPrepareTables(taos, cfg, "stmt2_st")) return false;
+
+  TAOS_STMT2_OPTION option = {0};
+  TAOS_STMT2       *stmt = taos_stmt2_init(taos, &option);
+  const char       *sql = "insert into ? values(?,?,?,?)";
+  if (stmt == NULL || taos_stmt2_prepare(stmt, sql, 0) != 0) {
+    printf("failed to prepare stmt2 since %s\n", taos_stmt2_error(stmt));
+    return false;
+  }
+
+  int32_t              rows = cfg.rows;
+  std::vector<int64_t> ts(rows);
+  std::vector<int32_t> c1(rows);
+  std::vector<double>  c2(rows);
+  std::vector<char>    c3(rows * 16);
+  std::vector<int32_t> c3Len(rows);
+  for (int32_t r = 0; r < rows; ++r) {
+    c1[r] = r;
+    c2[r] = r + 0.5;
+    c3Len[r] = snprintf(&c3[r * 16], 16, "v%d", r);
+  }
+
+  std::vector<std::string>     names(cfg.tables);
+  std::vector<char *>          tbnames(cfg.tables);
+  std::vector<TAOS_STMT2_BIND> cols(4 * cfg.tables);
+  std::vector<TAOS_STMT2_BIND *> bindCols(cfg.tables);
+  for (int32_t t = 0; t < cfg.tables; ++t) {
+    names[t] = "stmt2_st_" + std::to_string(t);
+    tbnames[t] = (char *)names[t].c_str();
+    TAOS_STMT2_BIND *pCols = &cols[4 * t];
+    pCols[0] = {TSDB_DATA_TYPE_TIMESTAMP, ts.data(), NULL, NULL, rows};
+    pCols[1] = {TSDB_DATA_TYPE_INT, c1.data(), NULL, NULL, rows};
+    pCols[2] = {TSDB_DATA_TYPE_DOUBLE, c2.data(), NULL, NULL, rows};
+    pCols[3] = {TSDB_DATA_TYPE_BINARY, c3.data(), c3Len.data(), NULL, rows};
+    bindCols[t] = pCols;
+  }
+  TAOS_STMT2_BINDV bindv = {cfg.tables, tbnames.data(), NULL, bindCols.data()};
+
+  // binary columns are passed packed, rebuild them without the gaps
+  std::vector<char> packed;
+  for (int32_t r = 0; r < rows; ++r) packed.insert(packed.end(), &c3[r * 16], &c3[r * 16] + c3Len[r]);
+  for (int32_t t = 0; t < cfg.tables; ++t) cols[4 * t + 3].buffer = packed.data();
+
+  STscStmt2 *pStmt = (STscStmt2 *)stmt;
+  for (int32_t b = 0; b < cfg.batches; ++b) {
+    for (int32_t r = 0; r < rows; ++r) ts[r] = benchTs(cfg, b, r);
+
+    int64_t bindUs = pStmt->stat.bindDataUs1 + pStmt->stat.bindDataUs2 + pStmt->stat.bindDataUs3 +
+                     pStmt->stat.bindDataUs4 + pStmt->stat.setTbNameUs;
+    int64_t execUs = pStmt->stat.execUseUs;
+    int32_t affectedRows = 0;
+    int64_t startUs = taosGetTimestampUs();
+    int32_t code = taos_stmt2_bind_param(stmt, &bindv, -1);
+    if (code == 0) {
+      code = taos_stmt2_exec(stmt, &affectedRows);
+    }
+    int64_t costUs = taosGetTimestampUs() - startUs;
+    if (code != 0) {
+      printf("stmt2 insert failed since %s\n", taos_stmt2_error(stmt));
+      (void)taos_stmt2_close(stmt);
+      return false;
+    }
+
+    result.stage.bindUs += pStmt->stat.bindDataUs1 + pStmt->stat.bindDataUs2 + pStmt->stat.bindDataUs3 +
+                           pStmt->stat.bindDataUs4 + pStmt->stat.setTbNameUs - bindUs;
+    result.stage.rpcUs += pStmt->stat.execUseUs - execUs;
+    result.rows += affectedRows;
+    result.latencyUs.push_back(costUs);
+  }
+
+  (void)taos_stmt2_close(stmt);
+  return true;
+}
+
+bool benchSml(TAOS *taos, const SBenchCfg &cfg, SBenchResult &result) {
+  std::string lines;
+  char        buf[128];
+  for (int32_t b = 0; b < cfg.batches; ++b) {
+    lines.clear();
+    for (int32_t t = 0; t < cfg.tables; ++t) {
+      for (int32_t r = 0; r < cfg.rows; ++r) {
+        snprintf(buf, sizeof(buf), "sml_st,t1=%d c1=%di32,c2=%d.5f64,c3=\"v%d\" %" PRId64 "\n", t, r, r, r,
+                 benchTs(cfg, b, r));
+        lines += buf;
+      }
+    }
+
+    int32_t   totalRows = 0;
+    int64_t   startUs = taosGetTimestampUs();
+    TAOS_RES *res = taos_schemaless_insert_raw(taos, (char *)lines.c_str(), (int)lines.size(), &totalRows,
+                                               TSDB_SML_LINE_PROTOCOL, TSDB_SML_TIMESTAMP_MILLI_SECONDS);
+    int64_t   costUs = taosGetTimestampUs() - startUs;
+    if (taos_errno(res) != 0) {
+      printf("sml insert failed since %s\n", taos_errstr(res));
+      taos_free_result(res);
+      return false;
+    }
+    result.rows += taos_affected_rows(res);
+    result.latencyUs.push_back(costUs);
+    taos_free_result(res);
+  }
+  return true;
+}
+
+// the ts column is the first one, its values follow the column schemas, the column lengths and its null bitmap
+int64_t *benchRawBlockTs(char *pBlock) {
+  int32_t numOfRows = *(int32_t *)(pBlock + 2 * sizeof(int32_t));
+  int32_t numOfCols = *(int32_t *)(pBlock + 3 * sizeof(int32_t));
+  char   *p = pBlock + 5 * sizeof(int32_t) + sizeof(uint64_t);
+  p += numOfCols * (sizeof(int8_t) + sizeof(int32_t)) + numOfCols * sizeof(int32_t);
+  return (int64_t *)(p + BitmapLen(numOfRows));
+}
+
+bool benchRaw(TAOS *taos, const SBenchCfg &cfg, SBenchResult &result) {
+  if (!benchPrepareTables(taos, cfg, "raw_st")) return false;
+
+  // the raw block comes from a query so it is laid out exactly like the table schema
+  char sql[256];
+  snprintf(sql, sizeof(sql), "insert into raw_st_0 values");
+  std::string insert = sql;
+  for (int32_t r = 0; r < cfg.rows; ++r) {
+    snprintf(sql, sizeof(sql), "(%" PRId64 ",%d,%d.5,'v%d')", benchTs(cfg, -1, r), r, r, r);
+    insert += sql;
+  }
+  if (!benchExec(taos, insert.c_str())) return false;
+
+  TAOS_RES *res = taos_query(taos, "select * from raw_st_0");
+  int32_t   numOfRows = 0;
+  void     *pData = NULL;
+  if (taos_errno(res) != 0 || taos_fetch_raw_block(res, &numOfRows, &pData) != 0 || numOfRows <= 0) {
+    printf("failed to fetch raw block since %s\n", taos_errstr(res));
+    taos_free_result(res);
+    return false;
+  }
+
+  // each batch writes new rows, not the same timestamps over and over
+  std::vector<char> block((char *)pData, (char *)pData + *(int32_t *)((char *)pData + sizeof(int32_t)));
+  int64_t          *ts = benchRawBlockTs(block.data());
+  taos_free_result(res);
+
+  for (int32_t b = 0; b < cfg.batches; ++b) {
+    for (int32_t r = 0; r < numOfRows; ++r) ts[r] = benchTs(cfg, b, r);
+
+    for (int32_t t = 0; t < cfg.tables; ++t) {
+      char tbname[TSDB_TABLE_NAME_LEN];
+      snprintf(tbname, sizeof(tbname), "raw_st_%d", t);
+
+      int64_t startUs = taosGetTimestampUs();
+      int32_t code = taos_write_raw_block(taos, numOfRows, block.data(), tbname);
+      int64_t costUs = taosGetTimestampUs() - startUs;
+      if (code != 0) {
+        printf("raw block write failed since %s\n", tstrerror(code));
+        return false;
+      }
+      result.rows += numOfRows;
+      result.stage.rpcUs += costUs;
+      result.latencyUs.push_back(costUs);
+    }
+  }
+
+  return true;
+}
+
+typedef bool (*FBenchWorkload)(TAOS *taos, const SBenchCfg &cfg, SBenchResult &result);
+
+void benchReport(const char *name, SBenchResult &result) {
+  std::vector<int64_t> &lat = result.latencyUs;
+  if (lat.empty()) return;
+  std::sort(lat.begin(), lat.end());
+  int64_t p50 = lat[lat.size() * 50 / 100];
+  int64_t p99 = lat[std::min(lat.size() - 1, lat.size() * 99 / 100)];
+  double  n = (double)lat.size();
+
+  printf("%-6s rows:%" PRId64 " cost:%.3fs rows/s:%.0f batch p50:%.3fms p99:%.3fms\n", name, result.rows,
+         result.totalUs / 1e6, result.totalUs > 0 ? result.rows * 1e6 / result.totalUs : 0.0, p50 / 1e3, p99 / 1e3);
+  printf("       per batch(us) parse:%.1f schema:%.1f bind:%.1f rpc:%.1f", result.stage.parseUs / n,
+         result.stage.schemaUs / n, result.stage.bindUs / n, result.stage.rpcUs / n);
+  if (result.vnode.submitNum > 0) {
+    printf(" | per submit(us) wal:%.1f memtable:%.1f (%" PRId64 " submits)",
+           result.vnode.walAppendNum > 0 ? (double)result.vnode.walAppendUs / result.vnode.walAppendNum : 0.0,
+           (double)result.vnode.memtableUs / result.vnode.submitNum, result.vnode.submitNum);
+  }
+  printf("\n");
+}
+
+void benchRun(TAOS *taos, const SBenchCfg &cfg, const char *name, FBenchWorkload fp) {
+  if (cfg.mode != "all" && cfg.mode != name) return;
+
+  SBenchResult    result;
+  SVnodeWriteStat vnodeStart = {0}, vnodeEnd = {0};
+  dmGetVnodeWriteStat(&vnodeStart);
+
+  int64_t startUs = taosGetTimestampUs();
+  bool    ok = fp(taos, cfg, result);
+  result.totalUs = taosGetTimestampUs() - startUs;
+
+  dmGetVnodeWriteStat(&vnodeEnd);
+  result.vnode.walAppendNum = vnodeEnd.walAppendNum - vnodeStart.walAppendNum;
+  result.vnode.walAppendUs = vnodeEnd.walAppendUs - vnodeStart.walAppendUs;
+  result.vnode.submitNum = vnodeEnd.submitNum - vnodeStart.submitNum;
+  result.vnode.memtableUs = vnodeEnd.memtableUs - vnodeStart.memtableUs;
+
+  if (!ok) {
+    printf("%-6s failed\n", name);
+    return;
+  }
+  benchReport(name, result);
+}
+
+void benchParseArgs(int argc, char *argv[], SBenchCfg &cfg) {
+  for (int32_t i = 1; i + 1 < argc; i += 2) {
+    std::string opt = argv[i];
+    const char *val = argv[i + 1];
+    if (opt == "-m") {
+      cfg.mode = val;
+    } else if (opt == "-t") {
+      cfg.tables = std::max(1, atoi(val));
+    } else if (opt == "-r") {
+      cfg.rows = std::max(1, atoi(val));
+    } else if (opt == "-b") {
+      cfg.batches = std::max(1, atoi(val));
+    } else if (opt == "-h") {
+      cfg.host = val;
+    } else if (opt == "-P") {
+      cfg.port = (uint16_t)atoi(val);
+    } else if (opt == "-d") {
+      cfg.dataDir = val;
+    } else {
+      printf("unknown option %s\n", opt.c_str());
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  SBenchCfg cfg;
+  benchParseArgs(argc, argv, cfg);
+
+  TestServer server;
+  bool       inProcess = cfg.host.empty();
+  if (inProcess) {
+    Testbase test;
+    osDefaultInit();
+    test.InitLog(TD_TMP_DIR_PATH "wbenchlog");
+    tsServerPort = cfg.port;
+    tstrncpy(tsLocalFqdn, "localhost", TSDB_FQDN_LEN);
+    snprintf(tsLocalEp, TSDB_EP_LEN, "%s:%u", tsLocalFqdn, tsServerPort);
+    tstrncpy(tsFirst, tsLocalEp, TSDB_EP_LEN);
+    tstrncpy(tsDataDir, cfg.dataDir.c_str(), PATH_MAX);
+    tsEnableWriteStat = true;
+    (void)taosRemoveDir(tsDataDir);
+    (void)taosMkDir(tsDataDir);
+    if (!server.Start()) {
+      printf("failed to start dnode\n");
+      return 1;
+    }
+  }
+
+  TAOS *taos = taos_connect(inProcess ? "localhost" : cfg.host.c_str(), "root", "taosdata", NULL, cfg.port);
+  if (taos == NULL) {
+    printf("failed to connect since %s\n", taos_errstr(NULL));
+    if (inProcess) server.Stop();
+    return 1;
+  }
+
+  char sql[128];
+  snprintf(sql, sizeof(sql), "drop database if exists %s", benchDb);
+  (void)benchExec(taos, sql);
+  snprintf(sql, sizeof(sql), "create database %s vgroups 4", benchDb);
+  if (benchExec(taos, sql) && taos_select_db(taos, benchDb) == 0) {
+    printf("tables:%d rows per table:%d batches:%d dnode:%s\n", cfg.tables, cfg.rows, cfg.batches,
+           inProcess ? "in-process" : cfg.host.c_str());
+    benchRun(taos, cfg, "sql", benchSql);
+    benchRun(taos, cfg, "stmt2", benchStmt2);
+    benchRun(taos, cfg, "sml", benchSml);
+    benchRun(taos, cfg, "raw", benchRaw);
+  }
+
+  taos_close(taos);
+  taos_cleanup();
+  if (inProcess) {
+    server.Stop();
+    dmCleanup();
+  }
+  return 0;
+}
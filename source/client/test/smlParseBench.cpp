@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Schemaless parse benchmark. Parses the same influx lines with smlParseStart using 1, 2, 4 and 8 parse threads
+ * (or the given ones) and reports the cost and lines/s of each run. Nothing is sent to a server.
+ *
+ * usage: smlParseBench [-l lines] [-t threads]
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "tglobal.h"
+
+#include "../inc/clientSml.h"
+#include "taos.h"
+
+namespace {
+
+struct SBenchCfg {
+  int32_t              lines = 200000;
+  std::vector<int32_t> threads = {1, 2, 4, 8};
+};
+
+char *benchBuildLines(int32_t numLines, int32_t *len) {
+  int32_t cap = numLines * 128;
+  char   *buf = (char *)taosMemoryMalloc(cap);
+  if (buf == NULL) return NULL;
+  int32_t pos = 0;
+  for (int32_t i = 0; i < numLines; ++i) {
+    pos += snprintf(buf + pos, cap - pos,
+                    "st%d,t1=%d,t2=host\\ %d c1=%di64,c2=\"val,ue %d\",c3=%d.5f64,c4=true %" PRId64 "\n", i % 4,
+                    i % 1000, i % 7, i, i, i, (int64_t)1626006833639000000LL + i);
+  }
+  *len = pos;
+  return buf;
+}
+
+SSmlHandle *benchBuildHandle(int32_t numLines) {
+  SSmlHandle *info = NULL;
+  if (smlBuildSmlInfo(NULL, &info) != 0) return NULL;
+  info->protocol = TSDB_SML_LINE_PROTOCOL;
+  info->precision = TSDB_SML_TIMESTAMP_NANO_SECONDS;
+  info->lineNum = numLines;
+  info->dataFormat = false;
+  info->lines = (SSmlLineInfo *)taosMemoryCalloc(numLines, sizeof(SSmlLineInfo));
+  return info;
+}
+
+void benchParseArgs(int argc, char *argv[], SBenchCfg &cfg) {
+  for (int32_t i = 1; i + 1 < argc; i += 2) {
+    std::string opt = argv[i];
+    const char *val = argv[i + 1];
+    if (opt == "-l") {
+      cfg.lines = std::max(1, atoi(val));
+    } else if (opt == "-t") {
+      cfg.threads = {std::max(1, atoi(val))};
+    } else {
+      printf("unknown option %s\n", opt.c_str());
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  SBenchCfg cfg;
+  benchParseArgs(argc, argv, cfg);
+
+  int32_t len = 0;
+  char   *raw = benchBuildLines(cfg.lines, &len);
+  if (raw == NULL) {
+    printf("failed to build %d lines\n", cfg.lines);
+    return 1;
+  }
+
+  int32_t code = 0;
+  for (int32_t threads : cfg.threads) {
+    SSmlHandle *info = benchBuildHandle(cfg.lines);
+    if (info == NULL) {
+      code = 1;
+      break;
+    }
+    tsSmlParseThreads = threads;
+
+    int64_t st = taosGetTimestampUs();
+    code = smlParseStart(info, NULL, raw, raw + len, cfg.lines);
+    int64_t cost = taosGetTimestampUs() - st;
+    smlDestroyInfo(info);
+    if (code != 0) {
+      printf("smlParseStart threads:%d failed, code:%s\n", threads, tstrerror(code));
+      break;
+    }
+    printf("smlParseStart threads:%d lines:%d cost:%" PRId64 "us, %.0f lines/s\n", threads, cfg.lines, cost,
+           cfg.lines * 1000000.0 / std::max(cost, (int64_t)1));
+  }
+
+  taosMemoryFree(raw);
+  return code == 0 ? 0 : 1;
+}
@@ -722,4 +722,123 @@ TEST(testCase, smlParseNumber_performance_Test) {
     printf("smlParseNumberOld:%s cost:%" PRId64, str[i], taosGetTimestampUs() - t2);
     printf("\n\n");
   }
-}
\ No newline at end of file
+}
+static char *smlBuildTestLines(int32_t numLines, int32_t *len) {
+  int32_t cap = numLines * 128;
+  char   *buf = (char *)taosMemoryMalloc(cap);
+  if (buf == NULL) return nullptr;
+  int32_t pos = 0;
+  for (int32_t i = 0; i < numLines; ++i) {
+    pos += snprintf(buf + pos, cap - pos,
+                    "st%d,t1=%d,t2=host\\ %d c1=%di64,c2=\"val,ue %d\",c3=%d.5f64,c4=true %" PRId64 "\n", i % 4,
+                    i % 1000, i % 7, i, i, i, (int64_t)1626006833639000000LL + i);
+  }
+  *len = pos;
+  return buf;
+}
+
+static SSmlHandle *smlBuildTestHandle(int32_t numLines) {
+  SSmlHandle *info = nullptr;
+  if (smlBuildSmlInfo(nullptr, &info) != 0) return nullptr;
+  info->protocol = TSDB_SML_LINE_PROTOCOL;
+  info->precision = TSDB_SML_TIMESTAMP_NANO_SECONDS;
+  info->lineNum = numLines;
+  info->dataFormat = false;
+  info->lines = (SSmlLineInfo *)taosMemoryCalloc(numLines, sizeof(SSmlLineInfo));
+  return info;
+}
+
+// the number of parse threads is global, it is restored even if the test stops at a failed assertion
+class SmlParseThreadsTest : public ::testing::Test {
+ protected:
+  void SetUp() override { threads_ = tsSmlParseThreads; }
+  void TearDown() override { tsSmlParseThreads = threads_; }
+
+ private:
+  int32_t threads_ = 1;
+};
+
+TEST_F(SmlParseThreadsTest, smlParseStart_parallel_Test) {
+  int32_t numLines = SML_PARSE_LINES_PER_THREAD * 4;
+  int32_t len = 0;
+  char   *raw = smlBuildTestLines(numLines, &len);
+  ASSERT_NE(raw, nullptr);
+
+  SSmlHandle *seqInfo = smlBuildTestHandle(numLines);
+  ASSERT_NE(seqInfo, nullptr);
+  tsSmlParseThreads = 1;
+  ASSERT_EQ(smlParseStart(seqInfo, nullptr, raw, raw + len, numLines), 0);
+
+  SSmlHandle *parInfo = smlBuildTestHandle(numLines);
+  ASSERT_NE(parInfo, nullptr);
+  tsSmlParseThreads = 4;
+  ASSERT_EQ(smlParseStart(parInfo, nullptr, raw, raw + len, numLines), 0);
+
+  ASSERT_EQ(taosHashGetSize(seqInfo->childTables), taosHashGetSize(parInfo->childTables));
+  for (int32_t i = 0; i < numLines; ++i) {
+    SSmlLineInfo *seq = seqInfo->lines + i;
+    SSmlLineInfo *par = parInfo->lines + i;
+    ASSERT_EQ(seq->measureTagsLen, par->measureTagsLen);
+    ASSERT_EQ(seq->tagsLen, par->tagsLen);
+    ASSERT_EQ(seq->colsLen, par->colsLen);
+    ASSERT_EQ(taosArrayGetSize(seq->colArray), taosArrayGetSize(par->colArray));
+    ASSERT_EQ(((SSmlKv *)taosArrayGet(seq->colArray, 0))->i, ((SSmlKv *)taosArrayGet(par->colArray, 0))->i);
+    ASSERT_EQ(((SSmlKv *)taosArrayGet(seq->colArray, 1))->i, ((SSmlKv *)taosArrayGet(par->colArray, 1))->i);
+  }
+  smlDestroyInfo(parInfo);
+
+  // a bad line in any chunk falls back to the sequential parse, which reports it
+  raw[len - 2] = 'x';
+  parInfo = smlBuildTestHandle(numLines);
+  ASSERT_NE(parInfo, nullptr);
+  ASSERT_NE(smlParseStart(parInfo, nullptr, raw, raw + len, numLines), 0);
+
+  smlDestroyInfo(parInfo);
+  smlDestroyInfo(seqInfo);
+  taosMemoryFree(raw);
+}
+
+TEST(testCase, smlCacheSetCTableName_Test) {
+  char raw[] =
+      "st,t1=3,id=ctb1,t2=a c1=1i64 1626006833639000000\n"
+      "st,t1=4,t2=b c1=2i64 1626006833639000000\n";
+  int32_t    len = strlen(raw);
+  SSmlCache *pCache = nullptr;
+  ASSERT_EQ(smlCreateCache(&pCache), 0);
+
+  SRequestObj request = {0};
+  request.pDb = "db";
+  SSmlTableInfo *names[2][2] = {0};
+  SSmlHandle    *infos[2] = {0};
+  char          *lines[2] = {0};
+  for (int32_t round = 0; round < 2; ++round) {
+    infos[round] = smlBuildTestHandle(2);
+    ASSERT_NE(infos[round], nullptr);
+    infos[round]->pCache = pCache;
+    infos[round]->pRequest = &request;
+    infos[round]->tbnameKey = "id";
+    lines[round] = (char *)taosMemoryMalloc(len);
+    (void)memcpy(lines[round], raw, len);
+    ASSERT_EQ(smlParseStart(infos[round], nullptr, lines[round], lines[round] + len, 2), 0);
+    for (int32_t i = 0; i < 2; ++i) {
+      SSmlLineInfo *elements = infos[round]->lines + i;
+      names[round][i] =
+          *(SSmlTableInfo **)taosHashGet(infos[round]->childTables, elements->measureTag, elements->measureTagsLen);
+    }
+    ASSERT_EQ(taosHashGetSize(pCache->pCTables), 2);
+  }
+
+  // the second round is served from the cache and must match the names built from the tags
+  ASSERT_STREQ(names[0][0]->childTableName, "ctb1");
+  for (int32_t i = 0; i < 2; ++i) {
+    ASSERT_STREQ(names[0][i]->childTableName, names[1][i]->childTableName);
+    ASSERT_EQ(taosArrayGetSize(names[0][i]->tags), taosArrayGetSize(names[1][i]->tags));
+  }
+  ASSERT_EQ(taosArrayGetSize(names[1][0]->tags), 2);
+
+  for (int32_t round = 0; round < 2; ++round) {
+    smlDestroyInfo(infos[round]);
+    taosMemoryFree(lines[round]);
+  }
+  smlDestroyCache(pCache);
+}
@@ -373,3 +373,121 @@ int32_t deleteRsync(const char* id) {
   uDebug("[rsync] delete data:%s successful", id);
   return 0;
 }
+
+static const char* rsyncLocalPath(const char* path, char* buf) {
+#ifdef WINDOWS
+  changeDirFromWindowsToLinux((char*)path, buf);
+  return buf;
+#else
+  return path;
+#endif
+}
+
+// the delta of an incremental checkpoint is merged into the data dir of the task, the sst files that are already in the
+// remote dir are not sent again. Nothing is removed here, not even for a base, since the CURRENT_xx/MANIFEST-xx_xx/META_xx
+// and sst files of the committed checkpoint must survive until a later checkpoint is committed.
+int32_t uploadDeltaByRsync(const char* id, const char* path, bool base) {
+  int64_t st = taosGetTimestampMs();
+  char    command[PATH_MAX] = {0};
+  char    pathTransform[PATH_MAX] = {0};
+
+  const char* p = rsyncLocalPath(path, pathTransform);
+  snprintf(command, PATH_MAX,
+           "rsync -av --debug=all --log-file=%s/rsynclog --timeout=10 --bwlimit=100000 %s%s "
+           "rsync://%s/checkpoint/%s/data/",
+           tsLogDir, p, (p[strlen(p) - 1] != '/') ? "/" : "", tsSnodeAddress, id);
+
+  int32_t code = execCommand(command);
+  if (code != 0) {
+    uError("[rsync] s-task:%s upload checkpoint %s in %s to %s failed, code:%d," ERRNO_ERR_FORMAT, id,
+           base ? "base" : "delta", path, tsSnodeAddress, code, ERRNO_ERR_DATA);
+    code = TAOS_SYSTEM_ERROR(errno);
+  } else {
+    uDebug("[rsync] s-task:%s upload checkpoint %s in:%s to %s successfully, elapsed time:%" PRId64 "ms", id,
+           base ? "base" : "delta", path, tsSnodeAddress, taosGetTimestampMs() - st);
+  }
+
+  return code;
+}
+
+// only the files in the include list are absent in the empty source dir, so rsync removes exactly these files. The list
+// may hold rsync wildcard patterns.
+int32_t deleteFilesByRsync(const char* id, SArray* pNames) {
+  int32_t num = taosArrayGetSize(pNames);
+  if (num == 0) {
+    return 0;
+  }
+
+  char emptyDir[PATH_MAX] = {0};
+  char listFile[PATH_MAX] = {0};
+  snprintf(emptyDir, PATH_MAX, "%s%sstream_empty_%s", tsTempDir, TD_DIRSEP, id);
+  snprintf(listFile, PATH_MAX, "%s%sstream_del_%s", tsTempDir, TD_DIRSEP, id);
+
+  taosRemoveDir(emptyDir);
+  int32_t code = taosMulMkDir(emptyDir);
+  if (code != 0) {
+    uError("[rsync] s-task:%s make tmp dir failed. code:%d," ERRNO_ERR_FORMAT, id, code, ERRNO_ERR_DATA);
+    return TAOS_SYSTEM_ERROR(errno);
+  }
+
+  TdFilePtr pFile = taosOpenFile(listFile, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  if (pFile == NULL) {
+    code = terrno;
+    taosRemoveDir(emptyDir);
+    return code;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    char* pName = taosArrayGetP(pNames, i);
+    if (taosWriteFile(pFile, pName, strlen(pName)) < 0 || taosWriteFile(pFile, "\n", 1) < 0) {
+      code = terrno;
+      break;
+    }
+  }
+  TAOS_UNUSED(taosCloseFile(&pFile));
+
+  if (code == 0) {
+    char command[PATH_MAX] = {0};
+    char pathTransform[PATH_MAX] = {0};
+    char listTransform[PATH_MAX] = {0};
+    snprintf(command, PATH_MAX,
+             "rsync -rv --debug=all --log-file=%s/rsynclog --delete --timeout=10 --include-from=%s --exclude=\"*\" "
+             "%s/ rsync://%s/checkpoint/%s/data/",
+             tsLogDir, rsyncLocalPath(listFile, listTransform), rsyncLocalPath(emptyDir, pathTransform),
+             tsSnodeAddress, id);
+
+    code = execCommand(command);
+    if (code != 0) {
+      uError("[rsync] s-task:%s delete %d files failed, code:%d," ERRNO_ERR_FORMAT, id, num, code, ERRNO_ERR_DATA);
+      code = TAOS_SYSTEM_ERROR(errno);
+    } else {
+      uDebug("[rsync] s-task:%s delete %d files successfully", id, num);
+    }
+  }
+
+  TAOS_UNUSED(taosRemoveFile(listFile));
+  taosRemoveDir(emptyDir);
+  return code;
+}
+
+int32_t downloadDeltaByRsync(const char* id, const char* path) {
+  int64_t st = taosGetTimestampMs();
+  char    command[PATH_MAX] = {0};
+  char    pathTransform[PATH_MAX] = {0};
+
+  snprintf(command, PATH_MAX,
+           "rsync -av --debug=all --log-file=%s/rsynclog --timeout=10 --bwlimit=100000 "
+           "rsync://%s/checkpoint/%s/data/ %s",
+           tsLogDir, tsSnodeAddress, id, rsyncLocalPath(path, pathTransform));
+
+  int32_t code = execCommand(command);
+  if (code != 0) {
+    uError("[rsync] %s download checkpoint data dir to:%s failed, code:%d," ERRNO_ERR_FORMAT, id, path, code,
+           ERRNO_ERR_DATA);
+    code = TAOS_SYSTEM_ERROR(errno);
+  } else {
+    uDebug("[rsync] %s download checkpoint data dir to:%s successfully, elapsed time:%" PRId64 "ms", id, path,
+           taosGetTimestampMs() - st);
+  }
+  return code;
+}
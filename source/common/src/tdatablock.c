@@ -16,6 +16,7 @@
 #define _DEFAULT_SOURCE
 #include "tdatablock.h"
 #include "tcompare.h"
+#include "tdataformat.h"
 #include "tlog.h"
 #include "tname.h"
 #include "tglobal.h"
@@ -1384,6 +1385,186 @@ static int32_t* createTupleIndex(size_t rows) {
 
 static void destroyTupleIndex(int32_t* index) { taosMemoryFreeClear(index); }
 
+#define SORT_NORM_KEY_VAR_PREFIX_LEN 8
+#define SORT_NORM_KEY_MAX_LEN        64
+#define SORT_NORM_KEY_MIN_ROWS       32
+
+typedef struct SSortNormKeyHelper {
+  int32_t                keyLen;
+  bool                   complete;  // true if equal prefixes imply equal sort keys
+  SSDataBlockSortHelper* pBlockHelper;
+} SSortNormKeyHelper;
+
+static int32_t sortNormKeyColLen(const SColumnInfoData* pCol) {
+  switch (pCol->info.type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+      return 1 + pCol->info.bytes;
+    case TSDB_DATA_TYPE_BINARY:
+      return 1 + SORT_NORM_KEY_VAR_PREFIX_LEN;
+    default:  // float/double compare with a tolerance, nchar/json/varbinary have their own compare rules
+      return -1;
+  }
+}
+
+// Encode one sort column of one row into a big-endian, memcmp comparable byte string. Signed integers get their sign
+// bit flipped, strings keep the prefix before the first '\0' as strncmp does, and desc order inverts the value bytes.
+static void sortNormKeyEncodeCol(const SBlockOrderInfo* pOrder, int32_t rowIndex, uint8_t* pBuf, int32_t len) {
+  SColumnInfoData* pCol = pOrder->pColData;
+  int32_t          type = pCol->info.type;
+  uint8_t*         pVal = pBuf + 1;
+  int32_t          valLen = len - 1;
+
+  if (colDataIsNull_s(pCol, rowIndex)) {
+    pBuf[0] = pOrder->nullFirst ? 0 : 2;
+    (void)memset(pVal, 0, valLen);
+    return;
+  }
+
+  pBuf[0] = 1;
+  const char* pData = colDataGetData(pCol, rowIndex);
+  if (type == TSDB_DATA_TYPE_BINARY) {
+    int32_t dataLen = varDataLen(pData);
+    int32_t i = 0;
+    for (; i < valLen && i < dataLen && varDataVal(pData)[i] != 0; ++i) {
+      pVal[i] = (uint8_t)varDataVal(pData)[i];
+    }
+    (void)memset(pVal + i, 0, valLen - i);
+  } else {
+    uint64_t v = 0;
+    switch (type) {
+      case TSDB_DATA_TYPE_BOOL:
+      case TSDB_DATA_TYPE_TINYINT:
+        v = (uint8_t)(*(int8_t*)pData) ^ 0x80u;
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        v = (uint16_t)(*(int16_t*)pData) ^ 0x8000u;
+        break;
+      case TSDB_DATA_TYPE_INT:
+        v = (uint32_t)(*(int32_t*)pData) ^ 0x80000000u;
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        v = (uint64_t)(*(int64_t*)pData) ^ 0x8000000000000000ull;
+        break;
+      case TSDB_DATA_TYPE_UTINYINT:
+        v = *(uint8_t*)pData;
+        break;
+      case TSDB_DATA_TYPE_USMALLINT:
+        v = *(uint16_t*)pData;
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        v = *(uint32_t*)pData;
+        break;
+      default:
+        v = *(uint64_t*)pData;
+        break;
+    }
+    for (int32_t i = valLen - 1; i >= 0; --i) {
+      pVal[i] = (uint8_t)(v & 0xFF);
+      v >>= 8;
+    }
+  }
+
+  if (pOrder->order == TSDB_ORDER_DESC) {
+    for (int32_t i = 0; i < valLen; ++i) {
+      pVal[i] = ~pVal[i];
+    }
+  }
+}
+
+static int32_t sortNormKeyCompar(const void* p1, const void* p2, const void* param) {
+  const SSortNormKeyHelper* pHelper = param;
+
+  int32_t ret = memcmp(p1, p2, pHelper->keyLen);
+  if (ret != 0 || pHelper->complete) {
+    return ret;
+  }
+
+  // the prefixes are equal, compare the full columns
+  return dataBlockCompar((const char*)p1 + pHelper->keyLen, (const char*)p2 + pHelper->keyLen, pHelper->pBlockHelper);
+}
+
+/**
+ * Sort the tuple index of a multi-key sort by normalized keys: each sort key is encoded once per row into a
+ * memcmp comparable prefix, and the full columns are touched only when two prefixes are equal.
+ * @return false if the sort keys can not be normalized, and the caller should fall back to the column compare.
+ */
+static bool blockDataSortByNormKey(SSDataBlockSortHelper* pHelper, int32_t* index, int32_t rows, int32_t* pCode) {
+  SArray* pOrderInfo = pHelper->orderInfo;
+  int32_t numOfOrders = taosArrayGetSize(pOrderInfo);
+  int32_t keyLen = 0;
+  bool    complete = true;
+
+  *pCode = TSDB_CODE_SUCCESS;
+  if (rows < SORT_NORM_KEY_MIN_ROWS) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < numOfOrders; ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pOrderInfo, i);
+    if (pOrder == NULL || pOrder->pColData == NULL) {
+      return false;
+    }
+
+    int32_t len = sortNormKeyColLen(pOrder->pColData);
+    if (len < 0) {
+      return false;
+    }
+    if (IS_VAR_DATA_TYPE(pOrder->pColData->info.type)) {
+      complete = false;
+    }
+    if (keyLen + len > SORT_NORM_KEY_MAX_LEN) {
+      complete = false;
+      break;
+    }
+    keyLen += len;
+  }
+
+  if (keyLen == 0) {
+    return false;
+  }
+
+  int32_t  entryLen = keyLen + sizeof(int32_t);
+  uint8_t* pEntries = taosMemoryMalloc((int64_t)entryLen * rows);
+  if (pEntries == NULL) {
+    *pCode = terrno;
+    return true;
+  }
+
+  for (int32_t j = 0; j < rows; ++j) {
+    uint8_t* pEntry = pEntries + (int64_t)entryLen * j;
+    int32_t  offset = 0;
+    for (int32_t i = 0; i < numOfOrders && offset < keyLen; ++i) {
+      SBlockOrderInfo* pOrder = TARRAY_GET_ELEM(pOrderInfo, i);
+      int32_t          len = sortNormKeyColLen(pOrder->pColData);
+      sortNormKeyEncodeCol(pOrder, j, pEntry + offset, len);
+      offset += len;
+    }
+    *(int32_t*)(pEntry + keyLen) = j;
+  }
+
+  SSortNormKeyHelper keyHelper = {.keyLen = keyLen, .complete = complete, .pBlockHelper = pHelper};
+  terrno = 0;
+  taosqsort_r(pEntries, rows, entryLen, &keyHelper, sortNormKeyCompar);
+  *pCode = terrno;
+
+  for (int32_t j = 0; j < rows; ++j) {
+    index[j] = *(int32_t*)(pEntries + (int64_t)entryLen * j + keyLen);
+  }
+
+  taosMemoryFree(pEntries);
+  return true;
+}
+
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   if (pDataBlock->info.rows <= 1) {
     return TSDB_CODE_SUCCESS;
@@ -1462,14 +1643,21 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
     pInfo->compFn = getKeyComparFunc(pInfo->pColData->info.type, pInfo->order);
   }
 
-  terrno = 0;
-  taosqsort_r(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
-  if (terrno) return terrno;
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (!blockDataSortByNormKey(&helper, index, rows, &code)) {
+    terrno = 0;
+    taosqsort_r(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
+    code = terrno;
+  }
+  if (code) {
+    destroyTupleIndex(index);
+    return code;
+  }
 
   int64_t p1 = taosGetTimestampUs();
 
   SColumnInfoData* pCols = NULL;
-  int32_t code = createHelpColInfoData(pDataBlock, &pCols);
+  code = createHelpColInfoData(pDataBlock, &pCols);
   if (code != 0) {
     destroyTupleIndex(index);
     return code;
@@ -3506,6 +3694,187 @@ int32_t trimDataBlock(SSDataBlock* pBlock, int32_t totalRows, const bool* pBoolL
   return code;
 }
 
+// Codec used for one column segment of an encoded block. Float and double go through lz4 so that the lossy float
+// configuration of the node never applies to query results.
+static int32_t blockGetSegCompressType(int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+      return type;
+    case TSDB_DATA_TYPE_BOOL:
+      return TSDB_DATA_TYPE_TINYINT;
+    default:
+      return TSDB_DATA_TYPE_BINARY;
+  }
+}
+
+// segment format: | algorithm sizeof(int8_t) | compressed length sizeof(int32_t) | compressed data |
+static int32_t blockCompressSeg(int32_t type, const char* pIn, int32_t size, char* pOut, int32_t outLen) {
+  int32_t headLen = sizeof(int8_t) + sizeof(int32_t);
+  if (outLen < headLen + size) {
+    return -1;
+  }
+
+  SCompressInfo info = {.dataType = type, .cmprAlg = ONE_STAGE_COMP, .originalSize = size};
+  int32_t       code = TSDB_CODE_FAILED;
+  if (size > 0 && outLen - headLen >= size + COMP_OVERFLOW_BYTES) {
+    code = tCompressData((void*)pIn, &info, pOut + headLen, outLen - headLen, NULL);
+  }
+
+  if (code != TSDB_CODE_SUCCESS || info.compressedSize >= size) {
+    info.cmprAlg = NO_COMPRESSION;
+    info.compressedSize = size;
+    (void)memcpy(pOut + headLen, pIn, size);
+  }
+
+  *(int8_t*)pOut = (int8_t)info.cmprAlg;
+  *(int32_t*)(pOut + sizeof(int8_t)) = info.compressedSize;
+  return headLen + info.compressedSize;
+}
+
+static int32_t blockDecompressSeg(int32_t type, const char* pIn, int32_t inLen, char* pOut, int32_t size) {
+  int32_t headLen = sizeof(int8_t) + sizeof(int32_t);
+  if (inLen < headLen) {
+    return -1;
+  }
+
+  SCompressInfo info = {.dataType = type,
+                        .cmprAlg = *(int8_t*)pIn,
+                        .originalSize = size,
+                        .compressedSize = *(int32_t*)(pIn + sizeof(int8_t))};
+  if (info.compressedSize < 0 || info.compressedSize > inLen - headLen) {
+    return -1;
+  }
+
+  if (size > 0 && tDecompressData((void*)(pIn + headLen), &info, pOut, size, NULL) != TSDB_CODE_SUCCESS) {
+    return -1;
+  }
+
+  return headLen + info.compressedSize;
+}
+
+// Compress a block produced by blockEncode column by column: the schema part is kept as it is, the null bitmap or
+// offsets and the data of each column are compressed with the codec of the column type, e.g. delta-of-delta for
+// timestamps and bit-packing for integers. Return the compressed length, or -1 if pOut is too small.
+int32_t blockCompressEncoded(const char* pRaw, int32_t rawLen, char* pOut, int32_t outLen) {
+  int32_t numOfRows = *(int32_t*)(pRaw + sizeof(int32_t) * 2);
+  int32_t numOfCols = *(int32_t*)(pRaw + sizeof(int32_t) * 3);
+  int32_t headLen = blockDataGetSerialMetaSize(numOfCols) - sizeof(bool);
+  if (headLen > rawLen || headLen > outLen) {
+    return -1;
+  }
+
+  const char*    pSchema = pRaw + sizeof(int32_t) * 5 + sizeof(uint64_t);
+  const int32_t* colSizes = (const int32_t*)(pSchema + numOfCols * (sizeof(int8_t) + sizeof(int32_t)));
+  const char*    pIn = pRaw + headLen;
+  int32_t        len = headLen;
+
+  (void)memcpy(pOut, pRaw, headLen);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t  type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    int32_t metaSize = IS_VAR_DATA_TYPE(type) ? numOfRows * sizeof(int32_t) : BitmapLen(numOfRows);
+    int32_t colSize = ntohl(colSizes[i]);
+    if (pIn + metaSize + colSize > pRaw + rawLen) {
+      return -1;
+    }
+
+    int32_t segLen = blockCompressSeg(IS_VAR_DATA_TYPE(type) ? TSDB_DATA_TYPE_INT : TSDB_DATA_TYPE_BINARY, pIn,
+                                      metaSize, pOut + len, outLen - len);
+    if (segLen < 0) {
+      return -1;
+    }
+    pIn += metaSize;
+    len += segLen;
+
+    segLen = blockCompressSeg(blockGetSegCompressType(type), pIn, colSize, pOut + len, outLen - len);
+    if (segLen < 0) {
+      return -1;
+    }
+    pIn += colSize;
+    len += segLen;
+  }
+
+  int32_t tailLen = rawLen - (int32_t)(pIn - pRaw);
+  if (tailLen < 0 || len + tailLen > outLen) {
+    return -1;
+  }
+  (void)memcpy(pOut + len, pIn, tailLen);
+
+  return len + tailLen;
+}
+
+// Restore the blockEncode format from the output of blockCompressEncoded.
+int32_t blockDecompressEncoded(const char* pIn, int32_t compLen, char* pRaw, int32_t rawLen) {
+  int32_t numOfRows = *(int32_t*)(pIn + sizeof(int32_t) * 2);
+  int32_t numOfCols = *(int32_t*)(pIn + sizeof(int32_t) * 3);
+  int32_t headLen = blockDataGetSerialMetaSize(numOfCols) - sizeof(bool);
+  if (numOfRows <= 0 || numOfCols < 0 || headLen > compLen || headLen > rawLen) {
+    return TSDB_CODE_INVALID_DATA_FMT;
+  }
+
+  const char*    pSchema = pIn + sizeof(int32_t) * 5 + sizeof(uint64_t);
+  const int32_t* colSizes = (const int32_t*)(pSchema + numOfCols * (sizeof(int8_t) + sizeof(int32_t)));
+  int32_t        pos = headLen;
+  char*          pOut = pRaw + headLen;
+
+  (void)memcpy(pRaw, pIn, headLen);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t  type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    int32_t metaSize = IS_VAR_DATA_TYPE(type) ? numOfRows * sizeof(int32_t) : BitmapLen(numOfRows);
+    int32_t colSize = ntohl(colSizes[i]);
+    if (colSize < 0 || pOut + metaSize + colSize > pRaw + rawLen) {
+      return TSDB_CODE_INVALID_DATA_FMT;
+    }
+
+    int32_t segLen = blockDecompressSeg(IS_VAR_DATA_TYPE(type) ? TSDB_DATA_TYPE_INT : TSDB_DATA_TYPE_BINARY,
+                                        pIn + pos, compLen - pos, pOut, metaSize);
+    if (segLen < 0) {
+      return TSDB_CODE_INVALID_DATA_FMT;
+    }
+    pos += segLen;
+    pOut += metaSize;
+
+    segLen = blockDecompressSeg(blockGetSegCompressType(type), pIn + pos, compLen - pos, pOut, colSize);
+    if (segLen < 0) {
+      return TSDB_CODE_INVALID_DATA_FMT;
+    }
+    pos += segLen;
+    pOut += colSize;
+  }
+
+  int32_t tailLen = compLen - pos;
+  if (tailLen < 0 || pOut + tailLen != pRaw + rawLen) {
+    return TSDB_CODE_INVALID_DATA_FMT;
+  }
+  (void)memcpy(pOut, pIn + pos, tailLen);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t blockDecompress(int8_t compressed, const char* pIn, int32_t compLen, char* pRaw, int32_t rawLen) {
+  if (compressed == BLOCK_COMPRESS_COLUMNAR) {
+    return blockDecompressEncoded(pIn, compLen, pRaw, rawLen);
+  }
+
+  int32_t len = tsDecompressString((void*)pIn, compLen, 1, pRaw, rawLen, ONE_STAGE_COMP, NULL, 0);
+  if (len < 0) {
+    return terrno ? terrno : TSDB_CODE_FAILED;
+  }
+  if (len != rawLen) {
+    uError("tsDecompressString failed, len:%d != rawLen:%d", len, rawLen);
+    return TSDB_CODE_INVALID_DATA_FMT;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t blockGetEncodeSize(const SSDataBlock* pBlock) {
   return blockDataGetSerialMetaSize(taosArrayGetSize(pBlock->pDataBlock)) + blockDataGetSize(pBlock);
 }
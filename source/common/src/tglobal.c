@@ -151,6 +151,8 @@ char tsSmlAutoChildTableNameDelimiter[TSDB_TABLE_NAME_LEN] = "";
 // true means that the name and order of cols in each line are the same(only for influx protocol)
 // bool    tsSmlDataFormat = false;
 // int32_t tsSmlBatchSize = 10000;
+int32_t tsSmlParseThreads = 1;  // threads used to parse one large line protocol batch
+int32_t tsStmt2PipelineDepth = 1;  // in-flight async stmt2 executions allowed per stmt
 
 // checkpoint backup
 char    tsSnodeAddress[TSDB_FQDN_LEN] = {0};
@@ -173,7 +175,16 @@ bool    tsEnableQueryHb = true;
 bool    tsEnableScience = false;  // on taos-cli show float and doulbe with scientific notation if true
 int32_t tsQuerySmaOptimize = 0;
 int32_t tsQueryRsmaTolerance = 1000;  // the tolerance time (ms) to judge from which level to query rsma data.
+bool    tsQueryAsyncSpill = false;
+bool    tsQuerySpillCompress = false;
+int32_t tsNumOfSortThreads = 1;
+int32_t tsNumOfScanThreads = 1;  // 1 disables the parallel read-ahead of a single table scan
+int32_t tsQueryMaxHeavyTasks = 0;
+int32_t tsQueryHeavyTaskMemSize = 64;
+int32_t tsQueryHeavyMemBudget = 0;
 bool    tsQueryPlannerTrace = false;
+bool    tsQueryCostBasedJoin = false;
+int32_t tsQueryPlanCacheSize = 0;  // cached physical plans per connection, 0 disables the plan cache
 int32_t tsQueryNodeChunkSize = 32 * 1024;
 bool    tsQueryUseNodeAllocator = true;
 bool    tsKeepColumnName = false;
@@ -202,6 +213,10 @@ bool    tsMultiResultFunctionStarReturnTags = false;
  */
 int32_t tsCompressMsgSize = -1;
 
+// compress query result blocks column by column with type-aware codecs instead of lz4 over the whole block, only
+// takes effect when the block is compressed according to tsCompressMsgSize. Requires clients that can decode it.
+bool tsCompressMsgByColumn = false;
+
 // count/hyperloglog function always return values in case of all NULL data or Empty data set.
 int32_t tsCountAlwaysReturnValue = 1;
 
@@ -214,6 +229,9 @@ int32_t tsMinIntervalTime = 1;
 // maximum batch rows numbers imported from a single csv load
 int32_t tsMaxInsertBatchRows = 1000000;
 
+// threads used to parse the rows of one csv load batch
+int32_t tsCsvParseThreads = 1;
+
 float   tsSelectivityRatio = 1.0;
 int32_t tsTagFilterResCacheSize = 1024 * 10;
 char    tsTagFilterCache = 0;
@@ -268,6 +286,7 @@ bool    tsStartUdfd = true;
 
 // wal
 int64_t tsWalFsyncDataSizeLimit = (100 * 1024 * 1024L);
+bool    tsEnableWriteStat = false;
 
 // ttl
 bool    tsTtlChangeOnWrite = false;  // if true, ttl delete time changes on last write
@@ -284,6 +303,8 @@ int32_t tsStreamCheckpointInterval = 300;
 float   tsSinkDataRate = 2.0;
 int32_t tsStreamNodeCheckInterval = 20;
 int32_t tsMaxConcurrentCheckpoint = 1;
+bool    tsStreamIncrementalCheckpoint = true;  // only ship the changed sst files to the remote checkpoint backup
+bool    tsStreamStateAsyncFlush = true;  // write the flushed window states to rocksdb in background thread
 int32_t tsTtlUnit = 86400;
 int32_t tsTtlPushIntervalSec = 10;
 int32_t tsTrimVDbIntervalSec = 60 * 60;    // interval of trimming db in all vgroups
@@ -578,6 +599,8 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
       cfgAddInt32(pCfg, "shellActivityTimer", tsShellActivityTimer, 1, 120, CFG_SCOPE_BOTH, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(
       cfgAddInt32(pCfg, "compressMsgSize", tsCompressMsgSize, -1, 100000000, CFG_SCOPE_BOTH, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(
+      cfgAddBool(pCfg, "compressMsgByColumn", tsCompressMsgByColumn, CFG_SCOPE_BOTH, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryPolicy", tsQueryPolicy, 1, 4, CFG_SCOPE_CLIENT, CFG_DYN_ENT_CLIENT));
   TAOS_CHECK_RETURN(
       cfgAddBool(pCfg, "queryTableNotExistAsEmpty", tsQueryTbNotExistAsEmpty, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
@@ -585,6 +608,9 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "enableScience", tsEnableScience, CFG_SCOPE_CLIENT, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "querySmaOptimize", tsQuerySmaOptimize, 0, 1, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "queryPlannerTrace", tsQueryPlannerTrace, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "queryCostBasedJoin", tsQueryCostBasedJoin, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(
+      cfgAddInt32(pCfg, "queryPlanCacheSize", tsQueryPlanCacheSize, 0, 100000, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryNodeChunkSize", tsQueryNodeChunkSize, 1024, 128 * 1024, CFG_SCOPE_CLIENT,
                                 CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(
@@ -598,8 +624,14 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "smlTagName", tsSmlTagName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "smlTsDefaultName", tsSmlTsDefaultName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "smlDot2Underline", tsSmlDot2Underline, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(
+      cfgAddInt32(pCfg, "smlParseThreads", tsSmlParseThreads, 1, 64, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(
+      cfgAddInt32(pCfg, "stmt2PipelineDepth", tsStmt2PipelineDepth, 1, 64, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "maxInsertBatchRows", tsMaxInsertBatchRows, 1, INT32_MAX, CFG_SCOPE_CLIENT,
                                 CFG_DYN_CLIENT) != 0);
+  TAOS_CHECK_RETURN(
+      cfgAddInt32(pCfg, "csvParseThreads", tsCsvParseThreads, 1, 64, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(
       cfgAddInt32(pCfg, "maxRetryWaitTime", tsMaxRetryWaitTime, 0, 86400000, CFG_SCOPE_SERVER, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "useAdapter", tsUseAdapter, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
@@ -808,9 +840,17 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "s3MigrateEnabled", tsS3MigrateEnabled, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "uptimeInterval", tsUptimeInterval, 1, 100000, CFG_SCOPE_SERVER, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryRsmaTolerance", tsQueryRsmaTolerance, 0, 900000, CFG_SCOPE_SERVER, CFG_DYN_NONE));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "numOfSortThreads", tsNumOfSortThreads, 1, 64, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "numOfScanThreads", tsNumOfScanThreads, 1, 64, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryMaxHeavyTasks", tsQueryMaxHeavyTasks, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryHeavyTaskMemSize", tsQueryHeavyTaskMemSize, 1, 1048576, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryHeavyMemBudget", tsQueryHeavyMemBudget, 0, INT32_MAX, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "queryAsyncSpill", tsQueryAsyncSpill, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "querySpillCompress", tsQuerySpillCompress, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "timeseriesThreshold", tsTimeSeriesThreshold, 0, 2000, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
 
   TAOS_CHECK_RETURN(cfgAddInt64(pCfg, "walFsyncDataSizeLimit", tsWalFsyncDataSizeLimit, 100 * 1024 * 1024, INT64_MAX, CFG_SCOPE_SERVER, CFG_DYN_NONE));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "enableWriteStat", tsEnableWriteStat, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
 
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "udf", tsStartUdfd, CFG_SCOPE_SERVER, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "udfdResFuncs", tsUdfdResFuncs, CFG_SCOPE_SERVER, CFG_DYN_NONE));
@@ -823,6 +863,8 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "checkpointInterval", tsStreamCheckpointInterval, 60, 1800, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
   TAOS_CHECK_RETURN(cfgAddFloat(pCfg, "streamSinkDataRate", tsSinkDataRate, 0.1, 5, CFG_SCOPE_SERVER, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "concurrentCheckpoint", tsMaxConcurrentCheckpoint, 1, 10, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "streamIncrementalCheckpoint", tsStreamIncrementalCheckpoint, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "streamStateAsyncFlush", tsStreamStateAsyncFlush, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
 
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "cacheLazyLoadThreshold", tsCacheLazyLoadThreshold, 0, 100000, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
 
@@ -1210,15 +1252,27 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "smlDot2Underline");
   tsSmlDot2Underline = pItem->bval;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "smlParseThreads");
+  tsSmlParseThreads = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "stmt2PipelineDepth");
+  tsStmt2PipelineDepth = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "maxInsertBatchRows");
   tsMaxInsertBatchRows = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "csvParseThreads");
+  tsCsvParseThreads = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "shellActivityTimer");
   tsShellActivityTimer = pItem->i32;
 
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "compressMsgSize");
   tsCompressMsgSize = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "compressMsgByColumn");
+  tsCompressMsgByColumn = pItem->bval;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfTaskQueueThreads");
   tsNumOfTaskQueueThreads = pItem->i32;
 
@@ -1240,6 +1294,12 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryPlannerTrace");
   tsQueryPlannerTrace = pItem->bval;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryCostBasedJoin");
+  tsQueryCostBasedJoin = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryPlanCacheSize");
+  tsQueryPlanCacheSize = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryNodeChunkSize");
   tsQueryNodeChunkSize = pItem->i32;
 
@@ -1562,12 +1622,36 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryRsmaTolerance");
   tsQueryRsmaTolerance = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfSortThreads");
+  tsNumOfSortThreads = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfScanThreads");
+  tsNumOfScanThreads = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryMaxHeavyTasks");
+  tsQueryMaxHeavyTasks = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryHeavyTaskMemSize");
+  tsQueryHeavyTaskMemSize = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryHeavyMemBudget");
+  tsQueryHeavyMemBudget = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryAsyncSpill");
+  tsQueryAsyncSpill = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "querySpillCompress");
+  tsQuerySpillCompress = pItem->bval;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "timeseriesThreshold");
   tsTimeSeriesThreshold = pItem->i32;
 
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "walFsyncDataSizeLimit");
   tsWalFsyncDataSizeLimit = pItem->i64;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "enableWriteStat");
+  tsEnableWriteStat = pItem->bval;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "syncElectInterval");
   tsElectInterval = pItem->i32;
 
@@ -1652,6 +1736,12 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "concurrentCheckpoint");
   tsMaxConcurrentCheckpoint = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "streamIncrementalCheckpoint");
+  tsStreamIncrementalCheckpoint = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "streamStateAsyncFlush");
+  tsStreamStateAsyncFlush = pItem->bval;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "streamSinkDataRate");
   tsSinkDataRate = pItem->fval;
 
@@ -2028,7 +2118,17 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, const char *name) {
                                          {"syncLogBufferMemoryAllowed", &tsLogBufferMemoryAllowed},
 
                                          {"cacheLazyLoadThreshold", &tsCacheLazyLoadThreshold},
+                                         {"enableWriteStat", &tsEnableWriteStat},
+                                         {"queryAsyncSpill", &tsQueryAsyncSpill},
+                                         {"querySpillCompress", &tsQuerySpillCompress},
+                                         {"numOfSortThreads", &tsNumOfSortThreads},
+                                         {"numOfScanThreads", &tsNumOfScanThreads},
+                                         {"queryMaxHeavyTasks", &tsQueryMaxHeavyTasks},
+                                         {"queryHeavyTaskMemSize", &tsQueryHeavyTaskMemSize},
+                                         {"queryHeavyMemBudget", &tsQueryHeavyMemBudget},
                                          {"checkpointInterval", &tsStreamCheckpointInterval},
+                                         {"streamIncrementalCheckpoint", &tsStreamIncrementalCheckpoint},
+                                         {"streamStateAsyncFlush", &tsStreamStateAsyncFlush},
                                          {"logKeepDays", &tsLogKeepDays},
                                          {"maxStreamBackendCache", &tsMaxStreamBackendCache},
                                          {"mqRebalanceInterval", &tsMqRebalanceInterval},
@@ -2282,12 +2382,14 @@ static int32_t taosCfgDynamicOptionsForClient(SConfig *pCfg, const char *name) {
     static OptionNameAndVar options[] = {{"asyncLog", &tsAsyncLog},
                                          {"assert", &tsAssert},
                                          {"compressMsgSize", &tsCompressMsgSize},
+                                         {"compressMsgByColumn", &tsCompressMsgByColumn},
                                          {"countAlwaysReturnValue", &tsCountAlwaysReturnValue},
                                          {"crashReporting", &tsEnableCrashReport},
                                          {"enableQueryHb", &tsEnableQueryHb},
                                          {"keepColumnName", &tsKeepColumnName},
                                          {"logKeepDays", &tsLogKeepDays},
                                          {"maxInsertBatchRows", &tsMaxInsertBatchRows},
+                                         {"csvParseThreads", &tsCsvParseThreads},
                                          {"maxRetryWaitTime", &tsMaxRetryWaitTime},
                                          {"minSlidingTime", &tsMinSlidingTime},
                                          {"minIntervalTime", &tsMinIntervalTime},
@@ -2296,12 +2398,16 @@ static int32_t taosCfgDynamicOptionsForClient(SConfig *pCfg, const char *name) {
                                          {"queryPolicy", &tsQueryPolicy},
                                          {"queryTableNotExistAsEmpty", &tsQueryTbNotExistAsEmpty},
                                          {"queryPlannerTrace", &tsQueryPlannerTrace},
+                                         {"queryCostBasedJoin", &tsQueryCostBasedJoin},
+                                         {"queryPlanCacheSize", &tsQueryPlanCacheSize},
                                          {"queryNodeChunkSize", &tsQueryNodeChunkSize},
                                          {"queryUseNodeAllocator", &tsQueryUseNodeAllocator},
                                          {"randErrorChance", &tsRandErrChance},
                                          {"randErrorDivisor", &tsRandErrDivisor},
                                          {"randErrorScope", &tsRandErrScope},
                                          {"smlDot2Underline", &tsSmlDot2Underline},
+                                         {"smlParseThreads", &tsSmlParseThreads},
+                                         {"stmt2PipelineDepth", &tsStmt2PipelineDepth},
                                          {"shellActivityTimer", &tsShellActivityTimer},
                                          {"useAdapter", &tsUseAdapter},
                                          {"experimental", &tsExperimental},
@@ -8914,6 +8914,8 @@ int32_t tSerializeSResFetchReq(void *buf, int32_t bufLen, SResFetchReq *pReq) {
     TAOS_CHECK_EXIT(tEncodeI32(&encoder, 0));
   }
   TAOS_CHECK_EXIT(tEncodeU64(&encoder, pReq->clientId));
+  TAOS_CHECK_EXIT(tEncodeI32(&encoder, pReq->creditRows));
+  TAOS_CHECK_EXIT(tEncodeI8(&encoder, pReq->acceptColumnar));
 
   tEndEncode(&encoder);
 
@@ -8968,6 +8970,16 @@ int32_t tDeserializeSResFetchReq(void *buf, int32_t bufLen, SResFetchReq *pReq)
   } else {
     pReq->clientId = 0;
   }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI32(&decoder, &pReq->creditRows));
+  } else {
+    pReq->creditRows = 0;
+  }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->acceptColumnar));
+  } else {
+    pReq->acceptColumnar = 0;
+  }
 
   tEndDecode(&decoder);
 
@@ -9394,6 +9406,11 @@ int32_t tSerializeSSchedulerHbRsp(void *buf, int32_t bufLen, SSchedulerHbRsp *pR
       STaskStatus *status = taosArrayGet(pRsp->taskStatus, i);
       TAOS_CHECK_EXIT(tEncodeU64(&encoder, status->clientId));
     }
+    for (int32_t i = 0; i < num; ++i) {
+      STaskStatus *status = taosArrayGet(pRsp->taskStatus, i);
+      TAOS_CHECK_EXIT(tEncodeI8(&encoder, status->admitState));
+      TAOS_CHECK_EXIT(tEncodeI64(&encoder, status->queueWaitMs));
+    }
   } else {
     TAOS_CHECK_EXIT(tEncodeI32(&encoder, 0));
   }
@@ -9443,6 +9460,13 @@ int32_t tDeserializeSSchedulerHbRsp(void *buf, int32_t bufLen, SSchedulerHbRsp *
         TAOS_CHECK_EXIT(tDecodeU64(&decoder, &status->clientId));
       }
     }
+    if (!tDecodeIsEnd(&decoder)) {
+      for (int32_t i = 0; i < num; ++i) {
+        STaskStatus *status = taosArrayGet(pRsp->taskStatus, i);
+        TAOS_CHECK_EXIT(tDecodeI8(&decoder, &status->admitState));
+        TAOS_CHECK_EXIT(tDecodeI64(&decoder, &status->queueWaitMs));
+      }
+    }
   } else {
     pRsp->taskStatus = NULL;
   }
@@ -11192,7 +11216,13 @@ int32_t tDecodeMqDataRspCommon(SDecoder *pDecoder, SMqDataRsp *pRsp) {
     for (int32_t i = 0; i < pRsp->blockNum; i++) {
       void    *data;
       uint64_t bLen;
-      TAOS_CHECK_EXIT(tDecodeBinaryAlloc(pDecoder, &data, &bLen));
+      if (pRsp->pRspBuf != NULL) {
+        uint32_t refLen = 0;
+        TAOS_CHECK_EXIT(tDecodeBinary(pDecoder, (uint8_t **)&data, &refLen));
+        bLen = refLen;
+      } else {
+        TAOS_CHECK_EXIT(tDecodeBinaryAlloc(pDecoder, &data, &bLen));
+      }
       if (taosArrayPush(pRsp->blockData, &data) == NULL) {
         TAOS_CHECK_EXIT(terrno);
       }
@@ -11244,7 +11274,12 @@ int32_t tDecodeMqDataRsp(SDecoder *pDecoder, SMqDataRsp *pRsp) {
 static void tDeleteMqDataRspCommon(SMqDataRsp *pRsp) {
   taosArrayDestroy(pRsp->blockDataLen);
   pRsp->blockDataLen = NULL;
-  taosArrayDestroyP(pRsp->blockData, (FDelete)taosMemoryFree);
+  if (pRsp->pRspBuf != NULL) {
+    taosArrayDestroy(pRsp->blockData);
+    taosMemoryFreeClear(pRsp->pRspBuf);
+  } else {
+    taosArrayDestroyP(pRsp->blockData, (FDelete)taosMemoryFree);
+  }
   pRsp->blockData = NULL;
   taosArrayDestroyP(pRsp->blockSchema, (FDelete)tDeleteSchemaWrapper);
   pRsp->blockSchema = NULL;
@@ -11449,11 +11484,13 @@ _exit:
   return code;
 }
 
-static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbData) {
+static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbData, SHashObj *pUidFilter,
+                                    bool *skipped) {
   int32_t code = 0;
   int32_t lino;
   int32_t flags;
   uint8_t version;
+  int64_t createPos = -1;
 
   TAOS_CHECK_EXIT(tStartDecode(pCoder));
   TAOS_CHECK_EXIT(tDecodeI32v(pCoder, &flags));
@@ -11462,17 +11499,49 @@ static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbDa
   version = (flags >> 8) & 0xff;
 
   if (pSubmitTbData->flags & SUBMIT_REQ_AUTO_CREATE_TABLE) {
-    pSubmitTbData->pCreateTbReq = taosMemoryCalloc(1, sizeof(SVCreateTbReq));
-    if (pSubmitTbData->pCreateTbReq == NULL) {
-      TAOS_CHECK_EXIT(terrno);
-    }
+    if (pUidFilter != NULL) {
+      // the create req is a length prefixed section, skip it until the uid is known to be wanted
+      int32_t createLen = 0;
+      createPos = pCoder->pos;
+      TAOS_CHECK_EXIT(tDecodeI32(pCoder, &createLen));
+      if (createLen < 0 || pCoder->pos + createLen > pCoder->size) {
+        TAOS_CHECK_EXIT(TSDB_CODE_INVALID_MSG);
+      }
+      pCoder->pos += createLen;
+    } else {
+      pSubmitTbData->pCreateTbReq = taosMemoryCalloc(1, sizeof(SVCreateTbReq));
+      if (pSubmitTbData->pCreateTbReq == NULL) {
+        TAOS_CHECK_EXIT(terrno);
+      }
 
-    TAOS_CHECK_EXIT(tDecodeSVCreateTbReq(pCoder, pSubmitTbData->pCreateTbReq));
+      TAOS_CHECK_EXIT(tDecodeSVCreateTbReq(pCoder, pSubmitTbData->pCreateTbReq));
+    }
   }
 
   // submit data
   TAOS_CHECK_EXIT(tDecodeI64(pCoder, &pSubmitTbData->suid));
   TAOS_CHECK_EXIT(tDecodeI64(pCoder, &pSubmitTbData->uid));
+
+  if (pUidFilter != NULL) {
+    if (taosHashGet(pUidFilter, &pSubmitTbData->uid, sizeof(int64_t)) == NULL) {
+      *skipped = true;
+      tEndDecode(pCoder);
+      return 0;
+    }
+
+    if (createPos >= 0) {
+      int64_t pos = pCoder->pos;
+      pSubmitTbData->pCreateTbReq = taosMemoryCalloc(1, sizeof(SVCreateTbReq));
+      if (pSubmitTbData->pCreateTbReq == NULL) {
+        TAOS_CHECK_EXIT(terrno);
+      }
+
+      pCoder->pos = createPos;
+      TAOS_CHECK_EXIT(tDecodeSVCreateTbReq(pCoder, pSubmitTbData->pCreateTbReq));
+      pCoder->pos = pos;
+    }
+  }
+
   TAOS_CHECK_EXIT(tDecodeI32v(pCoder, &pSubmitTbData->sver));
 
   if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
@@ -11533,7 +11602,9 @@ _exit:
   return code;
 }
 
-int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) {
+int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) { return tDecodeSubmitReqWithFilter(pCoder, pReq, NULL); }
+
+int32_t tDecodeSubmitReqWithFilter(SDecoder *pCoder, SSubmitReq2 *pReq, SHashObj *pUidFilter) {
   int32_t code = 0;
 
   memset(pReq, 0, sizeof(*pReq));
@@ -11557,10 +11628,14 @@ int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) {
   }
 
   for (uint64_t i = 0; i < nSubmitTbData; i++) {
-    if (tDecodeSSubmitTbData(pCoder, taosArrayReserve(pReq->aSubmitTbData, 1)) < 0) {
+    bool skipped = false;
+    if (tDecodeSSubmitTbData(pCoder, taosArrayReserve(pReq->aSubmitTbData, 1), pUidFilter, &skipped) < 0) {
       code = TSDB_CODE_INVALID_MSG;
       goto _exit;
     }
+    if (skipped) {
+      (void)taosArrayPop(pReq->aSubmitTbData);
+    }
   }
 
   tEndDecode(pCoder);
@@ -412,6 +412,139 @@ TEST(testCase, var_dataBlock_split_test) {
   }
 }
 
+TEST(testCase, dataBlock_columnar_compress_test) {
+  int32_t numOfRows = 4096;
+
+  SSDataBlock* b = NULL;
+  int32_t      code = createDataBlock(&b);
+  ASSERT_EQ(code, 0);
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, 8, 1);
+  ASSERT_EQ(blockDataAppendColInfo(b, &infoData), 0);
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 2);
+  ASSERT_EQ(blockDataAppendColInfo(b, &infoData1), 0);
+  SColumnInfoData infoData2 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 20, 3);
+  ASSERT_EQ(blockDataAppendColInfo(b, &infoData2), 0);
+  ASSERT_EQ(blockDataEnsureCapacity(b, numOfRows), 0);
+
+  char buf[20] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+    SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+    SColumnInfoData* p2 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 2);
+
+    int64_t ts = 1700000000000 + i * 1000;
+    int32_t v = i % 7;
+    ASSERT_EQ(colDataSetVal(p0, i, (const char*)&ts, false), 0);
+    ASSERT_EQ(colDataSetVal(p1, i, (const char*)&v, (i % 13) == 0), 0);
+    STR_TO_VARSTR(buf, (i % 3) ? "beijing" : "shanghai");
+    ASSERT_EQ(colDataSetVal(p2, i, buf, false), 0);
+    b->info.rows++;
+  }
+
+  int32_t cols = taosArrayGetSize(b->pDataBlock);
+  int32_t bufLen = blockGetEncodeSize(b);
+  char*   pRaw = (char*)taosMemoryCalloc(1, bufLen);
+  char*   pComp = (char*)taosMemoryCalloc(1, bufLen);
+  char*   pOut = (char*)taosMemoryCalloc(1, bufLen);
+  int32_t rawLen = blockEncode(b, pRaw, bufLen, cols);
+  ASSERT_GT(rawLen, 0);
+
+  int32_t compLen = blockCompressEncoded(pRaw, rawLen, pComp, bufLen);
+  ASSERT_GT(compLen, 0);
+  ASSERT_LT(compLen, rawLen / 2);
+
+  ASSERT_EQ(blockDecompress(BLOCK_COMPRESS_COLUMNAR, pComp, compLen, pOut, rawLen), 0);
+  ASSERT_EQ(memcmp(pRaw, pOut, rawLen), 0);
+
+  // no room to compress into
+  ASSERT_LT(blockCompressEncoded(pRaw, rawLen, pComp, 16), 0);
+
+  taosMemoryFree(pRaw);
+  taosMemoryFree(pComp);
+  taosMemoryFree(pOut);
+  blockDataDestroy(b);
+}
+
+TEST(testCase, multi_key_dataBlock_sort_test) {
+  int32_t numOfRows = 1000;
+
+  SSDataBlock* b = NULL;
+  int32_t      code = createDataBlock(&b);
+  ASSERT(code == 0);
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  blockDataAppendColInfo(b, &infoData);
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 2);
+  blockDataAppendColInfo(b, &infoData1);
+  SColumnInfoData infoData2 = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, 8, 3);
+  blockDataAppendColInfo(b, &infoData2);
+  blockDataEnsureCapacity(b, numOfRows);
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  SColumnInfoData* p2 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 2);
+
+  char buf[64] = {0};
+  char varbuf[64] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int32_t v0 = (i % 7) - 3;
+    colDataSetVal(p0, i, (const char*)&v0, (i % 11) == 0);
+
+    // a long common prefix, so that the normalized key prefix ties and the full value has to be compared
+    sprintf(buf, "prefix_%03d", (i * 37) % 13);
+    STR_TO_VARSTR(varbuf, buf)
+    colDataSetVal(p1, i, varbuf, false);
+
+    int64_t v2 = (int64_t)((i * 7919) % 1000) - 500;
+    colDataSetVal(p2, i, (const char*)&v2, false);
+    b->info.rows++;
+  }
+
+  SArray*         pOrderInfo = taosArrayInit(3, sizeof(SBlockOrderInfo));
+  SBlockOrderInfo order0 = {false, TSDB_ORDER_DESC, 0, NULL};
+  SBlockOrderInfo order1 = {true, TSDB_ORDER_ASC, 1, NULL};
+  SBlockOrderInfo order2 = {true, TSDB_ORDER_ASC, 2, NULL};
+  taosArrayPush(pOrderInfo, &order0);
+  taosArrayPush(pOrderInfo, &order1);
+  taosArrayPush(pOrderInfo, &order2);
+
+  ASSERT_EQ(blockDataSort(b, pOrderInfo), 0);
+  ASSERT_EQ(b->info.rows, numOfRows);
+
+  for (int32_t i = 1; i < numOfRows; ++i) {
+    bool null0 = colDataIsNull_f(p0->nullbitmap, i - 1);
+    bool null1 = colDataIsNull_f(p0->nullbitmap, i);
+    // nulls last
+    ASSERT_FALSE(null0 && !null1);
+    if (null0 != null1) {
+      continue;
+    }
+
+    if (!null0) {
+      int32_t l = *(int32_t*)colDataGetData(p0, i - 1);
+      int32_t r = *(int32_t*)colDataGetData(p0, i);
+      ASSERT_GE(l, r);
+      if (l != r) {
+        continue;
+      }
+    }
+
+    char*   ls = colDataGetData(p1, i - 1);
+    char*   rs = colDataGetData(p1, i);
+    int32_t ret = strncmp(varDataVal(ls), varDataVal(rs), TMIN(varDataLen(ls), varDataLen(rs)));
+    ASSERT_LE(ret, 0);
+    if (ret != 0) {
+      continue;
+    }
+
+    ASSERT_LE(*(int64_t*)colDataGetData(p2, i - 1), *(int64_t*)colDataGetData(p2, i));
+  }
+
+  taosArrayDestroy(pOrderInfo);
+  blockDataDestroy(b);
+}
+
 void check_tm(const STm* tm, int32_t y, int32_t mon, int32_t d, int32_t h, int32_t m, int32_t s, int64_t fsec) {
   ASSERT_EQ(tm->tm.tm_year, y);
   ASSERT_EQ(tm->tm.tm_mon, mon);
@@ -731,6 +864,60 @@ TEST(AlreadyAddGroupIdTest, GroupIdAddedWithDifferentLength) {
   EXPECT_FALSE(result);
 }
 
+TEST(testCase, submit_req_decode_with_filter_test) {
+  SSubmitReq2 req = {0};
+  req.aSubmitTbData = taosArrayInit(3, sizeof(SSubmitTbData));
+  ASSERT_NE(req.aSubmitTbData, nullptr);
+  for (int64_t uid = 1; uid <= 3; ++uid) {
+    SSubmitTbData tbData = {0};
+    tbData.suid = 100;
+    tbData.uid = uid;
+    tbData.sver = 1;
+    tbData.aRowP = taosArrayInit(1, sizeof(SRow*));
+    tbData.ctimeMs = uid * 10;
+    ASSERT_NE(taosArrayPush(req.aSubmitTbData, &tbData), nullptr);
+  }
+
+  int32_t len = 0;
+  int32_t ret = 0;
+  tEncodeSize(tEncodeSubmitReq, &req, len, ret);
+  ASSERT_EQ(ret, 0);
+
+  char*    buf = (char*)taosMemoryMalloc(len);
+  SEncoder encoder = {0};
+  tEncoderInit(&encoder, (uint8_t*)buf, len);
+  ASSERT_EQ(tEncodeSubmitReq(&encoder, &req), 0);
+  tEncoderClear(&encoder);
+
+  SHashObj* pFilter = taosHashInit(4, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  int64_t   wanted = 2;
+  ASSERT_EQ(taosHashPut(pFilter, &wanted, sizeof(int64_t), NULL, 0), 0);
+
+  SSubmitReq2 filtered = {0};
+  SDecoder    decoder = {0};
+  tDecoderInit(&decoder, (uint8_t*)buf, len);
+  ASSERT_EQ(tDecodeSubmitReqWithFilter(&decoder, &filtered, pFilter), 0);
+  tDecoderClear(&decoder);
+
+  ASSERT_EQ(taosArrayGetSize(filtered.aSubmitTbData), 1);
+  SSubmitTbData* pTbData = (SSubmitTbData*)taosArrayGet(filtered.aSubmitTbData, 0);
+  ASSERT_EQ(pTbData->uid, 2);
+  ASSERT_EQ(pTbData->suid, 100);
+  ASSERT_EQ(pTbData->ctimeMs, 20);
+
+  SSubmitReq2 all = {0};
+  tDecoderInit(&decoder, (uint8_t*)buf, len);
+  ASSERT_EQ(tDecodeSubmitReq(&decoder, &all), 0);
+  tDecoderClear(&decoder);
+  ASSERT_EQ(taosArrayGetSize(all.aSubmitTbData), 3);
+
+  tDestroySubmitReq(&all, TSDB_MSG_FLG_DECODE);
+  tDestroySubmitReq(&filtered, TSDB_MSG_FLG_DECODE);
+  tDestroySubmitReq(&req, TSDB_MSG_FLG_ENCODE);
+  taosHashCleanup(pFilter);
+  taosMemoryFree(buf);
+}
+
 #define SLOW_LOG_TYPE_NULL   0x0
 #define SLOW_LOG_TYPE_QUERY  0x1
 #define SLOW_LOG_TYPE_INSERT 0x2
@@ -77,6 +77,30 @@ void vmGetVnodeLoadsLite(SVnodeMgmt *pMgmt, SMonVloadInfo *pInfo) {
   (void)taosThreadRwlockUnlock(&pMgmt->lock);
 }
 
+void vmGetWriteStat(SVnodeMgmt *pMgmt, SVnodeWriteStat *pStat) {
+  (void)taosThreadRwlockRdlock(&pMgmt->lock);
+
+  void *pIter = taosHashIterate(pMgmt->hash, NULL);
+  while (pIter) {
+    SVnodeObj **ppVnode = pIter;
+    if (ppVnode == NULL || *ppVnode == NULL) continue;
+
+    SVnodeObj *pVnode = *ppVnode;
+    if (!pVnode->failed) {
+      SVnodeWriteStat stat = {0};
+      vnodeGetWriteStat(pVnode->pImpl, &stat);
+      pStat->submitNum += stat.submitNum;
+      pStat->submitRows += stat.submitRows;
+      pStat->memtableUs += stat.memtableUs;
+      pStat->walAppendNum += stat.walAppendNum;
+      pStat->walAppendUs += stat.walAppendUs;
+    }
+    pIter = taosHashIterate(pMgmt->hash, pIter);
+  }
+
+  (void)taosThreadRwlockUnlock(&pMgmt->lock);
+}
+
 void vmGetMonitorInfo(SVnodeMgmt *pMgmt, SMonVmInfo *pInfo) {
   SMonVloadInfo vloads = {0};
   vmGetVnodeLoads(pMgmt, &vloads, true);
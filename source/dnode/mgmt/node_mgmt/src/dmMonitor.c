@@ -167,6 +167,17 @@ void dmGetVnodeLoadsLite(SMonVloadInfo *pInfo) {
   }
 }
 
+void dmGetVnodeWriteStat(struct SVnodeWriteStat *pStat) {
+  SDnode       *pDnode = dmInstance();
+  SMgmtWrapper *pWrapper = &pDnode->wrappers[VNODE];
+  if (dmMarkWrapper(pWrapper) == 0) {
+    if (pWrapper->pMgmt != NULL) {
+      vmGetWriteStat(pWrapper->pMgmt, pStat);
+    }
+    dmReleaseWrapper(pWrapper);
+  }
+}
+
 void dmGetMnodeLoads(SMonMloadInfo *pInfo) {
   SDnode       *pDnode = dmInstance();
   SMgmtWrapper *pWrapper = &pDnode->wrappers[MNODE];
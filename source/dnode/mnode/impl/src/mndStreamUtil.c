@@ -1300,24 +1300,51 @@ int32_t setTaskAttrInResBlock(SStreamObj *pStream, SStreamTask *pTask, SSDataBlo
   code = colDataSetVal(pColInfo, numOfRows, (const char *)&pe->checkpointInfo.latestVer, false);
   TSDB_CHECK_CODE(code, lino, _end);
 
-  // checkpoint size
+  // checkpoint size, the bytes shipped to the remote backup in the latest checkpoint
   pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
   TSDB_CHECK_NULL(pColInfo, code, lino, _end, terrno);
 
-  colDataSetNULL(pColInfo, numOfRows);
+  if (pe->checkpointInfo.remoteBackup != TASK_CHKPT_BACKUP__NONE) {
+    snprintf(buf, tListLen(buf), formatTotalMb, SIZE_IN_MiB(pe->checkpointInfo.latestSize));
+    memset(vbuf, 0, tListLen(vbuf));
+    STR_TO_VARSTR(vbuf, buf);
+
+    code = colDataSetVal(pColInfo, numOfRows, (const char *)vbuf, false);
+    TSDB_CHECK_CODE(code, lino, _end);
+  } else {
+    colDataSetNULL(pColInfo, numOfRows);
+  }
 
-  // checkpoint backup status
+  // checkpoint backup status, the backup type and the elapsed time of the latest checkpoint
   pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
   TSDB_CHECK_NULL(pColInfo, code, lino, _end, terrno);
 
-  code = colDataSetVal(pColInfo, numOfRows, 0, true);
+  if (pe->checkpointInfo.remoteBackup != TASK_CHKPT_BACKUP__NONE) {
+    const char *pType = (pe->checkpointInfo.remoteBackup == TASK_CHKPT_BACKUP__FULL) ? "full" : "incr";
+    snprintf(buf, tListLen(buf), "%s %.2fs", pType, pe->checkpointInfo.latestElapsed / 1000.0);
+    memset(vbuf, 0, tListLen(vbuf));
+    STR_TO_VARSTR(vbuf, buf);
+
+    code = colDataSetVal(pColInfo, numOfRows, (const char *)vbuf, false);
+  } else {
+    code = colDataSetVal(pColInfo, numOfRows, 0, true);
+  }
   TSDB_CHECK_CODE(code, lino, _end);
 
-  // ds_err_info
+  // extra info, time spent on the window state io and blocked by the async state writer
   pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
   TSDB_CHECK_NULL(pColInfo, code, lino, _end, terrno);
 
-  code = colDataSetVal(pColInfo, numOfRows, 0, true);
+  if (pe->stateIoTime > 0 || pe->stateStallTime > 0) {
+    // no more than 25 characters, the width of extra_info column
+    snprintf(buf, 25 + 1, "io:%.1fs stall:%.1fs", pe->stateIoTime / 1000000.0, pe->stateStallTime / 1000000.0);
+    memset(vbuf, 0, tListLen(vbuf));
+    STR_TO_VARSTR(vbuf, buf);
+
+    code = colDataSetVal(pColInfo, numOfRows, (const char *)vbuf, false);
+  } else {
+    code = colDataSetVal(pColInfo, numOfRows, 0, true);
+  }
   TSDB_CHECK_CODE(code, lino, _end);
 
   // history_task_id
@@ -1339,6 +1366,36 @@ int32_t setTaskAttrInResBlock(SStreamObj *pStream, SStreamTask *pTask, SSDataBlo
   code = colDataSetVal(pColInfo, numOfRows, 0, true);
   TSDB_CHECK_CODE(code, lino, _end);
 
+  // exec_batch, number of input blocks in one exec batch, no more than 32 characters
+  pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+  TSDB_CHECK_NULL(pColInfo, code, lino, _end, terrno);
+
+  if (pe->execBatchLimit > 0) {
+    snprintf(buf, 32 + 1, "avg:%.1f p99:%d lim:%d", pe->execBatchAvg, pe->execBatchP99, pe->execBatchLimit);
+    memset(vbuf, 0, tListLen(vbuf));
+    STR_TO_VARSTR(vbuf, buf);
+
+    code = colDataSetVal(pColInfo, numOfRows, (const char *)vbuf, false);
+  } else {
+    code = colDataSetVal(pColInfo, numOfRows, 0, true);
+  }
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  // exec_lag, the lag from the input queue to the exec completed, no more than 32 characters
+  pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+  TSDB_CHECK_NULL(pColInfo, code, lino, _end, terrno);
+
+  if (pe->execLagP99 > 0) {
+    snprintf(buf, 32 + 1, "p50:%" PRId64 "ms p99:%" PRId64 "ms", pe->execLagP50, pe->execLagP99);
+    memset(vbuf, 0, tListLen(vbuf));
+    STR_TO_VARSTR(vbuf, buf);
+
+    code = colDataSetVal(pColInfo, numOfRows, (const char *)vbuf, false);
+  } else {
+    code = colDataSetVal(pColInfo, numOfRows, 0, true);
+  }
+  TSDB_CHECK_CODE(code, lino, _end);
+
   _end:
   if (code) {
     mError("error happens during build task attr result blocks, lino:%d, code:%s", lino, tstrerror(code));
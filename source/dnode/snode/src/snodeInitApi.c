@@ -40,6 +40,7 @@ void initStateStoreAPI(SStateStore* pStore) {
   pStore->streamStatePut = streamStatePut;
   pStore->streamStateGet = streamStateGet;
   pStore->streamStateCheck = streamStateCheck;
+  pStore->streamStatePrefetch = streamStatePrefetch;
   pStore->streamStateGetByPos = streamStateGetByPos;
   pStore->streamStateDel = streamStateDel;
   pStore->streamStateClear = streamStateClear;
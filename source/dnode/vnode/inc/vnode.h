@@ -107,6 +107,17 @@ int32_t vnodePreProcessWriteMsg(SVnode *pVnode, SRpcMsg *pMsg);
 int32_t vnodePreprocessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg);
 
 int32_t vnodeProcessWriteMsg(SVnode *pVnode, SRpcMsg *pMsg, int64_t version, SRpcMsg *pRsp);
+
+// counters of the submit path, only updated when enableWriteStat is set
+typedef struct SVnodeWriteStat {
+  int64_t submitNum;
+  int64_t submitRows;
+  int64_t memtableUs;  // time spent inserting rows into the memtable
+  int64_t walAppendNum;
+  int64_t walAppendUs;
+} SVnodeWriteStat;
+
+void    vnodeGetWriteStat(SVnode *pVnode, SVnodeWriteStat *pStat);
 int32_t vnodeProcessSyncMsg(SVnode *pVnode, SRpcMsg *pMsg, SRpcMsg **pRsp);
 int32_t vnodeProcessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo* pInfo);
 int32_t vnodeProcessFetchMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo);
@@ -173,6 +184,7 @@ int32_t      tsdbRetrieveDataBlock2(STsdbReader *pReader, SSDataBlock **pBlock,
 int32_t      tsdbReaderReset2(STsdbReader *pReader, SQueryTableDataCond *pCond);
 int32_t      tsdbGetFileBlocksDistInfo2(STsdbReader *pReader, STableBlockDistInfo *pTableBlockInfo);
 int64_t      tsdbGetNumOfRowsInMemTable2(STsdbReader *pHandle, uint32_t *rows);
+int32_t      tsdbReaderGetFilesetKeys2(STsdbReader *pReader, SArray *pKeys);
 void        *tsdbGetIdx2(SMeta *pMeta);
 void        *tsdbGetIvtIdx2(SMeta *pMeta);
 uint64_t     tsdbGetReaderMaxVersion2(STsdbReader *pReader);
@@ -213,6 +225,7 @@ typedef struct STqReader {
   int64_t         cachedSchemaSuid;
   int64_t         cachedSchemaUid;
   SSchemaWrapper *pSchemaWrapper;
+  STSchema       *pTSchema;  // row format decoding schema of pSchemaWrapper, built on first use
   SSDataBlock    *pResBlock;
   int64_t         lastTs;
   bool            hasPrimaryKey;
@@ -465,6 +465,8 @@ struct SVnode {
   SMsgCb    msgCb;
   bool      disableWrite;
 
+  SVnodeWriteStat writeStat;
+
   // Buffer Pool
   TdThreadMutex mutex;
   TdThreadCond  poolNotEmpty;
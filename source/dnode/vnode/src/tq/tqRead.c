@@ -310,6 +310,7 @@ void tqReaderClose(STqReader* pReader) {
   if (pReader->pSchemaWrapper) {
     tDeleteSchemaWrapper(pReader->pSchemaWrapper);
   }
+  taosMemoryFreeClear(pReader->pTSchema);
 
   if (pReader->pColIdList) {
     taosArrayDestroy(pReader->pColIdList);
@@ -391,6 +392,32 @@ int32_t extractMsgFromWal(SWalReader* pReader, void** pItem, int64_t maxVer, con
   }
 }
 
+// with pUidFilter, the tables not subscribed are skipped without decoding their create req or data
+static int32_t tqReaderSetSubmitMsgImpl(STqReader* pReader, void* msgStr, int32_t msgLen, int64_t ver,
+                                        SHashObj* pUidFilter) {
+  pReader->msg.msgStr = msgStr;
+  pReader->msg.msgLen = msgLen;
+  pReader->msg.ver = ver;
+
+  tqDebug("tq reader set msg %p %d", msgStr, msgLen);
+  SDecoder decoder = {0};
+
+  tDecoderInit(&decoder, pReader->msg.msgStr, pReader->msg.msgLen);
+  int32_t code = tDecodeSubmitReqWithFilter(&decoder, &pReader->submit, pUidFilter);
+  if (code != 0) {
+    tDecoderClear(&decoder);
+    tqError("DecodeSSubmitReq2 error, msgLen:%d, ver:%" PRId64, msgLen, ver);
+    return code;
+  }
+
+  tDecoderClear(&decoder);
+  return 0;
+}
+
+int32_t tqReaderSetSubmitMsg(STqReader* pReader, void* msgStr, int32_t msgLen, int64_t ver) {
+  return tqReaderSetSubmitMsgImpl(pReader, msgStr, msgLen, ver, NULL);
+}
+
 bool tqNextBlockInWal(STqReader* pReader, const char* id, int sourceExcluded) {
   SWalReader* pWalReader = pReader->pWalReader;
 
@@ -440,33 +467,13 @@ bool tqNextBlockInWal(STqReader* pReader, const char* id, int sourceExcluded) {
     void*   pBody = POINTER_SHIFT(pWalReader->pHead->head.body, sizeof(SSubmitReq2Msg));
     int32_t bodyLen = pWalReader->pHead->head.bodyLen - sizeof(SSubmitReq2Msg);
     int64_t ver = pWalReader->pHead->head.version;
-    if (tqReaderSetSubmitMsg(pReader, pBody, bodyLen, ver) != 0) {
+    if (tqReaderSetSubmitMsgImpl(pReader, pBody, bodyLen, ver, pReader->tbIdHash) != 0) {
       return false;
     }
     pReader->nextBlk = 0;
   }
 }
 
-int32_t tqReaderSetSubmitMsg(STqReader* pReader, void* msgStr, int32_t msgLen, int64_t ver) {
-  pReader->msg.msgStr = msgStr;
-  pReader->msg.msgLen = msgLen;
-  pReader->msg.ver = ver;
-
-  tqDebug("tq reader set msg %p %d", msgStr, msgLen);
-  SDecoder decoder = {0};
-
-  tDecoderInit(&decoder, pReader->msg.msgStr, pReader->msg.msgLen);
-  int32_t code = tDecodeSubmitReq(&decoder, &pReader->submit);
-  if (code != 0) {
-    tDecoderClear(&decoder);
-    tqError("DecodeSSubmitReq2 error, msgLen:%d, ver:%" PRId64, msgLen, ver);
-    return code;
-  }
-
-  tDecoderClear(&decoder);
-  return 0;
-}
-
 SWalReader* tqGetWalReader(STqReader* pReader) { return pReader->pWalReader; }
 
 SSDataBlock* tqGetResultBlock(STqReader* pReader) { return pReader->pResBlock; }
@@ -627,7 +634,7 @@ static int32_t doSetVal(SColumnInfoData* pColumnInfoData, int32_t rowIndex, SCol
   int32_t code = TSDB_CODE_SUCCESS;
 
   if (IS_VAR_DATA_TYPE(pColVal->value.type)) {
-    char val[65535 + 2] = {0};
+    char val[65535 + 2];  // only the header and nData bytes are read back, no need to clear it per value
     if (COL_VAL_IS_VALUE(pColVal)) {
       if (pColVal->value.pData != NULL) {
         (void)memcpy(varDataVal(val), pColVal->value.pData, pColVal->value.nData);
@@ -648,7 +655,6 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
   tqTrace("tq reader retrieve data block %p, index:%d", pReader->msg.msgStr, pReader->nextBlk);
   int32_t        code = 0;
   int32_t        line = 0;
-  STSchema*      pTSchema = NULL;
   SSubmitTbData* pSubmitTbData = taosArrayGet(pReader->submit.aSubmitTbData, pReader->nextBlk++);
   TSDB_CHECK_NULL(pSubmitTbData, code, line, END, terrno);
   SSDataBlock* pBlock = pReader->pResBlock;
@@ -668,6 +674,7 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
   if ((suid != 0 && pReader->cachedSchemaSuid != suid) || (suid == 0 && pReader->cachedSchemaUid != uid) ||
       (pReader->cachedSchemaVer != sversion)) {
     tDeleteSchemaWrapper(pReader->pSchemaWrapper);
+    taosMemoryFreeClear(pReader->pTSchema);
 
     pReader->pSchemaWrapper = metaGetTableSchema(pReader->pVnodeMeta, uid, sversion, 1, NULL);
     if (pReader->pSchemaWrapper == NULL) {
@@ -746,8 +753,11 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
   } else {
     SArray*         pRows = pSubmitTbData->aRowP;
     SSchemaWrapper* pWrapper = pReader->pSchemaWrapper;
-    pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
-    TSDB_CHECK_NULL(pTSchema, code, line, END, terrno);
+    if (pReader->pTSchema == NULL) {
+      pReader->pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
+      TSDB_CHECK_NULL(pReader->pTSchema, code, line, END, terrno);
+    }
+    STSchema* pTSchema = pReader->pTSchema;
 
     for (int32_t i = 0; i < numOfRows; i++) {
       SRow* pRow = taosArrayGetP(pRows, i);
@@ -783,7 +793,6 @@ END:
   if (code != 0) {
     tqError("tqRetrieveDataBlock failed, line:%d, code:%d", line, code);
   }
-  taosMemoryFreeClear(pTSchema);
   return code;
 }
 
@@ -978,6 +987,7 @@ int32_t tqRetrieveTaosxBlock(STqReader* pReader, SArray* blocks, SArray* schemas
   pReader->lastBlkUid = uid;
 
   tDeleteSchemaWrapper(pReader->pSchemaWrapper);
+  taosMemoryFreeClear(pReader->pTSchema);
   pReader->pSchemaWrapper = metaGetTableSchema(pReader->pVnodeMeta, uid, sversion, 1, createTime);
   if (pReader->pSchemaWrapper == NULL) {
     tqWarn("vgId:%d, cannot found schema wrapper for table: suid:%" PRId64 ", version %d, possibly dropped table",
@@ -387,6 +387,7 @@ int32_t tqStreamTaskProcessDispatchReq(SStreamMeta* pMeta, SRpcMsg* pMsg) {
     pRsp->msgId = htonl(req.msgId);
     pRsp->stage = htobe64(req.stage);
     pRsp->inputStatus = TASK_OUTPUT_STATUS__NORMAL;
+    pRsp->credit = htonl(-1);
 
     int32_t len = sizeof(SMsgHead) + sizeof(SStreamDispatchRsp);
     SRpcMsg rsp = {.code = TSDB_CODE_STREAM_TASK_NOT_EXIST, .info = pMsg->info, .contLen = len, .pCont = pRspHead};
@@ -411,6 +412,13 @@ int32_t tqStreamTaskProcessDispatchRsp(SStreamMeta* pMeta, SRpcMsg* pMsg) {
   pRsp->stage = htobe64(pRsp->stage);
   pRsp->msgId = htonl(pRsp->msgId);
 
+  // the rsp from old version has no credit
+  if (pMsg->contLen >= sizeof(SMsgHead) + sizeof(SStreamDispatchRsp)) {
+    pRsp->credit = htonl(pRsp->credit);
+  } else {
+    pRsp->credit = -1;
+  }
+
   tqDebug("s-task:0x%x vgId:%d recv dispatch-rsp from 0x%x vgId:%d", pRsp->upstreamTaskId, pRsp->upstreamNodeId,
           pRsp->downstreamTaskId, pRsp->downstreamNodeId);
 
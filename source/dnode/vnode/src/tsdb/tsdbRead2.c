@@ -6760,6 +6760,53 @@ _end:
   return code;
 }
 
+int32_t tsdbReaderGetFilesetKeys2(STsdbReader* pReader, SArray* pKeys) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t lino = 0;
+  bool    acquired = false;
+
+  TSDB_CHECK_NULL(pReader, code, lino, _end, TSDB_CODE_INVALID_PARA);
+  TSDB_CHECK_NULL(pKeys, code, lino, _end, TSDB_CODE_INVALID_PARA);
+
+  taosArrayClear(pKeys);
+  code = tsdbAcquireReader(pReader);
+  TSDB_CHECK_CODE(code, lino, _end);
+  acquired = true;
+
+  if (pReader->flag == READER_STATUS_SUSPEND) {
+    code = tsdbReaderResume2(pReader);
+    TSDB_CHECK_CODE(code, lino, _end);
+  }
+
+  if (pReader->pReadSnap == NULL || pReader->pReadSnap->pfSetArray == NULL) {
+    goto _end;
+  }
+
+  // the file sets are sorted by fid, so the start keys are in ascending order
+  STimeWindow*   pWin = &pReader->info.window;
+  TFileSetArray* pArray = pReader->pReadSnap->pfSetArray;
+  for (int32_t i = 0; i < TARRAY2_SIZE(pArray); ++i) {
+    TSKEY minKey = 0, maxKey = 0;
+    tsdbFidKeyRange(pArray->data[i]->fid, pReader->pTsdb->keepCfg.days, pReader->pTsdb->keepCfg.precision, &minKey,
+                    &maxKey);
+    if (maxKey < pWin->skey || minKey > pWin->ekey) {
+      continue;
+    }
+
+    void* p = taosArrayPush(pKeys, &minKey);
+    TSDB_CHECK_NULL(p, code, lino, _end, terrno);
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  if (acquired) {
+    (void)tsdbReleaseReader(pReader);
+  }
+  return code;
+}
+
 int32_t tsdbGetTableSchema(SMeta* pMeta, int64_t uid, STSchema** pSchema, int64_t* suid) {
   SMetaReader mr = {0};
   metaReaderDoInit(&mr, pMeta, META_READER_LOCK);
@@ -57,6 +57,8 @@ void initTsdbReaderAPI(TsdReader* pReader) {
 
   pReader->tsdReaderGetDataBlockDistInfo = tsdbGetFileBlocksDistInfo2;
   pReader->tsdReaderGetNumOfInMemRows = tsdbGetNumOfRowsInMemTable2;  // todo this function should be moved away
+  pReader->tsdReaderGetFilesetKeys = tsdbReaderGetFilesetKeys2;
+  pReader->tsdReaderGetMaxVersion = tsdbGetReaderMaxVersion2;
 
   pReader->tsdSetQueryTableList = tsdbSetTableList2;
   pReader->tsdSetReaderTaskId = tsdbReaderSetId;
@@ -156,6 +158,7 @@ void initStateStoreAPI(SStateStore* pStore) {
   pStore->streamStatePut = streamStatePut;
   pStore->streamStateGet = streamStateGet;
   pStore->streamStateCheck = streamStateCheck;
+  pStore->streamStatePrefetch = streamStatePrefetch;
   pStore->streamStateGetByPos = streamStateGetByPos;
   pStore->streamStateDel = streamStateDel;
   pStore->streamStateClear = streamStateClear;
@@ -1727,6 +1727,17 @@ static int32_t vnodeRebuildSubmitReqMsg(SSubmitReq2 *pSubmitReq, void **ppMsg) {
   return code;
 }
 
+void vnodeGetWriteStat(SVnode *pVnode, SVnodeWriteStat *pStat) {
+  SWalWriteStat walStat = {0};
+  walGetWriteStat(pVnode->pWal, &walStat);
+
+  pStat->submitNum = atomic_load_64(&pVnode->writeStat.submitNum);
+  pStat->submitRows = atomic_load_64(&pVnode->writeStat.submitRows);
+  pStat->memtableUs = atomic_load_64(&pVnode->writeStat.memtableUs);
+  pStat->walAppendNum = walStat.appendNum;
+  pStat->walAppendUs = walStat.appendUs;
+}
+
 static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, int32_t len, SRpcMsg *pRsp,
                                      SRpcMsg *pOriginalMsg) {
   int32_t code = 0;
@@ -1929,7 +1940,11 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
 
     // insert data
     int32_t affectedRows;
+    int64_t memStartUs = tsEnableWriteStat ? taosGetTimestampUs() : 0;
     code = tsdbInsertTableData(pVnode->pTsdb, ver, pSubmitTbData, &affectedRows);
+    if (memStartUs > 0) {
+      (void)atomic_add_fetch_64(&pVnode->writeStat.memtableUs, taosGetTimestampUs() - memStartUs);
+    }
     if (code) goto _exit;
 
     code = metaUpdateChangeTimeWithLock(pVnode->pMeta, pSubmitTbData->uid, pSubmitTbData->ctimeMs);
@@ -1962,6 +1977,10 @@ _exit:
   (void)atomic_add_fetch_64(&pVnode->statis.nInsert, pSubmitRsp->affectedRows);
   (void)atomic_add_fetch_64(&pVnode->statis.nInsertSuccess, pSubmitRsp->affectedRows);
   (void)atomic_add_fetch_64(&pVnode->statis.nBatchInsert, 1);
+  if (tsEnableWriteStat) {
+    (void)atomic_add_fetch_64(&pVnode->writeStat.submitNum, 1);
+    (void)atomic_add_fetch_64(&pVnode->writeStat.submitRows, pSubmitRsp->affectedRows);
+  }
 
   if (tsEnableMonitor && tsMonitorFqdn[0] != 0 && tsMonitorPort != 0 && pSubmitRsp->affectedRows > 0 &&
       strlen(pOriginalMsg->info.conn.user) > 0 && tsInsertCounter != NULL) {
@@ -41,6 +41,7 @@ extern "C" {
 #define CTG_MAX_COMMAND_LEN              512
 #define CTG_DEFAULT_CACHE_MON_MSEC       5000
 #define CTG_CLEAR_CACHE_ROUND_TB_NUM     3000
+#define CTG_EPOCH_SLOT_NUM               256
 
 #define CTG_RENT_SLOT_SECOND 1.5
 
@@ -311,7 +312,7 @@ typedef STableIndexRsp STableIndex;
 typedef STableTSMAInfo STSMACache;
 
 typedef struct SCtgTbCache {
-  SRWLatch     metaLock;
+  SRWLatch     metaLock;  // serializes writers only, readers pin pMeta with ctgEnterMetaEpoch
   SRWLatch     indexLock;
   STableMeta*  pMeta;
   STableIndex* pIndex;
@@ -512,6 +513,11 @@ typedef struct SCtgRuntimeStat {
   uint64_t numOfOpDequeue;
   uint64_t numOfOpClearMeta;
   uint64_t numOfOpClearCache;
+  uint64_t numOfMetaRetired;
+  uint64_t numOfMetaReclaimed;
+  uint64_t opNum[CTG_OP_MAX];
+  uint64_t opCostUs[CTG_OP_MAX];
+  uint64_t opMaxCostUs[CTG_OP_MAX];
 } SCtgRuntimeStat;
 
 typedef struct SCatalogStat {
@@ -653,6 +659,26 @@ typedef struct SCtgQueue {
   uint64_t   qRemainNum;
 } SCtgQueue;
 
+// Table metas are read without taking metaLock: a reader is counted under the parity of the epoch it entered in,
+// and a meta replaced or dropped by the update thread is only freed once no reader of its epoch is left.
+typedef struct SCtgEpochSlot {
+  int64_t readers[2];  // active readers by epoch parity, threads may share a slot
+  char    padding[48];
+} SCtgEpochSlot;
+
+typedef struct SCtgRetiredMeta {
+  int64_t     epoch;
+  STableMeta* pMeta;
+} SCtgRetiredMeta;
+
+typedef struct SCtgEpoch {
+  int64_t       epoch;
+  int32_t       slotSeq;
+  TdThreadMutex retiredLock;
+  SArray*       pRetired;  // SArray<SCtgRetiredMeta>
+  SCtgEpochSlot slots[CTG_EPOCH_SLOT_NUM];
+} SCtgEpoch;
+
 typedef struct SCatalogMgmt {
   bool         exit;
   int32_t      jobPool;
@@ -664,6 +690,7 @@ typedef struct SCatalogMgmt {
   SHashObj*    pCluster;  // key: clusterId, value: SCatalog*
   SCatalogStat statInfo;
   SCatalogCfg  cfg;
+  SCtgEpoch    metaEpoch;
 } SCatalogMgmt;
 
 typedef uint32_t (*tableNameHashFp)(const char*, uint32_t);
@@ -1149,6 +1176,12 @@ void    ctgClearSubTaskRes(SCtgSubRes* pRes);
 void    ctgFreeQNode(SCtgQNode* node);
 void    ctgClearHandle(SCatalog* pCtg);
 void    ctgFreeTbCacheImpl(SCtgTbCache* pCache, bool lock);
+int32_t ctgInitMetaEpoch(void);
+void    ctgCleanupMetaEpoch(void);
+void    ctgEnterMetaEpoch(void);
+void    ctgLeaveMetaEpoch(void);
+void    ctgRetireTbMeta(STableMeta* pMeta);
+void    ctgReclaimTbMeta(void);
 void    ctgFreeViewCacheImpl(SCtgViewCache* pCache, bool lock);
 int32_t ctgRemoveTbMeta(SCatalog* pCtg, SName* pTableName);
 int32_t ctgRemoveCacheUser(SCatalog* pCtg, SCtgUserAuth* pUser, const char* user);
@@ -1162,9 +1195,9 @@ int32_t ctgChkSetAuthRes(SCatalog* pCtg, SCtgAuthReq* req, SCtgAuthRsp* res);
 int32_t ctgReadDBCfgFromCache(SCatalog* pCtg, const char* dbFName, SDbCfgInfo* pDbCfg);
 
 int32_t ctgAcquireVgMetaFromCache(SCatalog* pCtg, const char* dbFName, const char* tbName, SCtgDBCache** pDb,
-                                  SCtgTbCache** pTb);
-int32_t ctgCopyTbMeta(SCatalog* pCtg, SCtgTbMetaCtx* ctx, SCtgDBCache** pDb, SCtgTbCache** pTb, STableMeta** pTableMeta,
-                      char* dbFName);
+                                  SCtgTbCache** pTb, STableMeta** pMeta);
+int32_t ctgCopyTbMeta(SCatalog* pCtg, SCtgTbMetaCtx* ctx, SCtgDBCache** pDb, SCtgTbCache** pTb, STableMeta* tbMeta,
+                      STableMeta** pTableMeta, char* dbFName);
 void    ctgReleaseVgMetaToCache(SCatalog* pCtg, SCtgDBCache* dbCache, SCtgTbCache* pCache);
 void    ctgReleaseTbMetaToCache(SCatalog* pCtg, SCtgDBCache* dbCache, SCtgTbCache* pCache);
 void    ctgGetGlobalCacheStat(SCtgCacheStat* pStat);
@@ -1217,6 +1250,7 @@ extern SCatalogMgmt      gCtgMgmt;
 extern SCtgDebug         gCTGDebug;
 extern SCtgAsyncFps      gCtgAsyncFps[];
 extern SCtgCacheItemInfo gCtgStatItem[CTG_CI_MAX_VALUE];
+extern SCtgOperation     gCtgCacheOperation[CTG_OP_MAX];
 
 #ifdef __cplusplus
 }
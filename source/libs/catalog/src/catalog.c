@@ -625,8 +625,9 @@ int32_t ctgGetCachedTbVgMeta(SCatalog* pCtg, const SName* pTableName, SVgroupInf
   (void)tNameGetFullDbName(pTableName, db);
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
+  STableMeta  *tbMeta = NULL;
 
-  CTG_ERR_RET(ctgAcquireVgMetaFromCache(pCtg, db, pTableName->tname, &dbCache, &tbCache));
+  CTG_ERR_RET(ctgAcquireVgMetaFromCache(pCtg, db, pTableName->tname, &dbCache, &tbCache, &tbMeta));
 
   if (NULL == dbCache || NULL == tbCache) {
     *pTableMeta = NULL;
@@ -640,7 +641,7 @@ int32_t ctgGetCachedTbVgMeta(SCatalog* pCtg, const SName* pTableName, SVgroupInf
   SCtgTbMetaCtx ctx = {0};
   ctx.pName = (SName*)pTableName;
   ctx.flag = CTG_FLAG_UNKNOWN_STB;
-  code = ctgCopyTbMeta(pCtg, &ctx, &dbCache, &tbCache, pTableMeta, db);
+  code = ctgCopyTbMeta(pCtg, &ctx, &dbCache, &tbCache, tbMeta, pTableMeta, db);
 
   ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
 
@@ -698,6 +699,9 @@ void ctgProcessTimerEvent(void *param, void *tmrId) {
   (void)ctgdShowCacheInfo();
   (void)ctgdShowStatInfo();
 
+  // reclaiming otherwise only runs after cache updates
+  ctgReclaimTbMeta();
+
   int32_t cacheMaxSize = atomic_load_32(&tsMetaCacheMaxSize);
   if (cacheMaxSize >= 0) {
     uint64_t cacheSize = 0;
@@ -868,6 +872,8 @@ int32_t catalogInit(SCatalogCfg* cfg) {
   }
   gCtgMgmt.queue.tail = gCtgMgmt.queue.head;
 
+  CTG_ERR_RET(ctgInitMetaEpoch());
+
   gCtgMgmt.jobPool = taosOpenRef(200, ctgFreeJob);
   if (gCtgMgmt.jobPool < 0) {
     qError("taosOpenRef failed, error:%s", tstrerror(terrno));
@@ -1008,6 +1014,27 @@ _return:
   CTG_API_LEAVE(code);
 }
 
+int32_t catalogGetDBCfgVersion(SCatalog* pCtg, const char* dbFName, int32_t* pCfgVersion) {
+  CTG_API_ENTER();
+
+  if (NULL == pCtg || NULL == dbFName || NULL == pCfgVersion) {
+    CTG_API_LEAVE(TSDB_CODE_CTG_INVALID_INPUT);
+  }
+
+  SDbCfgInfo cfgInfo = {0};
+  int32_t    code = 0;
+
+  CTG_ERR_JRET(ctgReadDBCfgFromCache(pCtg, dbFName, &cfgInfo));
+  *pCfgVersion = cfgInfo.cfgVersion;
+  tFreeSDbCfgRsp(&cfgInfo);
+
+  ctgDebug("Got db cfgVersion from cache, dbFName:%s, cfgVersion:%d", dbFName, *pCfgVersion);
+
+_return:
+
+  CTG_API_LEAVE(code);
+}
+
 int32_t catalogGetDBVgList(SCatalog* pCtg, SRequestConnInfo* pConn, const char* dbFName, SArray** vgroupList) {
   CTG_API_ENTER();
 
@@ -1994,6 +2021,7 @@ void catalogDestroy(void) {
   if (!taosCheckCurrentInDll()) {
     (void)ctgClearCacheEnqueue(NULL, false, true, true, true);
     (void)taosThreadJoin(gCtgMgmt.updateThread, NULL);
+    ctgCleanupMetaEpoch();
   }
 
   taosHashCleanup(gCtgMgmt.pCluster);
@@ -169,7 +169,7 @@ void ctgReleaseVgInfoToCache(SCatalog *pCtg, SCtgDBCache *dbCache) {
 
 void ctgReleaseTbMetaToCache(SCatalog *pCtg, SCtgDBCache *dbCache, SCtgTbCache *pCache) {
   if (pCache && dbCache) {
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+    ctgLeaveMetaEpoch();
     taosHashRelease(dbCache->tbCache, pCache);
   }
 
@@ -203,7 +203,7 @@ void ctgReleaseTbIndexToCache(SCatalog *pCtg, SCtgDBCache *dbCache, SCtgTbCache
 
 void ctgReleaseVgMetaToCache(SCatalog *pCtg, SCtgDBCache *dbCache, SCtgTbCache *pCache) {
   if (pCache && dbCache) {
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+    ctgLeaveMetaEpoch();
     taosHashRelease(dbCache->tbCache, pCache);
   }
 
@@ -261,9 +261,11 @@ _return:
   return code;
 }
 
-int32_t ctgAcquireTbMetaFromCache(SCatalog *pCtg, const char *dbFName, const char *tbName, SCtgDBCache **pDb, SCtgTbCache **pTb) {
+int32_t ctgAcquireTbMetaFromCache(SCatalog *pCtg, const char *dbFName, const char *tbName, SCtgDBCache **pDb,
+                                  SCtgTbCache **pTb, STableMeta **pMeta) {
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *pCache = NULL;
+  STableMeta  *tbMeta = NULL;
   int32_t code = TSDB_CODE_SUCCESS;
   
   CTG_ERR_JRET(ctgAcquireDBCache(pCtg, dbFName, &dbCache));
@@ -278,18 +280,20 @@ int32_t ctgAcquireTbMetaFromCache(SCatalog *pCtg, const char *dbFName, const cha
     goto _return;
   }
 
-  CTG_LOCK(CTG_READ, &pCache->metaLock);
-  if (NULL == pCache->pMeta) {
+  ctgEnterMetaEpoch();
+  tbMeta = (STableMeta *)atomic_load_ptr(&pCache->pMeta);
+  if (NULL == tbMeta) {
     ctgDebug("tb %s meta not in cache, dbFName:%s", tbName, dbFName);
     goto _return;
   }
 
   *pDb = dbCache;
   *pTb = pCache;
+  *pMeta = tbMeta;
 
   ctgDebug("tb %s meta got in cache, dbFName:%s", tbName, dbFName);
 
-  CTG_META_HIT_INC(pCache->pMeta->tableType);
+  CTG_META_HIT_INC(tbMeta->tableType);
 
   return TSDB_CODE_SUCCESS;
 
@@ -303,9 +307,10 @@ _return:
 }
 
 int32_t ctgAcquireVgMetaFromCache(SCatalog *pCtg, const char *dbFName, const char *tbName, SCtgDBCache **pDb,
-                                  SCtgTbCache **pTb) {
+                                  SCtgTbCache **pTb, STableMeta **pMeta) {
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
+  STableMeta  *tbMeta = NULL;
   bool         vgInCache = false;
   int32_t      code = TSDB_CODE_SUCCESS;
 
@@ -336,25 +341,27 @@ int32_t ctgAcquireVgMetaFromCache(SCatalog *pCtg, const char *dbFName, const cha
     goto _return;
   }
 
-  CTG_LOCK(CTG_READ, &tbCache->metaLock);
-  if (NULL == tbCache->pMeta) {
+  ctgEnterMetaEpoch();
+  tbMeta = (STableMeta *)atomic_load_ptr(&tbCache->pMeta);
+  if (NULL == tbMeta) {
     ctgDebug("tb %s meta not in cache, dbFName:%s", tbName, dbFName);
     CTG_META_NHIT_INC();
     goto _return;
   }
 
   *pTb = tbCache;
+  *pMeta = tbMeta;
 
   ctgDebug("tb %s meta got in cache, dbFName:%s", tbName, dbFName);
 
-  CTG_META_HIT_INC(tbCache->pMeta->tableType);
+  CTG_META_HIT_INC(tbMeta->tableType);
 
   return TSDB_CODE_SUCCESS;
 
 _return:
 
   if (tbCache) {
-    CTG_UNLOCK(CTG_READ, &tbCache->metaLock);
+    ctgLeaveMetaEpoch();
     taosHashRelease(dbCache->tbCache, tbCache);
   }
 
@@ -368,6 +375,7 @@ _return:
 
   *pDb = NULL;
   *pTb = NULL;
+  *pMeta = NULL;
 
   return TSDB_CODE_SUCCESS;
 }
@@ -397,7 +405,7 @@ int32_t ctgAcquireStbMetaFromCache(SCatalog *pCtg, char *dbFName, uint64_t suid,
 
   taosHashRelease(dbCache->stbCache, stName);
 
-  CTG_LOCK(CTG_READ, &pCache->metaLock);
+  ctgEnterMetaEpoch();
   if (NULL == pCache->pMeta) {
     ctgDebug("stb 0x%" PRIx64 " meta not in cache, dbFName:%s", suid, dbFName);
     goto _return;
@@ -426,8 +434,9 @@ _return:
 */
 
 int32_t ctgAcquireStbMetaFromCache(SCtgDBCache *dbCache, SCatalog *pCtg, char *dbFName, uint64_t suid,
-                                   SCtgTbCache **pTb) {
+                                   SCtgTbCache **pTb, STableMeta **pMeta) {
   SCtgTbCache *pCache = NULL;
+  STableMeta  *stbMeta = NULL;
   char        *stName = taosHashAcquire(dbCache->stbCache, &suid, sizeof(suid));
   if (NULL == stName) {
     ctgDebug("stb 0x%" PRIx64 " not in cache, dbFName:%s", suid, dbFName);
@@ -443,17 +452,19 @@ int32_t ctgAcquireStbMetaFromCache(SCtgDBCache *dbCache, SCatalog *pCtg, char *d
 
   taosHashRelease(dbCache->stbCache, stName);
 
-  CTG_LOCK(CTG_READ, &pCache->metaLock);
-  if (NULL == pCache->pMeta) {
+  ctgEnterMetaEpoch();
+  stbMeta = (STableMeta *)atomic_load_ptr(&pCache->pMeta);
+  if (NULL == stbMeta) {
     ctgDebug("stb 0x%" PRIx64 " meta not in cache, dbFName:%s", suid, dbFName);
     goto _return;
   }
 
   *pTb = pCache;
+  *pMeta = stbMeta;
 
   ctgDebug("stb 0x%" PRIx64 " meta got in cache, dbFName:%s", suid, dbFName);
 
-  CTG_META_HIT_INC(pCache->pMeta->tableType);
+  CTG_META_HIT_INC(stbMeta->tableType);
 
   return TSDB_CODE_SUCCESS;
 
@@ -464,6 +475,7 @@ _return:
   CTG_META_NHIT_INC();
 
   *pTb = NULL;
+  *pMeta = NULL;
 
   return TSDB_CODE_SUCCESS;
 }
@@ -513,8 +525,9 @@ _return:
 int32_t ctgTbMetaExistInCache(SCatalog *pCtg, const char *dbFName, const char *tbName, int32_t *exist) {
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
+  STableMeta  *tbMeta = NULL;
   
-  CTG_ERR_RET(ctgAcquireTbMetaFromCache(pCtg, dbFName, tbName, &dbCache, &tbCache));
+  CTG_ERR_RET(ctgAcquireTbMetaFromCache(pCtg, dbFName, tbName, &dbCache, &tbCache, &tbMeta));
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
 
@@ -528,11 +541,11 @@ int32_t ctgTbMetaExistInCache(SCatalog *pCtg, const char *dbFName, const char *t
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t ctgCopyTbMeta(SCatalog *pCtg, SCtgTbMetaCtx *ctx, SCtgDBCache **pDb, SCtgTbCache **pTb, STableMeta **pTableMeta,
-                      char *dbFName) {
+int32_t ctgCopyTbMeta(SCatalog *pCtg, SCtgTbMetaCtx *ctx, SCtgDBCache **pDb, SCtgTbCache **pTb, STableMeta *tbMeta,
+                      STableMeta **pTableMeta, char *dbFName) {
   SCtgDBCache *dbCache = *pDb;
   SCtgTbCache *tbCache = *pTb;
-  STableMeta  *tbMeta = tbCache->pMeta;
+  STableMeta  *stbMeta = NULL;
   ctx->tbInfo.inCache = true;
   ctx->tbInfo.dbId = dbCache->dbId;
   ctx->tbInfo.suid = tbMeta->suid;
@@ -573,14 +586,14 @@ int32_t ctgCopyTbMeta(SCatalog *pCtg, SCtgTbMetaCtx *ctx, SCtgDBCache **pDb, SCt
 
   // ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
 
-  CTG_UNLOCK(CTG_READ, &tbCache->metaLock);
+  ctgLeaveMetaEpoch();
   taosHashRelease(dbCache->tbCache, tbCache);
   *pTb = NULL;
 
   ctgDebug("Got ctb %s meta from cache, will continue to get its stb meta, type:%d, dbFName:%s", ctx->pName->tname,
            ctx->tbInfo.tbType, dbFName);
 
-  CTG_ERR_RET(ctgAcquireStbMetaFromCache(dbCache, pCtg, dbFName, ctx->tbInfo.suid, &tbCache));
+  CTG_ERR_RET(ctgAcquireStbMetaFromCache(dbCache, pCtg, dbFName, ctx->tbInfo.suid, &tbCache, &stbMeta));
   if (NULL == tbCache) {
     taosMemoryFreeClear(*pTableMeta);
     *pDb = NULL;
@@ -590,7 +603,6 @@ int32_t ctgCopyTbMeta(SCatalog *pCtg, SCtgTbMetaCtx *ctx, SCtgDBCache **pDb, SCt
 
   *pTb = tbCache;
 
-  STableMeta *stbMeta = tbCache->pMeta;
   if (stbMeta->suid != ctx->tbInfo.suid) {
     ctgError("stb suid 0x%" PRIx64 " in stbCache mis-match, expected suid 0x%" PRIx64, stbMeta->suid, ctx->tbInfo.suid);
     taosMemoryFreeClear(*pTableMeta);
@@ -613,6 +625,7 @@ int32_t ctgReadTbMetaFromCache(SCatalog *pCtg, SCtgTbMetaCtx *ctx, STableMeta **
   int32_t      code = 0;
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
+  STableMeta  *tbMeta = NULL;
   *pTableMeta = NULL;
 
   char dbFName[TSDB_DB_FNAME_LEN] = {0};
@@ -622,13 +635,13 @@ int32_t ctgReadTbMetaFromCache(SCatalog *pCtg, SCtgTbMetaCtx *ctx, STableMeta **
     (void)tNameGetFullDbName(ctx->pName, dbFName);
   }
 
-  CTG_ERR_JRET(ctgAcquireTbMetaFromCache(pCtg, dbFName, ctx->pName->tname, &dbCache, &tbCache));
+  CTG_ERR_JRET(ctgAcquireTbMetaFromCache(pCtg, dbFName, ctx->pName->tname, &dbCache, &tbCache, &tbMeta));
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     return TSDB_CODE_SUCCESS;
   }
 
-  CTG_ERR_JRET(ctgCopyTbMeta(pCtg, ctx, &dbCache, &tbCache, pTableMeta, dbFName));
+  CTG_ERR_JRET(ctgCopyTbMeta(pCtg, ctx, &dbCache, &tbCache, tbMeta, pTableMeta, dbFName));
 
   ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
 
@@ -652,16 +665,16 @@ int32_t ctgReadTbVerFromCache(SCatalog *pCtg, SName *pTableName, int32_t *sver,
 
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
+  STableMeta  *tbMeta = NULL;
   char         dbFName[TSDB_DB_FNAME_LEN] = {0};
   (void)tNameGetFullDbName(pTableName, dbFName);
 
-  CTG_ERR_RET(ctgAcquireTbMetaFromCache(pCtg, dbFName, pTableName->tname, &dbCache, &tbCache));
+  CTG_ERR_RET(ctgAcquireTbMetaFromCache(pCtg, dbFName, pTableName->tname, &dbCache, &tbCache, &tbMeta));
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     return TSDB_CODE_SUCCESS;
   }
 
-  STableMeta *tbMeta = tbCache->pMeta;
   *tbType = tbMeta->tableType;
   *suid = tbMeta->suid;
 
@@ -680,20 +693,20 @@ int32_t ctgReadTbVerFromCache(SCatalog *pCtg, SName *pTableName, int32_t *sver,
 
   // ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
   if (tbCache) {
-    CTG_UNLOCK(CTG_READ, &tbCache->metaLock);
+    ctgLeaveMetaEpoch();
     taosHashRelease(dbCache->tbCache, tbCache);
   }
 
   ctgDebug("Got ctb %s ver from cache, will continue to get its stb ver, dbFName:%s", pTableName->tname, dbFName);
 
-  CTG_ERR_RET(ctgAcquireStbMetaFromCache(dbCache, pCtg, dbFName, *suid, &tbCache));
+  STableMeta *stbMeta = NULL;
+  CTG_ERR_RET(ctgAcquireStbMetaFromCache(dbCache, pCtg, dbFName, *suid, &tbCache, &stbMeta));
   if (NULL == tbCache) {
     // ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     ctgDebug("stb 0x%" PRIx64 " meta not in cache", *suid);
     return TSDB_CODE_SUCCESS;
   }
 
-  STableMeta *stbMeta = tbCache->pMeta;
   if (stbMeta->suid != *suid) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     ctgError("stb suid 0x%" PRIx64 " in stbCache mis-match, expected suid:0x%" PRIx64, stbMeta->suid, *suid);
@@ -720,13 +733,14 @@ int32_t ctgReadTbVerFromCache(SCatalog *pCtg, SName *pTableName, int32_t *sver,
 int32_t ctgReadTbTypeFromCache(SCatalog *pCtg, char *dbFName, char *tbName, int32_t *tbType) {
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
-  CTG_ERR_RET(ctgAcquireTbMetaFromCache(pCtg, dbFName, tbName, &dbCache, &tbCache));
+  STableMeta  *tbMeta = NULL;
+  CTG_ERR_RET(ctgAcquireTbMetaFromCache(pCtg, dbFName, tbName, &dbCache, &tbCache, &tbMeta));
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     return TSDB_CODE_SUCCESS;
   }
 
-  *tbType = tbCache->pMeta->tableType;
+  *tbType = tbMeta->tableType;
   ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
 
   ctgDebug("Got tb %s tbType %d from cache, dbFName:%s", tbName, *tbType, dbFName);
@@ -1874,10 +1888,14 @@ int32_t ctgWriteTbMetaToCache(SCatalog *pCtg, SCtgDBCache *dbCache, char *dbFNam
 
     (void)atomic_add_fetch_64(&dbCache->dbCacheSize, ctgGetTbMetaCacheSize(meta) - ctgGetTbMetaCacheSize(pCache->pMeta));
 
-    taosMemoryFree(pCache->pMeta);
-    pCache->pMeta = meta;
+    STableMeta *pOld = pCache->pMeta;
+    atomic_store_ptr(&pCache->pMeta, meta);
     
     CTG_UNLOCK(CTG_WRITE, &pCache->metaLock);
+
+    if (pOld) {
+      ctgRetireTbMeta(pOld);
+    }
   }
 
   CTG_META_NUM_INC(pCache->pMeta->tableType);
@@ -3280,7 +3298,19 @@ void *ctgUpdateThreadFunc(void *param) {
 
     ctgDebug("process [%s] operation", gCtgCacheOperation[operation->opId].name);
 
-    (void)(*gCtgCacheOperation[operation->opId].func)(operation); // ignore any error
+    int32_t opId = operation->opId;
+    int64_t startTs = taosGetTimestampUs();
+
+    (void)(*gCtgCacheOperation[opId].func)(operation); // ignore any error
+
+    uint64_t costUs = (uint64_t)(taosGetTimestampUs() - startTs);
+    CTG_STAT_RT_INC(opNum[opId], 1);
+    CTG_STAT_RT_INC(opCostUs[opId], costUs);
+    if (costUs > gCtgMgmt.statInfo.runtime.opMaxCostUs[opId]) {
+      gCtgMgmt.statInfo.runtime.opMaxCostUs[opId] = costUs;
+    }
+
+    ctgReclaimTbMeta();
 
     if (operation->syncOp) {
       code = tsem_post(&operation->rspSem);
@@ -3463,9 +3493,10 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       continue;
     }
 
-    CTG_LOCK(CTG_READ, &pCache->metaLock);
-    if (NULL == pCache->pMeta) {
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+    ctgEnterMetaEpoch();
+    STableMeta *tbMeta = (STableMeta *)atomic_load_ptr(&pCache->pMeta);
+    if (NULL == tbMeta) {
+      ctgLeaveMetaEpoch();
       taosHashRelease(dbCache->tbCache, pCache);
       
       ctgDebug("tb %s meta not in cache, dbFName:%s", pName->tname, dbFName);
@@ -3480,8 +3511,6 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       continue;
     }
 
-    STableMeta *tbMeta = pCache->pMeta;
-
     CTG_META_HIT_INC(tbMeta->tableType);
 
     SCtgTbMetaCtx nctx = {0};
@@ -3514,7 +3543,7 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
         pTableMeta->schemaExt = NULL;
       }
 
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+      ctgLeaveMetaEpoch();
       taosHashRelease(dbCache->tbCache, pCache);
 
       ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", pName->tname, pTableMeta->tableType, dbFName);
@@ -3532,14 +3561,14 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
     if (lastSuid && tbMeta->suid == lastSuid && lastTableMeta) {
       code = cloneTableMeta(lastTableMeta, &pTableMeta);
       if (code) {
-        CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+        ctgLeaveMetaEpoch();
         taosHashRelease(dbCache->tbCache, pCache);
         CTG_ERR_JRET(code);
       }
       
       TAOS_MEMCPY(pTableMeta, tbMeta, sizeof(SCTableMeta));
 
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+      ctgLeaveMetaEpoch();
       taosHashRelease(dbCache->tbCache, pCache);
 
       ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", pName->tname, pTableMeta->tableType, dbFName);
@@ -3561,7 +3590,7 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
     TAOS_MEMCPY(pTableMeta, tbMeta, metaSize);
 
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+    ctgLeaveMetaEpoch();
     taosHashRelease(dbCache->tbCache, pCache);
 
     ctgDebug("Got ctb %s meta from cache, will continue to get its stb meta, type:%d, dbFName:%s", pName->tname,
@@ -3598,10 +3627,11 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
     taosHashRelease(dbCache->stbCache, stName);
 
-    CTG_LOCK(CTG_READ, &pCache->metaLock);
-    if (NULL == pCache->pMeta) {
+    ctgEnterMetaEpoch();
+    STableMeta *stbMeta = (STableMeta *)atomic_load_ptr(&pCache->pMeta);
+    if (NULL == stbMeta) {
       ctgDebug("stb 0x%" PRIx64 " meta not in cache, dbFName:%s", pTableMeta->suid, dbFName);
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+      ctgLeaveMetaEpoch();
       taosHashRelease(dbCache->tbCache, pCache);
 
       CTG_ERR_JRET(ctgAddFetch(&ctx->pFetchs, dbIdx, i, fetchIdx, baseResIdx + i, flag));
@@ -3615,9 +3645,8 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       continue;
     }
 
-    STableMeta *stbMeta = pCache->pMeta;
     if (stbMeta->suid != nctx.tbInfo.suid) {
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+      ctgLeaveMetaEpoch();
       taosHashRelease(dbCache->tbCache, pCache);
 
       ctgError("stb suid 0x%" PRIx64 " in stbCache mis-match, expected suid 0x%" PRIx64, stbMeta->suid,
@@ -3652,7 +3681,7 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       pTableMeta->schemaExt = NULL;
     }
 
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+    ctgLeaveMetaEpoch();
     taosHashRelease(dbCache->tbCache, pCache);
 
     CTG_META_HIT_INC(pTableMeta->tableType);
@@ -3947,9 +3976,10 @@ int32_t ctgGetTbTSMAFromCache(SCatalog* pCtg, SCtgTbTSMACtx* pCtx, int32_t dbIdx
       continue;
     }
     
-    CTG_LOCK(CTG_READ, &pTbCache->metaLock);
-    if (!pTbCache->pMeta) {
-      CTG_UNLOCK(CTG_READ, &pTbCache->metaLock);
+    ctgEnterMetaEpoch();
+    STableMeta *pTbMeta = (STableMeta *)atomic_load_ptr(&pTbCache->pMeta);
+    if (!pTbMeta) {
+      ctgLeaveMetaEpoch();
       ctgDebug("tb: %s.%s not in cache", dbFName, pName->tname);
       
       CTG_ERR_JRET(ctgAddTSMAFetch(&pCtx->pFetches, dbIdx, i, fetchIdx, baseResIdx + i, flag, FETCH_TSMA_SOURCE_TB_META, NULL));
@@ -3961,9 +3991,9 @@ int32_t ctgGetTbTSMAFromCache(SCatalog* pCtg, SCtgTbTSMACtx* pCtx, int32_t dbIdx
       
       continue;
     }
-    uint64_t suid = pTbCache->pMeta->suid;
-    int8_t   tbType = pTbCache->pMeta->tableType;
-    CTG_UNLOCK(CTG_READ, &pTbCache->metaLock);
+    uint64_t suid = pTbMeta->suid;
+    int8_t   tbType = pTbMeta->tableType;
+    ctgLeaveMetaEpoch();
     
     taosHashRelease(dbCache->tbCache, pTbCache);
     SName tsmaSourceTbName = *pName;
@@ -579,13 +579,31 @@ int32_t ctgdShowStatInfo(void) {
   ctgGetGlobalCacheSize(&cacheSize);
 
   qDebug("## Global Stat Info %s ##", "begin");
-  qDebug("##            \t%s \t%s \t%s ##", "Num", "Hit", "Nhit");
+  qDebug("##            \t%s \t%s \t%s \t%s ##", "Num", "Hit", "Nhit", "HitRate");
   for (int32_t i = 0; i < CTG_CI_MAX_VALUE; ++i) {
-    qDebug("#  %s \t%" PRIu64 " \t%" PRIu64 " \t%" PRIu64 " #", gCtgStatItem[i].name, cache.cacheNum[i], cache.cacheHit[i], cache.cacheNHit[i]);
+    uint64_t total = cache.cacheHit[i] + cache.cacheNHit[i];
+    double   hitRate = total ? (double)cache.cacheHit[i] * 100 / total : 0;
+    qDebug("#  %s \t%" PRIu64 " \t%" PRIu64 " \t%" PRIu64 " \t%.2f%% #", gCtgStatItem[i].name, cache.cacheNum[i],
+           cache.cacheHit[i], cache.cacheNHit[i], hitRate);
   }
   qDebug("## Global Stat Info %s ##", "end");
   qDebug("## Global Cache Size: %" PRIu64, cacheSize);
 
+  SCtgRuntimeStat *pRt = &gCtgMgmt.statInfo.runtime;
+  qDebug("## Update Stat Info %s ##", "begin");
+  qDebug("##            \t%s \t%s \t%s ##", "Num", "AvgUs", "MaxUs");
+  for (int32_t i = 0; i < CTG_OP_MAX; ++i) {
+    uint64_t opNum = atomic_load_64((int64_t *)&pRt->opNum[i]);
+    if (0 == opNum) {
+      continue;
+    }
+    qDebug("#  %s \t%" PRIu64 " \t%" PRIu64 " \t%" PRIu64 " #", gCtgCacheOperation[i].name, opNum,
+           atomic_load_64((int64_t *)&pRt->opCostUs[i]) / opNum, pRt->opMaxCostUs[i]);
+  }
+  qDebug("## Update Stat Info %s ##", "end");
+  qDebug("## Meta Retired: %" PRIu64 ", Reclaimed: %" PRIu64, atomic_load_64((int64_t *)&pRt->numOfMetaRetired),
+         atomic_load_64((int64_t *)&pRt->numOfMetaReclaimed));
+
   CTG_API_LEAVE(TSDB_CODE_SUCCESS);
 }
 
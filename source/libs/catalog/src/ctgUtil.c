@@ -245,15 +245,166 @@ void ctgFreeStbMetaCache(SCtgDBCache* dbCache) {
   dbCache->stbCache = NULL;
 }
 
+static threadlocal int32_t ctgEpochSlotIdx = -1;
+static threadlocal int32_t ctgEpochDepth = 0;
+static threadlocal int32_t ctgEpochParity = 0;
+
+int32_t ctgInitMetaEpoch(void) {
+  SCtgEpoch* pEpoch = &gCtgMgmt.metaEpoch;
+
+  pEpoch->epoch = 1;
+  if (taosThreadMutexInit(&pEpoch->retiredLock, NULL)) {
+    qError("init catalog epoch mutex failed, error:%s", tstrerror(terrno));
+    CTG_ERR_RET(TSDB_CODE_CTG_SYS_ERROR);
+  }
+
+  pEpoch->pRetired = taosArrayInit(64, sizeof(SCtgRetiredMeta));
+  if (NULL == pEpoch->pRetired) {
+    qError("taosArrayInit %d retired meta failed", 64);
+    CTG_ERR_RET(terrno);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+void ctgCleanupMetaEpoch(void) {
+  SCtgEpoch* pEpoch = &gCtgMgmt.metaEpoch;
+  if (NULL == pEpoch->pRetired) {
+    return;
+  }
+
+  int32_t num = taosArrayGetSize(pEpoch->pRetired);
+  for (int32_t i = 0; i < num; ++i) {
+    SCtgRetiredMeta* pRetired = taosArrayGet(pEpoch->pRetired, i);
+    taosMemoryFree(pRetired->pMeta);
+  }
+
+  taosArrayDestroy(pEpoch->pRetired);
+  pEpoch->pRetired = NULL;
+  (void)taosThreadMutexDestroy(&pEpoch->retiredLock);
+}
+
+// A reader is counted under the parity of the epoch it entered in. The counter is re-checked against the epoch
+// after being raised, so a reader never counts under a parity the epoch has already moved away from.
+void ctgEnterMetaEpoch(void) {
+  if (ctgEpochDepth++ > 0) {
+    return;
+  }
+
+  SCtgEpoch* pEpoch = &gCtgMgmt.metaEpoch;
+  if (ctgEpochSlotIdx < 0) {
+    ctgEpochSlotIdx = (int32_t)((uint32_t)atomic_fetch_add_32(&pEpoch->slotSeq, 1) % CTG_EPOCH_SLOT_NUM);
+  }
+
+  SCtgEpochSlot* pSlot = &pEpoch->slots[ctgEpochSlotIdx];
+  while (true) {
+    int64_t epoch = atomic_load_64(&pEpoch->epoch);
+    int32_t parity = (int32_t)(epoch & 1);
+    (void)atomic_add_fetch_64(&pSlot->readers[parity], 1);
+    if (atomic_load_64(&pEpoch->epoch) == epoch) {
+      ctgEpochParity = parity;
+      break;
+    }
+    (void)atomic_sub_fetch_64(&pSlot->readers[parity], 1);
+  }
+}
+
+void ctgLeaveMetaEpoch(void) {
+  if (--ctgEpochDepth > 0) {
+    return;
+  }
+
+  (void)atomic_sub_fetch_64(&gCtgMgmt.metaEpoch.slots[ctgEpochSlotIdx].readers[ctgEpochParity], 1);
+}
+
+// The epoch moves on only when no reader is left in the previous one, so active readers are always in the current
+// epoch or the one before it. Must be called with retiredLock held.
+static int64_t ctgTryAdvanceMetaEpoch(void) {
+  SCtgEpoch* pEpoch = &gCtgMgmt.metaEpoch;
+  int64_t    epoch = atomic_load_64(&pEpoch->epoch);
+  int32_t    prevParity = (int32_t)((epoch - 1) & 1);
+
+  for (int32_t i = 0; i < CTG_EPOCH_SLOT_NUM; ++i) {
+    if (atomic_load_64(&pEpoch->slots[i].readers[prevParity]) > 0) {
+      return epoch;
+    }
+  }
+
+  return atomic_add_fetch_64(&pEpoch->epoch, 1);
+}
+
+// Must be called after pMeta has been unlinked from its SCtgTbCache.
+void ctgRetireTbMeta(STableMeta* pMeta) {
+  SCtgEpoch*      pEpoch = &gCtgMgmt.metaEpoch;
+  SCtgRetiredMeta retired = {.pMeta = pMeta};
+
+  (void)taosThreadMutexLock(&pEpoch->retiredLock);
+  retired.epoch = atomic_load_64(&pEpoch->epoch);
+  if (NULL == taosArrayPush(pEpoch->pRetired, &retired)) {
+    // no room to defer, wait until no reader that may still see the meta is left
+    while (ctgTryAdvanceMetaEpoch() < retired.epoch + 2) {
+      (void)taosThreadMutexUnlock(&pEpoch->retiredLock);
+      taosUsleep(1);
+      (void)taosThreadMutexLock(&pEpoch->retiredLock);
+    }
+    (void)taosThreadMutexUnlock(&pEpoch->retiredLock);
+    taosMemoryFree(pMeta);
+    return;
+  }
+  (void)taosThreadMutexUnlock(&pEpoch->retiredLock);
+
+  CTG_STAT_RT_INC(numOfMetaRetired, 1);
+}
+
+void ctgReclaimTbMeta(void) {
+  SCtgEpoch* pEpoch = &gCtgMgmt.metaEpoch;
+
+  (void)taosThreadMutexLock(&pEpoch->retiredLock);
+  int32_t num = taosArrayGetSize(pEpoch->pRetired);
+  if (num <= 0) {
+    (void)taosThreadMutexUnlock(&pEpoch->retiredLock);
+    return;
+  }
+
+  // a second step only succeeds when the readers of the epoch just left are gone too
+  (void)ctgTryAdvanceMetaEpoch();
+  int64_t epoch = ctgTryAdvanceMetaEpoch();
+
+  // retired metas are in epoch order, one retired in epoch e may be seen by readers of epoch e at most
+  int32_t freeNum = 0;
+  for (; freeNum < num; ++freeNum) {
+    SCtgRetiredMeta* pRetired = taosArrayGet(pEpoch->pRetired, freeNum);
+    if (pRetired->epoch > epoch - 2) {
+      break;
+    }
+    taosMemoryFree(pRetired->pMeta);
+  }
+
+  if (freeNum > 0) {
+    taosArrayPopFrontBatch(pEpoch->pRetired, freeNum);
+  }
+  (void)taosThreadMutexUnlock(&pEpoch->retiredLock);
+
+  CTG_STAT_RT_INC(numOfMetaReclaimed, freeNum);
+}
+
 void ctgFreeTbCacheImpl(SCtgTbCache* pCache, bool lock) {
   if (pCache->pMeta) {
+    // readers may still hold the meta without any lock, let it go through epoch reclamation
     if (lock) {
       CTG_LOCK(CTG_WRITE, &pCache->metaLock);
     }
-    taosMemoryFreeClear(pCache->pMeta);
+    STableMeta* pMeta = pCache->pMeta;
+    atomic_store_ptr(&pCache->pMeta, NULL);
     if (lock) {
       CTG_UNLOCK(CTG_WRITE, &pCache->metaLock);
     }
+    // the epoch is cleaned up before the remaining caches when the catalog is destroyed
+    if (NULL != gCtgMgmt.metaEpoch.pRetired) {
+      ctgRetireTbMeta(pMeta);
+    } else {
+      taosMemoryFree(pMeta);
+    }
   }
 
   if (pCache->pIndex) {
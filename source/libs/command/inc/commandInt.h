@@ -59,6 +59,7 @@ extern "C" {
 #define EXPLAIN_TIMERANGE_FORMAT "Time Range: [%" PRId64 ", %" PRId64 "]"
 #define EXPLAIN_OUTPUT_FORMAT "Output: "
 #define EXPLAIN_JOIN_PARAM_FORMAT "Join Param: "
+#define EXPLAIN_JOIN_ESTIMATE_FORMAT "Join Estimate: left_rows=%" PRId64 " right_rows=%" PRId64
 #define EXPLAIN_TIME_WINDOWS_FORMAT "Time Window: interval=%" PRId64 "%c offset=%" PRId64 "%c sliding=%" PRId64 "%c"
 #define EXPLAIN_WINDOW_FORMAT "Window: gap=%" PRId64
 #define EXPLAIN_RATIO_TIME_FORMAT "Ratio: %f"
@@ -66,6 +67,7 @@ extern "C" {
 #define EXPLAIN_MERGE_KEYS_FORMAT "Merge Key: "
 #define EXPLAIN_IGNORE_GROUPID_FORMAT "Ignore Group Id: %s"
 #define EXPLAIN_PARTITION_KETS_FORMAT "Partition Key: "
+#define EXPLAIN_SPILL_FORMAT "Spill: "
 #define EXPLAIN_INTERP_FORMAT "Interp"
 #define EXPLAIN_EVENT_FORMAT "Event"
 #define EXPLAIN_EVENT_START_FORMAT "Start Cond: "
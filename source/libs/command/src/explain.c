@@ -19,6 +19,7 @@
 #include "query.h"
 #include "tcommon.h"
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "systable.h"
 #include "functionMgt.h"
 
@@ -275,6 +276,41 @@ static int32_t qExplainBufAppendExecInfo(SArray *pExecInfo, char *tbuf, int32_t
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t qExplainBufAppendSpillInfo(int64_t writeBytes, int64_t rawWriteBytes, int64_t stallTime, char *tbuf,
+                                          int32_t *len) {
+  int32_t tlen = *len;
+
+  EXPLAIN_ROW_APPEND("spill:%.2f Kb", writeBytes / 1024.0);
+  if (rawWriteBytes > writeBytes) {
+    EXPLAIN_ROW_APPEND("  compress ratio:%.2f", rawWriteBytes / (double)writeBytes);
+  }
+  EXPLAIN_ROW_APPEND("  stall:%.3f ms", stallTime / 1000.0);
+
+  *len = tlen;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// the spill info of the paged buffer of an operator, summed up over all the nodes that run it.
+static SSpillExecInfo qExplainGetSpillExecInfo(SArray *pExecInfo) {
+  SSpillExecInfo info = {0};
+  int32_t        nodeNum = taosArrayGetSize(pExecInfo);
+
+  for (int32_t i = 0; i < nodeNum; ++i) {
+    SExplainExecInfo *execInfo = taosArrayGet(pExecInfo, i);
+    if (execInfo->verboseInfo == NULL || execInfo->verboseLen != sizeof(SSpillExecInfo)) {
+      continue;
+    }
+
+    SSpillExecInfo *pSpill = (SSpillExecInfo *)execInfo->verboseInfo;
+    info.writeBytes += pSpill->writeBytes;
+    info.rawWriteBytes += pSpill->rawWriteBytes;
+    info.stallTime += pSpill->stallTime;
+  }
+
+  return info;
+}
+
 static int32_t qExplainBufAppendVerboseExecInfo(SArray *pExecInfo, char *tbuf, int32_t *len) {
   int32_t          tlen = 0;
   bool             gotVerbose = false;
@@ -472,6 +508,8 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
           info.loadBlockStatis += pScanInfo->loadBlockStatis;
           info.totalCheckedRows += pScanInfo->totalCheckedRows;
           info.filterOutBlocks += pScanInfo->filterOutBlocks;
+          info.rtFilterOutBlocks += pScanInfo->rtFilterOutBlocks;
+          info.rtFilterOutRows += pScanInfo->rtFilterOutRows;
 
           if (pScanInfo->totalRows > totalRows) {
             totalRows = pScanInfo->totalRows;
@@ -493,6 +531,14 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
 
         EXPLAIN_ROW_APPEND("check_rows=%.1f", ((double)info.totalCheckedRows) / nodeNum);
         EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+
+        if (info.rtFilterOutBlocks > 0 || info.rtFilterOutRows > 0) {
+          EXPLAIN_ROW_APPEND("rt_filter_out_blocks=%.1f", ((double)info.rtFilterOutBlocks) / nodeNum);
+          EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+
+          EXPLAIN_ROW_APPEND("rt_filter_out_rows=%.1f", ((double)info.rtFilterOutRows) / nodeNum);
+          EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+        }
         EXPLAIN_ROW_END();
 
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
@@ -663,6 +709,14 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
 
+        if (tsQueryCostBasedJoin &&
+            (pJoinNode->inputStat[0].inputRowNum > 0 || pJoinNode->inputStat[1].inputRowNum > 0)) {
+          EXPLAIN_ROW_NEW(level + 1, EXPLAIN_JOIN_ESTIMATE_FORMAT, pJoinNode->inputStat[0].inputRowNum,
+                          pJoinNode->inputStat[1].inputRowNum);
+          EXPLAIN_ROW_END();
+          QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+        }
+
         if (IS_ASOF_JOIN(pJoinNode->subType) || IS_WINDOW_JOIN(pJoinNode->subType)) {
           EXPLAIN_ROW_NEW(level + 1, EXPLAIN_JOIN_PARAM_FORMAT);
           if (IS_ASOF_JOIN(pJoinNode->subType)) {
@@ -794,6 +848,17 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
         EXPLAIN_ROW_NEW(level + 1, EXPLAIN_MERGEBLOCKS_FORMAT, pAggNode->mergeDataBlock? "True":"False");
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+
+        if (pResNode->pExecInfo) {
+          SSpillExecInfo spillInfo = qExplainGetSpillExecInfo(pResNode->pExecInfo);
+          if (spillInfo.writeBytes > 0) {
+            EXPLAIN_ROW_NEW(level + 1, EXPLAIN_SPILL_FORMAT);
+            QRY_ERR_RET(qExplainBufAppendSpillInfo(spillInfo.writeBytes, spillInfo.rawWriteBytes, spillInfo.stallTime,
+                                                   tbuf, &tlen));
+            EXPLAIN_ROW_END();
+            QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+          }
+        }
       }
       break;
     }
@@ -935,6 +1000,11 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->writeBytes > 0) {
+          EXPLAIN_ROW_APPEND("  ");
+          QRY_ERR_RET(qExplainBufAppendSpillInfo(pExecInfo->writeBytes, pExecInfo->rawWriteBytes, pExecInfo->stallTime,
+                                                 tbuf, &tlen));
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1262,6 +1332,17 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
           EXPLAIN_ROW_END();
           QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
         }
+
+        if (pResNode->pExecInfo) {
+          SSpillExecInfo spillInfo = qExplainGetSpillExecInfo(pResNode->pExecInfo);
+          if (spillInfo.writeBytes > 0) {
+            EXPLAIN_ROW_NEW(level + 1, EXPLAIN_SPILL_FORMAT);
+            QRY_ERR_RET(qExplainBufAppendSpillInfo(spillInfo.writeBytes, spillInfo.rawWriteBytes, spillInfo.stallTime,
+                                                   tbuf, &tlen));
+            EXPLAIN_ROW_END();
+            QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+          }
+        }
       }
       break;
     }
@@ -1306,6 +1387,11 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
           }
 
           EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+          if (pExecInfo->writeBytes > 0) {
+            EXPLAIN_ROW_APPEND("  ");
+            QRY_ERR_RET(qExplainBufAppendSpillInfo(pExecInfo->writeBytes, pExecInfo->rawWriteBytes, pExecInfo->stallTime,
+                                                   tbuf, &tlen));
+          }
           EXPLAIN_ROW_END();
           QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
         }
@@ -1528,6 +1614,11 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->writeBytes > 0) {
+          EXPLAIN_ROW_APPEND("  ");
+          QRY_ERR_RET(qExplainBufAppendSpillInfo(pExecInfo->writeBytes, pExecInfo->rawWriteBytes, pExecInfo->stallTime,
+                                                 tbuf, &tlen));
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1729,6 +1820,14 @@ static int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
 
+        if (tsQueryCostBasedJoin &&
+            (pJoinNode->inputStat[0].inputRowNum > 0 || pJoinNode->inputStat[1].inputRowNum > 0)) {
+          EXPLAIN_ROW_NEW(level + 1, EXPLAIN_JOIN_ESTIMATE_FORMAT, pJoinNode->inputStat[0].inputRowNum,
+                          pJoinNode->inputStat[1].inputRowNum);
+          EXPLAIN_ROW_END();
+          QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+        }
+
         if (pJoinNode->node.pConditions) {
           EXPLAIN_ROW_NEW(level + 1, EXPLAIN_FILTER_FORMAT);
           QRY_ERR_RET(nodesNodeToSQL(pJoinNode->node.pConditions, tbuf + VARSTR_HEADER_SIZE,
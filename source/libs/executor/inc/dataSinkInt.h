@@ -39,6 +39,8 @@ typedef void (*FGetDataLength)(struct SDataSinkHandle* pHandle, int64_t* pLen, i
 typedef int32_t (*FGetDataBlock)(struct SDataSinkHandle* pHandle, SOutputData* pOutput);
 typedef int32_t (*FDestroyDataSinker)(struct SDataSinkHandle* pHandle);
 typedef int32_t (*FGetCacheSize)(struct SDataSinkHandle* pHandle, uint64_t* size);
+typedef void (*FSetCompressMode)(struct SDataSinkHandle* pHandle, int8_t compressMode);
+typedef int8_t (*FGetDataCompressed)(struct SDataSinkHandle* pHandle);
 
 typedef struct SDataSinkHandle {
   FPutDataBlock      fPut;
@@ -48,6 +50,8 @@ typedef struct SDataSinkHandle {
   FGetDataBlock      fGetData;
   FDestroyDataSinker fDestroy;
   FGetCacheSize      fGetCacheSize;
+  FSetCompressMode   fSetCompress;
+  FGetDataCompressed fGetCompressed;
 } SDataSinkHandle;
 
 int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pDataSink, DataSinkHandle* pHandle);
@@ -38,6 +38,7 @@ extern "C" {
 #include "tlockfree.h"
 #include "tmsg.h"
 #include "tpagedbuf.h"
+#include "runtimefilter.h"
 // #include "tstream.h"
 // #include "tstreamUpdate.h"
 #include "tlrucache.h"
@@ -203,6 +204,7 @@ typedef struct SExchangeInfo {
   int64_t             openedTs;  // start exec time stamp, todo: move to SLoadRemoteDataInfo
   char*               pTaskId;
   SArray*             pFetchRpcHandles;
+  int32_t             creditRows;  // max rows a source may return in one fetch rsp
 } SExchangeInfo;
 
 typedef struct SScanInfo {
@@ -264,25 +266,62 @@ typedef struct STableScanBase {
   // there are more than one table list exists in one task, if only one vnode exists.
   STableListInfo* pTableListInfo;
   TsdReader       readerAPI;
+  SRuntimeFilter* pRtFilter;        // published by the parent join operator, owned by the scan
+  bool            rtFilterOnTs;     // the filter key is the primary timestamp, blocks are pruned by their time range
+  int32_t         rtFilterSmaMiss;  // blocks in a row whose SMA was loaded for the runtime filter but not pruned
 } STableScanBase;
 
+typedef struct STableScanReadAhead STableScanReadAhead;
+
+typedef enum EScanWindowState {
+  SCAN_WINDOW_PENDING = 0,  // not picked up by the query job pool yet
+  SCAN_WINDOW_RUNNING,      // read ahead by a thread of the query job pool
+  SCAN_WINDOW_FOREGROUND,   // reached by the operator before the pool picked it up, read by the operator itself
+  SCAN_WINDOW_DONE,
+} EScanWindowState;
+
+typedef struct STableScanWindow {
+  STableScanReadAhead* pParent;
+  SQueryTableDataCond  cond;  // shallow copy of the scan condition with a disjoint time sub-window
+  STsdbReader*         pReader;
+  SSDataBlock*         pReaderBlock;
+  SArray*              pBlocks;  // SSDataBlock*, loaded by the query job pool but not consumed yet
+  int8_t               state;    // EScanWindowState
+  int32_t              code;
+} STableScanWindow;
+
+// the scan window of a single table is split by file set boundaries. The first sub-window is read by the data reader
+// of the operator, and the rest ones are read ahead in the query job pool shared by all queries, and then consumed in
+// scan order.
+struct STableScanReadAhead {
+  TdThreadMutex     lock;
+  TdThreadCond      cond;
+  TsdReader*        pAPI;
+  STableScanWindow* pWindows;
+  int32_t           numOfWindows;
+  int32_t           current;  // -1 when the data reader of the operator is consumed
+  int32_t           ref;      // held by the operator and by each job submitted to the query job pool
+  bool              closing;
+};
+
 typedef struct STableScanInfo {
-  STableScanBase  base;
-  SScanInfo       scanInfo;
-  int32_t         scanTimes;
-  SSDataBlock*    pResBlock;
-  SHashObj*       pIgnoreTables;
-  SSampleExecInfo sample;           // sample execution info
-  int32_t         tableStartIndex;  // current group scan start
-  int32_t         tableEndIndex;    // current group scan end
-  int32_t         currentGroupId;
-  int32_t         currentTable;
-  int8_t          scanMode;
-  int8_t          assignBlockUid;
-  uint8_t         countState;  // empty table count state
-  bool            hasGroupByTag;
-  bool            filesetDelimited;
-  bool            needCountEmptyTable;
+  STableScanBase       base;
+  SScanInfo            scanInfo;
+  int32_t              scanTimes;
+  SSDataBlock*         pResBlock;
+  SHashObj*            pIgnoreTables;
+  SSampleExecInfo      sample;           // sample execution info
+  int32_t              tableStartIndex;  // current group scan start
+  int32_t              tableEndIndex;    // current group scan end
+  int32_t              currentGroupId;
+  int32_t              currentTable;
+  int8_t               scanMode;
+  int8_t               assignBlockUid;
+  uint8_t              countState;  // empty table count state
+  bool                 hasGroupByTag;
+  bool                 filesetDelimited;
+  bool                 needCountEmptyTable;
+  STableScanReadAhead* pReadAhead;
 } STableScanInfo;
 
 typedef enum ESubTableInputType {
@@ -916,6 +955,7 @@ void     cleanupResultInfoWithoutHash(SExecTaskInfo* pTaskInfo, SExprSupp* pSup,
 int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols, size_t keyBufSize,
                    const char* pkey, void* pState, SFunctionStateStore* pStore);
 void    cleanupAggSup(SAggSupporter* pAggSup);
+int32_t getDBufSpillExecInfo(SDiskbasedBuf* pBuf, void** pOptrExplain, uint32_t* len);
 
 void initResultSizeInfo(SResultInfo* pResultInfo, int32_t numOfRows);
 
@@ -933,6 +973,13 @@ bool hasSlimitOffsetInfo(SLimitInfo* pLimitInfo);
 void initLimitInfo(const SNode* pLimit, const SNode* pSLimit, SLimitInfo* pLimitInfo);
 void resetLimitInfoForNextGroup(SLimitInfo* pLimitInfo);
 bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo);
+int32_t setTableScanRuntimeFilter(struct SOperatorInfo* pOperator, SRuntimeFilter* pFilter);
+
+int32_t tableScanReadAheadCreate(TsdReader* pAPI, int32_t numOfWindows, STableScanReadAhead** ppReadAhead);
+void    tableScanReadAheadStart(STableScanReadAhead* pReadAhead);
+int32_t tableScanReadAheadNext(STableScanReadAhead* pReadAhead, SSDataBlock* pBlock, bool* hasNext);
+void    tableScanReadAheadNotifyClosing(STableScanReadAhead* pReadAhead);
+void    tableScanReadAheadDestroy(STableScanReadAhead* pReadAhead);
 
 int32_t applyAggFunctionOnPartialTuples(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData,
                                         int32_t offset, int32_t forwardStep, int32_t numOfTotal, int32_t numOfOutput);
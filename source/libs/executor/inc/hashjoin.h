@@ -27,6 +27,7 @@ extern "C" {
 #define HJOIN_BLK_SIZE_LIMIT 10485760
 #define HJOIN_ROW_BITMAP_SIZE (2 * 1048576)
 #define HJOIN_BLK_THRESHOLD_RATIO 0.9
+#define HJOIN_MAX_INIT_HASH_CAP 1048576  // the input rows are planner estimates, don't trust them for big tables
 
 typedef int32_t (*hJoinImplFp)(SOperatorInfo*);
 
@@ -62,6 +63,7 @@ typedef struct SHJoinCtx {
 typedef struct SHJoinColInfo {
   int32_t          srcSlot;
   int32_t          dstSlot;
+  int8_t           type;
   bool             keyCol;
   bool             vardata;
   int32_t*         offset;
@@ -129,6 +131,7 @@ typedef struct SHJoinExecInfo {
   int64_t probeBlkRows;
   int64_t resRows;
   int64_t expectRows;
+  int64_t rtFilterKeys;
 } SHJoinExecInfo;
 
 
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef TDENGINE_RUNTIMEFILTER_H
+#define TDENGINE_RUNTIMEFILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "os.h"
+#include "tbloomfilter.h"
+#include "tcommon.h"
+
+#define RT_FILTER_MAX_KEYS        1048576
+#define RT_FILTER_BLOOM_ERROR_RATE 0.01
+
+// Runtime filter published by the build side of a join and consulted by the probe side table scan. It holds the
+// min/max range and a bloom filter of the join key, so that blocks and rows that can never match are dropped early.
+typedef struct SRuntimeFilter {
+  int32_t       slotId;  // slot of the key column in the probe side scan result block
+  int8_t        type;
+  int32_t       bytes;
+  int64_t       keyNum;
+  int64_t       min;
+  int64_t       max;
+  SBloomFilter* pBloom;
+  int64_t       checkedRows;
+  int64_t       filterOutRows;
+  int64_t       filterOutBlocks;
+} SRuntimeFilter;
+
+bool    rtFilterIsSupportedType(int8_t type);
+int32_t rtFilterCreate(int32_t slotId, int8_t type, int32_t bytes, int64_t expectedKeys, SRuntimeFilter** ppFilter);
+int32_t rtFilterPutKey(SRuntimeFilter* pFilter, const char* pKey);
+bool    rtFilterBlockMayMatch(SRuntimeFilter* pFilter, const SColumnDataAgg* pAgg);
+int32_t rtFilterApplyToBlock(SRuntimeFilter* pFilter, SSDataBlock* pBlock);
+void    rtFilterDestroy(SRuntimeFilter* pFilter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TDENGINE_RUNTIMEFILTER_H
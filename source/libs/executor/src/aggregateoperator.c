@@ -52,7 +52,8 @@ typedef struct SAggOperatorInfo {
   bool             cleanGroupResInfo;
 } SAggOperatorInfo;
 
-static void destroyAggOperatorInfo(void* param);
+static void    destroyAggOperatorInfo(void* param);
+static int32_t getAggExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len);
 static int32_t setExecutionContext(SOperatorInfo* pOperator, int32_t numOfOutput, uint64_t groupId);
 
 static int32_t createDataBlockForEmptyInput(SOperatorInfo* pOperator, SSDataBlock** ppBlock);
@@ -127,7 +128,7 @@ int32_t createAggregateOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pA
   setOperatorInfo(pOperator, "TableAggregate", QUERY_NODE_PHYSICAL_PLAN_HASH_AGG,
                   !pAggNode->node.forceCreateNonBlockingOptr, OP_NOT_OPENED, pInfo, pTaskInfo);
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, getAggregateResultNext, NULL, destroyAggOperatorInfo,
-                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+                                         optrDefaultBufFn, getAggExplainExecInfo, optrDefaultGetNextExtFn, NULL);
 
   if (downstream->operatorType == QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
     STableScanInfo* pTableScanInfo = downstream->info;
@@ -600,6 +601,11 @@ int32_t doInitAggInfoSup(SAggSupporter* pAggSup, SqlFunctionCtx* pCtx, int32_t n
     return code;
   }
 
+  code = setBufPageCompressOnDisk(pAggSup->pResultBuf, tsQuerySpillCompress);
+  if (code == TSDB_CODE_SUCCESS) {
+    code = setBufPageAsyncFlush(pAggSup->pResultBuf, tsQueryAsyncSpill);
+  }
+
   return code;
 }
 
@@ -727,6 +733,29 @@ void cleanupAggSup(SAggSupporter* pAggSup) {
   destroyDiskbasedBuf(pAggSup->pResultBuf);
 }
 
+int32_t getDBufSpillExecInfo(SDiskbasedBuf* pBuf, void** pOptrExplain, uint32_t* len) {
+  SSpillExecInfo* pInfo = taosMemoryCalloc(1, sizeof(SSpillExecInfo));
+  if (pInfo == NULL) {
+    return terrno;
+  }
+
+  if (pBuf != NULL) {
+    SDiskbasedBufStatis st = getDBufStatis(pBuf);
+    pInfo->writeBytes = st.flushBytes;
+    pInfo->rawWriteBytes = st.rawFlushBytes;
+    pInfo->stallTime = st.stallTime;
+  }
+
+  *pOptrExplain = pInfo;
+  *len = sizeof(SSpillExecInfo);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t getAggExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SAggOperatorInfo* pInfo = pOptr->info;
+  return getDBufSpillExecInfo(pInfo->aggSup.pResultBuf, pOptrExplain, len);
+}
+
 int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols, size_t keyBufSize,
                    const char* pkey, void* pState, SFunctionStateStore* pStore) {
   int32_t code = initExprSupp(pSup, pExprInfo, numOfCols, pStore);
@@ -52,6 +52,7 @@ typedef struct SDataDispatchHandle {
   uint64_t            cachedSize;
   void*               pCompressBuf;
   int32_t             bufSize;
+  int8_t              compressMode;  // BLOCK_COMPRESS_LZ4 or BLOCK_COMPRESS_COLUMNAR, as the requester asks for
   TdThreadMutex       mutex;
 } SDataDispatchHandle;
 
@@ -177,10 +178,17 @@ static int32_t toDataCacheEntry(SDataDispatchHandle* pHandle, const SInputData*
         qError("failed to encode data block, code: %d", dataLen);
         return terrno;
       }
-      int32_t len =
-          tsCompressString(pHandle->pCompressBuf, dataLen, 1, pEntry->data, pBuf->allocSize, ONE_STAGE_COMP, NULL, 0);
-      if (len < dataLen) {
-        pEntry->compressed = 1;
+      int32_t len = 0;
+      int8_t  compressMode = atomic_load_8(&pHandle->compressMode);
+      if (compressMode == BLOCK_COMPRESS_COLUMNAR) {
+        len = blockCompressEncoded(pHandle->pCompressBuf, dataLen, pEntry->data,
+                                   pBuf->allocSize - sizeof(SDataCacheEntry));
+      } else {
+        len = tsCompressString(pHandle->pCompressBuf, dataLen, 1, pEntry->data, pBuf->allocSize, ONE_STAGE_COMP, NULL,
+                               0);
+      }
+      if (len > 0 && len < dataLen) {
+        pEntry->compressed = compressMode;
         pEntry->dataLen = len;
         pEntry->rawLen = dataLen;
       } else {  // no need to compress data
@@ -293,17 +301,21 @@ static void resetDispatcher(struct SDataSinkHandle* pHandle) {
 
 static void getDataLength(SDataSinkHandle* pHandle, int64_t* pLen, int64_t* pRowLen, bool* pQueryEnd) {
   SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
-  if (taosQueueEmpty(pDispatcher->pDataBlocks)) {
-    *pQueryEnd = pDispatcher->queryEnd;
-    *pLen = 0;
-    return;
-  }
 
-  SDataDispatchBuf* pBuf = NULL;
-  taosReadQitem(pDispatcher->pDataBlocks, (void**)&pBuf);
-  if (pBuf != NULL) {
-    TAOS_MEMCPY(&pDispatcher->nextOutput, pBuf, sizeof(SDataDispatchBuf));
-    taosFreeQitem(pBuf);
+  // the block is still pending if the caller did not get it after the previous call
+  if (NULL == pDispatcher->nextOutput.pData) {
+    if (taosQueueEmpty(pDispatcher->pDataBlocks)) {
+      *pQueryEnd = pDispatcher->queryEnd;
+      *pLen = 0;
+      return;
+    }
+
+    SDataDispatchBuf* pBuf = NULL;
+    taosReadQitem(pDispatcher->pDataBlocks, (void**)&pBuf);
+    if (pBuf != NULL) {
+      TAOS_MEMCPY(&pDispatcher->nextOutput, pBuf, sizeof(SDataDispatchBuf));
+      taosFreeQitem(pBuf);
+    }
   }
 
   SDataCacheEntry* pEntry = (SDataCacheEntry*)pDispatcher->nextOutput.pData;
@@ -315,6 +327,19 @@ static void getDataLength(SDataSinkHandle* pHandle, int64_t* pLen, int64_t* pRow
          ((SDataCacheEntry*)(pDispatcher->nextOutput.pData))->numOfRows);
 }
 
+static void setCompressMode(SDataSinkHandle* pHandle, int8_t compressMode) {
+  SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
+  atomic_store_8(&pDispatcher->compressMode, compressMode);
+}
+
+static int8_t getDataCompressed(SDataSinkHandle* pHandle) {
+  SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
+  if (NULL == pDispatcher->nextOutput.pData) {
+    return BLOCK_COMPRESS_NONE;
+  }
+  return ((SDataCacheEntry*)pDispatcher->nextOutput.pData)->compressed;
+}
+
 static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
   SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
   if (NULL == pDispatcher->nextOutput.pData) {
@@ -448,6 +473,8 @@ int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pD
   dispatcher->sink.fGetData = getDataBlock;
   dispatcher->sink.fDestroy = destroyDataSinker;
   dispatcher->sink.fGetCacheSize = getCacheSize;
+  dispatcher->sink.fSetCompress = setCompressMode;
+  dispatcher->sink.fGetCompressed = getDataCompressed;
 
   dispatcher->pManager = pManager;
   pManager = NULL;
@@ -455,6 +482,7 @@ int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pD
   dispatcher->outPutColCounts = getOutputColCounts(dispatcher->pSchema);
   dispatcher->status = DS_BUF_EMPTY;
   dispatcher->queryEnd = false;
+  dispatcher->compressMode = BLOCK_COMPRESS_LZ4;
   code = taosOpenQueue(&dispatcher->pDataBlocks);
   if (code) {
     terrno = code;
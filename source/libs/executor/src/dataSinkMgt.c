@@ -82,6 +82,21 @@ void dsGetDataLength(DataSinkHandle handle, int64_t* pLen, int64_t* pRawLen, boo
   pHandleImpl->fGetLen(pHandleImpl, pLen, pRawLen, pQueryEnd);
 }
 
+void dsSetCompressMode(DataSinkHandle handle, int8_t compressMode) {
+  SDataSinkHandle* pHandleImpl = (SDataSinkHandle*)handle;
+  if (pHandleImpl->fSetCompress) {
+    pHandleImpl->fSetCompress(pHandleImpl, compressMode);
+  }
+}
+
+int8_t dsGetDataCompressed(DataSinkHandle handle) {
+  SDataSinkHandle* pHandleImpl = (SDataSinkHandle*)handle;
+  if (pHandleImpl->fGetCompressed) {
+    return pHandleImpl->fGetCompressed(pHandleImpl);
+  }
+  return 0;
+}
+
 int32_t dsGetDataBlock(DataSinkHandle handle, SOutputData* pOutput) {
   SDataSinkHandle* pHandleImpl = (SDataSinkHandle*)handle;
   return pHandleImpl->fGetData(pHandleImpl, pOutput);
@@ -25,6 +25,13 @@
 #include "tref.h"
 #include "trpc.h"
 
+// Rows granted to all sources together for one round of fetch rsps. Each source gets an equal share within
+// [EXCHANGE_MIN_CREDIT_ROWS, EXCHANGE_MAX_CREDIT_ROWS], so fewer sources mean fewer and larger round trips. The
+// minimum is the rows a source returns without any credit (QW_MIN_RES_ROWS), so a credit never shrinks a fetch rsp.
+#define EXCHANGE_CREDIT_WINDOW_ROWS (1024 * 1024)
+#define EXCHANGE_MIN_CREDIT_ROWS    16384
+#define EXCHANGE_MAX_CREDIT_ROWS    (256 * 1024)
+
 typedef struct SFetchRspHandleWrapper {
   uint32_t exchangeId;
   int32_t  sourceIndex;
@@ -246,6 +253,12 @@ static SSDataBlock* doLoadRemoteDataImpl(SOperatorInfo* pOperator) {
   }
 }
 
+static int32_t getExchangeWindowCredit(SExchangeInfo* pInfo) {
+  int64_t numOfSources = pInfo->seqLoadData ? 1 : taosArrayGetSize(pInfo->pSources);
+  int64_t credit = EXCHANGE_CREDIT_WINDOW_ROWS / TMAX(numOfSources, 1);
+  return (int32_t)TMIN(TMAX(credit, EXCHANGE_MIN_CREDIT_ROWS), EXCHANGE_MAX_CREDIT_ROWS);
+}
+
 static int32_t loadRemoteDataNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
   int32_t        code = TSDB_CODE_SUCCESS;
   int32_t        lino = 0;
@@ -267,6 +280,11 @@ static int32_t loadRemoteDataNext(SOperatorInfo* pOperator, SSDataBlock** ppRes)
       return code;
     }
 
+    // the limit applies to each partition, so a source may return more rows than the limit for all of them
+    if (pBlock->info.id.groupId != 0) {
+      pExchangeInfo->creditRows = TMAX(pExchangeInfo->creditRows, getExchangeWindowCredit(pExchangeInfo));
+    }
+
     code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, NULL);
     QUERY_CHECK_CODE(code, lino, _end);
 
@@ -399,6 +417,19 @@ static int32_t initExchangeOperator(SExchangePhysiNode* pExNode, SExchangeInfo*
   return initDataSource(numOfSources, pInfo, id);
 }
 
+static void initExchangeCredit(SExchangeInfo* pInfo, bool hasFilter) {
+  int64_t credit = getExchangeWindowCredit(pInfo);
+
+  // no need to ask any source for more rows than the limit clause can return, as long as the limit is not applied
+  // to each group. The limit of partitioned data is lifted once a grouped block arrives, see loadRemoteDataNext.
+  SLimitInfo* pLimitInfo = &pInfo->limitInfo;
+  if (!hasFilter && pLimitInfo->limit.limit >= 0 && pLimitInfo->slimit.limit < 0) {
+    credit = TMIN(credit, TMAX(pLimitInfo->limit.limit + TMAX(pLimitInfo->limit.offset, 0), 1));
+  }
+
+  pInfo->creditRows = (int32_t)credit;
+}
+
 int32_t createExchangeOperatorInfo(void* pTransporter, SExchangePhysiNode* pExNode, SExecTaskInfo* pTaskInfo,
                                    SOperatorInfo** pOptrInfo) {
   QRY_PARAM_CHECK(pOptrInfo);
@@ -441,6 +472,8 @@ int32_t createExchangeOperatorInfo(void* pTransporter, SExchangePhysiNode* pExNo
   code = filterInitFromNode((SNode*)pExNode->node.pConditions, &pOperator->exprSupp.pFilterInfo, 0);
   QUERY_CHECK_CODE(code, lino, _error);
 
+  initExchangeCredit(pInfo, pOperator->exprSupp.pFilterInfo != NULL);
+
   pOperator->fpSet = createOperatorFpSet(prepareLoadRemoteData, loadRemoteDataNext, NULL, destroyExchangeOperatorInfo,
                                          optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
   *pOptrInfo = pOperator;
@@ -654,6 +687,8 @@ int32_t doSendFetchDataRequest(SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTas
     req.taskId = pSource->taskId;
     req.queryId = pTaskInfo->id.queryId;
     req.execId = pSource->execId;
+    req.creditRows = pExchangeInfo->creditRows;
+    req.acceptColumnar = tsCompressMsgByColumn;
     if (pDataInfo->pSrcUidList) {
       int32_t code =
           buildTableScanOperatorParam(&req.pOpParam, pDataInfo->pSrcUidList, pDataInfo->srcOpType, pDataInfo->tableSeq);
@@ -910,8 +945,8 @@ int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDa
 
     pNextStart = pStart + compLen;
     if (pRetrieveRsp->compressed && (compLen < rawLen)) {
-      int32_t t = tsDecompressString(pStart, compLen, 1, pDataInfo->decompBuf, rawLen, ONE_STAGE_COMP, NULL, 0);
-      QUERY_CHECK_CONDITION((t == rawLen), code, lino, _end, TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR);
+      code = blockDecompress(pRetrieveRsp->compressed, pStart, compLen, pDataInfo->decompBuf, rawLen);
+      QUERY_CHECK_CODE(code, lino, _end);
       pStart = pDataInfo->decompBuf;
     }
 
@@ -934,6 +969,22 @@ _end:
   return code;
 }
 
+// Send the next fetch request before the blocks of the current rsp are consumed, so that the round trip
+// overlaps with the execution of the upstream operators.
+static int32_t seqPrefetchRemoteData(SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTaskInfo) {
+  if (pExchangeInfo->dynamicOp || pExchangeInfo->current >= taosArrayGetSize(pExchangeInfo->pSources)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SSourceDataInfo* pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, pExchangeInfo->current);
+  if (!pDataInfo) {
+    return terrno;
+  }
+
+  pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+  return doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
+}
+
 int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
   SExchangeInfo* pExchangeInfo = pOperator->info;
   SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
@@ -954,13 +1005,16 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
       pTaskInfo->code = terrno;
       T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
     }
-    pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+    // the request may have been prefetched while the previous rsp was consumed
+    if (pDataInfo->status != EX_SOURCE_DATA_STARTED && pDataInfo->status != EX_SOURCE_DATA_READY) {
+      pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
 
-    code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
-    if (code != TSDB_CODE_SUCCESS) {
-      qError("%s failed at line %d since %s", __func__, __LINE__, tstrerror(code));
-      pTaskInfo->code = code;
-      T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
+      code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
+      if (code != TSDB_CODE_SUCCESS) {
+        qError("%s failed at line %d since %s", __func__, __LINE__, tstrerror(code));
+        pTaskInfo->code = code;
+        T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
+      }
     }
 
     code = exchangeWait(pOperator, pExchangeInfo);
@@ -1024,6 +1078,11 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
     pDataInfo->totalRows += pRetrieveRsp->numOfRows;
 
     taosMemoryFreeClear(pDataInfo->pRsp);
+
+    code = seqPrefetchRemoteData(pExchangeInfo, pTaskInfo);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _error;
+    }
     return TSDB_CODE_SUCCESS;
   }
 
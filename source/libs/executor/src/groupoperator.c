@@ -23,6 +23,7 @@
 #include "tmsg.h"
 
 #include "executorInt.h"
+#include "functionMgt.h"
 #include "operator.h"
 #include "querytask.h"
 #include "tcompare.h"
@@ -40,6 +41,9 @@ typedef struct SGroupbyOperatorInfo {
   SGroupResInfo  groupResInfo;
   SExprSupp      scalarSup;
   SOperatorInfo  *pOperator;
+  int64_t        topN;        // only the first topN groups ordered by pTopNInfo are kept if greater than 0
+  SArray*        pTopNInfo;   // SArray<SBlockOrderInfo>, the slotId is the index of the group key in pGroupCols
+  BoundedQueue*  pTopNQueue;  // keys of the groups in the hash table, the last one of the top N on the top
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -75,6 +79,11 @@ static void freeGroupKey(void* param) {
   taosMemoryFree(pKey->pData);
 }
 
+static int32_t getGroupbyExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SGroupbyOperatorInfo* pInfo = pOptr->info;
+  return getDBufSpillExecInfo(pInfo->aggSup.pResultBuf, pOptrExplain, len);
+}
+
 static void destroyGroupOperatorInfo(void* param) {
   if (param == NULL) {
     return;
@@ -86,6 +95,8 @@ static void destroyGroupOperatorInfo(void* param) {
   taosArrayDestroy(pInfo->pGroupCols);
   taosArrayDestroyEx(pInfo->pGroupColVals, freeGroupKey);
   cleanupExprSupp(&pInfo->scalarSup);
+  taosArrayDestroy(pInfo->pTopNInfo);
+  destroyBoundedQueue(pInfo->pTopNQueue);
 
   if (pInfo->pOperator != NULL) {
     cleanupResultInfo(pInfo->pOperator->pTaskInfo, &pInfo->pOperator->exprSupp, &pInfo->groupResInfo, &pInfo->aggSup,
@@ -285,6 +296,153 @@ static void doAssignGroupKeys(SqlFunctionCtx* pCtx, int32_t numOfOutput, int32_t
   }
 }
 
+// the value of the idx-th group key in a key built by buildGroupKeys
+static const char* getGroupKeyVal(const SArray* pGroupColVals, const char* pKey, int32_t idx, bool* isNull) {
+  size_t      numOfGroupCols = taosArrayGetSize(pGroupColVals);
+  const char* pStart = pKey + sizeof(int8_t) * numOfGroupCols;
+  for (int32_t i = 0; i < idx; ++i) {
+    if (pKey[i]) {
+      continue;
+    }
+
+    SGroupKeys* pkey = taosArrayGet(pGroupColVals, i);
+    if (pkey->type == TSDB_DATA_TYPE_JSON) {
+      pStart += getJsonValueLen(pStart);
+    } else if (IS_VAR_DATA_TYPE(pkey->type)) {
+      pStart += varDataTLen(pStart);
+    } else {
+      pStart += pkey->bytes;
+    }
+  }
+
+  *isNull = (pKey[idx] != 0);
+  return pStart;
+}
+
+// each element of the top N queue is the length of the hash key followed by the hash key itself, which is the group
+// id followed by the group keys. Return true if the group l is ahead of the group r in the order of the top N keys.
+static bool groupTopNCompFn(void* l, void* r, void* param) {
+  SGroupbyOperatorInfo* pInfo = param;
+  const char*           pLeft = (const char*)l + sizeof(int32_t) + sizeof(uint64_t);
+  const char*           pRight = (const char*)r + sizeof(int32_t) + sizeof(uint64_t);
+
+  size_t size = taosArrayGetSize(pInfo->pTopNInfo);
+  for (int32_t i = 0; i < size; ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pInfo->pTopNInfo, i);
+    bool             leftNull = false, rightNull = false;
+    const char*      pLeftVal = getGroupKeyVal(pInfo->pGroupColVals, pLeft, pOrder->slotId, &leftNull);
+    const char*      pRightVal = getGroupKeyVal(pInfo->pGroupColVals, pRight, pOrder->slotId, &rightNull);
+
+    if (leftNull && rightNull) {
+      continue;
+    } else if (leftNull || rightNull) {
+      return leftNull ? pOrder->nullFirst : !pOrder->nullFirst;
+    }
+
+    int32_t ret = ((__compar_fn_t)pOrder->compFn)(pLeftVal, pRightVal);
+    if (ret != 0) {
+      return ret < 0;
+    }
+  }
+
+  return false;
+}
+
+static void removeTopNGroup(SOperatorInfo* pOperator, const char* pData) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SExprSupp*            pSup = &pOperator->exprSupp;
+  int32_t               keyLen = *(int32_t*)pData;
+  const char*           pKey = pData + sizeof(int32_t);
+
+  SResultRowPosition* pPos = tSimpleHashGet(pInfo->aggSup.pResultRowHashTable, pKey, keyLen);
+  if (pPos == NULL) {
+    return;
+  }
+
+  bool needCleanup = false;
+  for (int32_t j = 0; j < pSup->numOfExprs; ++j) {
+    needCleanup |= pSup->pCtx[j].needCleanup;
+  }
+
+  if (needCleanup) {
+    SFilePage* page = getBufPage(pInfo->aggSup.pResultBuf, pPos->pageId);
+    if (page == NULL) {
+      qError("failed to get buffer, code:%s, %s", tstrerror(terrno), GET_TASKID(pOperator->pTaskInfo));
+    } else {
+      SResultRow* pRow = (SResultRow*)((char*)page + pPos->offset);
+      for (int32_t j = 0; j < pSup->numOfExprs; ++j) {
+        pSup->pCtx[j].resultInfo = getResultEntryInfo(pRow, j, pSup->rowEntryInfoOffset);
+        if (pSup->pCtx[j].fpSet.cleanup) {
+          pSup->pCtx[j].fpSet.cleanup(&pSup->pCtx[j]);
+        }
+      }
+      releaseBufPage(pInfo->aggSup.pResultBuf, page);
+    }
+  }
+
+  (void)tSimpleHashRemove(pInfo->aggSup.pResultRowHashTable, pKey, keyLen);
+}
+
+/**
+ * @brief check if the rows of current group should be skipped since the group can not be in the top N
+ * @retval true if the group should be skipped
+ * @note Only the groups of the first topN group keys seen so far are kept in the hash table. A new group that goes
+ *       ahead of the last one of them takes its place, and the last one is removed from the hash table. A group that
+ *       ends up in the top N is always among the top N of the groups seen so far, so it is never skipped or removed.
+ */
+static bool filterGroupWithTopN(SOperatorInfo* pOperator, int32_t len, uint64_t groupId) {
+  int32_t               code = TSDB_CODE_SUCCESS;
+  int32_t               lino = 0;
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  if (pInfo->topN <= 0) {
+    return false;
+  }
+
+  // the same hash key as the one built in doSetResultOutBufByKey
+  int32_t keyLen = GET_RES_WINDOW_KEY_LEN(len);
+  char*   pKey = pInfo->aggSup.keyBuf;
+  SET_RES_WINDOW_KEY(pKey, pInfo->keyBuf, len, groupId);
+  *(uint64_t*)pKey = calcGroupId(pKey, keyLen);
+  if (tSimpleHashGet(pInfo->aggSup.pResultRowHashTable, pKey, keyLen) != NULL) {
+    return false;
+  }
+
+  if (pInfo->pTopNQueue == NULL) {
+    pInfo->pTopNQueue = createBoundedQueue(pInfo->topN - 1, groupTopNCompFn, taosMemoryFree, pInfo);
+    QUERY_CHECK_NULL(pInfo->pTopNQueue, code, lino, _end, terrno);
+  }
+
+  PriorityQueueNode node = {.data = taosMemoryMalloc(sizeof(int32_t) + keyLen)};
+  QUERY_CHECK_NULL(node.data, code, lino, _end, terrno);
+
+  *(int32_t*)node.data = keyLen;
+  (void)memcpy((char*)node.data + sizeof(int32_t), pKey, keyLen);
+
+  // if the queue is full, the new group either goes after the last one of the top N, or replaces it
+  if (taosBQSize(pInfo->pTopNQueue) == taosBQMaxSize(pInfo->pTopNQueue) + 1) {
+    PriorityQueueNode* top = taosBQTop(pInfo->pTopNQueue);
+    if (groupTopNCompFn(top->data, node.data, pInfo)) {
+      taosMemoryFree(node.data);
+      return true;
+    }
+    removeTopNGroup(pOperator, top->data);
+  }
+
+  if (NULL == taosBQPush(pInfo->pTopNQueue, &node)) {
+    taosMemoryFree(node.data);
+    return true;
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+    pTaskInfo->code = code;
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+  return false;
+}
+
 static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
@@ -329,27 +487,33 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
     }
 
     len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
-    int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
-                                          len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
-    if (ret != TSDB_CODE_SUCCESS) {  // null data, too many state code
-      T_LONG_JMP(pTaskInfo->env, ret);
-    }
+    if (!filterGroupWithTopN(pOperator, len, pBlock->info.id.groupId)) {
+      int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
+                                            len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+      if (ret != TSDB_CODE_SUCCESS) {  // null data, too many state code
+        T_LONG_JMP(pTaskInfo->env, ret);
+      }
 
-    int32_t rowIndex = j - num;
-    ret = applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
-                                                   pOperator->exprSupp.numOfExprs);
-    if (ret != TSDB_CODE_SUCCESS) {
-      T_LONG_JMP(pTaskInfo->env, ret);
-    }
+      int32_t rowIndex = j - num;
+      ret = applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
+                                            pOperator->exprSupp.numOfExprs);
+      if (ret != TSDB_CODE_SUCCESS) {
+        T_LONG_JMP(pTaskInfo->env, ret);
+      }
 
-    // assign the group keys or user input constant values if required
-    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+      // assign the group keys or user input constant values if required
+      doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+    }
     recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, j);
     num = 1;
   }
 
   if (num > 0) {
     len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
+    if (filterGroupWithTopN(pOperator, len, pBlock->info.id.groupId)) {
+      return;
+    }
+
     int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
                                           len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
     if (ret != TSDB_CODE_SUCCESS) {
@@ -514,6 +678,56 @@ _end:
   return code;
 }
 
+// The top N keys refer to the output of the _group_key functions, map them to the group keys, so that the order of a
+// group is known from its key. The top N groups are not tracked if any of them can not be mapped.
+static int32_t initGroupTopNInfo(SOperatorInfo* pOperator, SAggPhysiNode* pAggNode) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SExprSupp*            pSup = &pOperator->exprSupp;
+
+  SArray* pTopNInfo = createSortInfo(pAggNode->pTopNKeys);
+  if (pTopNInfo == NULL) {
+    return terrno;
+  }
+
+  size_t size = taosArrayGetSize(pTopNInfo);
+  for (int32_t i = 0; i < size; ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pTopNInfo, i);
+    int32_t          groupIdx = -1;
+
+    for (int32_t j = 0; j < pSup->numOfExprs && groupIdx < 0; ++j) {
+      SExprInfo* pExpr = &pSup->pExprInfo[j];
+      if (pExpr->base.resSchema.slotId != pOrder->slotId || pExpr->pExpr->nodeType != QUERY_NODE_FUNCTION ||
+          pExpr->pExpr->_function.functionType != FUNCTION_TYPE_GROUP_KEY || pExpr->base.numOfParams < 1 ||
+          pExpr->base.pParam[0].type != FUNC_PARAM_TYPE_COLUMN) {
+        continue;
+      }
+
+      for (int32_t k = 0; k < taosArrayGetSize(pInfo->pGroupCols); ++k) {
+        SColumn* pCol = taosArrayGet(pInfo->pGroupCols, k);
+        if (pCol->slotId == pExpr->base.pParam[0].pCol->slotId && pCol->type != TSDB_DATA_TYPE_JSON) {
+          groupIdx = k;
+          break;
+        }
+      }
+    }
+
+    if (groupIdx < 0) {
+      qDebug("%s top N groups not tracked, slotId:%d is not a group key", GET_TASKID(pOperator->pTaskInfo),
+             pOrder->slotId);
+      taosArrayDestroy(pTopNInfo);
+      return TSDB_CODE_SUCCESS;
+    }
+
+    SColumn* pCol = taosArrayGet(pInfo->pGroupCols, groupIdx);
+    pOrder->slotId = groupIdx;
+    pOrder->compFn = getKeyComparFunc(pCol->type, pOrder->order);
+  }
+
+  pInfo->pTopNInfo = pTopNInfo;
+  pInfo->topN = pAggNode->topN;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pAggNode, SExecTaskInfo* pTaskInfo,
                                 SOperatorInfo** pOptrInfo) {
   QRY_PARAM_CHECK(pOptrInfo);
@@ -579,8 +793,13 @@ int32_t createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pAggNo
 
   pInfo->pOperator = pOperator;
 
+  if (pAggNode->topN > 0) {
+    code = initGroupTopNInfo(pOperator, pAggNode);
+    QUERY_CHECK_CODE(code, lino, _error);
+  }
+
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, hashGroupbyAggregateNext, NULL, destroyGroupOperatorInfo,
-                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+                                         optrDefaultBufFn, getGroupbyExplainExecInfo, optrDefaultGetNextExtFn, NULL);
   code = appendDownstream(pOperator, &downstream, 1);
   QUERY_CHECK_CODE(code, lino, _error);
 
@@ -1072,6 +1291,11 @@ _end:
   return code;
 }
 
+static int32_t getPartitionExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SPartitionOperatorInfo* pInfo = pOptr->info;
+  return getDBufSpillExecInfo(pInfo->pBuf, pOptrExplain, len);
+}
+
 static void destroyPartitionOperatorInfo(void* param) {
   SPartitionOperatorInfo* pInfo = (SPartitionOperatorInfo*)param;
   cleanupBasicInfo(&pInfo->binfo);
@@ -1181,6 +1405,16 @@ int32_t createPartitionOperatorInfo(SOperatorInfo* downstream, SPartitionPhysiNo
     goto _error;
   }
 
+  code = setBufPageCompressOnDisk(pInfo->pBuf, tsQuerySpillCompress);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _error;
+  }
+
+  code = setBufPageAsyncFlush(pInfo->pBuf, tsQueryAsyncSpill);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _error;
+  }
+
   pInfo->rowCapacity =
       blockDataGetCapacityInRow(pInfo->binfo.pRes, getBufPageSize(pInfo->pBuf),
                                 blockDataGetSerialMetaSize(taosArrayGetSize(pInfo->binfo.pRes->pDataBlock)));
@@ -1201,7 +1435,7 @@ int32_t createPartitionOperatorInfo(SOperatorInfo* downstream, SPartitionPhysiNo
                   pTaskInfo);
 
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, hashPartitionNext, NULL, destroyPartitionOperatorInfo,
-                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+                                         optrDefaultBufFn, getPartitionExplainExecInfo, optrDefaultGetNextExtFn, NULL);
 
   code = appendDownstream(pOperator, &downstream, 1);
   if (code != TSDB_CODE_SUCCESS) {
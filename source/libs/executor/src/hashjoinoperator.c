@@ -164,6 +164,7 @@ static int32_t hJoinInitKeyColsInfo(SHJoinTableCtx* pTable, SNodeList* pList) {
   FOREACH(pNode, pList) {
     SColumnNode* pColNode = (SColumnNode*)pNode;
     pTable->keyCols[i].srcSlot = pColNode->slotId;
+    pTable->keyCols[i].type = pColNode->node.resType.type;
     pTable->keyCols[i].vardata = IS_VAR_DATA_TYPE(pColNode->node.resType.type);
     pTable->keyCols[i].bytes = pColNode->node.resType.bytes;
     bufSize += pColNode->node.resType.bytes;
@@ -932,6 +933,54 @@ static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone)
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t hJoinPublishRuntimeFilter(struct SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinTableCtx*     pBuild = pJoin->pBuild;
+  SHJoinTableCtx*     pProbe = pJoin->pProbe;
+
+  // only rows of inner join can be dropped before probing, and the key must be read by the scan as it is
+  if (!IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) || 1 != pProbe->keyNum || NULL != pProbe->primExpr) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SOperatorInfo* pDownstream = pOperator->pDownstream[pProbe->downStreamIdx];
+  if (QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN != pDownstream->operatorType) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int8_t type = pProbe->keyCols[0].type;
+  if (!rtFilterIsSupportedType(type) || type != pBuild->keyCols[0].type) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t keyNum = tSimpleHashGetSize(pJoin->pKeyHash);
+  if (keyNum <= 0 || keyNum > RT_FILTER_MAX_KEYS) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SRuntimeFilter* pFilter = NULL;
+  HJ_ERR_RET(rtFilterCreate(pProbe->keyCols[0].srcSlot, type, pProbe->keyCols[0].bytes, keyNum, &pFilter));
+
+  SGroupData* pGroup = NULL;
+  int32_t     iter = 0;
+  while (NULL != (pGroup = tSimpleHashIterate(pJoin->pKeyHash, pGroup, &iter))) {
+    int32_t code = rtFilterPutKey(pFilter, tSimpleHashGetKey(pGroup, NULL));
+    if (code) {
+      rtFilterDestroy(pFilter);
+      return code;
+    }
+  }
+
+  if (setTableScanRuntimeFilter(pDownstream, pFilter)) {
+    qDebug("%s hash join skip runtime filter on probe table", GET_TASKID(pOperator->pTaskInfo));
+    rtFilterDestroy(pFilter);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pJoin->execInfo.rtFilterKeys = keyNum;
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t hJoinPrepareStart(struct SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SHJoinTableCtx* pProbe = pJoin->pProbe;
@@ -1017,6 +1066,9 @@ static int32_t hJoinMainProcess(struct SOperatorInfo* pOperator, SSDataBlock** p
     if (queryDone) {
       goto _end;
     }
+
+    code = hJoinPublishRuntimeFilter(pOperator);
+    QUERY_CHECK_CODE(code, lino, _end);
   }
 
   blockDataCleanup(pRes);
@@ -1081,9 +1133,9 @@ _end:
 
 static void destroyHashJoinOperator(void* param) {
   SHJoinOperatorInfo* pJoinOperator = (SHJoinOperatorInfo*)param;
-  qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64, 
+  qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64 ", rtFilterKeys:%" PRId64, 
          pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum, 
-         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows);
+         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows, pJoinOperator->execInfo.rtFilterKeys);
 
   hJoinDestroyKeyHash(&pJoinOperator->pKeyHash);
 
@@ -1199,6 +1251,7 @@ int32_t createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t numOfDow
   HJ_ERR_JRET(hJoinInitBufPages(pInfo));
 
   size_t hashCap = pInfo->pBuild->inputStat.inputRowNum > 0 ? (pInfo->pBuild->inputStat.inputRowNum * 1.5) : 1024;
+  hashCap = TMIN(hashCap, HJOIN_MAX_INIT_HASH_CAP);
   pInfo->pKeyHash = tSimpleHashInit(hashCap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
   if (pInfo->pKeyHash == NULL) {
     code = TSDB_CODE_OUT_OF_MEMORY;
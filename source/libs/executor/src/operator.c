@@ -257,6 +257,7 @@ static ERetType doStopDataReader(SOperatorInfo* pOperator, STraverParam* pParam,
     if (pInfo->base.dataReader != NULL) {
       pAPI->tsdReader.tsdReaderNotifyClosing(pInfo->base.dataReader);
     }
+    tableScanReadAheadNotifyClosing(pInfo->pReadAhead);
     return OPTR_FN_RET_ABORT;
   } else if (pOperator->operatorType == QUERY_NODE_PHYSICAL_PLAN_STREAM_SCAN) {
     SStreamScanInfo* pInfo = pOperator->info;
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "runtimefilter.h"
+#include "executorInt.h"
+#include "tdatablock.h"
+#include "ttypes.h"
+
+static FORCE_INLINE int64_t rtFilterGetKeyVal(int8_t type, const char* pData) {
+  int64_t v = 0;
+  GET_TYPED_DATA(v, int64_t, type, pData);
+  return v;
+}
+
+static FORCE_INLINE bool rtFilterKeyLessThan(int8_t type, int64_t left, int64_t right) {
+  if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
+    return (uint64_t)left < (uint64_t)right;
+  }
+  return left < right;
+}
+
+static FORCE_INLINE bool rtFilterKeyInRange(SRuntimeFilter* pFilter, int64_t v) {
+  return !rtFilterKeyLessThan(pFilter->type, v, pFilter->min) && !rtFilterKeyLessThan(pFilter->type, pFilter->max, v);
+}
+
+static FORCE_INLINE bool rtFilterBloomMayContain(SRuntimeFilter* pFilter, int64_t v) {
+  if (NULL == pFilter->pBloom) {
+    return true;
+  }
+
+  uint64_t h1 = (uint64_t)pFilter->pBloom->hashFn1((const char*)&v, sizeof(v));
+  uint64_t h2 = (uint64_t)pFilter->pBloom->hashFn2((const char*)&v, sizeof(v));
+  return TSDB_CODE_SUCCESS != tBloomFilterNoContain(pFilter->pBloom, h1, h2);
+}
+
+bool rtFilterIsSupportedType(int8_t type) { return IS_INTEGER_TYPE(type) || IS_TIMESTAMP_TYPE(type); }
+
+int32_t rtFilterCreate(int32_t slotId, int8_t type, int32_t bytes, int64_t expectedKeys, SRuntimeFilter** ppFilter) {
+  *ppFilter = NULL;
+  if (!rtFilterIsSupportedType(type) || expectedKeys <= 0 || expectedKeys > RT_FILTER_MAX_KEYS) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  SRuntimeFilter* pFilter = taosMemoryCalloc(1, sizeof(SRuntimeFilter));
+  if (NULL == pFilter) {
+    return terrno;
+  }
+
+  pFilter->slotId = slotId;
+  pFilter->type = type;
+  pFilter->bytes = bytes;
+
+  int32_t code = tBloomFilterInit(expectedKeys, RT_FILTER_BLOOM_ERROR_RATE, &pFilter->pBloom);
+  if (code) {
+    taosMemoryFree(pFilter);
+    return code;
+  }
+
+  *ppFilter = pFilter;
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t rtFilterPutKey(SRuntimeFilter* pFilter, const char* pKey) {
+  int64_t v = rtFilterGetKeyVal(pFilter->type, pKey);
+  if (0 == pFilter->keyNum) {
+    pFilter->min = v;
+    pFilter->max = v;
+  } else if (rtFilterKeyLessThan(pFilter->type, v, pFilter->min)) {
+    pFilter->min = v;
+  } else if (rtFilterKeyLessThan(pFilter->type, pFilter->max, v)) {
+    pFilter->max = v;
+  }
+
+  pFilter->keyNum++;
+
+  // duplicated keys are reported as failure by the bloom filter, which is harmless here
+  (void)tBloomFilterPut(pFilter->pBloom, &v, sizeof(v));
+  return TSDB_CODE_SUCCESS;
+}
+
+bool rtFilterBlockMayMatch(SRuntimeFilter* pFilter, const SColumnDataAgg* pAgg) {
+  if (NULL == pFilter || NULL == pAgg || pAgg->colId == -1) {
+    return true;
+  }
+
+  if (rtFilterKeyLessThan(pFilter->type, pAgg->max, pFilter->min) ||
+      rtFilterKeyLessThan(pFilter->type, pFilter->max, pAgg->min)) {
+    pFilter->filterOutBlocks++;
+    return false;
+  }
+
+  return true;
+}
+
+int32_t rtFilterApplyToBlock(SRuntimeFilter* pFilter, SSDataBlock* pBlock) {
+  int32_t rows = pBlock->info.rows;
+  if (NULL == pFilter || rows <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pFilter->slotId);
+  if (NULL == pCol || pCol->info.type != pFilter->type) {
+    qError("runtime filter column mismatch, slotId:%d, type:%d", pFilter->slotId, pFilter->type);
+    return TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR;
+  }
+
+  bool* pKeep = taosMemoryMalloc(rows * sizeof(bool));
+  if (NULL == pKeep) {
+    return terrno;
+  }
+
+  int32_t keepRows = 0;
+  for (int32_t i = 0; i < rows; ++i) {
+    // null keys never match an inner join
+    if (colDataIsNull_f(pCol->nullbitmap, i)) {
+      pKeep[i] = false;
+      continue;
+    }
+
+    int64_t v = rtFilterGetKeyVal(pFilter->type, colDataGetData(pCol, i));
+    pKeep[i] = rtFilterKeyInRange(pFilter, v) && rtFilterBloomMayContain(pFilter, v);
+    if (pKeep[i]) {
+      keepRows++;
+    }
+  }
+
+  pFilter->checkedRows += rows;
+  pFilter->filterOutRows += rows - keepRows;
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (keepRows < rows) {
+    code = trimDataBlock(pBlock, rows, pKeep);
+  }
+
+  taosMemoryFree(pKeep);
+  return code;
+}
+
+void rtFilterDestroy(SRuntimeFilter* pFilter) {
+  if (NULL == pFilter) {
+    return;
+  }
+
+  qDebug("runtime filter destroyed, keys:%" PRId64 ", checkedRows:%" PRId64 ", filterOutRows:%" PRId64
+         ", filterOutBlocks:%" PRId64,
+         pFilter->keyNum, pFilter->checkedRows, pFilter->filterOutRows, pFilter->filterOutBlocks);
+  tBloomFilterDestroy(pFilter->pBloom);
+  taosMemoryFree(pFilter);
+}
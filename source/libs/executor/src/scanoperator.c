@@ -33,6 +33,7 @@
 #include "tcompare.h"
 #include "thash.h"
 #include "ttypes.h"
+#include "tworker.h"
 
 #include "storageapi.h"
 #include "wal.h"
@@ -40,6 +41,8 @@
 int32_t scanDebug = 0;
 
 #define MULTI_READER_MAX_TABLE_NUM     5000
+#define SCAN_READ_AHEAD_MAX_BLOCKS     4
+#define RT_FILTER_SMA_MAX_MISS         32  // stop loading block SMA for the runtime filter after so many useless loads
 #define SET_REVERSE_SCAN_FLAG(_info)   ((_info)->scanFlag = REVERSE_SCAN)
 #define SWITCH_ORDER(n)                (((n) = ((n) == TSDB_ORDER_ASC) ? TSDB_ORDER_DESC : TSDB_ORDER_ASC))
 #define STREAM_SCAN_OP_NAME            "StreamScanOperator"
@@ -280,6 +283,119 @@ static int32_t doLoadBlockSMA(STableScanBase* pTableScanInfo, SSDataBlock* pBloc
   return code;
 }
 
+// The time range of the block is always known, so a filter on the primary timestamp never needs the block SMA. For
+// other keys the SMA is loaded only while it keeps pruning blocks, since the key range of the build side may well
+// cover every block of the probe side.
+static int32_t doFilterByRuntimeFilter(STableScanBase* pTableScanInfo, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo,
+                                       bool* keep) {
+  SRuntimeFilter* pFilter = pTableScanInfo->pRtFilter;
+  int32_t         code = TSDB_CODE_SUCCESS;
+
+  *keep = true;
+  if (pTableScanInfo->rtFilterOnTs) {
+    SColumnDataAgg agg = {.colId = PRIMARYKEY_TIMESTAMP_COL_ID,
+                          .min = pBlock->info.window.skey,
+                          .max = pBlock->info.window.ekey};
+    *keep = rtFilterBlockMayMatch(pFilter, &agg);
+    return code;
+  }
+
+  bool loaded = false;
+  if (pBlock->pBlockAgg == NULL) {
+    if (pTableScanInfo->rtFilterSmaMiss >= RT_FILTER_SMA_MAX_MISS) {
+      return code;
+    }
+
+    bool success = true;
+    code = doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo, &success);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    loaded = (pBlock->pBlockAgg != NULL);
+  }
+
+  if (pBlock->pBlockAgg == NULL || pFilter->slotId >= taosArrayGetSize(pBlock->pDataBlock)) {
+    return code;
+  }
+
+  *keep = rtFilterBlockMayMatch(pFilter, &pBlock->pBlockAgg[pFilter->slotId]);
+  if (!*keep) {
+    pTableScanInfo->rtFilterSmaMiss = 0;
+  } else if (loaded) {
+    pTableScanInfo->rtFilterSmaMiss += 1;
+  }
+
+  return code;
+}
+
+static int32_t doApplyRuntimeFilter(STableScanBase* pTableScanInfo, SSDataBlock* pBlock) {
+  int64_t rows = pBlock->info.rows;
+  int32_t code = rtFilterApplyToBlock(pTableScanInfo->pRtFilter, pBlock);
+  if (code != TSDB_CODE_SUCCESS || pBlock->info.rows == rows) {
+    return code;
+  }
+
+  pTableScanInfo->readRecorder.rtFilterOutRows += rows - pBlock->info.rows;
+  if (pBlock->info.rows == 0) {
+    return code;
+  }
+
+  size_t size = taosArrayGetSize(pTableScanInfo->matchInfo.pList);
+  for (int32_t i = 0; i < size; ++i) {
+    SColMatchItem* pItem = taosArrayGet(pTableScanInfo->matchInfo.pList, i);
+    if (pItem != NULL && pItem->colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
+      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, pItem->dstSlotId);
+      if (pColData != NULL && pColData->info.type == TSDB_DATA_TYPE_TIMESTAMP) {
+        code = blockDataUpdateTsWindow(pBlock, pItem->dstSlotId);
+      }
+      break;
+    }
+  }
+
+  return code;
+}
+
+int32_t setTableScanRuntimeFilter(SOperatorInfo* pOperator, SRuntimeFilter* pFilter) {
+  if (pOperator->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  STableScanInfo*  pInfo = pOperator->info;
+  SColumnInfoData* pCol = taosArrayGet(pInfo->pResBlock->pDataBlock, pFilter->slotId);
+  if (NULL == pCol || pCol->info.type != pFilter->type) {
+    qError("%s invalid runtime filter, slotId:%d, type:%d", GET_TASKID(pOperator->pTaskInfo), pFilter->slotId,
+           pFilter->type);
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  // the limit/offset pushed down to the scan counts the rows of the table, dropping rows ahead of it changes the result
+  SLimitInfo* pLimitInfo = &pInfo->base.limitInfo;
+  if (pLimitInfo->limit.limit >= 0 || pLimitInfo->limit.offset > 0 || pLimitInfo->slimit.limit >= 0 ||
+      pLimitInfo->slimit.offset > 0) {
+    qDebug("%s runtime filter not set to table scan with limit/offset", GET_TASKID(pOperator->pTaskInfo));
+    return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+  bool   onTs = false;
+  size_t size = taosArrayGetSize(pInfo->base.matchInfo.pList);
+  for (int32_t i = 0; i < size; ++i) {
+    SColMatchItem* pItem = taosArrayGet(pInfo->base.matchInfo.pList, i);
+    if (pItem != NULL && pItem->dstSlotId == pFilter->slotId) {
+      onTs = (pItem->colId == PRIMARYKEY_TIMESTAMP_COL_ID);
+      break;
+    }
+  }
+
+  rtFilterDestroy(pInfo->base.pRtFilter);
+  pInfo->base.pRtFilter = pFilter;
+  pInfo->base.rtFilterOnTs = onTs;
+  pInfo->base.rtFilterSmaMiss = 0;
+
+  qDebug("%s runtime filter set to table scan, slotId:%d, keys:%" PRId64, GET_TASKID(pOperator->pTaskInfo),
+         pFilter->slotId, pFilter->keyNum);
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t doSetTagColumnData(STableScanBase* pTableScanInfo, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo,
                                   int32_t rows) {
   int32_t    code = 0;
@@ -331,6 +447,58 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
   return false;
 }
 
+// apply the tags, the runtime filter, the filter and the limit to a data block whose columns are all loaded
+static int32_t doApplyLoadedDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock) {
+  int32_t                 code = TSDB_CODE_SUCCESS;
+  int32_t                 lino = 0;
+  SExecTaskInfo*          pTaskInfo = pOperator->pTaskInfo;
+  SFileBlockLoadRecorder* pCost = &pTableScanInfo->readRecorder;
+  SDataBlockInfo*         pBlockInfo = &pBlock->info;
+
+  code = doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
+  if (code) {
+    return code;
+  }
+
+  // restore the previous value
+  pCost->totalRows -= pBlock->info.rows;
+
+  if (pTableScanInfo->pRtFilter != NULL) {
+    code = doApplyRuntimeFilter(pTableScanInfo, pBlock);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  if (pOperator->exprSupp.pFilterInfo != NULL) {
+    code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    int64_t st = taosGetTimestampUs();
+    double  el = (taosGetTimestampUs() - st) / 1000.0;
+    pTableScanInfo->readRecorder.filterTime += el;
+
+    if (pBlock->info.rows == 0) {
+      pCost->filterOutBlocks += 1;
+      qDebug("%s data block filter out, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64 ", elapsed time:%.2f ms",
+             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows, el);
+    } else {
+      qDebug("%s data block filter applied, elapsed time:%.2f ms", GET_TASKID(pTaskInfo), el);
+    }
+  }
+
+  bool limitReached = applyLimitOffset(&pTableScanInfo->limitInfo, pBlock, pTaskInfo);
+  if (limitReached) {  // set operator flag is done
+    setOperatorCompleted(pOperator);
+  }
+
+  pCost->totalRows += pBlock->info.rows;
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
                              uint32_t* status) {
   int32_t        code = TSDB_CODE_SUCCESS;
@@ -439,6 +607,30 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     }
   }
 
+  // try to filter data block according to the runtime filter published by the join operator
+  if (pTableScanInfo->pRtFilter != NULL) {
+    bool keep = true;
+    code = doFilterByRuntimeFilter(pTableScanInfo, pBlock, pTaskInfo, &keep);
+    if (code) {
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      qError("%s failed to retrieve sma info", GET_TASKID(pTaskInfo));
+      QUERY_CHECK_CODE(code, lino, _end);
+    }
+
+    if (!keep) {
+      qDebug("%s data block filter out by runtime filter, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+      pCost->filterOutBlocks += 1;
+      pCost->rtFilterOutBlocks += 1;
+      pCost->rtFilterOutRows += pBlockInfo->rows;
+      (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
+      taosMemoryFreeClear(pBlock->pBlockAgg);
+
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
   // free the sma info, since it should not be involved in *later computing process.
   taosMemoryFreeClear(pBlock->pBlockAgg);
 
@@ -473,37 +665,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     return code;
   }
 
-  code = doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
-  if (code) {
-    return code;
-  }
-
-  // restore the previous value
-  pCost->totalRows -= pBlock->info.rows;
-
-  if (pOperator->exprSupp.pFilterInfo != NULL) {
-    code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
-    QUERY_CHECK_CODE(code, lino, _end);
-
-    int64_t st = taosGetTimestampUs();
-    double  el = (taosGetTimestampUs() - st) / 1000.0;
-    pTableScanInfo->readRecorder.filterTime += el;
-
-    if (pBlock->info.rows == 0) {
-      pCost->filterOutBlocks += 1;
-      qDebug("%s data block filter out, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64 ", elapsed time:%.2f ms",
-             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows, el);
-    } else {
-      qDebug("%s data block filter applied, elapsed time:%.2f ms", GET_TASKID(pTaskInfo), el);
-    }
-  }
-
-  bool limitReached = applyLimitOffset(&pTableScanInfo->limitInfo, pBlock, pTaskInfo);
-  if (limitReached) {  // set operator flag is done
-    setOperatorCompleted(pOperator);
-  }
-
-  pCost->totalRows += pBlock->info.rows;
+  return doApplyLoadedDataBlock(pOperator, pTableScanInfo, pBlock);
 
 _end:
   if (code != TSDB_CODE_SUCCESS) {
@@ -926,6 +1088,478 @@ static SSDataBlock* getBlockForEmptyTable(SOperatorInfo* pOperator, const STable
   return pBlock;
 }
 
+static bool isTableScanReadAheadAllowed(SOperatorInfo* pOperator, int32_t numOfTables) {
+  STableScanInfo* pInfo = pOperator->info;
+  STableScanBase* pBase = &pInfo->base;
+
+  // the blocks are read ahead with all columns loaded, so the scan that relies on the block sma or skips the block
+  // data, the repeated scan and the limited scan are still served by the data reader of the operator only.
+  return tsNumOfScanThreads > 1 && numOfTables == 1 && pOperator->pTaskInfo->execModel == OPTR_EXEC_MODEL_BATCH &&
+         !pOperator->dynamicTask && pInfo->scanMode == TABLE_SCAN__BLOCK_ORDER && !pInfo->filesetDelimited &&
+         (pInfo->scanInfo.numOfAsc + pInfo->scanInfo.numOfDesc) == 1 &&
+         pBase->dataBlockLoadFlag == FUNC_DATA_REQUIRED_DATA_LOAD && !pBase->cond.notLoadData &&
+         pBase->cond.type == TIMEWINDOW_RANGE_CONTAINED && pBase->limitInfo.limit.limit < 0 &&
+         tableListGetOutputGroups(pBase->pTableListInfo) == 1;
+}
+
+static void releaseTableScanReadAhead(STableScanReadAhead* pReadAhead) {
+  if (atomic_sub_fetch_32(&pReadAhead->ref, 1) > 0) {
+    return;
+  }
+
+  (void)taosThreadCondDestroy(&pReadAhead->cond);
+  (void)taosThreadMutexDestroy(&pReadAhead->lock);
+  taosMemoryFree(pReadAhead->pWindows);
+  taosMemoryFree(pReadAhead);
+}
+
+static int32_t doReadAheadScanWindow(STableScanReadAhead* pReadAhead, STableScanWindow* pWin) {
+  TsdReader* pAPI = pReadAhead->pAPI;
+  int32_t    code = TSDB_CODE_SUCCESS;
+  bool       hasNext = false;
+
+  while (true) {
+    code = pAPI->tsdNextDataBlock(pWin->pReader, &hasNext);
+    if (code != TSDB_CODE_SUCCESS || !hasNext) {
+      break;
+    }
+
+    SSDataBlock* p = NULL;
+    code = pAPI->tsdReaderRetrieveDataBlock(pWin->pReader, &p, NULL);
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+
+    SSDataBlock* pCopy = NULL;
+    if (p != NULL) {
+      code = createOneDataBlock(p, true, &pCopy);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+    }
+
+    bool blocked = false;
+    (void)taosThreadMutexLock(&pReadAhead->lock);
+    while (!pReadAhead->closing && taosArrayGetSize(pWin->pBlocks) >= SCAN_READ_AHEAD_MAX_BLOCKS) {
+      if (!blocked) {
+        blocked = true;
+        (void)tQueryJobBeforeBlocking();
+      }
+      (void)taosThreadCondWait(&pReadAhead->cond, &pReadAhead->lock);
+    }
+
+    bool closing = pReadAhead->closing;
+    if (!closing && pCopy != NULL) {
+      if (taosArrayPush(pWin->pBlocks, &pCopy) != NULL) {
+        pCopy = NULL;
+        (void)taosThreadCondBroadcast(&pReadAhead->cond);
+      } else {
+        code = terrno;
+      }
+    }
+    (void)taosThreadMutexUnlock(&pReadAhead->lock);
+
+    if (blocked) {
+      (void)tQueryJobAfterBlocking();
+    }
+
+    blockDataDestroy(pCopy);
+    if (closing || code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+  }
+
+  return code;
+}
+
+static void tableScanReadAheadTaskFp(void* param) {
+  STableScanWindow*    pWin = param;
+  STableScanReadAhead* pReadAhead = pWin->pParent;
+
+  (void)taosThreadMutexLock(&pReadAhead->lock);
+  bool run = !pReadAhead->closing && pWin->state == SCAN_WINDOW_PENDING;
+  if (run) {
+    pWin->state = SCAN_WINDOW_RUNNING;
+  }
+  (void)taosThreadMutexUnlock(&pReadAhead->lock);
+
+  if (run) {
+    int32_t code = doReadAheadScanWindow(pReadAhead, pWin);
+
+    (void)taosThreadMutexLock(&pReadAhead->lock);
+    pWin->code = code;
+    pWin->state = SCAN_WINDOW_DONE;
+    (void)taosThreadCondBroadcast(&pReadAhead->cond);
+    (void)taosThreadMutexUnlock(&pReadAhead->lock);
+  }
+
+  // the window is not touched any more, the operator may have released the read-ahead already
+  releaseTableScanReadAhead(pReadAhead);
+}
+
+int32_t tableScanReadAheadCreate(TsdReader* pAPI, int32_t numOfWindows, STableScanReadAhead** ppReadAhead) {
+  int32_t              code = TSDB_CODE_SUCCESS;
+  int32_t              lino = 0;
+  STableScanReadAhead* pReadAhead = taosMemoryCalloc(1, sizeof(STableScanReadAhead));
+  QUERY_CHECK_NULL(pReadAhead, code, lino, _end, terrno);
+
+  pReadAhead->pWindows = taosMemoryCalloc(numOfWindows, sizeof(STableScanWindow));
+  QUERY_CHECK_NULL(pReadAhead->pWindows, code, lino, _end, terrno);
+
+  code = taosThreadMutexInit(&pReadAhead->lock, NULL);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  code = taosThreadCondInit(&pReadAhead->cond, NULL);
+  if (code != TSDB_CODE_SUCCESS) {
+    (void)taosThreadMutexDestroy(&pReadAhead->lock);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  pReadAhead->pAPI = pAPI;
+  pReadAhead->current = -1;
+  pReadAhead->ref = 1;
+  pReadAhead->numOfWindows = numOfWindows;
+  for (int32_t i = 0; i < numOfWindows; ++i) {
+    STableScanWindow* pWin = &pReadAhead->pWindows[i];
+    pWin->pParent = pReadAhead;
+    pWin->pBlocks = taosArrayInit(SCAN_READ_AHEAD_MAX_BLOCKS, POINTER_BYTES);
+    if (pWin->pBlocks == NULL) {
+      code = terrno;
+      tableScanReadAheadDestroy(pReadAhead);
+      pReadAhead = NULL;
+      QUERY_CHECK_CODE(code, lino, _end);
+    }
+  }
+
+  *ppReadAhead = pReadAhead;
+  return code;
+
+_end:
+  qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  if (pReadAhead != NULL) {
+    taosMemoryFree(pReadAhead->pWindows);
+    taosMemoryFree(pReadAhead);
+  }
+  return code;
+}
+
+/**
+ * Submit the sub-windows to the query job pool. A sub-window that is not submitted, or not picked up by the pool before
+ * the operator reaches it, is read by the operator itself, so the scan never waits behind the jobs of other queries.
+ * Nothing is read ahead while the pool has more jobs queued than threads.
+ */
+void tableScanReadAheadStart(STableScanReadAhead* pReadAhead) {
+  for (int32_t i = 0; i < pReadAhead->numOfWindows; ++i) {
+    if (tQueryJobPending() >= tQueryJobThreads()) {
+      break;
+    }
+
+    (void)atomic_add_fetch_32(&pReadAhead->ref, 1);
+    if (tQueryJobSubmit(tableScanReadAheadTaskFp, &pReadAhead->pWindows[i]) != TSDB_CODE_SUCCESS) {
+      (void)atomic_sub_fetch_32(&pReadAhead->ref, 1);
+      break;
+    }
+  }
+}
+
+static int32_t nextScanWindowBlock(TsdReader* pAPI, STableScanWindow* pWin, SSDataBlock* pBlock, bool* hasNext) {
+  while (true) {
+    int32_t code = pAPI->tsdNextDataBlock(pWin->pReader, hasNext);
+    if (code != TSDB_CODE_SUCCESS || !(*hasNext)) {
+      return code;
+    }
+
+    SSDataBlock* p = NULL;
+    code = pAPI->tsdReaderRetrieveDataBlock(pWin->pReader, &p, NULL);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+
+    if (p != NULL) {
+      return copyDataBlock(pBlock, p);
+    }
+  }
+}
+
+int32_t tableScanReadAheadNext(STableScanReadAhead* pReadAhead, SSDataBlock* pBlock, bool* hasNext) {
+  int32_t      code = TSDB_CODE_SUCCESS;
+  SSDataBlock* p = NULL;
+
+  *hasNext = false;
+  (void)taosThreadMutexLock(&pReadAhead->lock);
+  while (pReadAhead->current < pReadAhead->numOfWindows) {
+    STableScanWindow* pWin = &pReadAhead->pWindows[pReadAhead->current];
+    if (pWin->state == SCAN_WINDOW_PENDING) {
+      pWin->state = SCAN_WINDOW_FOREGROUND;
+    }
+
+    if (pWin->state == SCAN_WINDOW_FOREGROUND) {
+      (void)taosThreadMutexUnlock(&pReadAhead->lock);
+      code = nextScanWindowBlock(pReadAhead->pAPI, pWin, pBlock, hasNext);
+      if (code != TSDB_CODE_SUCCESS || *hasNext) {
+        return code;
+      }
+
+      (void)taosThreadMutexLock(&pReadAhead->lock);
+      pWin->state = SCAN_WINDOW_DONE;
+      pReadAhead->current += 1;
+      continue;
+    }
+
+    if (taosArrayGetSize(pWin->pBlocks) > 0) {
+      p = *(SSDataBlock**)taosArrayGet(pWin->pBlocks, 0);
+      taosArrayRemove(pWin->pBlocks, 0);
+      (void)taosThreadCondBroadcast(&pReadAhead->cond);
+      break;
+    }
+
+    if (pWin->state == SCAN_WINDOW_DONE) {
+      code = pWin->code;
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+      pReadAhead->current += 1;
+      continue;
+    }
+
+    (void)taosThreadCondWait(&pReadAhead->cond, &pReadAhead->lock);
+  }
+  (void)taosThreadMutexUnlock(&pReadAhead->lock);
+
+  if (p != NULL) {
+    code = copyDataBlock(pBlock, p);
+    blockDataDestroy(p);
+    *hasNext = (code == TSDB_CODE_SUCCESS);
+  }
+
+  return code;
+}
+
+void tableScanReadAheadNotifyClosing(STableScanReadAhead* pReadAhead) {
+  if (pReadAhead == NULL) {
+    return;
+  }
+
+  (void)taosThreadMutexLock(&pReadAhead->lock);
+  for (int32_t i = 0; i < pReadAhead->numOfWindows; ++i) {
+    STableScanWindow* pWin = &pReadAhead->pWindows[i];
+    if (pWin->pReader != NULL &&
+        (pWin->state == SCAN_WINDOW_RUNNING || pWin->state == SCAN_WINDOW_FOREGROUND)) {
+      pReadAhead->pAPI->tsdReaderNotifyClosing(pWin->pReader);
+    }
+  }
+  (void)taosThreadMutexUnlock(&pReadAhead->lock);
+}
+
+void tableScanReadAheadDestroy(STableScanReadAhead* pReadAhead) {
+  if (pReadAhead == NULL) {
+    return;
+  }
+
+  // the pending windows are dropped, and the running ones stop at the next block
+  (void)taosThreadMutexLock(&pReadAhead->lock);
+  pReadAhead->closing = true;
+  for (int32_t i = 0; i < pReadAhead->numOfWindows; ++i) {
+    STableScanWindow* pWin = &pReadAhead->pWindows[i];
+    if (pWin->state == SCAN_WINDOW_PENDING) {
+      pWin->state = SCAN_WINDOW_DONE;
+    } else if (pWin->state == SCAN_WINDOW_RUNNING) {
+      pReadAhead->pAPI->tsdReaderNotifyClosing(pWin->pReader);
+    }
+  }
+  (void)taosThreadCondBroadcast(&pReadAhead->cond);
+
+  for (int32_t i = 0; i < pReadAhead->numOfWindows; ++i) {
+    while (pReadAhead->pWindows[i].state == SCAN_WINDOW_RUNNING) {
+      (void)taosThreadCondWait(&pReadAhead->cond, &pReadAhead->lock);
+    }
+  }
+  (void)taosThreadMutexUnlock(&pReadAhead->lock);
+
+  for (int32_t i = 0; i < pReadAhead->numOfWindows; ++i) {
+    STableScanWindow* pWin = &pReadAhead->pWindows[i];
+    pReadAhead->pAPI->tsdReaderClose(pWin->pReader);
+    pWin->pReader = NULL;
+    blockDataDestroy(pWin->pReaderBlock);
+    pWin->pReaderBlock = NULL;
+    taosArrayDestroyP(pWin->pBlocks, (FDelete)blockDataDestroy);
+    pWin->pBlocks = NULL;
+  }
+
+  releaseTableScanReadAhead(pReadAhead);
+}
+
+static int32_t createTableScanReadAhead(SOperatorInfo* pOperator, SArray* pKeys, int32_t numOfWindows,
+                                        STableKeyInfo* pList, int32_t num, STableScanReadAhead** ppReadAhead,
+                                        STimeWindow* pFirst) {
+  int32_t              code = TSDB_CODE_SUCCESS;
+  int32_t              lino = 0;
+  STableScanInfo*      pInfo = pOperator->info;
+  SExecTaskInfo*       pTaskInfo = pOperator->pTaskInfo;
+  TsdReader*           pAPI = &pTaskInfo->storageAPI.tsdReader;
+  STimeWindow*         pRange = &pInfo->base.cond.twindows;
+  bool                 asc = (pInfo->base.cond.order == TSDB_ORDER_ASC);
+  int32_t              numOfFsets = taosArrayGetSize(pKeys);
+  STableScanReadAhead* pReadAhead = NULL;
+
+  code = tableScanReadAheadCreate(pAPI, numOfWindows - 1, &pReadAhead);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  // all the sub-windows read the same version as the data reader of the operator
+  int64_t endVersion = (int64_t)pAPI->tsdReaderGetMaxVersion(pInfo->base.dataReader);
+
+  // each sub-window starts at a file set boundary, and the windows are consumed in the scan order
+  for (int32_t i = 0; i < numOfWindows; ++i) {
+    STimeWindow w = {.skey = pRange->skey, .ekey = pRange->ekey};
+    if (i > 0) {
+      w.skey = *(TSKEY*)taosArrayGet(pKeys, (int64_t)i * numOfFsets / numOfWindows);
+    }
+    if (i < numOfWindows - 1) {
+      w.ekey = *(TSKEY*)taosArrayGet(pKeys, (int64_t)(i + 1) * numOfFsets / numOfWindows) - 1;
+    }
+
+    int32_t seq = asc ? i : (numOfWindows - 1 - i);
+    if (seq == 0) {
+      *pFirst = w;
+      continue;
+    }
+
+    STableScanWindow* pWin = &pReadAhead->pWindows[seq - 1];
+    pWin->cond = pInfo->base.cond;
+    pWin->cond.twindows = w;
+    pWin->cond.endVersion = endVersion;
+  }
+
+  for (int32_t i = 0; i < pReadAhead->numOfWindows; ++i) {
+    STableScanWindow* pWin = &pReadAhead->pWindows[i];
+    code = createOneDataBlock(pInfo->pResBlock, false, &pWin->pReaderBlock);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    code = pAPI->tsdReaderOpen(pInfo->base.readHandle.vnode, &pWin->cond, pList, num, pWin->pReaderBlock,
+                               (void**)&pWin->pReader, GET_TASKID(pTaskInfo), NULL);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  *ppReadAhead = pReadAhead;
+  return code;
+
+_end:
+  qError("%s %s failed at line %d since %s", GET_TASKID(pTaskInfo), __func__, lino, tstrerror(code));
+  tableScanReadAheadDestroy(pReadAhead);
+  return code;
+}
+
+/**
+ * Split the scan window of a single table by the file set boundaries, and read the sub-windows after the first one
+ * ahead in background threads. A failure in preparing the read-ahead falls back to the sequential scan.
+ */
+static int32_t initTableScanReadAhead(SOperatorInfo* pOperator, STableKeyInfo* pList, int32_t num) {
+  int32_t              code = TSDB_CODE_SUCCESS;
+  int32_t              lino = 0;
+  STableScanInfo*      pInfo = pOperator->info;
+  SExecTaskInfo*       pTaskInfo = pOperator->pTaskInfo;
+  TsdReader*           pAPI = &pTaskInfo->storageAPI.tsdReader;
+  STableScanReadAhead* pReadAhead = NULL;
+  STimeWindow          first = {0};
+  SArray*              pKeys = NULL;
+
+  if (!isTableScanReadAheadAllowed(pOperator, num) || pInfo->base.dataReader == NULL) {
+    return code;
+  }
+
+  pKeys = taosArrayInit(16, sizeof(TSKEY));
+  QUERY_CHECK_NULL(pKeys, code, lino, _end, terrno);
+
+  code = pAPI->tsdReaderGetFilesetKeys(pInfo->base.dataReader, pKeys);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  int32_t numOfWindows = TMIN(tsNumOfScanThreads, taosArrayGetSize(pKeys));
+  if (numOfWindows <= 1) {
+    goto _end;
+  }
+
+  if (createTableScanReadAhead(pOperator, pKeys, numOfWindows, pList, num, &pReadAhead, &first) != 0) {
+    qWarn("%s failed to prepare the table scan read-ahead, scan sequentially", GET_TASKID(pTaskInfo));
+    goto _end;
+  }
+
+  SQueryTableDataCond cond = pInfo->base.cond;
+  cond.twindows = first;
+  code = pAPI->tsdReaderResetStatus(pInfo->base.dataReader, &cond);
+  if (code != TSDB_CODE_SUCCESS) {
+    tableScanReadAheadDestroy(pReadAhead);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  tableScanReadAheadStart(pReadAhead);
+  pInfo->pReadAhead = pReadAhead;
+  qDebug("%s table scan is split into %d windows by %d file sets, first window:%" PRId64 "-%" PRId64,
+         GET_TASKID(pTaskInfo), numOfWindows, (int32_t)taosArrayGetSize(pKeys), first.skey, first.ekey);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s %s failed at line %d since %s", GET_TASKID(pTaskInfo), __func__, lino, tstrerror(code));
+  }
+  taosArrayDestroy(pKeys);
+  return code;
+}
+
+static int32_t doReadAheadTableScanNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
+  int32_t                 code = TSDB_CODE_SUCCESS;
+  int32_t                 lino = 0;
+  STableScanInfo*         pTableScanInfo = pOperator->info;
+  SExecTaskInfo*          pTaskInfo = pOperator->pTaskInfo;
+  SSDataBlock*            pBlock = pTableScanInfo->pResBlock;
+  SFileBlockLoadRecorder* pCost = &pTableScanInfo->base.readRecorder;
+  bool                    hasNext = false;
+  int64_t                 st = taosGetTimestampUs();
+
+  while (true) {
+    code = tableScanReadAheadNext(pTableScanInfo->pReadAhead, pBlock, &hasNext);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    if (!hasNext || pOperator->status == OP_EXEC_DONE) {
+      break;
+    }
+
+    if (isTaskKilled(pTaskInfo)) {
+      code = pTaskInfo->code;
+      goto _end;
+    }
+
+    if (pBlock->info.id.uid) {
+      pBlock->info.id.groupId = tableListGetTableGroupId(pTableScanInfo->base.pTableListInfo, pBlock->info.id.uid);
+    }
+
+    pCost->totalBlocks += 1;
+    pCost->totalRows += pBlock->info.rows;
+    pCost->totalCheckedRows += pBlock->info.rows;
+    pCost->loadBlocks += 1;
+
+    code = doApplyLoadedDataBlock(pOperator, &pTableScanInfo->base, pBlock);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    if (pBlock->info.rows == 0) {
+      continue;
+    }
+
+    pOperator->resultInfo.totalRows = pCost->totalRows;
+    pCost->elapsedTime += (taosGetTimestampUs() - st) / 1000.0;
+
+    pOperator->cost.totalCost = pCost->elapsedTime;
+    pBlock->info.scanFlag = pTableScanInfo->base.scanFlag;
+
+    (*ppRes) = pBlock;
+    return code;
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 static int32_t doTableScanImplNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
   int32_t         code = TSDB_CODE_SUCCESS;
   int32_t         lino = 0;
@@ -939,6 +1573,12 @@ static int32_t doTableScanImplNext(SOperatorInfo* pOperator, SSDataBlock** ppRes
   QRY_PARAM_CHECK(ppRes);
   pBlock->info.dataLoad = false;
 
+  if (pTableScanInfo->pReadAhead != NULL && pTableScanInfo->pReadAhead->current >= 0) {
+    code = doReadAheadTableScanNext(pOperator, ppRes);
+    QUERY_CHECK_CODE(code, lino, _end);
+    return code;
+  }
+
   while (true) {
     code = pAPI->tsdReader.tsdNextDataBlock(pTableScanInfo->base.dataReader, &hasNext);
     if (code != TSDB_CODE_SUCCESS) {
@@ -947,6 +1587,13 @@ static int32_t doTableScanImplNext(SOperatorInfo* pOperator, SSDataBlock** ppRes
     }
 
     if (!hasNext) {
+      // the first window is exhausted, continue with the windows read ahead by the background threads
+      if (pTableScanInfo->pReadAhead != NULL) {
+        pTableScanInfo->pReadAhead->current = 0;
+        code = doReadAheadTableScanNext(pOperator, ppRes);
+        QUERY_CHECK_CODE(code, lino, _end);
+        return code;
+      }
       break;
     }
 
@@ -1289,6 +1936,9 @@ static int32_t groupSeqTableScan(SOperatorInfo* pOperator, SSDataBlock** pResBlo
       pAPI->tsdReader.tsdSetFilesetDelimited(pInfo->base.dataReader);
     }
 
+    code = initTableScanReadAhead(pOperator, pList, num);
+    QUERY_CHECK_CODE(code, lino, _end);
+
     if (pInfo->pResBlock->info.capacity > pOperator->resultInfo.capacity) {
       pOperator->resultInfo.capacity = pInfo->pResBlock->info.capacity;
     }
@@ -1452,10 +2102,14 @@ static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
   tableListDestroy(pBase->pTableListInfo);
   taosLRUCacheCleanup(pBase->metaCache.pTableMetaEntryCache);
   cleanupExprSupp(&pBase->pseudoSup);
+  rtFilterDestroy(pBase->pRtFilter);
+  pBase->pRtFilter = NULL;
 }
 
 static void destroyTableScanOperatorInfo(void* param) {
   STableScanInfo* pTableScanInfo = (STableScanInfo*)param;
+  tableScanReadAheadDestroy(pTableScanInfo->pReadAhead);
+  pTableScanInfo->pReadAhead = NULL;
   blockDataDestroy(pTableScanInfo->pResBlock);
   taosHashCleanup(pTableScanInfo->pIgnoreTables);
   destroyTableScanBase(&pTableScanInfo->base, &pTableScanInfo->base.readerAPI);
@@ -6150,6 +6804,8 @@ void stopDurationForGroupTableMergeScan(SOperatorInfo* pOperator) {
   pInfo->sortExecInfo.loops += sortExecInfo.loops;
   pInfo->sortExecInfo.readBytes += sortExecInfo.readBytes;
   pInfo->sortExecInfo.writeBytes += sortExecInfo.writeBytes;
+  pInfo->sortExecInfo.rawWriteBytes += sortExecInfo.rawWriteBytes;
+  pInfo->sortExecInfo.stallTime += sortExecInfo.stallTime;
 
   tsortDestroySortHandle(pInfo->pSortHandle);
   pInfo->pSortHandle = NULL;
@@ -703,6 +703,8 @@ int32_t finishSortGroup(SOperatorInfo* pOperator) {
   pInfo->sortExecInfo.loops += sortExecInfo.loops;
   pInfo->sortExecInfo.readBytes += sortExecInfo.readBytes;
   pInfo->sortExecInfo.writeBytes += sortExecInfo.writeBytes;
+  pInfo->sortExecInfo.rawWriteBytes += sortExecInfo.rawWriteBytes;
+  pInfo->sortExecInfo.stallTime += sortExecInfo.stallTime;
 
   tsortDestroySortHandle(pInfo->pCurrSortHandle);
   pInfo->pCurrSortHandle = NULL;
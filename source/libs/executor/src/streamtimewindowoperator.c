@@ -1031,6 +1031,34 @@ static int32_t getNextQualifiedFinalWindow(SInterval* pInterval, STimeWindow* pN
   return startPos;
 }
 
+#define MAX_NUM_OF_PREFETCH_WINDOWS 64
+
+// load the window states of the whole block from rocksdb in one batch, instead of reading them one by one on miss
+static void prefetchIntervalWindows(SStreamIntervalOperatorInfo* pInfo, STimeWindow win, TSKEY ekey,
+                                    uint64_t groupId) {
+  if (pInfo->stateStore.streamStatePrefetch == NULL) {
+    return;
+  }
+
+  SWinKey keys[MAX_NUM_OF_PREFETCH_WINDOWS];
+  int32_t num = 0;
+  while (num < MAX_NUM_OF_PREFETCH_WINDOWS && win.skey <= ekey) {
+    keys[num].ts = win.skey;
+    keys[num].groupId = groupId;
+    num++;
+    TSKEY prev = win.skey;
+    getNextTimeWindow(&pInfo->interval, &win, TSDB_ORDER_ASC);
+    if (win.skey <= prev) {
+      break;
+    }
+  }
+
+  int32_t code = pInfo->stateStore.streamStatePrefetch(pInfo->pState, keys, num);
+  if (code != TSDB_CODE_SUCCESS) {
+    qWarn("failed to prefetch window states, num:%d, code:%s", num, tstrerror(code));
+  }
+}
+
 static int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pSDataBlock, uint64_t groupId,
                                        SSHashObj* pUpdatedMap, SSHashObj* pDeletedMap) {
   int32_t                      code = TSDB_CODE_SUCCESS;
@@ -1080,6 +1108,8 @@ static int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pS
   } else {
     nextWin = getActiveTimeWindow(pInfo->aggSup.pResultBuf, pResultRowInfo, ts, &pInfo->interval, TSDB_ORDER_ASC);
   }
+  prefetchIntervalWindows(pInfo, nextWin, pSDataBlock->info.window.ekey, groupId);
+
   while (1) {
     bool isClosed = isCloseWindow(&nextWin, &pInfo->twAggSup);
     if (hasSrcPrimaryKeyCol(&pInfo->basic) && !IS_FINAL_INTERVAL_OP(pOperator) && pInfo->ignoreExpiredData &&
@@ -24,9 +24,12 @@
 #include "tpagedbuf.h"
 #include "tsort.h"
 #include "tutil.h"
+#include "tworker.h"
 #include "tsimplehash.h"
 #include "executil.h"
 
+#define SORT_RUN_GEN_MIN_ROWS 65536
+
 #define AllocatedTupleType 0
 #define ReferencedTupleType 1 // tuple references to one row in pDataBlock
 
@@ -114,6 +117,7 @@ struct SSortHandle {
   bool          bSortPk;
   void (*mergeLimitReachedFn)(uint64_t tableUid, void* param);
   void* mergeLimitReachedParam;
+  int32_t numOfParallelRuns;
 };
 
 static void destroySortMemFile(SSortHandle* pHandle);
@@ -469,6 +473,14 @@ _err:
   return code;
 }
 
+static int32_t tsortSetBufSpillOption(SDiskbasedBuf* pBuf) {
+  int32_t code = setBufPageCompressOnDisk(pBuf, tsQuerySpillCompress);
+  if (code == TSDB_CODE_SUCCESS) {
+    code = setBufPageAsyncFlush(pBuf, tsQueryAsyncSpill);
+  }
+  return code;
+}
+
 static int32_t doAddToBuf(SSDataBlock* pDataBlock, SSortHandle* pHandle) {
   int32_t start = 0;
 
@@ -485,6 +497,11 @@ static int32_t doAddToBuf(SSDataBlock* pDataBlock, SSortHandle* pHandle) {
       return code;
     }
     dBufSetPrintInfo(pHandle->pBuf);
+
+    code = tsortSetBufSpillOption(pHandle->pBuf);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
   }
 
   SArray* pPageIdList = taosArrayInit(4, sizeof(int32_t));
@@ -587,6 +604,11 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
     } else {
       dBufSetPrintInfo(pHandle->pBuf);
     }
+
+    code = tsortSetBufSpillOption(pHandle->pBuf);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
   }
 
   if (pHandle->type == SORT_SINGLESOURCE_SORT) {
@@ -1144,6 +1166,11 @@ static int32_t createPageBuf(SSortHandle* pHandle) {
     } else {
       dBufSetPrintInfo(pHandle->pBuf);
     }
+
+    code = tsortSetBufSpillOption(pHandle->pBuf);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
   }
   return 0;
 }
@@ -2413,6 +2440,141 @@ static void freeSortSource(void* p) {
   taosMemoryFreeClear(*pSource);
 }
 
+typedef struct SSortRunGenTask {
+  SSDataBlock* pBlock;
+  SArray*      pOrderInfo;  // private copy, since blockDataSort updates the column info of the order info
+  tsem_t*      pDone;
+  int32_t      code;
+} SSortRunGenTask;
+
+static void tsortRunGenTaskFp(void* param) {
+  SSortRunGenTask* pTask = param;
+  pTask->code = blockDataSort(pTask->pBlock, pTask->pOrderInfo);
+  (void)tsem_post(pTask->pDone);
+}
+
+static bool tsortIsParallelRunGen(SSortHandle* pHandle) {
+  // the bounded queue sort keeps the first N rows of each run, and it only works with one run per flush.
+  return tsNumOfSortThreads > 1 && pHandle->pqMaxRows <= 0;
+}
+
+static int32_t tsortGetRunGenTaskNum(SSortHandle* pHandle, SSDataBlock* pBlock) {
+  if (!tsortIsParallelRunGen(pHandle)) {
+    return 1;
+  }
+
+  int32_t num = TMIN(tsNumOfSortThreads, pBlock->info.rows / SORT_RUN_GEN_MIN_ROWS);
+  return TMAX(num, 1);
+}
+
+/**
+ * The rows to flush are copied into the slices before they are sorted, so the parallel sort holds the rows twice
+ * and it flushes at half of the sort buffer to stay within the budget.
+ */
+static size_t tsortGetFlushThreshold(SSortHandle* pHandle, size_t sortBufSize) {
+  return tsortIsParallelRunGen(pHandle) ? sortBufSize / 2 : sortBufSize;
+}
+
+/**
+ * Sort the buffered rows and spill them into the external buffer. When the buffer is large enough, it is split into
+ * several slices that are sorted concurrently in the shared query job pool, and each slice becomes one sorted run of the
+ * final merge.
+ */
+static int32_t tsortSortAndFlushBlock(SSortHandle* pHandle, SSDataBlock* pBlock) {
+  int32_t code = 0;
+  int32_t lino = 0;
+  int32_t numOfTasks = tsortGetRunGenTaskNum(pHandle, pBlock);
+  int64_t st = taosGetTimestampUs();
+
+  if (numOfTasks <= 1) {
+    code = blockDataSort(pBlock, pHandle->pSortInfo);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    pHandle->sortElapsed += (taosGetTimestampUs() - st);
+    if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pBlock, pHandle->pqMaxRows);
+    return doAddToBuf(pBlock, pHandle);
+  }
+
+  tsem_t           done;
+  int32_t          numOfScheduled = 0;
+  SSortRunGenTask* pTasks = taosMemoryCalloc(numOfTasks, sizeof(SSortRunGenTask));
+  if (pTasks == NULL) {
+    code = terrno;
+    goto _end;
+  }
+
+  code = tsem_init(&done, 0, 0);
+  if (code) {
+    taosMemoryFree(pTasks);
+    goto _end;
+  }
+
+  int32_t totalRows = pBlock->info.rows;
+  int32_t rowsPerTask = totalRows / numOfTasks;
+  for (int32_t i = 0, start = 0; i < numOfTasks; ++i) {
+    int32_t rows = (i == numOfTasks - 1) ? (totalRows - start) : rowsPerTask;
+    code = blockDataExtractBlock(pBlock, start, rows, &pTasks[i].pBlock);
+    if (code) goto _free;
+
+    pTasks[i].pOrderInfo = taosArrayDup(pHandle->pSortInfo, NULL);
+    if (pTasks[i].pOrderInfo == NULL) {
+      code = terrno;
+      goto _free;
+    }
+    pTasks[i].pDone = &done;
+    start += rows;
+  }
+
+  // the rows live in the slices from now on, the buffer is reused by the next run.
+  blockDataCleanup(pBlock);
+
+  for (int32_t i = 1; i < numOfTasks; ++i) {
+    if (tQueryJobSubmit(tsortRunGenTaskFp, &pTasks[i]) == TSDB_CODE_SUCCESS) {
+      numOfScheduled += 1;
+    } else {
+      // fall back to sort it in the current thread
+      pTasks[i].code = blockDataSort(pTasks[i].pBlock, pTasks[i].pOrderInfo);
+    }
+  }
+
+  pTasks[0].code = blockDataSort(pTasks[0].pBlock, pTasks[0].pOrderInfo);
+  for (int32_t i = 0; i < numOfScheduled; ++i) {
+    (void)tsem_wait(&done);
+  }
+
+  pHandle->sortElapsed += (taosGetTimestampUs() - st);
+  pHandle->numOfParallelRuns += numOfTasks;
+
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    if (pTasks[i].code) {
+      code = pTasks[i].code;
+      goto _free;
+    }
+  }
+
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    code = doAddToBuf(pTasks[i].pBlock, pHandle);
+    if (code) goto _free;
+  }
+
+  qDebug("%s %d sorted runs generated in parallel, rows:%d, elapsed:%" PRId64 " us", pHandle->idStr, numOfTasks,
+         totalRows, taosGetTimestampUs() - st);
+
+_free:
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    blockDataDestroy(pTasks[i].pBlock);
+    taosArrayDestroy(pTasks[i].pOrderInfo);
+  }
+  taosMemoryFree(pTasks);
+  (void)tsem_destroy(&done);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
   int32_t       code = 0;
   int32_t       lino = 0;
@@ -2453,22 +2615,20 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
     QUERY_CHECK_CODE(code, lino, _end);
 
     size_t size = blockDataGetSize(pHandle->pDataBlock);
-    if (size > sortBufSize) {
+    if (size > tsortGetFlushThreshold(pHandle, sortBufSize)) {
       // Perform the in-memory sort and then flush data in the buffer into disk.
-      int64_t st = taosGetTimestampUs();
-      code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      pHandle->sortElapsed += (taosGetTimestampUs() - st);
-
-      if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
-      code = doAddToBuf(pHandle->pDataBlock, pHandle);
+      code = tsortSortAndFlushBlock(pHandle, pHandle->pDataBlock);
       QUERY_CHECK_CODE(code, lino, _end);
     }
   }
 
   if (pHandle->pDataBlock != NULL && pHandle->pDataBlock->info.rows > 0) {
     size_t size = blockDataGetSize(pHandle->pDataBlock);
+    if (pHandle->pBuf != NULL) {
+      // some runs have been spilled already, so the last one goes to the external buffer as well.
+      code = tsortSortAndFlushBlock(pHandle, pHandle->pDataBlock);
+      goto _end;
+    }
 
     // Perform the in-memory sort and then flush data in the buffer into disk.
     int64_t st = taosGetTimestampUs();
@@ -2947,6 +3107,8 @@ SSortExecInfo tsortGetSortExecInfo(SSortHandle* pHandle) {
       SDiskbasedBufStatis st = getDBufStatis(pHandle->pBuf);
       info.writeBytes = st.flushBytes;
       info.readBytes = st.loadBytes;
+      info.rawWriteBytes = st.rawFlushBytes;
+      info.stallTime = st.stallTime;
     }
   }
 
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include "runtimefilter.h"
+#include "taos.h"
+#include "tdatablock.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+SSDataBlock* createKeyBlock(int64_t start, int32_t rows, int32_t nullEvery) {
+  SSDataBlock* pBlock = NULL;
+  int32_t      code = createDataBlock(&pBlock);
+  EXPECT_EQ(code, 0);
+
+  SColumnInfoData ts = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+  SColumnInfoData key = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 2);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &ts), 0);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &key), 0);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, rows), 0);
+
+  SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData* pKey = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  for (int32_t i = 0; i < rows; ++i) {
+    int64_t tsVal = 1700000000000 + i;
+    int64_t keyVal = start + i;
+    EXPECT_EQ(colDataSetVal(pTs, i, (const char*)&tsVal, false), 0);
+    EXPECT_EQ(colDataSetVal(pKey, i, (const char*)&keyVal, nullEvery > 0 && (i % nullEvery) == 0), 0);
+  }
+  pBlock->info.rows = rows;
+  return pBlock;
+}
+
+}  // namespace
+
+TEST(runtimeFilterTest, rangeAndBloom) {
+  SRuntimeFilter* pFilter = NULL;
+  ASSERT_EQ(rtFilterCreate(1, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 10, &pFilter), 0);
+
+  for (int64_t k = 100; k < 200; k += 10) {
+    ASSERT_EQ(rtFilterPutKey(pFilter, (const char*)&k), 0);
+  }
+  ASSERT_EQ(pFilter->min, 100);
+  ASSERT_EQ(pFilter->max, 190);
+  ASSERT_EQ(pFilter->keyNum, 10);
+
+  SColumnDataAgg agg = {.colId = 2, .numOfNull = 0, .sum = 0, .max = 99, .min = 0};
+  ASSERT_FALSE(rtFilterBlockMayMatch(pFilter, &agg));
+  agg.min = 191;
+  agg.max = 1000;
+  ASSERT_FALSE(rtFilterBlockMayMatch(pFilter, &agg));
+  agg.min = 150;
+  ASSERT_TRUE(rtFilterBlockMayMatch(pFilter, &agg));
+  agg.colId = -1;
+  agg.min = 0;
+  agg.max = 1;
+  ASSERT_TRUE(rtFilterBlockMayMatch(pFilter, &agg));
+  ASSERT_EQ(pFilter->filterOutBlocks, 2);
+
+  SSDataBlock* pBlock = createKeyBlock(0, 1000, 0);
+  ASSERT_EQ(rtFilterApplyToBlock(pFilter, pBlock), 0);
+  // bloom filter may keep some false positives inside the key range, but never drops a matching key
+  ASSERT_GE(pBlock->info.rows, 10);
+  ASSERT_LE(pBlock->info.rows, 91);
+
+  SColumnInfoData* pKey = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  int32_t          matched = 0;
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    int64_t v = *(int64_t*)colDataGetData(pKey, i);
+    ASSERT_GE(v, 100);
+    ASSERT_LE(v, 190);
+    if (v % 10 == 0) {
+      matched++;
+    }
+  }
+  ASSERT_EQ(matched, 10);
+  blockDataDestroy(pBlock);
+
+  rtFilterDestroy(pFilter);
+}
+
+TEST(runtimeFilterTest, nullKeys) {
+  SRuntimeFilter* pFilter = NULL;
+  ASSERT_EQ(rtFilterCreate(1, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 100, &pFilter), 0);
+  for (int64_t k = 0; k < 100; ++k) {
+    ASSERT_EQ(rtFilterPutKey(pFilter, (const char*)&k), 0);
+  }
+
+  SSDataBlock* pBlock = createKeyBlock(0, 100, 2);
+  ASSERT_EQ(rtFilterApplyToBlock(pFilter, pBlock), 0);
+  ASSERT_EQ(pBlock->info.rows, 50);
+  ASSERT_EQ(pFilter->filterOutRows, 50);
+  blockDataDestroy(pBlock);
+
+  rtFilterDestroy(pFilter);
+}
+
+TEST(runtimeFilterTest, unsupportedType) {
+  SRuntimeFilter* pFilter = NULL;
+  ASSERT_NE(rtFilterCreate(1, TSDB_DATA_TYPE_BINARY, 20, 10, &pFilter), 0);
+  ASSERT_EQ(pFilter, nullptr);
+  ASSERT_NE(rtFilterCreate(1, TSDB_DATA_TYPE_INT, sizeof(int32_t), 0, &pFilter), 0);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "executorInt.h"
+#include "tdatablock.h"
+#include "tworker.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const int32_t kRowsPerBlock = 10;
+
+// a data reader of one sub-window that returns numOfBlocks blocks of consecutive timestamps from start
+struct SFakeReader {
+  SSDataBlock* pBlock;
+  int64_t      start;
+  int32_t      numOfBlocks;
+  int32_t      next;
+  int32_t      failAt;  // return an error when this block is asked for, -1 for never
+  int32_t      closed;
+  int32_t      notified;
+};
+
+int32_t fakeNextDataBlock(SFakeReader* pReader, bool* hasNext) {
+  if (pReader->next == pReader->failAt) {
+    *hasNext = false;
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+
+  *hasNext = pReader->next < pReader->numOfBlocks;
+  if (!*hasNext) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pReader->pBlock->pDataBlock, 0);
+  for (int32_t i = 0; i < kRowsPerBlock; ++i) {
+    int64_t ts = pReader->start + pReader->next * kRowsPerBlock + i;
+    EXPECT_EQ(colDataSetVal(pTs, i, (const char*)&ts, false), 0);
+  }
+  pReader->pBlock->info.rows = kRowsPerBlock;
+  pReader->next += 1;
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t fakeRetrieveDataBlock(SFakeReader* pReader, SSDataBlock** pBlock, SArray* pIdList) {
+  *pBlock = pReader->pBlock;
+  return TSDB_CODE_SUCCESS;
+}
+
+void fakeReaderClose(SFakeReader* pReader) {
+  if (pReader != NULL) {
+    (void)atomic_add_fetch_32(&pReader->closed, 1);
+  }
+}
+
+void fakeReaderNotifyClosing(SFakeReader* pReader) { (void)atomic_add_fetch_32(&pReader->notified, 1); }
+
+// a job that occupies a thread of the query job pool until the semaphore is posted
+struct SBlockingJobs {
+  tsem_t  sem;
+  int32_t done;
+};
+
+void blockingJob(void* param) {
+  SBlockingJobs* pJobs = (SBlockingJobs*)param;
+  (void)tsem_wait(&pJobs->sem);
+  (void)atomic_add_fetch_32(&pJobs->done, 1);
+}
+
+SSDataBlock* createTsBlock() {
+  SSDataBlock* pBlock = NULL;
+  EXPECT_EQ(createDataBlock(&pBlock), 0);
+
+  SColumnInfoData ts = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &ts), 0);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, kRowsPerBlock), 0);
+  return pBlock;
+}
+
+class TableScanReadAheadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    api.tsdNextDataBlock = (int32_t(*)())fakeNextDataBlock;
+    api.tsdReaderRetrieveDataBlock = (int32_t(*)())fakeRetrieveDataBlock;
+    api.tsdReaderClose = (void (*)())fakeReaderClose;
+    api.tsdReaderNotifyClosing = (void (*)())fakeReaderNotifyClosing;
+  }
+
+  void TearDown() override {
+    for (auto& r : readers) {
+      blockDataDestroy(r.pBlock);
+    }
+  }
+
+  // the windows follow each other in the scan order, each of them has numOfBlocks blocks
+  STableScanReadAhead* create(int32_t numOfWindows, int32_t numOfBlocks) {
+    readers.assign(numOfWindows, SFakeReader{});
+    for (int32_t i = 0; i < numOfWindows; ++i) {
+      readers[i].pBlock = createTsBlock();
+      readers[i].start = (int64_t)i * numOfBlocks * kRowsPerBlock;
+      readers[i].numOfBlocks = numOfBlocks;
+      readers[i].failAt = -1;
+    }
+
+    STableScanReadAhead* pReadAhead = NULL;
+    EXPECT_EQ(tableScanReadAheadCreate(&api, numOfWindows, &pReadAhead), 0);
+    for (int32_t i = 0; i < numOfWindows; ++i) {
+      pReadAhead->pWindows[i].pReader = (STsdbReader*)&readers[i];
+    }
+    return pReadAhead;
+  }
+
+  // drain the read-ahead and check that the rows come in the scan order
+  int64_t drain(STableScanReadAhead* pReadAhead, int32_t* pCode) {
+    SSDataBlock* pBlock = createTsBlock();
+    int64_t      expected = 0;
+    bool         hasNext = false;
+
+    pReadAhead->current = 0;
+    while ((*pCode = tableScanReadAheadNext(pReadAhead, pBlock, &hasNext)) == 0 && hasNext) {
+      SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+      for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+        EXPECT_EQ(*(int64_t*)colDataGetData(pTs, i), expected);
+        expected += 1;
+      }
+    }
+
+    blockDataDestroy(pBlock);
+    return expected;
+  }
+
+  TsdReader                api = {0};
+  std::vector<SFakeReader> readers;
+};
+
+}  // namespace
+
+TEST_F(TableScanReadAheadTest, readInScanOrder) {
+  STableScanReadAhead* pReadAhead = create(4, 20);
+  tableScanReadAheadStart(pReadAhead);
+
+  int32_t code = 0;
+  EXPECT_EQ(drain(pReadAhead, &code), 4 * 20 * kRowsPerBlock);
+  EXPECT_EQ(code, 0);
+
+  tableScanReadAheadDestroy(pReadAhead);
+  for (auto& r : readers) {
+    EXPECT_EQ(r.closed, 1);
+  }
+}
+
+TEST_F(TableScanReadAheadTest, readUnscheduledWindowsInPlace) {
+  // nothing is submitted to the query job pool, so the operator reads every window itself
+  STableScanReadAhead* pReadAhead = create(3, 5);
+
+  int32_t code = 0;
+  EXPECT_EQ(drain(pReadAhead, &code), 3 * 5 * kRowsPerBlock);
+  EXPECT_EQ(code, 0);
+
+  tableScanReadAheadDestroy(pReadAhead);
+  for (auto& r : readers) {
+    EXPECT_EQ(r.closed, 1);
+  }
+}
+
+TEST_F(TableScanReadAheadTest, destroyBeforeDrained) {
+  STableScanReadAhead* pReadAhead = create(4, 100);
+  tableScanReadAheadStart(pReadAhead);
+
+  SSDataBlock* pBlock = createTsBlock();
+  bool         hasNext = false;
+  pReadAhead->current = 0;
+  ASSERT_EQ(tableScanReadAheadNext(pReadAhead, pBlock, &hasNext), 0);
+  ASSERT_TRUE(hasNext);
+  blockDataDestroy(pBlock);
+
+  // the windows still read ahead by the pool stop at the next block, the rest are dropped
+  tableScanReadAheadDestroy(pReadAhead);
+  for (auto& r : readers) {
+    EXPECT_EQ(r.closed, 1);
+  }
+}
+
+TEST_F(TableScanReadAheadTest, errorOfWindow) {
+  STableScanReadAhead* pReadAhead = create(3, 5);
+  readers[1].failAt = 2;
+  tableScanReadAheadStart(pReadAhead);
+
+  int32_t code = 0;
+  int64_t rows = drain(pReadAhead, &code);
+  EXPECT_EQ(code, TSDB_CODE_FILE_CORRUPTED);
+  EXPECT_EQ(rows, (5 + 2) * kRowsPerBlock);
+
+  tableScanReadAheadDestroy(pReadAhead);
+  for (auto& r : readers) {
+    EXPECT_EQ(r.closed, 1);
+  }
+}
+
+TEST_F(TableScanReadAheadTest, skipWhenPoolSaturated) {
+  SBlockingJobs jobs = {0};
+  int32_t       numOfJobs = tQueryJobThreads() * 2;
+  ASSERT_EQ(tsem_init(&jobs.sem, 0, 0), 0);
+  for (int32_t i = 0; i < numOfJobs; ++i) {
+    ASSERT_EQ(tQueryJobSubmit(blockingJob, &jobs), 0);
+  }
+
+  // the jobs queued behind the blocked ones keep the pool saturated, nothing is read ahead
+  STableScanReadAhead* pReadAhead = create(3, 5);
+  tableScanReadAheadStart(pReadAhead);
+  EXPECT_EQ(pReadAhead->ref, 1);
+
+  int32_t code = 0;
+  EXPECT_EQ(drain(pReadAhead, &code), 3 * 5 * kRowsPerBlock);
+  EXPECT_EQ(code, 0);
+  tableScanReadAheadDestroy(pReadAhead);
+
+  for (int32_t i = 0; i < numOfJobs; ++i) {
+    (void)tsem_post(&jobs.sem);
+  }
+  while (atomic_load_32(&jobs.done) < numOfJobs) {
+    taosMsleep(1);
+  }
+  (void)tsem_destroy(&jobs.sem);
+}
+
+#pragma GCC diagnostic pop
@@ -331,6 +331,15 @@ int32_t tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval, dou
     return ret;
   }
 
+  ret = setBufPageCompressOnDisk((*pBucket)->pBuffer, tsQuerySpillCompress);
+  if (ret == 0) {
+    ret = setBufPageAsyncFlush((*pBucket)->pBuffer, tsQueryAsyncSpill);
+  }
+  if (ret != 0) {
+    tMemBucketDestroy(pBucket);
+    return ret;
+  }
+
   //  qDebug("MemBucket:%p, elem size:%d", pBucket, pBucket->bytes);
   return TSDB_CODE_SUCCESS;
 }
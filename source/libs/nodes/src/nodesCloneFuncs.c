@@ -537,6 +537,7 @@ static int32_t logicJoinCopy(const SJoinLogicNode* pSrc, SJoinLogicNode* pDst) {
   CLONE_NODE_FIELD(pRightOnCond);
   COPY_SCALAR_FIELD(timeRangeTarget);
   COPY_OBJECT_FIELD(timeRange, sizeof(STimeWindow));  
+  COPY_OBJECT_FIELD(inputStat, sizeof(pSrc->inputStat));
   return TSDB_CODE_SUCCESS;
 }
 
@@ -552,6 +553,8 @@ static int32_t logicAggCopy(const SAggLogicNode* pSrc, SAggLogicNode* pDst) {
   COPY_SCALAR_FIELD(isGroupTb);
   COPY_SCALAR_FIELD(isPartTb);
   COPY_SCALAR_FIELD(hasGroup);
+  CLONE_NODE_LIST_FIELD(pTopNKeys);
+  COPY_SCALAR_FIELD(topN);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -2629,6 +2629,8 @@ static const char* jkAggPhysiPlanAggFuncs = "AggFuncs";
 static const char* jkAggPhysiPlanMergeDataBlock = "MergeDataBlock";
 static const char* jkAggPhysiPlanGroupKeyOptimized = "GroupKeyOptimized";
 static const char* jkAggPhysiPlanHasCountLikeFunc = "HasCountFunc";
+static const char* jkAggPhysiPlanTopNKeys = "TopNKeys";
+static const char* jkAggPhysiPlanTopN = "TopN";
 
 static int32_t physiAggNodeToJson(const void* pObj, SJson* pJson) {
   const SAggPhysiNode* pNode = (const SAggPhysiNode*)pObj;
@@ -2652,6 +2654,12 @@ static int32_t physiAggNodeToJson(const void* pObj, SJson* pJson) {
   if (TSDB_CODE_SUCCESS == code) {
     code = tjsonAddBoolToObject(pJson, jkAggPhysiPlanHasCountLikeFunc, pNode->hasCountLikeFunc);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodeListToJson(pJson, jkAggPhysiPlanTopNKeys, pNode->pTopNKeys);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tjsonAddIntegerToObject(pJson, jkAggPhysiPlanTopN, pNode->topN);
+  }
 
   return code;
 }
@@ -2678,6 +2686,12 @@ static int32_t jsonToPhysiAggNode(const SJson* pJson, void* pObj) {
   if (TSDB_CODE_SUCCESS == code) {
     code = tjsonGetBoolValue(pJson, jkAggPhysiPlanHasCountLikeFunc, &pNode->hasCountLikeFunc);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = jsonToNodeList(pJson, jkAggPhysiPlanTopNKeys, &pNode->pTopNKeys);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tjsonGetBigIntValue(pJson, jkAggPhysiPlanTopN, &pNode->topN);
+  }
 
   return code;
 }
@@ -3817,6 +3831,8 @@ static const char* jkSubplanRowsThreshold = "RowThreshold";
 static const char* jkSubplanDynamicRowsThreshold = "DyRowThreshold";
 static const char* jkSubplanIsView = "IsView";
 static const char* jkSubplanIsAudit = "IsAudit";
+static const char* jkSubplanEstMemSize = "EstMemSize";
+static const char* jkSubplanEstCpuCost = "EstCpuCost";
 
 static int32_t subplanToJson(const void* pObj, SJson* pJson) {
   const SSubplan* pNode = (const SSubplan*)pObj;
@@ -3867,6 +3883,12 @@ static int32_t subplanToJson(const void* pObj, SJson* pJson) {
   if (TSDB_CODE_SUCCESS == code) {
     code = tjsonAddBoolToObject(pJson, jkSubplanDynamicRowsThreshold, pNode->dynamicRowThreshold);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tjsonAddIntegerToObject(pJson, jkSubplanEstMemSize, pNode->estMemSize);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tjsonAddIntegerToObject(pJson, jkSubplanEstCpuCost, pNode->estCpuCost);
+  }
 
   return code;
 }
@@ -3920,6 +3942,12 @@ static int32_t jsonToSubplan(const SJson* pJson, void* pObj) {
   if (TSDB_CODE_SUCCESS == code) {
     code = tjsonGetBoolValue(pJson, jkSubplanDynamicRowsThreshold, &pNode->dynamicRowThreshold);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tjsonGetBigIntValue(pJson, jkSubplanEstMemSize, &pNode->estMemSize);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tjsonGetBigIntValue(pJson, jkSubplanEstCpuCost, &pNode->estCpuCost);
+  }
 
   return code;
 }
@@ -3958,6 +3986,8 @@ static int32_t jsonToPlan(const SJson* pJson, void* pObj) {
 
 static const char* jkAggLogicPlanGroupKeys = "GroupKeys";
 static const char* jkAggLogicPlanAggFuncs = "AggFuncs";
+static const char* jkAggLogicPlanTopNKeys = "TopNKeys";
+static const char* jkAggLogicPlanTopN = "TopN";
 
 static int32_t logicAggNodeToJson(const void* pObj, SJson* pJson) {
   const SAggLogicNode* pNode = (const SAggLogicNode*)pObj;
@@ -3969,6 +3999,12 @@ static int32_t logicAggNodeToJson(const void* pObj, SJson* pJson) {
   if (TSDB_CODE_SUCCESS == code) {
     code = nodeListToJson(pJson, jkAggLogicPlanAggFuncs, pNode->pAggFuncs);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodeListToJson(pJson, jkAggLogicPlanTopNKeys, pNode->pTopNKeys);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tjsonAddIntegerToObject(pJson, jkAggLogicPlanTopN, pNode->topN);
+  }
 
   return code;
 }
@@ -3983,6 +4019,12 @@ static int32_t jsonToLogicAggNode(const SJson* pJson, void* pObj) {
   if (TSDB_CODE_SUCCESS == code) {
     code = jsonToNodeList(pJson, jkAggLogicPlanAggFuncs, &pNode->pAggFuncs);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = jsonToNodeList(pJson, jkAggLogicPlanTopNKeys, &pNode->pTopNKeys);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tjsonGetBigIntValue(pJson, jkAggLogicPlanTopN, &pNode->topN);
+  }
 
   return code;
 }
@@ -2869,6 +2869,8 @@ enum {
   PHY_AGG_CODE_MERGE_DATA_BLOCK,
   PHY_AGG_CODE_GROUP_KEY_OPTIMIZE,
   PHY_AGG_CODE_HAS_COUNT_LIKE_FUNCS,
+  PHY_AGG_CODE_TOP_N_KEYS,
+  PHY_AGG_CODE_TOP_N,
 };
 
 static int32_t physiAggNodeToMsg(const void* pObj, STlvEncoder* pEncoder) {
@@ -2893,6 +2895,12 @@ static int32_t physiAggNodeToMsg(const void* pObj, STlvEncoder* pEncoder) {
   if (TSDB_CODE_SUCCESS == code) {
     code = tlvEncodeBool(pEncoder, PHY_AGG_CODE_HAS_COUNT_LIKE_FUNCS, pNode->hasCountLikeFunc);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tlvEncodeObj(pEncoder, PHY_AGG_CODE_TOP_N_KEYS, nodeListToMsg, pNode->pTopNKeys);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tlvEncodeI64(pEncoder, PHY_AGG_CODE_TOP_N, pNode->topN);
+  }
 
   return code;
 }
@@ -2925,6 +2933,12 @@ static int32_t msgToPhysiAggNode(STlvDecoder* pDecoder, void* pObj) {
       case PHY_AGG_CODE_HAS_COUNT_LIKE_FUNCS:
         code = tlvDecodeBool(pTlv, &pNode->hasCountLikeFunc);
         break;
+      case PHY_AGG_CODE_TOP_N_KEYS:
+        code = msgToNodeListFromTlv(pTlv, (void**)&pNode->pTopNKeys);
+        break;
+      case PHY_AGG_CODE_TOP_N:
+        code = tlvDecodeI64(pTlv, &pNode->topN);
+        break;
       default:
         break;
     }
@@ -4336,9 +4350,16 @@ enum {
   SUBPLAN_CODE_ROOT_NODE,
   SUBPLAN_CODE_DATA_SINK,
   SUBPLAN_CODE_TAG_COND,
-  SUBPLAN_CODE_TAG_INDEX_COND
+  SUBPLAN_CODE_TAG_INDEX_COND,
+  SUBPLAN_CODE_VERSION,
+  SUBPLAN_CODE_EST_MEM_SIZE,
+  SUBPLAN_CODE_EST_CPU_COST
 };
 
+// Bumped when a change to the subplan msg can not be skipped safely by an older qworker. Msgs without a version tlv
+// come from nodes older than the versioning and are decoded as version 1.
+#define SUBPLAN_MSG_VERSION 1
+
 static int32_t subplanInlineToMsg(const void* pObj, STlvEncoder* pEncoder) {
   const SSubplan* pNode = (const SSubplan*)pObj;
 
@@ -4383,7 +4404,10 @@ static int32_t subplanInlineToMsg(const void* pObj, STlvEncoder* pEncoder) {
 static int32_t subplanToMsg(const void* pObj, STlvEncoder* pEncoder) {
   const SSubplan* pNode = (const SSubplan*)pObj;
 
-  int32_t code = tlvEncodeObj(pEncoder, SUBPLAN_CODE_INLINE_ATTRS, subplanInlineToMsg, pNode);
+  int32_t code = tlvEncodeI32(pEncoder, SUBPLAN_CODE_VERSION, SUBPLAN_MSG_VERSION);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tlvEncodeObj(pEncoder, SUBPLAN_CODE_INLINE_ATTRS, subplanInlineToMsg, pNode);
+  }
   if (TSDB_CODE_SUCCESS == code) {
     code = tlvEncodeObj(pEncoder, SUBPLAN_CODE_ROOT_NODE, nodeToMsg, pNode->pNode);
   }
@@ -4396,6 +4420,12 @@ static int32_t subplanToMsg(const void* pObj, STlvEncoder* pEncoder) {
   if (TSDB_CODE_SUCCESS == code) {
     code = tlvEncodeObj(pEncoder, SUBPLAN_CODE_TAG_INDEX_COND, nodeToMsg, pNode->pTagIndexCond);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tlvEncodeI64(pEncoder, SUBPLAN_CODE_EST_MEM_SIZE, pNode->estMemSize);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = tlvEncodeI64(pEncoder, SUBPLAN_CODE_EST_CPU_COST, pNode->estCpuCost);
+  }
 
   return code;
 }
@@ -4444,9 +4474,17 @@ static int32_t msgToSubplan(STlvDecoder* pDecoder, void* pObj) {
   SSubplan* pNode = (SSubplan*)pObj;
 
   int32_t code = TSDB_CODE_SUCCESS;
+  int32_t version = 1;
   STlv*   pTlv = NULL;
   tlvForEach(pDecoder, pTlv, code) {
     switch (pTlv->type) {
+      case SUBPLAN_CODE_VERSION:
+        code = tlvDecodeI32(pTlv, &version);
+        if (TSDB_CODE_SUCCESS == code && version > SUBPLAN_MSG_VERSION) {
+          nodesError("subplan msg version %d is newer than supported version %d", version, SUBPLAN_MSG_VERSION);
+          code = TSDB_CODE_VERSION_NOT_COMPATIBLE;
+        }
+        break;
       case SUBPLAN_CODE_INLINE_ATTRS:
         code = tlvDecodeObjFromTlv(pTlv, msgToSubplanInline, pNode);
         break;
@@ -4462,6 +4500,12 @@ static int32_t msgToSubplan(STlvDecoder* pDecoder, void* pObj) {
       case SUBPLAN_CODE_TAG_INDEX_COND:
         code = msgToNodeFromTlv(pTlv, (void**)&pNode->pTagIndexCond);
         break;
+      case SUBPLAN_CODE_EST_MEM_SIZE:
+        code = tlvDecodeI64(pTlv, &pNode->estMemSize);
+        break;
+      case SUBPLAN_CODE_EST_CPU_COST:
+        code = tlvDecodeI64(pTlv, &pNode->estCpuCost);
+        break;
       default:
         break;
     }
@@ -1652,6 +1652,7 @@ void nodesDestroyNode(SNode* pNode) {
       destroyLogicNode((SLogicNode*)pLogicNode);
       nodesDestroyList(pLogicNode->pAggFuncs);
       nodesDestroyList(pLogicNode->pGroupKeys);
+      nodesDestroyList(pLogicNode->pTopNKeys);
       break;
     }
     case QUERY_NODE_LOGIC_PLAN_PROJECT: {
@@ -1834,6 +1835,7 @@ void nodesDestroyNode(SNode* pNode) {
       nodesDestroyList(pPhyNode->pExprs);
       nodesDestroyList(pPhyNode->pAggFuncs);
       nodesDestroyList(pPhyNode->pGroupKeys);
+      nodesDestroyList(pPhyNode->pTopNKeys);
       break;
     }
     case QUERY_NODE_PHYSICAL_PLAN_EXCHANGE: {
@@ -47,6 +47,7 @@ typedef struct STranslateContext {
   SNode*           pPrevRoot;
   SNode*           pPostRoot;
   bool             dual; // whether select stmt without from stmt, true for without.
+  bool             nonDeterministic;
 } STranslateContext;
 
 int32_t biRewriteToTbnameFunc(STranslateContext* pCxt, SNode** ppNode, bool* pRet);
@@ -2074,6 +2074,150 @@ static int32_t parseOneStbRow(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pSt
   return code;
 }
 
+static FORCE_INLINE bool isValueSpace(char c) {
+  return ' ' == c || '\t' == c || '\n' == c || '\r' == c || '\f' == c;
+}
+
+static FORCE_INLINE bool isValueEnd(const char* p) {
+  while (isValueSpace(*p)) {
+    ++p;
+  }
+  // '\0' ends the last value of a csv line
+  return ',' == *p || ')' == *p || '\0' == *p;
+}
+
+// convert eight ascii digits with three multiplications instead of eight, the input is read little endian
+static FORCE_INLINE uint64_t eightDigitsToInt(const char* p) {
+  uint64_t val = 0;
+  memcpy(&val, p, sizeof(val));
+  val = (val & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+  val = (val & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+  return (val & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32;
+}
+
+// only plain decimal integers of at most 18 digits followed by the end of the value, so no overflow is possible
+static bool parseIntegerFast(const char** pSql, bool isSigned, int64_t* pVal) {
+  const char* p = *pSql;
+  bool        negative = false;
+  if ('-' == *p && isSigned) {
+    negative = true;
+    ++p;
+  }
+
+  const char* pDigits = p;
+  while (*p >= '0' && *p <= '9') {
+    ++p;
+  }
+  int32_t n = p - pDigits;
+  if (0 == n || n > 18 || !isValueEnd(p)) {
+    return false;
+  }
+
+  uint64_t val = 0;
+  for (; n >= 8; n -= 8, pDigits += 8) {
+    val = val * 100000000 + eightDigitsToInt(pDigits);
+  }
+  for (; n > 0; --n, ++pDigits) {
+    val = val * 10 + (*pDigits - '0');
+  }
+  *pVal = negative ? -(int64_t)val : (int64_t)val;
+  *pSql = p;
+  return true;
+}
+
+// only quoted strings without escapes followed by the end of the value, so the token needs no trimString
+static bool parseStringFast(const char** pSql, SToken* pToken) {
+  const char* p = *pSql;
+  char        delim = *p;
+  if ('\'' != delim && '"' != delim) {
+    return false;
+  }
+
+  const char* pEnd = strchr(p + 1, delim);
+  if (NULL == pEnd || delim == pEnd[1]) {
+    return false;
+  }
+  int32_t len = pEnd - p - 1;
+  if (len + 2 >= TSDB_MAX_BYTES_PER_ROW || NULL != memchr(p + 1, '\\', len) || !isValueEnd(pEnd + 1)) {
+    return false;
+  }
+
+  pToken->type = TK_NK_STRING;
+  pToken->z = (char*)p + 1;
+  pToken->n = len;
+  *pSql = pEnd + 1;
+  return true;
+}
+
+static bool isIntegerInRange(int8_t type, int64_t val) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return IS_VALID_TINYINT(val);
+    case TSDB_DATA_TYPE_UTINYINT:
+      return val <= UINT8_MAX;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return IS_VALID_SMALLINT(val);
+    case TSDB_DATA_TYPE_USMALLINT:
+      return val <= UINT16_MAX;
+    case TSDB_DATA_TYPE_INT:
+      return IS_VALID_INT(val);
+    case TSDB_DATA_TYPE_UINT:
+      return val <= UINT32_MAX;
+    default:
+      return true;
+  }
+}
+
+// Bulk VALUES are dominated by integers, timestamps and plain strings. Such values are scanned here without the
+// general tokenizer; everything else, including all invalid input, is left to parseValueToken so that the behavior
+// and the error messages stay the same.
+static int32_t parseValueFast(SInsertParseContext* pCxt, const char** pSql, SSchema* pSchema, int16_t timePrec,
+                              SColVal* pVal, bool* pParsed) {
+  const char* p = *pSql;
+  while (isValueSpace(*p)) {
+    ++p;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  switch (pSchema->type) {
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT: {
+      int64_t val = 0;
+      if (!parseIntegerFast(&p, !IS_UNSIGNED_NUMERIC_TYPE(pSchema->type), &val) ||
+          !isIntegerInRange(pSchema->type, val)) {
+        return TSDB_CODE_SUCCESS;
+      }
+      pVal->value.val = val;
+      pVal->flag = CV_FLAG_VALUE;
+      break;
+    }
+    case TSDB_DATA_TYPE_BINARY:
+    case TSDB_DATA_TYPE_NCHAR: {
+      SToken token = {0};
+      if (!parseStringFast(&p, &token)) {
+        return TSDB_CODE_SUCCESS;
+      }
+      code = parseValueTokenImpl(pCxt, &p, &token, pSchema, timePrec, pVal);
+      break;
+    }
+    default:
+      return TSDB_CODE_SUCCESS;
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    *pSql = p;
+    *pParsed = true;
+  }
+  return code;
+}
+
 static int parseOneRow(SInsertParseContext* pCxt, const char** pSql, STableDataCxt* pTableCxt, bool* pGotRow,
                        SToken* pToken) {
   SBoundColInfo* pCols = &pTableCxt->boundColsInfo;
@@ -2082,36 +2226,46 @@ static int parseOneRow(SInsertParseContext* pCxt, const char** pSql, STableDataC
   int32_t code = TSDB_CODE_SUCCESS;
   // 1. set the parsed value from sql string
   for (int i = 0; i < pCols->numOfBound && TSDB_CODE_SUCCESS == code; ++i) {
-    const char* pOrigSql = *pSql;
-    bool        ignoreComma = false;
-    NEXT_TOKEN_WITH_PREV_EXT(*pSql, *pToken, &ignoreComma);
-    if (ignoreComma) {
-      code = buildSyntaxErrMsg(&pCxt->msg, "invalid data or symbol", pOrigSql);
-      break;
-    }
-
     SSchema* pSchema = &pSchemas[pCols->pColIndex[i]];
     SColVal* pVal = taosArrayGet(pTableCxt->pValues, pCols->pColIndex[i]);
 
-    if (pToken->type == TK_NK_QUESTION) {
-      pCxt->isStmtBind = true;
-      if (NULL == pCxt->pComCxt->pStmtCb) {
-        code = buildSyntaxErrMsg(&pCxt->msg, "? only used in stmt", pToken->z);
-        break;
-      }
-    } else {
-      if (TK_NK_RP == pToken->type) {
-        code = generateSyntaxErrMsg(&pCxt->msg, TSDB_CODE_PAR_INVALID_COLUMNS_NUM);
+    bool parsed = false;
+    if (!pCxt->isStmtBind) {
+      code = parseValueFast(pCxt, pSql, pSchema, getTableInfo(pTableCxt->pMeta).precision, pVal, &parsed);
+      if (TSDB_CODE_SUCCESS != code) {
         break;
       }
+    }
 
-      if (pCxt->isStmtBind) {
-        code = buildInvalidOperationMsg(&pCxt->msg, "stmt bind param does not support normal value in sql");
+    if (!parsed) {
+      const char* pOrigSql = *pSql;
+      bool        ignoreComma = false;
+      NEXT_TOKEN_WITH_PREV_EXT(*pSql, *pToken, &ignoreComma);
+      if (ignoreComma) {
+        code = buildSyntaxErrMsg(&pCxt->msg, "invalid data or symbol", pOrigSql);
         break;
       }
 
-      if (TSDB_CODE_SUCCESS == code) {
-        code = parseValueToken(pCxt, pSql, pToken, pSchema, getTableInfo(pTableCxt->pMeta).precision, pVal);
+      if (pToken->type == TK_NK_QUESTION) {
+        pCxt->isStmtBind = true;
+        if (NULL == pCxt->pComCxt->pStmtCb) {
+          code = buildSyntaxErrMsg(&pCxt->msg, "? only used in stmt", pToken->z);
+          break;
+        }
+      } else {
+        if (TK_NK_RP == pToken->type) {
+          code = generateSyntaxErrMsg(&pCxt->msg, TSDB_CODE_PAR_INVALID_COLUMNS_NUM);
+          break;
+        }
+
+        if (pCxt->isStmtBind) {
+          code = buildInvalidOperationMsg(&pCxt->msg, "stmt bind param does not support normal value in sql");
+          break;
+        }
+
+        if (TSDB_CODE_SUCCESS == code) {
+          code = parseValueToken(pCxt, pSql, pToken, pSchema, getTableInfo(pTableCxt->pMeta).precision, pVal);
+        }
       }
     }
 
@@ -2200,6 +2354,249 @@ static int32_t parseValuesClause(SInsertParseContext* pCxt, SVnodeModifyOpStmt*
   return code;
 }
 
+#define CSV_PARSE_LINES_PER_THREAD 10000
+
+// lines of a csv file read in one go, each line is '\0' terminated in pBuf
+typedef struct SCsvChunk {
+  char*   pBuf;
+  int64_t len;
+  int64_t cap;
+  SArray* pOffsets;  // int64_t, start of each line in pBuf
+} SCsvChunk;
+
+typedef struct SCsvParseTask {
+  SInsertParseContext* pCxt;
+  STableDataCxt        tableCxt;
+  SSubmitTbData        data;
+  const SCsvChunk*     pChunk;
+  int32_t              start;
+  int32_t              end;
+  int32_t              code;
+  char                 msg[128];
+} SCsvParseTask;
+
+static void destroyCsvChunk(SCsvChunk* pChunk) {
+  taosMemoryFreeClear(pChunk->pBuf);
+  taosArrayDestroy(pChunk->pOffsets);
+  pChunk->pOffsets = NULL;
+}
+
+static FORCE_INLINE char* getCsvLine(const SCsvChunk* pChunk, int32_t index) {
+  return pChunk->pBuf + *(int64_t*)taosArrayGet(pChunk->pOffsets, index);
+}
+
+static int32_t appendCsvLine(SCsvChunk* pChunk, const char* pLine, int64_t len) {
+  if (pChunk->len + len + 1 > pChunk->cap) {
+    int64_t cap = TMAX(pChunk->cap * 2, pChunk->len + len + 1);
+    char*   pBuf = taosMemoryRealloc(pChunk->pBuf, cap);
+    if (NULL == pBuf) {
+      return terrno;
+    }
+    pChunk->pBuf = pBuf;
+    pChunk->cap = cap;
+  }
+  if (NULL == taosArrayPush(pChunk->pOffsets, &pChunk->len)) {
+    return terrno;
+  }
+  memcpy(pChunk->pBuf + pChunk->len, pLine, len);
+  pChunk->pBuf[pChunk->len + len] = '\0';
+  pChunk->len += len + 1;
+  return TSDB_CODE_SUCCESS;
+}
+
+// read up to maxLines non-empty lines, an empty first line of the file ends the header detection as before
+static int32_t readCsvChunk(TdFilePtr fp, int32_t maxLines, SCsvChunk* pChunk, bool* pFirstLine, bool* pEof) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  char*   pLine = NULL;
+  int64_t readLen = 0;
+  pChunk->len = 0;
+  taosArrayClear(pChunk->pOffsets);
+  while (TSDB_CODE_SUCCESS == code && taosArrayGetSize(pChunk->pOffsets) < maxLines) {
+    readLen = taosGetLineFile(fp, &pLine);
+    if (-1 == readLen) {
+      *pEof = true;
+      break;
+    }
+    if (('\r' == pLine[readLen - 1]) || ('\n' == pLine[readLen - 1])) {
+      pLine[--readLen] = '\0';
+    }
+    if (readLen == 0) {
+      if (0 == taosArrayGetSize(pChunk->pOffsets)) {
+        *pFirstLine = false;
+      }
+      continue;
+    }
+    code = appendCsvLine(pChunk, pLine, readLen);
+  }
+  taosMemoryFree(pLine);
+  return code;
+}
+
+static int32_t parseCsvLinesSeq(SInsertParseContext* pCxt, STableDataCxt* pTableCxt, const SCsvChunk* pChunk,
+                                int32_t start, int32_t end, int32_t* pNumOfRows) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  for (int32_t i = start; i < end && TSDB_CODE_SUCCESS == code; ++i) {
+    char*       pLine = getCsvLine(pChunk, i);
+    const char* pRow = pLine;
+    SToken      token;
+    bool        gotRow = false;
+    (void)strtolower(pLine, pLine);
+    code = parseOneRow(pCxt, &pRow, pTableCxt, &gotRow, &token);
+    if (TSDB_CODE_SUCCESS == code && gotRow) {
+      (*pNumOfRows)++;
+    }
+  }
+  return code;
+}
+
+static void* parseCsvLinesFn(void* param) {
+  SCsvParseTask* pTask = (SCsvParseTask*)param;
+  int32_t        numOfRows = 0;
+  pTask->code = parseCsvLinesSeq(pTask->pCxt, &pTask->tableCxt, pTask->pChunk, pTask->start, pTask->end, &numOfRows);
+  return NULL;
+}
+
+static void destroyCsvParseTask(SCsvParseTask* pTask) {
+  taosMemoryFreeClear(pTask->pCxt);
+  taosArrayDestroy(pTask->tableCxt.pValues);
+  taosArrayDestroyP(pTask->data.aRowP, (FDelete)tRowDestroy);
+}
+
+// Each thread parses its lines into rows of a private copy of the table data context. The rows are appended to
+// pTableCxt in line order afterwards. If any line fails, *pFallback is set and nothing is appended, so the caller
+// can parse the lines again in sequence and report the error exactly as before.
+static int32_t parseCsvLinesParallel(SInsertParseContext* pCxt, STableDataCxt* pTableCxt, const SCsvChunk* pChunk,
+                                     int32_t start, int32_t end, int32_t numOfThreads, int32_t* pNumOfRows,
+                                     bool* pFallback) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  SCsvParseTask* pTasks = taosMemoryCalloc(numOfThreads, sizeof(SCsvParseTask));
+  TdThread*      pThreads = taosMemoryCalloc(numOfThreads, sizeof(TdThread));
+  bool*          pStarted = taosMemoryCalloc(numOfThreads, sizeof(bool));
+  if (NULL == pTasks || NULL == pThreads || NULL == pStarted) {
+    code = terrno;
+  }
+
+  int32_t step = (end - start) / numOfThreads;
+  for (int32_t t = 0; TSDB_CODE_SUCCESS == code && t < numOfThreads; ++t) {
+    SCsvParseTask* pTask = &pTasks[t];
+    pTask->pChunk = pChunk;
+    pTask->start = start + t * step;
+    pTask->end = (t == numOfThreads - 1) ? end : start + (t + 1) * step;
+    pTask->tableCxt = *pTableCxt;
+    pTask->tableCxt.pData = &pTask->data;
+    pTask->tableCxt.pValues = taosArrayDup(pTableCxt->pValues, NULL);
+    pTask->data.aRowP = taosArrayInit(pTask->end - pTask->start, POINTER_BYTES);
+    pTask->pCxt = taosMemoryCalloc(1, sizeof(SInsertParseContext));
+    if (NULL == pTask->tableCxt.pValues || NULL == pTask->data.aRowP || NULL == pTask->pCxt) {
+      code = terrno;
+      break;
+    }
+    pTask->pCxt->pComCxt = pCxt->pComCxt;
+    pTask->pCxt->msg.buf = pTask->msg;
+    pTask->pCxt->msg.len = sizeof(pTask->msg);
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    for (int32_t t = 0; t < numOfThreads - 1; ++t) {
+      pStarted[t] = (0 == taosThreadCreate(&pThreads[t], NULL, parseCsvLinesFn, &pTasks[t]));
+      if (!pStarted[t]) {
+        (void)parseCsvLinesFn(&pTasks[t]);
+      }
+    }
+    (void)parseCsvLinesFn(&pTasks[numOfThreads - 1]);
+    for (int32_t t = 0; t < numOfThreads - 1; ++t) {
+      if (pStarted[t]) {
+        (void)taosThreadJoin(pThreads[t], NULL);
+      }
+    }
+
+    for (int32_t t = 0; t < numOfThreads; ++t) {
+      if (TSDB_CODE_SUCCESS != pTasks[t].code) {
+        *pFallback = true;
+        break;
+      }
+    }
+  }
+
+  for (int32_t t = 0; TSDB_CODE_SUCCESS == code && !(*pFallback) && t < numOfThreads; ++t) {
+    SArray* pRows = pTasks[t].data.aRowP;
+    int32_t numOfRows = taosArrayGetSize(pRows);
+    if (0 == numOfRows) {
+      continue;
+    }
+    if (NULL == taosArrayAddBatch(pTableCxt->pData->aRowP, TARRAY_GET_ELEM(pRows, 0), numOfRows)) {
+      code = terrno;
+      break;
+    }
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      SRowKey key;
+      tRowGetKey(*(SRow**)taosArrayGet(pRows, i), &key);
+      insCheckTableDataOrder(pTableCxt, &key);
+    }
+    // the rows are owned by pTableCxt now
+    taosArrayClear(pRows);
+    (*pNumOfRows) += numOfRows;
+  }
+
+  for (int32_t t = 0; NULL != pTasks && t < numOfThreads; ++t) {
+    destroyCsvParseTask(&pTasks[t]);
+  }
+  taosMemoryFree(pTasks);
+  taosMemoryFree(pThreads);
+  taosMemoryFree(pStarted);
+  return code;
+}
+
+static int32_t parseCsvLines(SInsertParseContext* pCxt, STableDataCxt* pTableCxt, const SCsvChunk* pChunk,
+                             int32_t start, int32_t end, int32_t* pNumOfRows) {
+  int32_t numOfThreads = TMAX(TMIN(tsCsvParseThreads, (end - start) / CSV_PARSE_LINES_PER_THREAD), 1);
+  if (numOfThreads > 1) {
+    bool    fallback = false;
+    int32_t code =
+        parseCsvLinesParallel(pCxt, pTableCxt, pChunk, start, end, numOfThreads, pNumOfRows, &fallback);
+    if (TSDB_CODE_SUCCESS != code || !fallback) {
+      return code;
+    }
+  }
+  return parseCsvLinesSeq(pCxt, pTableCxt, pChunk, start, end, pNumOfRows);
+}
+
+// the normal table path of parseCsvFile when csvParseThreads > 1, the file is read in chunks of lines which are
+// parsed by several threads
+static int32_t parseCsvFileByChunk(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, STableDataCxt* pTableCxt,
+                                   bool firstLine, int32_t* pNumOfRows) {
+  SCsvChunk chunk = {0};
+  chunk.pOffsets = taosArrayInit(CSV_PARSE_LINES_PER_THREAD, sizeof(int64_t));
+  if (NULL == chunk.pOffsets) {
+    return terrno;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  bool    eof = false;
+  while (TSDB_CODE_SUCCESS == code && !eof && (*pNumOfRows) < tsMaxInsertBatchRows) {
+    int32_t maxLines = TMIN(tsCsvParseThreads * CSV_PARSE_LINES_PER_THREAD, tsMaxInsertBatchRows - (*pNumOfRows));
+    code = readCsvChunk(pStmt->fp, maxLines, &chunk, &firstLine, &eof);
+
+    int32_t start = 0;
+    int32_t numOfLines = taosArrayGetSize(chunk.pOffsets);
+    if (TSDB_CODE_SUCCESS == code && firstLine && numOfLines > 0) {
+      // the first line is taken as the header if it can not be parsed
+      (void)parseCsvLinesSeq(pCxt, pTableCxt, &chunk, 0, 1, pNumOfRows);
+      firstLine = false;
+      start = 1;
+    }
+    if (TSDB_CODE_SUCCESS == code && start < numOfLines) {
+      code = parseCsvLines(pCxt, pTableCxt, &chunk, start, numOfLines, pNumOfRows);
+    }
+  }
+  destroyCsvChunk(&chunk);
+
+  if (TSDB_CODE_SUCCESS == code && (*pNumOfRows) >= tsMaxInsertBatchRows) {
+    pStmt->fileProcessing = true;
+  }
+  return code;
+}
+
 static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
                             int32_t* pNumOfRows) {
   int32_t code = TSDB_CODE_SUCCESS;
@@ -2207,8 +2604,13 @@ static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt
   char*   pLine = NULL;
   int64_t readLen = 0;
   bool    firstLine = (pStmt->fileProcessing == false);
+  int64_t startTs = taosGetTimestampUs();
   pStmt->fileProcessing = false;
-  while (TSDB_CODE_SUCCESS == code && (readLen = taosGetLineFile(pStmt->fp, &pLine)) != -1) {
+  if (!pStmt->stbSyntax && tsCsvParseThreads > 1) {
+    code = parseCsvFileByChunk(pCxt, pStmt, rowsDataCxt.pTableDataCxt, firstLine, pNumOfRows);
+  }
+  while (TSDB_CODE_SUCCESS == code && (pStmt->stbSyntax || tsCsvParseThreads <= 1) &&
+         (readLen = taosGetLineFile(pStmt->fp, &pLine)) != -1) {
     if (('\r' == pLine[readLen - 1]) || ('\n' == pLine[readLen - 1])) {
       pLine[--readLen] = '\0';
     }
@@ -2259,7 +2661,11 @@ static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt
   }
   taosMemoryFree(pLine);
 
-  parserDebug("0x%" PRIx64 " %d rows have been parsed", pCxt->pComCxt->requestId, *pNumOfRows);
+  int64_t elapsed = taosGetTimestampUs() - startTs;
+  parserDebug("0x%" PRIx64 " %d rows have been parsed in %" PRId64 "us, %.0f rows/s, %" PRId64
+              " rows of the file in total",
+              pCxt->pComCxt->requestId, *pNumOfRows, elapsed, elapsed > 0 ? (*pNumOfRows) * 1000000.0 / elapsed : 0.0,
+              (int64_t)pStmt->totalRowsNum + (*pNumOfRows));
 
   if (TSDB_CODE_SUCCESS == code && 0 == (*pNumOfRows) && 0 == pStmt->totalRowsNum &&
       (!TSDB_QUERY_HAS_TYPE(pStmt->insertType, TSDB_QUERY_TYPE_STMT_INSERT)) && !pStmt->fileProcessing) {
@@ -3235,6 +3235,10 @@ static EDealRes translateFunction(STranslateContext* pCxt, SFunctionNode** pFunc
     }
   }
   if (TSDB_CODE_SUCCESS == pCxt->errCode) {
+    if (FUNCTION_TYPE_NOW == (*pFunc)->funcType || FUNCTION_TYPE_TODAY == (*pFunc)->funcType ||
+        FUNCTION_TYPE_RAND == (*pFunc)->funcType) {
+      pCxt->nonDeterministic = true;
+    }
     pCxt->errCode = translateFunctionImpl(pCxt, pFunc);
   }
   return TSDB_CODE_SUCCESS == pCxt->errCode ? DEAL_RES_CONTINUE : DEAL_RES_ERROR;
@@ -16638,6 +16642,7 @@ static int32_t setQuery(STranslateContext* pCxt, SQuery* pQuery) {
   }
 
   pQuery->stableQuery = pCxt->stableQuery;
+  pQuery->nonDeterministic = pCxt->nonDeterministic;
 
   if (pQuery->haveResultSet) {
     taosMemoryFreeClear(pQuery->pResSchema);
@@ -116,6 +116,57 @@ bool qParseDbName(const char* pStr, size_t length, char** pDbName) {
   return false;
 }
 
+static bool isSqlLiteral(uint32_t type) {
+  return TK_NK_INTEGER == type || TK_NK_FLOAT == type || TK_NK_HEX == type || TK_NK_BIN == type ||
+         TK_NK_STRING == type;
+}
+
+int32_t qGetSqlTemplate(const char* pStr, int32_t length, char** ppTemplate, int32_t* pTemplateLen,
+                        SArray** ppLiterals) {
+  char*   pTemplate = taosMemoryMalloc(length + 1);
+  SArray* pLiterals = taosArrayInit(8, POINTER_BYTES);
+  if (NULL == pTemplate || NULL == pLiterals) {
+    taosMemoryFree(pTemplate);
+    taosArrayDestroy(pLiterals);
+    return terrno;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t len = 0;
+  int32_t pos = 0;
+  while (TSDB_CODE_SUCCESS == code && pos < length && '\0' != pStr[pos]) {
+    uint32_t type = 0;
+    uint32_t n = tGetToken(pStr + pos, &type);
+    if (0 == n || pos + n > length) {
+      n = length - pos;
+      type = TK_NK_ILLEGAL;
+    }
+    if (isSqlLiteral(type)) {
+      char* pLiteral = taosStrndup(pStr + pos, n);
+      if (NULL == pLiteral || NULL == taosArrayPush(pLiterals, &pLiteral)) {
+        taosMemoryFree(pLiteral);
+        code = terrno;
+      }
+      pTemplate[len++] = '?';
+    } else {
+      (void)memcpy(pTemplate + len, pStr + pos, n);
+      len += n;
+    }
+    pos += n;
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    pTemplate[len] = '\0';
+    *ppTemplate = pTemplate;
+    *pTemplateLen = len;
+    *ppLiterals = pLiterals;
+  } else {
+    taosMemoryFree(pTemplate);
+    taosArrayDestroyP(pLiterals, taosMemoryFree);
+  }
+  return code;
+}
+
 static int32_t analyseSemantic(SParseContext* pCxt, SQuery* pQuery, SParseMetaCache* pMetaCache) {
   int32_t code = authenticate(pCxt, pQuery, pMetaCache);
 
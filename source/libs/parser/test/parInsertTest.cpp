@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+
 #include "parTestUtil.h"
 
 using namespace std;
@@ -48,6 +50,38 @@ TEST_F(ParserInsertTest, singleTableMultiRowTest) {
       "(now+2s, 3, 'guangzhou', 9, 10, 11)");
 }
 
+// plain integers and strings take the scanner fast path, the other shapes go through the tokenizer
+TEST_F(ParserInsertTest, singleTableValueShapeTest) {
+  useDb("root", "test");
+
+  run("INSERT INTO t1 VALUES (1626006833639, -1, 'beijing', 123456789012345678, 4, 5)"
+      "( 1626006833640 , 2 , \"shanghai\" , -9 , 7 , 8 )"
+      "(1626006833641, 0x10, 'it''s', 1234567890123456789, 10, 11)"
+      "(1626006833641 + 1s, +3, 'tab\\tend', '12', 1.5, 1e3)"
+      "('2021-07-11 20:33:53.642', 1.6, '', NULL, 4, 5)");
+}
+
+// INSERT INTO tb_name FILE csv_file_path, parsed sequentially and by several threads
+TEST_F(ParserInsertTest, singleTableCsvFileTest) {
+  useDb("root", "test");
+
+  string   path = TD_TMP_DIR_PATH "parInsertTest.csv";
+  ofstream csv(path);
+  csv << "ts,c1,c2,c3,c4,c5" << endl;
+  for (int32_t i = 0; i < 30000; ++i) {
+    csv << 1626006833639 + i << "," << i << ",'beijing'," << -i << ",4.5,5" << endl;
+  }
+  csv.close();
+
+  int32_t threads = tsCsvParseThreads;
+  tsCsvParseThreads = 1;
+  run("INSERT INTO t1 FILE '" + path + "'");
+  tsCsvParseThreads = 4;
+  run("INSERT INTO t1 FILE '" + path + "'");
+  tsCsvParseThreads = threads;
+  (void)remove(path.c_str());
+}
+
 // INSERT INTO tb1_name VALUES (field1_value, ...) tb2_name VALUES (field1_value, ...)
 TEST_F(ParserInsertTest, multiTableSingleRowTest) {
   useDb("root", "test");
@@ -83,6 +83,16 @@ int32_t sortPriKeyOptGetSequencingNodesImpl(SLogicNode* pNode, bool groupSort, S
 bool isColRefExpr(const SColumnNode* pCol, const SExprNode* pExpr);
 void rewriteTargetsWithResId(SNodeList* pTargets);
 
+#define PLAN_EST_TABLE_ROWS        100000  // assumed rows of one table when the scan has no time range
+#define PLAN_EST_VGROUP_TABLES     100     // assumed tables of one vgroup when the vgroup table number is unknown
+#define PLAN_EST_SYSTABLE_ROWS     1000
+#define PLAN_EST_COND_SELECTIVITY  0.3
+#define PLAN_EST_RANGE_SELECTIVITY 0.1
+#define PLAN_EST_MIN_SELECTIVITY   0.001
+#define PLAN_EST_GROUP_REDUCTION   10
+int64_t estimateLogicNodeRows(SLogicNode* pNode);
+void    estimateLogicSubplanCost(SLogicSubplan* pSubplan, int64_t* pMemSize, int64_t* pCpuCost);
+
 
 #ifdef __cplusplus
 }
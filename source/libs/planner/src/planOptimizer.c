@@ -109,6 +109,9 @@ typedef enum ECondAction {
 #define PUSH_DONW_FLT_COND  (PUSH_DOWN_LEFT_FLT | PUSH_DOWN_RIGHT_FLT)
 #define PUSH_DOWN_ALL_COND  (PUSH_DOWN_LEFT_FLT | PUSH_DOWN_RIGHT_FLT | PUSH_DOWN_ON_COND)
 
+#define HASH_JOIN_OPT_MAX_BUILD_ROWS     1000000  // beyond it the hash table may not fit in the join buffer
+#define HASH_JOIN_OPT_BUILD_COST_FACTOR  3
+
 typedef struct SJoinOptimizeOpt {
   int8_t pushDownFlag;
 } SJoinOptimizeOpt;
@@ -5269,6 +5272,72 @@ static int32_t pushDownLimitOptimize(SOptimizeContext* pCxt, SLogicSubplan* pLog
   return TSDB_CODE_SUCCESS;
 }
 
+// only the order of the group keys is known when a group is created, so that a group that can not be in the top N is
+// never aggregated
+static bool topNAggOptIsGroupKeyCol(SAggLogicNode* pAgg, SNode* pExpr) {
+  if (QUERY_NODE_COLUMN != nodeType(pExpr) || TSDB_DATA_TYPE_JSON == ((SExprNode*)pExpr)->resType.type) {
+    return false;
+  }
+  SNode* pFunc = NULL;
+  FOREACH(pFunc, pAgg->pAggFuncs) {
+    if (QUERY_NODE_FUNCTION == nodeType(pFunc) && fmIsGroupKeyFunc(((SFunctionNode*)pFunc)->funcId) &&
+        0 == strcmp(((SExprNode*)pFunc)->aliasName, ((SColumnNode*)pExpr)->colName)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool topNAggOptShouldBeOptimized(SLogicNode* pNode, void* pCtx) {
+  if (QUERY_NODE_LOGIC_PLAN_SORT != nodeType(pNode) || NULL == pNode->pLimit || NULL != pNode->pSlimit ||
+      1 != LIST_LENGTH(pNode->pChildren)) {
+    return false;
+  }
+
+  SSortLogicNode* pSort = (SSortLogicNode*)pNode;
+  SLogicNode*     pChild = (SLogicNode*)nodesListGetNode(pNode->pChildren, 0);
+  if (pSort->groupSort || pSort->calcGroupId || QUERY_NODE_LOGIC_PLAN_AGG != nodeType(pChild) ||
+      NULL != pChild->pLimit || NULL != pChild->pSlimit || NULL != pChild->pConditions) {
+    return false;
+  }
+
+  SAggLogicNode* pAgg = (SAggLogicNode*)pChild;
+  SLimitNode*    pLimit = (SLimitNode*)pNode->pLimit;
+  if (NULL == pAgg->pGroupKeys || NULL != pAgg->pTopNKeys || pLimit->limit <= 0) {
+    return false;
+  }
+
+  SNode* pKey = NULL;
+  FOREACH(pKey, pSort->pSortKeys) {
+    if (!topNAggOptIsGroupKeyCol(pAgg, ((SOrderByExprNode*)pKey)->pExpr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The sort above the group aggregation only needs the first (limit + offset) groups. When it is ordered by group keys,
+// the aggregation keeps only these groups in its hash table, and skips the rows of the others.
+static int32_t topNAggOptimize(SOptimizeContext* pCxt, SLogicSubplan* pLogicSubplan) {
+  if (pCxt->pPlanCxt->streamQuery) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SLogicNode* pNode = optFindPossibleNode(pLogicSubplan->pNode, topNAggOptShouldBeOptimized, NULL);
+  if (NULL == pNode) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SAggLogicNode* pAgg = (SAggLogicNode*)nodesListGetNode(pNode->pChildren, 0);
+  SLimitNode*    pLimit = (SLimitNode*)pNode->pLimit;
+  int32_t        code = nodesCloneList(((SSortLogicNode*)pNode)->pSortKeys, &pAgg->pTopNKeys);
+  if (TSDB_CODE_SUCCESS == code) {
+    pAgg->topN = pLimit->limit + TMAX(pLimit->offset, 0);
+    pCxt->optimized = true;
+  }
+  return code;
+}
+
 typedef struct STbCntScanOptInfo {
   SAggLogicNode*  pAgg;
   SScanLogicNode* pScan;
@@ -5590,6 +5659,47 @@ static int32_t sortNonPriKeyOptimize(SOptimizeContext* pCxt, SLogicSubplan* pLog
   return TSDB_CODE_SUCCESS;
 }
 
+static void hashJoinOptEstimateInputs(SJoinLogicNode* pJoin) {
+  for (int32_t i = 0; i < 2 && i < LIST_LENGTH(pJoin->node.pChildren); ++i) {
+    pJoin->inputStat[i].inputRowNum = estimateLogicNodeRows((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, i));
+  }
+}
+
+// a merge join input which is not a scan of one table has to be sorted by the primary key first
+static double hashJoinOptMergeInputCost(SLogicNode* pChild, int64_t rows) {
+  if (QUERY_NODE_LOGIC_PLAN_SCAN == nodeType(pChild) && TSDB_SUPER_TABLE != ((SScanLogicNode*)pChild)->tableType) {
+    return rows;
+  }
+  return rows * log2(rows + 2);
+}
+
+static bool hashJoinOptPreferredByCost(SJoinLogicNode* pJoin) {
+  if (!tsQueryCostBasedJoin || DATA_ORDER_LEVEL_NONE != pJoin->node.requireDataOrder ||
+      (!pJoin->isSingleTableJoin && NULL != pJoin->pTagEqCond) || LIST_LENGTH(pJoin->node.pChildren) != 2) {
+    return false;
+  }
+
+  int64_t leftRows = pJoin->inputStat[0].inputRowNum;
+  int64_t rightRows = pJoin->inputStat[1].inputRowNum;
+  int64_t buildRows = TMIN(leftRows, rightRows);
+  if (JOIN_TYPE_LEFT == pJoin->joinType) {
+    buildRows = rightRows;
+  } else if (JOIN_TYPE_RIGHT == pJoin->joinType) {
+    buildRows = leftRows;
+  }
+
+  if (leftRows <= 0 || rightRows <= 0 || buildRows > HASH_JOIN_OPT_MAX_BUILD_ROWS) {
+    return false;
+  }
+
+  double hashCost = buildRows * HASH_JOIN_OPT_BUILD_COST_FACTOR + (leftRows + rightRows - buildRows);
+  double mergeCost = hashJoinOptMergeInputCost((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, 0), leftRows) +
+                     hashJoinOptMergeInputCost((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, 1), rightRows);
+  planDebug("join estimated rows left:%" PRId64 ", right:%" PRId64 ", hash cost:%.0f, merge cost:%.0f", leftRows,
+            rightRows, hashCost, mergeCost);
+  return hashCost < mergeCost;
+}
+
 static bool hashJoinOptShouldBeOptimized(SLogicNode* pNode, void* pCtx) {
   bool res = false;
   if (QUERY_NODE_LOGIC_PLAN_JOIN != nodeType(pNode)) {
@@ -5600,8 +5710,11 @@ static bool hashJoinOptShouldBeOptimized(SLogicNode* pNode, void* pCtx) {
   if (pJoin->joinAlgo != JOIN_ALGO_UNKNOWN) {
     return res;
   }
-  
-  if (!pJoin->hashJoinHint) {
+
+  if (tsQueryCostBasedJoin) {
+    hashJoinOptEstimateInputs(pJoin);
+  }
+  if (!pJoin->hashJoinHint && !hashJoinOptPreferredByCost(pJoin)) {
     goto _return;
   }
 
@@ -7494,6 +7607,7 @@ static const SOptimizeRule optimizeRuleSet[] = {
   {.pName = "SortForjoin",                .optimizeFunc = sortForJoinOptimize},
   {.pName = "SmaIndex",                   .optimizeFunc = smaIndexOptimize},
   {.pName = "PushDownLimit",              .optimizeFunc = pushDownLimitOptimize},
+  {.pName = "TopNAgg",                    .optimizeFunc = topNAggOptimize},
   {.pName = "PartitionTags",              .optimizeFunc = partTagsOptimize},
   {.pName = "MergeProjects",              .optimizeFunc = mergeProjectsOptimize},
   {.pName = "RewriteTail",                .optimizeFunc = rewriteTailOptimize},
@@ -1065,12 +1065,18 @@ static int32_t createMergeJoinPhysiNode(SPhysiPlanContext* pCxt, SNodeList* pChi
     pJoin->node.inputTsOrder = pJoinLogicNode->node.inputTsOrder;
     pJoin->seqWinGroup = pJoinLogicNode->seqWinGroup;
     pJoin->grpJoin = pJoinLogicNode->grpJoin;
+    pJoin->inputStat[0] = pJoinLogicNode->inputStat[0];
+    pJoin->inputStat[1] = pJoinLogicNode->inputStat[1];
     code = getJoinDataBlockDescNode(pChildren, 0, &pLeftDesc);
   }
 
   if (TSDB_CODE_SUCCESS == code) {
     code = getJoinDataBlockDescNode(pChildren, 1, &pRightDesc);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    pJoin->inputStat[0].inputRowSize = pLeftDesc->totalRowSize;
+    pJoin->inputStat[1].inputRowSize = pRightDesc->totalRowSize;
+  }
 
   if (TSDB_CODE_SUCCESS == code && NULL != pJoinLogicNode->pPrimKeyEqCond) {
     code = setNodeSlotId(pCxt, pLeftDesc->dataBlockId, pRightDesc->dataBlockId, pJoinLogicNode->pPrimKeyEqCond,
@@ -1486,6 +1492,10 @@ static int32_t createHashJoinPhysiNode(SPhysiPlanContext* pCxt, SNodeList* pChil
   pJoin->timeRangeTarget = pJoinLogicNode->timeRangeTarget;
   pJoin->timeRange.skey = pJoinLogicNode->timeRange.skey;
   pJoin->timeRange.ekey = pJoinLogicNode->timeRange.ekey;
+  pJoin->inputStat[0] = pJoinLogicNode->inputStat[0];
+  pJoin->inputStat[1] = pJoinLogicNode->inputStat[1];
+  pJoin->inputStat[0].inputRowSize = pLeftDesc->totalRowSize;
+  pJoin->inputStat[1].inputRowSize = pRightDesc->totalRowSize;
 
   if (NULL != pJoinLogicNode->pPrimKeyEqCond) {
     code = setNodeSlotId(pCxt, pLeftDesc->dataBlockId, pRightDesc->dataBlockId, pJoinLogicNode->pPrimKeyEqCond,
@@ -1852,6 +1862,15 @@ static int32_t createAggPhysiNode(SPhysiPlanContext* pCxt, SNodeList* pChildren,
     code = setConditionsSlotId(pCxt, (const SLogicNode*)pAggLogicNode, (SPhysiNode*)pAgg);
   }
 
+  // the top N keys refer to the output columns of the agg itself
+  if (TSDB_CODE_SUCCESS == code && NULL != pAggLogicNode->pTopNKeys) {
+    code = setListSlotId(pCxt, pAgg->node.pOutputDataBlockDesc->dataBlockId, -1, pAggLogicNode->pTopNKeys,
+                         &pAgg->pTopNKeys);
+    if (TSDB_CODE_SUCCESS == code) {
+      pAgg->topN = pAggLogicNode->topN;
+    }
+  }
+
   if (TSDB_CODE_SUCCESS == code) {
     *pPhyNode = (SPhysiNode*)pAgg;
   } else {
@@ -2987,6 +3006,9 @@ static int32_t createPhysiSubplan(SPhysiPlanContext* pCxt, SLogicSubplan* pLogic
     if (TSDB_CODE_SUCCESS == code && !pCxt->pPlanCxt->streamQuery && !pCxt->pPlanCxt->topicQuery) {
       code = createDataDispatcher(pCxt, pSubplan->pNode, &pSubplan->pDataSink);
     }
+    if (TSDB_CODE_SUCCESS == code) {
+      estimateLogicSubplanCost(pLogicSubplan, &pSubplan->estMemSize, &pSubplan->estCpuCost);
+    }
   }
 
   if (TSDB_CODE_SUCCESS == code) {
@@ -1023,9 +1023,16 @@ static int32_t stbSplCreatePartAggNode(SAggLogicNode* pMergeAgg, SLogicNode** pO
   pMergeAgg->node.pChildren = NULL;
   SNode* pConditions = pMergeAgg->node.pConditions;
   pMergeAgg->node.pConditions = NULL;
+  // only the merge agg sees all rows of each group, and can pick the top N groups
+  SNodeList* pTopNKeys = pMergeAgg->pTopNKeys;
+  pMergeAgg->pTopNKeys = NULL;
+  int64_t topN = pMergeAgg->topN;
+  pMergeAgg->topN = 0;
 
   SAggLogicNode* pPartAgg = NULL;
   int32_t code = nodesCloneNode((SNode*)pMergeAgg, (SNode**)&pPartAgg);
+  pMergeAgg->pTopNKeys = pTopNKeys;
+  pMergeAgg->topN = topN;
   if (NULL == pPartAgg) {
     return code;
   }
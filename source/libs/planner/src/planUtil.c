@@ -752,3 +752,198 @@ void rewriteTargetsWithResId(SNodeList* pTargets) {
     pCol->resIdx = pCol->projRefIdx;
   }
 }
+
+static double estimateCondSelectivity(SNode* pCond) {
+  if (NULL == pCond) {
+    return 1.0;
+  }
+
+  // the conjuncts are assumed to be independent, and each one of them keeps a third of the rows
+  if (QUERY_NODE_LOGIC_CONDITION == nodeType(pCond) &&
+      LOGIC_COND_TYPE_AND == ((SLogicConditionNode*)pCond)->condType) {
+    double selectivity = 1.0;
+    SNode* pNode = NULL;
+    FOREACH(pNode, ((SLogicConditionNode*)pCond)->pParameterList) {
+      selectivity *= estimateCondSelectivity(pNode);
+    }
+    return TMAX(selectivity, PLAN_EST_MIN_SELECTIVITY);
+  }
+
+  return PLAN_EST_COND_SELECTIVITY;
+}
+
+static int64_t estimateScanRows(SScanLogicNode* pScan) {
+  double numOfTables = 1;
+  if (TSDB_SUPER_TABLE == pScan->tableType) {
+    int64_t numOfVgTables = 0;
+    int32_t numOfVgroups = (NULL != pScan->pVgroupList) ? pScan->pVgroupList->numOfVgroups : 1;
+    for (int32_t i = 0; i < numOfVgroups && NULL != pScan->pVgroupList; ++i) {
+      numOfVgTables += (int64_t)pScan->pVgroupList->vgroups[i].numOfTable * TSDB_TABLE_NUM_UNIT;
+    }
+    numOfTables = TMAX(numOfVgTables, (int64_t)numOfVgroups * PLAN_EST_VGROUP_TABLES);
+    if (NULL != pScan->pTagCond || NULL != pScan->pTagIndexCond) {
+      numOfTables = TMAX(numOfTables * PLAN_EST_COND_SELECTIVITY, 1);
+    }
+  }
+
+  switch (pScan->scanType) {
+    case SCAN_TYPE_TAG:
+    case SCAN_TYPE_LAST_ROW:
+    case SCAN_TYPE_BLOCK_INFO:
+    case SCAN_TYPE_TABLE_COUNT:
+      return (int64_t)numOfTables;
+    case SCAN_TYPE_SYSTEM_TABLE:
+      return PLAN_EST_SYSTABLE_ROWS;
+    default:
+      break;
+  }
+
+  double rows = numOfTables * PLAN_EST_TABLE_ROWS;
+  bool   hasStart = (TSKEY_MIN != pScan->scanRange.skey);
+  bool   hasEnd = (TSKEY_MAX != pScan->scanRange.ekey);
+  if (hasStart && hasEnd) {
+    rows *= PLAN_EST_RANGE_SELECTIVITY;
+  } else if (hasStart || hasEnd) {
+    rows *= PLAN_EST_COND_SELECTIVITY;
+  }
+
+  return (int64_t)TMAX(rows * estimateCondSelectivity(pScan->node.pConditions), 1);
+}
+
+static int64_t estimateNodeRows(SLogicNode* pNode, SNodeList* pSources);
+
+// the exchange of a merge subplan receives the rows of the source subplans in its group range
+static int64_t estimateExchangeRows(SExchangeLogicNode* pExchange, SNodeList* pSources) {
+  int64_t rows = 0;
+  SNode*  pNode = NULL;
+  FOREACH(pNode, pSources) {
+    SLogicSubplan* pSource = (SLogicSubplan*)pNode;
+    if (pSource->id.groupId >= pExchange->srcStartGroupId && pSource->id.groupId <= pExchange->srcEndGroupId) {
+      rows += estimateNodeRows(pSource->pNode, pSource->pChildren);
+    }
+  }
+  return TMAX(rows, 1);
+}
+
+static int64_t estimateJoinRows(SJoinLogicNode* pJoin, SNodeList* pSources) {
+  int64_t leftRows = estimateNodeRows((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, 0), pSources);
+  int64_t rightRows = estimateNodeRows((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, 1), pSources);
+
+  // the joins are equal joins on the primary key, so an inner join keeps no more rows than the smaller side
+  switch (pJoin->joinType) {
+    case JOIN_TYPE_LEFT:
+      return leftRows;
+    case JOIN_TYPE_RIGHT:
+      return rightRows;
+    case JOIN_TYPE_FULL:
+      return leftRows + rightRows;
+    default:
+      return TMIN(leftRows, rightRows);
+  }
+}
+
+static int64_t estimateNodeRows(SLogicNode* pNode, SNodeList* pSources) {
+  if (NULL == pNode) {
+    return 1;
+  }
+
+  double rows = 0;
+  switch (nodeType(pNode)) {
+    case QUERY_NODE_LOGIC_PLAN_SCAN:
+      return estimateScanRows((SScanLogicNode*)pNode);
+    case QUERY_NODE_LOGIC_PLAN_EXCHANGE:
+      rows = estimateExchangeRows((SExchangeLogicNode*)pNode, pSources);
+      break;
+    case QUERY_NODE_LOGIC_PLAN_JOIN:
+      rows = estimateJoinRows((SJoinLogicNode*)pNode, pSources);
+      break;
+    case QUERY_NODE_LOGIC_PLAN_AGG:
+      if (NULL == ((SAggLogicNode*)pNode)->pGroupKeys) {
+        return 1;
+      }
+      rows = estimateNodeRows((SLogicNode*)nodesListGetNode(pNode->pChildren, 0), pSources) / PLAN_EST_GROUP_REDUCTION;
+      break;
+    case QUERY_NODE_LOGIC_PLAN_WINDOW:
+      rows = estimateNodeRows((SLogicNode*)nodesListGetNode(pNode->pChildren, 0), pSources) / PLAN_EST_GROUP_REDUCTION;
+      break;
+    default: {
+      SNode* pChild = NULL;
+      FOREACH(pChild, pNode->pChildren) { rows += estimateNodeRows((SLogicNode*)pChild, pSources); }
+      break;
+    }
+  }
+
+  rows *= estimateCondSelectivity(pNode->pConditions);
+  if (NULL != pNode->pLimit) {
+    SLimitNode* pLimit = (SLimitNode*)pNode->pLimit;
+    if (pLimit->limit >= 0) {
+      rows = TMIN(rows, pLimit->limit);
+    }
+  }
+
+  return (int64_t)TMAX(rows, 1);
+}
+
+/**
+ * Estimate the output rows of a logic node, with the table count of the vgroups, the scan time range and the
+ * conditions. The estimation is coarse, it is only used to compare the inputs of the same join.
+ */
+int64_t estimateLogicNodeRows(SLogicNode* pNode) { return estimateNodeRows(pNode, NULL); }
+
+static int64_t estimateRowSize(SLogicNode* pNode) {
+  int64_t size = 0;
+  SNode*  pTarget = NULL;
+  FOREACH(pTarget, pNode->pTargets) { size += ((SExprNode*)pTarget)->resType.bytes; }
+  return TMAX(size, 1);
+}
+
+static void estimateNodeCost(SLogicNode* pNode, SNodeList* pSources, double* pMemSize, double* pCpuCost) {
+  SNode* pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) { estimateNodeCost((SLogicNode*)pChild, pSources, pMemSize, pCpuCost); }
+
+  SLogicNode* pInput = (SLogicNode*)nodesListGetNode(pNode->pChildren, 0);
+  switch (nodeType(pNode)) {
+    case QUERY_NODE_LOGIC_PLAN_SCAN:
+    case QUERY_NODE_LOGIC_PLAN_EXCHANGE:
+      *pCpuCost += estimateNodeRows(pNode, pSources);
+      break;
+    case QUERY_NODE_LOGIC_PLAN_AGG:
+      // the group results stay in the hash table until the input is drained
+      if (NULL != ((SAggLogicNode*)pNode)->pGroupKeys) {
+        *pMemSize += (double)estimateNodeRows(pNode, pSources) * estimateRowSize(pNode);
+      }
+      break;
+    case QUERY_NODE_LOGIC_PLAN_SORT:
+    case QUERY_NODE_LOGIC_PLAN_PARTITION:
+      if (NULL != pInput) {
+        *pMemSize += (double)estimateNodeRows(pInput, pSources) * estimateRowSize(pInput);
+      }
+      break;
+    case QUERY_NODE_LOGIC_PLAN_JOIN: {
+      // the smaller input is the one that is buffered, as the hash join build side or the merge join window
+      SLogicNode* pRight = (SLogicNode*)nodesListGetNode(pNode->pChildren, 1);
+      if (NULL != pInput && NULL != pRight) {
+        double leftSize = (double)estimateNodeRows(pInput, pSources) * estimateRowSize(pInput);
+        double rightSize = (double)estimateNodeRows(pRight, pSources) * estimateRowSize(pRight);
+        *pMemSize += TMIN(leftSize, rightSize);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+/**
+ * Estimate the memory held by the blocking operators of a subplan and the rows it processes. The qworker uses them
+ * to decide which tasks are heavy and need admission.
+ */
+void estimateLogicSubplanCost(SLogicSubplan* pSubplan, int64_t* pMemSize, int64_t* pCpuCost) {
+  double memSize = 0;
+  double cpuCost = 0;
+  if (NULL != pSubplan->pNode) {
+    estimateNodeCost(pSubplan->pNode, pSubplan->pChildren, &memSize, &cpuCost);
+  }
+  *pMemSize = (memSize < (double)INT64_MAX) ? (int64_t)memSize : INT64_MAX;
+  *pCpuCost = (cpuCost < (double)INT64_MAX) ? (int64_t)cpuCost : INT64_MAX;
+}
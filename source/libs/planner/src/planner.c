@@ -17,6 +17,7 @@
 
 #include "planInt.h"
 #include "scalar.h"
+#include "tencode.h"
 #include "tglobal.h"
 
 static int32_t debugPrintNode(SNode* pNode) {
@@ -183,4 +184,325 @@ SQueryPlan* qStringToQueryPlan(const char* pStr) {
   return pPlan;
 }
 
+typedef struct SSubplanMsg {
+  char*   pData;
+  int32_t len;
+} SSubplanMsg;
+
+typedef struct SSubplanLinks {
+  SSubplan* pSubplan;
+  SArray*   pChildIdx;
+} SSubplanLinks;
+
+static void destroySubplanMsg(void* p) { taosMemoryFree(((SSubplanMsg*)p)->pData); }
+
+static void destroySubplanLinks(void* p) { taosArrayDestroy(((SSubplanLinks*)p)->pChildIdx); }
+
+static int32_t collectSubplans(const SQueryPlan* pPlan, SArray* pSubplans) {
+  SNode* pGroup = NULL;
+  FOREACH(pGroup, pPlan->pSubplans) {
+    SNode* pSubplan = NULL;
+    FOREACH(pSubplan, ((SNodeListNode*)pGroup)->pNodeList) {
+      if (NULL == taosArrayPush(pSubplans, &pSubplan)) {
+        return terrno;
+      }
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t getSubplanIndex(SArray* pSubplans, SNode* pSubplan) {
+  for (int32_t i = 0; i < taosArrayGetSize(pSubplans); ++i) {
+    if (pSubplan == taosArrayGetP(pSubplans, i)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static int32_t encodeQueryPlan(SEncoder* pEncoder, SArray* pSubplans, SArray* pMsgs) {
+  int32_t num = taosArrayGetSize(pSubplans);
+  TAOS_CHECK_RETURN(tStartEncode(pEncoder));
+  TAOS_CHECK_RETURN(tEncodeI32(pEncoder, num));
+  for (int32_t i = 0; i < num; ++i) {
+    SSubplan*    pSubplan = taosArrayGetP(pSubplans, i);
+    SSubplanMsg* pMsg = taosArrayGet(pMsgs, i);
+    TAOS_CHECK_RETURN(tEncodeI32(pEncoder, pSubplan->execNodeStat.tableNum));
+    TAOS_CHECK_RETURN(tEncodeI32(pEncoder, LIST_LENGTH(pSubplan->pChildren)));
+    SNode* pChild = NULL;
+    FOREACH(pChild, pSubplan->pChildren) {
+      TAOS_CHECK_RETURN(tEncodeI32(pEncoder, getSubplanIndex(pSubplans, pChild)));
+    }
+    TAOS_CHECK_RETURN(tEncodeBinary(pEncoder, (const uint8_t*)pMsg->pData, pMsg->len));
+  }
+  tEndEncode(pEncoder);
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t qQueryPlanToMsg(const SQueryPlan* pPlan, char** pStr, int32_t* pLen) {
+  if (NULL != pPlan->pPostPlan || EXPLAIN_MODE_DISABLE != pPlan->explainInfo.mode) {
+    return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+  SArray* pSubplans = taosArrayInit(TMAX(pPlan->numOfSubplans, 1), POINTER_BYTES);
+  SArray* pMsgs = taosArrayInit(TMAX(pPlan->numOfSubplans, 1), sizeof(SSubplanMsg));
+  if (NULL == pSubplans || NULL == pMsgs) {
+    taosArrayDestroy(pSubplans);
+    taosArrayDestroy(pMsgs);
+    return terrno;
+  }
+
+  int32_t code = collectSubplans(pPlan, pSubplans);
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < taosArrayGetSize(pSubplans); ++i) {
+    SSubplan*   pSubplan = taosArrayGetP(pSubplans, i);
+    SSubplanMsg msg = {0};
+    if (SUBPLAN_TYPE_MODIFY == pSubplan->subplanType && NULL == pSubplan->pNode) {
+      code = TSDB_CODE_OPS_NOT_SUPPORT;
+    } else {
+      code = nodesNodeToMsg((const SNode*)pSubplan, &msg.pData, &msg.len);
+    }
+    if (TSDB_CODE_SUCCESS == code && NULL == taosArrayPush(pMsgs, &msg)) {
+      taosMemoryFree(msg.pData);
+      code = terrno;
+    }
+  }
+
+  int32_t len = 0;
+  if (TSDB_CODE_SUCCESS == code) {
+    SEncoder encoder = {0};
+    tEncoderInit(&encoder, NULL, 0);
+    code = encodeQueryPlan(&encoder, pSubplans, pMsgs);
+    len = encoder.pos;
+    tEncoderClear(&encoder);
+  }
+
+  char* pBuf = NULL;
+  if (TSDB_CODE_SUCCESS == code) {
+    pBuf = taosMemoryMalloc(len);
+    if (NULL == pBuf) {
+      code = terrno;
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    SEncoder encoder = {0};
+    tEncoderInit(&encoder, (uint8_t*)pBuf, len);
+    code = encodeQueryPlan(&encoder, pSubplans, pMsgs);
+    tEncoderClear(&encoder);
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    *pStr = pBuf;
+    *pLen = len;
+  } else {
+    taosMemoryFree(pBuf);
+  }
+  taosArrayDestroy(pSubplans);
+  taosArrayDestroyEx(pMsgs, destroySubplanMsg);
+  return code;
+}
+
+static int32_t appendSubplanToLevel(SQueryPlan* pPlan, SSubplan* pSubplan) {
+  while (pSubplan->level >= LIST_LENGTH(pPlan->pSubplans)) {
+    SNodeListNode* pGroup = NULL;
+    int32_t        code = nodesMakeNode(QUERY_NODE_NODE_LIST, (SNode**)&pGroup);
+    if (TSDB_CODE_SUCCESS == code) {
+      code = nodesListStrictAppend(pPlan->pSubplans, (SNode*)pGroup);
+    }
+    if (TSDB_CODE_SUCCESS != code) {
+      return code;
+    }
+  }
+  SNodeListNode* pGroup = (SNodeListNode*)nodesListGetNode(pPlan->pSubplans, pSubplan->level);
+  return nodesListMakeAppend(&pGroup->pNodeList, (SNode*)pSubplan);
+}
+
+static int32_t decodeSubplan(SDecoder* pDecoder, uint64_t queryId, SQueryPlan* pPlan, SSubplanLinks* pLinks) {
+  int32_t  tableNum = 0;
+  int32_t  childNum = 0;
+  uint8_t* pMsg = NULL;
+  uint32_t msgLen = 0;
+
+  TAOS_CHECK_RETURN(tDecodeI32(pDecoder, &tableNum));
+  TAOS_CHECK_RETURN(tDecodeI32(pDecoder, &childNum));
+  pLinks->pChildIdx = taosArrayInit(TMAX(childNum, 1), sizeof(int32_t));
+  if (NULL == pLinks->pChildIdx) {
+    return terrno;
+  }
+  for (int32_t i = 0; i < childNum; ++i) {
+    int32_t childIdx = 0;
+    TAOS_CHECK_RETURN(tDecodeI32(pDecoder, &childIdx));
+    if (NULL == taosArrayPush(pLinks->pChildIdx, &childIdx)) {
+      return terrno;
+    }
+  }
+  TAOS_CHECK_RETURN(tDecodeBinary(pDecoder, &pMsg, &msgLen));
+
+  SSubplan* pSubplan = NULL;
+  TAOS_CHECK_RETURN(nodesMsgToNode((const char*)pMsg, msgLen, (SNode**)&pSubplan));
+  pSubplan->id.queryId = queryId;
+  pSubplan->execNodeStat.tableNum = tableNum;
+  int32_t code = appendSubplanToLevel(pPlan, pSubplan);
+  if (TSDB_CODE_SUCCESS != code) {
+    nodesDestroyNode((SNode*)pSubplan);
+    return code;
+  }
+  pLinks->pSubplan = pSubplan;
+  return code;
+}
+
+static int32_t linkSubplans(SArray* pLinks) {
+  int32_t num = taosArrayGetSize(pLinks);
+  for (int32_t i = 0; i < num; ++i) {
+    SSubplanLinks* pParent = taosArrayGet(pLinks, i);
+    for (int32_t j = 0; j < taosArrayGetSize(pParent->pChildIdx); ++j) {
+      int32_t childIdx = *(int32_t*)taosArrayGet(pParent->pChildIdx, j);
+      if (childIdx < 0 || childIdx >= num) {
+        return TSDB_CODE_INVALID_MSG;
+      }
+      SSubplanLinks* pChild = taosArrayGet(pLinks, childIdx);
+      TAOS_CHECK_RETURN(nodesListMakeAppend(&pParent->pSubplan->pChildren, (SNode*)pChild->pSubplan));
+      TAOS_CHECK_RETURN(nodesListMakeAppend(&pChild->pSubplan->pParents, (SNode*)pParent->pSubplan));
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t decodeQueryPlan(SDecoder* pDecoder, uint64_t queryId, SQueryPlan* pPlan, SArray* pLinks) {
+  int32_t num = 0;
+  TAOS_CHECK_RETURN(tStartDecode(pDecoder));
+  TAOS_CHECK_RETURN(tDecodeI32(pDecoder, &num));
+  for (int32_t i = 0; i < num; ++i) {
+    SSubplanLinks links = {0};
+    int32_t       code = decodeSubplan(pDecoder, queryId, pPlan, &links);
+    if (NULL == taosArrayPush(pLinks, &links)) {
+      destroySubplanLinks(&links);
+      return terrno;
+    }
+    TAOS_CHECK_RETURN(code);
+  }
+  tEndDecode(pDecoder);
+  pPlan->numOfSubplans = num;
+  return linkSubplans(pLinks);
+}
+
+int32_t qMsgToQueryPlan(const char* pStr, int32_t len, uint64_t queryId, SQueryPlan** ppPlan) {
+  SQueryPlan* pPlan = NULL;
+  int32_t     code = nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN, (SNode**)&pPlan);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodesMakeList(&pPlan->pSubplans);
+  }
+
+  SArray* pLinks = NULL;
+  if (TSDB_CODE_SUCCESS == code) {
+    pLinks = taosArrayInit(4, sizeof(SSubplanLinks));
+    if (NULL == pLinks) {
+      code = terrno;
+    }
+  }
+  // the tlv decoding of subplans converts the headers in place, so work on a copy to keep @pStr reusable
+  char* pBuf = NULL;
+  if (TSDB_CODE_SUCCESS == code) {
+    pBuf = taosMemoryMalloc(len);
+    if (NULL == pBuf) {
+      code = terrno;
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    memcpy(pBuf, pStr, len);
+    SDecoder decoder = {0};
+    tDecoderInit(&decoder, (uint8_t*)pBuf, len);
+    pPlan->queryId = queryId;
+    pPlan->explainInfo.mode = EXPLAIN_MODE_DISABLE;
+    code = decodeQueryPlan(&decoder, queryId, pPlan, pLinks);
+    tDecoderClear(&decoder);
+  }
+  taosMemoryFree(pBuf);
+  taosArrayDestroyEx(pLinks, destroySubplanLinks);
+
+  if (TSDB_CODE_SUCCESS == code) {
+    *ppPlan = pPlan;
+  } else {
+    nodesDestroyNode((SNode*)pPlan);
+  }
+  return code;
+}
+
+static void getPhysiNodeTimeRange(SPhysiNode* pNode, STimeWindow* pRange, int32_t* pNum, bool* pSame) {
+  switch (nodeType(pNode)) {
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN:
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_SEQ_SCAN:
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_MERGE_SCAN: {
+      STimeWindow* pScanRange = &((STableScanPhysiNode*)pNode)->scanRange;
+      if (0 == (*pNum)++) {
+        *pRange = *pScanRange;
+      } else if (pRange->skey != pScanRange->skey || pRange->ekey != pScanRange->ekey) {
+        *pSame = false;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  SNode* pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) { getPhysiNodeTimeRange((SPhysiNode*)pChild, pRange, pNum, pSame); }
+}
+
+int32_t qQueryPlanGetTimeRange(const SQueryPlan* pPlan, STimeWindow* pRange) {
+  int32_t num = 0;
+  bool    same = true;
+  SNode*  pGroup = NULL;
+  FOREACH(pGroup, pPlan->pSubplans) {
+    SNode* pSubplan = NULL;
+    FOREACH(pSubplan, ((SNodeListNode*)pGroup)->pNodeList) {
+      if (NULL != ((SSubplan*)pSubplan)->pNode) {
+        getPhysiNodeTimeRange(((SSubplan*)pSubplan)->pNode, pRange, &num, &same);
+      }
+    }
+  }
+  return (num > 0 && same) ? TSDB_CODE_SUCCESS : TSDB_CODE_OPS_NOT_SUPPORT;
+}
+
+static void setTimeWindow(STimeWindow* pWindow, const STimeWindow* pOld, const STimeWindow* pNew) {
+  if (pWindow->skey == pOld->skey && pWindow->ekey == pOld->ekey) {
+    *pWindow = *pNew;
+  }
+}
+
+static void setPhysiNodeTimeRange(SPhysiNode* pNode, const STimeWindow* pOld, const STimeWindow* pNew) {
+  switch (nodeType(pNode)) {
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN:
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_SEQ_SCAN:
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_MERGE_SCAN:
+      setTimeWindow(&((STableScanPhysiNode*)pNode)->scanRange, pOld, pNew);
+      break;
+    case QUERY_NODE_PHYSICAL_PLAN_FILL:
+      setTimeWindow(&((SFillPhysiNode*)pNode)->timeRange, pOld, pNew);
+      break;
+    case QUERY_NODE_PHYSICAL_PLAN_INTERP_FUNC:
+      setTimeWindow(&((SInterpFuncPhysiNode*)pNode)->timeRange, pOld, pNew);
+      break;
+    case QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN:
+      setTimeWindow(&((SHashJoinPhysiNode*)pNode)->timeRange, pOld, pNew);
+      break;
+    default:
+      break;
+  }
+
+  SNode* pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) { setPhysiNodeTimeRange((SPhysiNode*)pChild, pOld, pNew); }
+}
+
+void qQueryPlanSetTimeRange(SQueryPlan* pPlan, const STimeWindow* pOld, const STimeWindow* pNew) {
+  SNode* pGroup = NULL;
+  FOREACH(pGroup, pPlan->pSubplans) {
+    SNode* pSubplan = NULL;
+    FOREACH(pSubplan, ((SNodeListNode*)pGroup)->pNodeList) {
+      if (NULL != ((SSubplan*)pSubplan)->pNode) {
+        setPhysiNodeTimeRange(((SSubplan*)pSubplan)->pNode, pOld, pNew);
+      }
+    }
+  }
+}
+
 void qDestroyQueryPlan(SQueryPlan* pPlan) { nodesDestroyNode((SNode*)pPlan); }
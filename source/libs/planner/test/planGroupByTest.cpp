@@ -83,3 +83,26 @@ TEST_F(PlanGroupByTest, selectFunc) {
   run("SELECT MAX(c1), c2 FROM t1 GROUP BY c3");
   run("SELECT MAX(c1), t1.* FROM t1 GROUP BY c3");
 }
+
+TEST_F(PlanGroupByTest, topN) {
+  useDb("root", "test");
+
+  run("SELECT c1, COUNT(*) cnt FROM t1 GROUP BY c1 ORDER BY c1 DESC LIMIT 10");
+  EXPECT_NE(physiPlan().find("\"TopNKeys\""), string::npos);
+
+  run("SELECT c1, c2, SUM(c3) s FROM t1 GROUP BY c1, c2 ORDER BY c2, c1 LIMIT 5, 10");
+  EXPECT_NE(physiPlan().find("\"TopNKeys\""), string::npos);
+
+  run("SELECT c2, MAX(c1) m FROM st1 GROUP BY c2 ORDER BY c2 DESC LIMIT 3");
+  EXPECT_NE(physiPlan().find("\"TopNKeys\""), string::npos);
+
+  // the order of an aggregate result is only known after all rows are consumed
+  run("SELECT c1, COUNT(*) cnt FROM t1 GROUP BY c1 ORDER BY cnt DESC LIMIT 10");
+  EXPECT_EQ(physiPlan().find("\"TopNKeys\""), string::npos);
+
+  run("SELECT c1, COUNT(*) cnt FROM t1 GROUP BY c1 HAVING COUNT(*) > 1 ORDER BY c1 LIMIT 10");
+  EXPECT_EQ(physiPlan().find("\"TopNKeys\""), string::npos);
+
+  run("SELECT c1, COUNT(*) cnt FROM t1 GROUP BY c1 ORDER BY c1");
+  EXPECT_EQ(physiPlan().find("\"TopNKeys\""), string::npos);
+}
@@ -15,10 +15,20 @@
 
 #include "planTestUtil.h"
 #include "planner.h"
+#include "tglobal.h"
 
 using namespace std;
 
-class PlanJoinTest : public PlannerTestBase {};
+class PlanJoinTest : public PlannerTestBase {
+ protected:
+  void SetUp() override { costBasedJoin_ = tsQueryCostBasedJoin; }
+
+  // the option is global, a failed assertion must not leak it into the following tests
+  void TearDown() override { tsQueryCostBasedJoin = costBasedJoin_; }
+
+ private:
+  bool costBasedJoin_ = false;
+};
 
 TEST_F(PlanJoinTest, basic) {
   useDb("root", "test");
@@ -58,3 +68,20 @@ TEST_F(PlanJoinTest, multiJoin) {
 
   run("SELECT t1.c1, t2.c1 FROM st1s1 t1 JOIN st1s2 t2 ON t1.ts = t2.ts JOIN st1s3 t3 ON t1.ts = t3.ts");
 }
+
+TEST_F(PlanJoinTest, costBasedJoin) {
+  useDb("root", "test");
+
+  tsQueryCostBasedJoin = false;
+  run("SELECT t1.c1, t2.c1 FROM st1s1 t1 JOIN (SELECT ts, c1 FROM st1 ORDER BY c1) t2 ON t1.ts = t2.ts");
+  EXPECT_EQ(physiPlan().find("PhysiHashJoin"), std::string::npos);
+
+  // the right input has to be sorted by the primary key for a merge join, a hash join on the smaller left input is
+  // cheaper
+  tsQueryCostBasedJoin = true;
+  run("SELECT t1.c1, t2.c1 FROM st1s1 t1 JOIN (SELECT ts, c1 FROM st1 ORDER BY c1) t2 ON t1.ts = t2.ts");
+  EXPECT_NE(physiPlan().find("PhysiHashJoin"), std::string::npos);
+
+  run("SELECT t1.c1, t2.c1 FROM st1s1 t1 JOIN st1s2 t2 ON t1.ts = t2.ts "
+      "WHERE t1.ts > TIMESTAMP '2022-04-01 00:00:00' AND t1.c1 > 10");
+}
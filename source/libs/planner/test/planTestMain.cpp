@@ -86,6 +86,7 @@ static void parseArg(int argc, char* argv[]) {
     {"log", required_argument, NULL, 'l'},
     {"queryPolicy", required_argument, NULL, 'q'},
     {"useNodeAllocator", required_argument, NULL, 'a'},
+    {"codecBench", optional_argument, NULL, 'c'},
     {0, 0, 0, 0}
   };
   // clang-format on
@@ -109,6 +110,9 @@ static void parseArg(int argc, char* argv[]) {
       case 'a':
         setUseNodeAllocator(optarg);
         break;
+      case 'c':
+        setCodecBench(optarg);
+        break;
       default:
         break;
     }
@@ -58,6 +58,7 @@ int32_t    g_limitSql = 0;
 int32_t    g_logLevel = 131;
 int32_t    g_queryPolicy = QUERY_POLICY_VNODE;
 bool       g_useNodeAllocator = false;
+int32_t    g_codecBenchLoops = 0;
 
 void setDumpModule(const char* pModule) {
   if (NULL == pModule) {
@@ -88,9 +89,43 @@ void setLimitSqlNum(const char* pArg) { g_limitSql = stoi(pArg); }
 void setLogLevel(const char* pArg) { g_logLevel = stoi(pArg); }
 void setQueryPolicy(const char* pArg) { g_queryPolicy = stoi(pArg); }
 void setUseNodeAllocator(const char* pArg) { g_useNodeAllocator = stoi(pArg); }
+void setCodecBench(const char* pArg) { g_codecBenchLoops = (NULL == pArg ? 1000 : stoi(pArg)); }
 
 int32_t getLogLevel() { return g_logLevel; }
 
+// Accumulated subplan codec cost of all sqls, json text vs tlv msg, reported when the test program exits.
+struct SubplanCodecStat {
+  int64_t numOfSubplans_;
+  int64_t jsonBytes_;
+  int64_t jsonEncodeNs_;
+  int64_t jsonDecodeNs_;
+  int64_t msgBytes_;
+  int64_t msgEncodeNs_;
+  int64_t msgDecodeNs_;
+
+  SubplanCodecStat()
+      : numOfSubplans_(0),
+        jsonBytes_(0),
+        jsonEncodeNs_(0),
+        jsonDecodeNs_(0),
+        msgBytes_(0),
+        msgEncodeNs_(0),
+        msgDecodeNs_(0) {}
+
+  ~SubplanCodecStat() {
+    if (0 == numOfSubplans_) {
+      return;
+    }
+    cout << "subplan codec total, subplans:" << numOfSubplans_ << ", loops:" << g_codecBenchLoops << endl;
+    cout << "  json bytes:" << jsonBytes_ << ", encode:" << jsonEncodeNs_ / 1000 << "us, decode:" << jsonDecodeNs_ / 1000
+         << "us" << endl;
+    cout << "  msg  bytes:" << msgBytes_ << ", encode:" << msgEncodeNs_ / 1000 << "us, decode:" << msgDecodeNs_ / 1000
+         << "us" << endl;
+  }
+};
+
+SubplanCodecStat g_codecStat;
+
 class PlannerTestBaseImpl {
  public:
   PlannerTestBaseImpl() : sqlNo_(0), sqlNum_(0) { assert(qInitKeywordsTable() == 0); }
@@ -175,6 +210,8 @@ class PlannerTestBaseImpl {
     nodesDestroyAllocator(allocatorId);
   }
 
+  const string& physiPlan() const { return res_.physiPlan_; }
+
   void prepare(const string& sql) {
     if (caseEnv_.numOfSkipSql_ > 0) {
       return;
@@ -233,6 +270,10 @@ class PlannerTestBaseImpl {
       unique_ptr<SQueryPlan, void (*)(SQueryPlan*)> plan(pPlan, (void (*)(SQueryPlan*))nodesDestroyNode);
 
       checkPlanMsg((SNode*)pPlan);
+      checkQueryPlanMsg(pPlan);
+      if (g_codecBenchLoops > 0) {
+        benchSubplanCodec(pPlan);
+      }
 
       dump(g_dumpModule);
     } catch (...) {
@@ -513,6 +554,114 @@ class PlannerTestBaseImpl {
     taosMemoryFreeClear(pStr);
   }
 
+  void checkQueryPlanMsg(const SQueryPlan* pPlan) {
+    char*   pStr = NULL;
+    int32_t len = 0;
+    // explain, post plans and inserts can not be converted
+    int32_t code = qQueryPlanToMsg(pPlan, &pStr, &len);
+    if (TSDB_CODE_OPS_NOT_SUPPORT == code) {
+      return;
+    }
+    if (TSDB_CODE_SUCCESS != code) {
+      throw runtime_error("sql:[" + stmtEnv_.sql_ + "] qQueryPlanToMsg code:" + to_string(code) +
+                          ", strerror:" + string(tstrerror(code)));
+    }
+
+    SQueryPlan* pNewPlan = NULL;
+    char*       pNewStr = NULL;
+    int32_t     newlen = 0;
+    DO_WITH_THROW(qMsgToQueryPlan, pStr, len, pPlan->queryId, &pNewPlan)
+    DO_WITH_THROW(qQueryPlanToMsg, pNewPlan, &pNewStr, &newlen)
+    if (pNewPlan->numOfSubplans != pPlan->numOfSubplans ||
+        LIST_LENGTH(pNewPlan->pSubplans) != LIST_LENGTH(pPlan->pSubplans) || newlen != len ||
+        0 != memcmp(pStr, pNewStr, len)) {
+      cout << "qQueryPlanToMsg error!!!!!!!!!!!!!! len = " << len << ", newlen = " << newlen << endl;
+    }
+    qDestroyQueryPlan(pNewPlan);
+    taosMemoryFreeClear(pNewStr);
+    taosMemoryFreeClear(pStr);
+  }
+
+  static int64_t elapsedNs(chrono::steady_clock::time_point start) {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+  }
+
+  // Compare the json text used by qSubPlanToString with the tlv msg used by qSubPlanToMsg for each subplan.
+  void benchSubplanCodec(const SQueryPlan* pPlan) {
+    SubplanCodecStat stat;
+    SNode*           pLevel = NULL;
+    FOREACH(pLevel, pPlan->pSubplans) {
+      SNode* pSubplan = NULL;
+      FOREACH(pSubplan, ((SNodeListNode*)pLevel)->pNodeList) {
+        if (NULL == ((SSubplan*)pSubplan)->pNode) {
+          continue;
+        }
+        benchSubplanJson(pSubplan, stat);
+        benchSubplanMsg(pSubplan, stat);
+        ++stat.numOfSubplans_;
+      }
+    }
+
+    cout << "subplan codec, sql:[" << stmtEnv_.sql_ << "] subplans:" << stat.numOfSubplans_
+         << ", json bytes:" << stat.jsonBytes_ << " encode:" << stat.jsonEncodeNs_ / g_codecBenchLoops
+         << "ns decode:" << stat.jsonDecodeNs_ / g_codecBenchLoops << "ns, msg bytes:" << stat.msgBytes_
+         << " encode:" << stat.msgEncodeNs_ / g_codecBenchLoops << "ns decode:" << stat.msgDecodeNs_ / g_codecBenchLoops
+         << "ns" << endl;
+
+    g_codecStat.numOfSubplans_ += stat.numOfSubplans_;
+    g_codecStat.jsonBytes_ += stat.jsonBytes_;
+    g_codecStat.jsonEncodeNs_ += stat.jsonEncodeNs_;
+    g_codecStat.jsonDecodeNs_ += stat.jsonDecodeNs_;
+    g_codecStat.msgBytes_ += stat.msgBytes_;
+    g_codecStat.msgEncodeNs_ += stat.msgEncodeNs_;
+    g_codecStat.msgDecodeNs_ += stat.msgDecodeNs_;
+  }
+
+  void benchSubplanJson(const SNode* pSubplan, SubplanCodecStat& stat) {
+    char*   pStr = NULL;
+    int32_t len = 0;
+    auto    start = chrono::steady_clock::now();
+    for (int32_t i = 0; i < g_codecBenchLoops; ++i) {
+      taosMemoryFreeClear(pStr);
+      DO_WITH_THROW(nodesNodeToString, pSubplan, false, &pStr, &len)
+    }
+    stat.jsonEncodeNs_ += elapsedNs(start);
+    stat.jsonBytes_ += len;
+
+    for (int32_t i = 0; i < g_codecBenchLoops; ++i) {
+      SNode* pNode = NULL;
+      start = chrono::steady_clock::now();
+      DO_WITH_THROW(nodesStringToNode, pStr, &pNode)
+      stat.jsonDecodeNs_ += elapsedNs(start);
+      nodesDestroyNode(pNode);
+    }
+    taosMemoryFreeClear(pStr);
+  }
+
+  void benchSubplanMsg(const SNode* pSubplan, SubplanCodecStat& stat) {
+    char*   pStr = NULL;
+    int32_t len = 0;
+    auto    start = chrono::steady_clock::now();
+    for (int32_t i = 0; i < g_codecBenchLoops; ++i) {
+      taosMemoryFreeClear(pStr);
+      DO_WITH_THROW(nodesNodeToMsg, pSubplan, &pStr, &len)
+    }
+    stat.msgEncodeNs_ += elapsedNs(start);
+    stat.msgBytes_ += len;
+
+    // the tlv decoder converts headers in place, so each round decodes a fresh copy and only the decoding is timed
+    string copyStr(pStr, len);
+    for (int32_t i = 0; i < g_codecBenchLoops; ++i) {
+      memcpy((char*)copyStr.data(), pStr, len);
+      SNode* pNode = NULL;
+      start = chrono::steady_clock::now();
+      DO_WITH_THROW(nodesMsgToNode, copyStr.data(), len, &pNode)
+      stat.msgDecodeNs_ += elapsedNs(start);
+      nodesDestroyNode(pNode);
+    }
+    taosMemoryFreeClear(pStr);
+  }
+
   caseEnv caseEnv_;
   stmtEnv stmtEnv_;
   stmtRes res_;
@@ -528,6 +677,8 @@ void PlannerTestBase::useDb(const std::string& user, const std::string& db) { im
 
 void PlannerTestBase::run(const std::string& sql) { return impl_->run(sql); }
 
+const std::string& PlannerTestBase::physiPlan() const { return impl_->physiPlan(); }
+
 void PlannerTestBase::prepare(const std::string& sql) { return impl_->prepare(sql); }
 
 void PlannerTestBase::bindParams(TAOS_MULTI_BIND* pParams, int32_t colIdx) {
@@ -32,6 +32,8 @@ class PlannerTestBase : public testing::Test {
 
   void useDb(const std::string& user, const std::string& db);
   void run(const std::string& sql);
+  // the physical plan of the last sql, in json
+  const std::string& physiPlan() const;
   // stmt mode APIs
   void prepare(const std::string& sql);
   void bindParams(TAOS_MULTI_BIND* pParams, int32_t colIdx);
@@ -47,6 +49,7 @@ extern void    setLimitSqlNum(const char* pArg);
 extern void    setLogLevel(const char* pArg);
 extern void    setQueryPolicy(const char* pArg);
 extern void    setUseNodeAllocator(const char* pArg);
+extern void    setCodecBench(const char* pArg);
 extern int32_t getLogLevel();
 
 #endif  // PLAN_TEST_UTIL_H
@@ -273,6 +273,23 @@ char* jobTaskStatusStr(int32_t status) {
   return "UNKNOWN";
 }
 
+char* taskAdmitStateStr(int32_t state) {
+  switch (state) {
+    case TASK_ADMIT_DIRECT:
+      return "DIRECT";
+    case TASK_ADMIT_QUEUED:
+      return "QUEUED";
+    case TASK_ADMIT_WAITED:
+      return "WAITED";
+    case TASK_ADMIT_ALONE:
+      return "ALONE";
+    default:
+      break;
+  }
+
+  return "UNKNOWN";
+}
+
 #if 0
 SSchema createSchema(int8_t type, int32_t bytes, col_id_t colId, const char* name) {
   SSchema s = {0};
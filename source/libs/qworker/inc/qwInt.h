@@ -36,6 +36,9 @@ extern "C" {
 #define QW_DEFAULT_HEARTBEAT_MSEC   5000
 #define QW_SCH_TIMEOUT_MSEC         180000
 #define QW_MIN_RES_ROWS             16384
+#define QW_MAX_RES_ROWS             1048576
+#define QW_HEAVY_TASK_CPU_COST      100000000  // estimated processed rows from which a query task is heavy
+#define QW_ADMIT_AGING_MSEC         30000      // queued heavy tasks waiting longer can not be passed by cheaper ones
 
 enum {
   QW_PHASE_PRE_QUERY = 1,
@@ -72,6 +75,14 @@ enum {
   QW_NOT_EXIST_ADD,
 };
 
+enum {
+  QW_ADMIT_SLOT_NONE = 0,
+  QW_ADMIT_SLOT_PENDING,  // heavy task deferred, not in the admission queue yet
+  QW_ADMIT_SLOT_QUEUED,   // heavy task waiting in the admission queue
+  QW_ADMIT_SLOT_HELD,     // heavy task holding a heavy task slot
+  QW_ADMIT_SLOT_YIELDED,  // heavy task paused on a full sink, its slot is lent to the others
+};
+
 typedef struct SQWDebug {
   bool lockEnable;
   bool statusEnable;
@@ -110,6 +121,9 @@ typedef struct SQWTaskStatus {
   int64_t refId;  // job's refId
   int32_t code;
   int8_t  status;
+  int8_t  admitState;   // ETaskAdmitState
+  int64_t queueTs;      // msecond the task started to wait for admission
+  int64_t queueWaitMs;  // msecond the task waited for admission
 } SQWTaskStatus;
 
 typedef struct SQWTaskCtx {
@@ -123,6 +137,8 @@ typedef struct SQWTaskCtx {
   int8_t   dynamicTask;
   int32_t  queryMsgType;
   int32_t  fetchMsgType;
+  int32_t  fetchCreditRows;
+  int8_t   fetchColumnar;  // the requester decodes the blocks compressed column by column
   int32_t  level;
   int32_t  dynExecId;
   uint64_t sId;
@@ -137,6 +153,13 @@ typedef struct SQWTaskCtx {
   int32_t rspCode;
   int64_t affectedRows;  // for insert ...select stmt
 
+  int8_t  admitSlot;   // guarded by gQwMgmt.admitLock
+  int8_t  admitState;  // ETaskAdmitState
+  int64_t admitTs;
+  int64_t estMemSize;  // estimated by the planner
+  int64_t estCpuCost;
+  bool    hasExchange;  // reads the results of other tasks, never queued behind them
+
   SRpcHandleInfo ctrlConnInfo;
   SRpcHandleInfo dataConnInfo;
 
@@ -204,12 +227,29 @@ typedef struct SQWorker {
   int8_t nodeStopped;
 } SQWorker;
 
+typedef struct SQWAdmitTask {
+  int64_t  refId;  // qworker refId
+  uint64_t sId;
+  uint64_t qId;
+  uint64_t cId;
+  uint64_t tId;
+  int64_t  rId;
+  int32_t  eId;
+  int64_t  memSize;
+  int64_t  cpuCost;
+  int64_t  queueTs;
+} SQWAdmitTask;
+
 typedef struct SQWorkerMgmt {
   SRWLatch   lock;
   int32_t    qwRef;
   int32_t    qwNum;
   SQWHbParam param[1024];
   int32_t    paramIdx;
+  SRWLatch   admitLock;
+  int32_t    heavyNum;      // heavy tasks holding a slot on the dnode
+  int64_t    heavyMemSize;  // estimated memory of the heavy tasks holding a slot
+  SArray    *admitQueue;    // SQWAdmitTask, ordered by the estimated cpu cost
 } SQWorkerMgmt;
 
 #define QW_CTX_NOT_EXISTS_ERR_CODE(mgmt) \
@@ -433,6 +473,12 @@ void    qwClearExpiredSch(SQWorker *mgmt, SArray *pExpiredSch);
 int32_t qwAcquireScheduler(SQWorker *mgmt, uint64_t sId, int32_t rwType, SQWSchStatus **sch);
 void    qwFreeTaskCtx(SQWTaskCtx *ctx);
 int32_t qwHandleTaskComplete(QW_FPARAMS_DEF, SQWTaskCtx *ctx);
+int32_t qwAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *admitted);
+int32_t qwEnqueueAdmitTask(QW_FPARAMS_DEF);
+void    qwReleaseAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx);
+void    qwYieldAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx);
+void    qwReclaimAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx);
+void    qwDispatchAdmitTasks(void);
 
 void    qwDbgDumpMgmtInfo(SQWorker *mgmt);
 int32_t qwDbgValidateStatus(QW_FPARAMS_DEF, int8_t oriStatus, int8_t newStatus, bool *ignore, bool dynamicTask);
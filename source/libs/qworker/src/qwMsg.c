@@ -570,6 +570,8 @@ int32_t qWorkerProcessFetchMsg(void *node, void *qWorkerMgmt, SRpcMsg *pMsg, int
   int32_t  eId = req.execId;
 
   SQWMsg qwMsg = {.node = node, .msg = req.pOpParam, .msgLen = 0, .connInfo = pMsg->info, .msgType = pMsg->msgType};
+  qwMsg.msgInfo.fetchCreditRows = req.creditRows;
+  qwMsg.msgInfo.fetchColumnar = req.acceptColumnar;
 
   QW_SCH_TASK_DLOG("processFetch start, node:%p, handle:%p", node, pMsg->info.handle);
 
@@ -6,6 +6,7 @@
 #include "qwMsg.h"
 #include "qworker.h"
 #include "tcommon.h"
+#include "tglobal.h"
 #include "tmsg.h"
 #include "tname.h"
 
@@ -387,6 +388,8 @@ int32_t qwDropTaskCtx(QW_FPARAMS_DEF) {
     QW_ERR_RET(QW_CTX_NOT_EXISTS_ERR_CODE(mgmt));
   }
 
+  qwReleaseAdmitTask(QW_FPARAMS(), ctx);
+
   octx = *ctx;
 
   atomic_store_ptr(&ctx->taskHandle, NULL);
@@ -567,6 +570,11 @@ void qwCloseRef(void) {
   if (atomic_load_32(&gQwMgmt.qwNum) <= 0 && gQwMgmt.qwRef >= 0) {
     taosCloseRef(gQwMgmt.qwRef);  // ignore error
     gQwMgmt.qwRef = -1;
+
+    taosWLockLatch(&gQwMgmt.admitLock);
+    taosArrayDestroy(gQwMgmt.admitQueue);
+    gQwMgmt.admitQueue = NULL;
+    taosWUnLockLatch(&gQwMgmt.admitLock);
   }
   taosWUnLockLatch(&gQwMgmt.lock);
 }
@@ -589,7 +597,8 @@ void qwDestroyImpl(void *pMgmt) {
   mgmt->hbTimer = NULL;
   taosTmrCleanUp(mgmt->timer);
 
-  uint64_t qId, cId, tId;
+  uint64_t sId = 0, qId, cId, tId;
+  int64_t  rId = 0;
   int32_t  eId;
   void    *pIter = taosHashIterate(mgmt->ctxHash, NULL);
 
@@ -597,7 +606,9 @@ void qwDestroyImpl(void *pMgmt) {
     SQWTaskCtx *ctx = (SQWTaskCtx *)pIter;
     void       *key = taosHashGetKey(pIter, NULL);
     QW_GET_QTID(key, qId, cId, tId, eId);
+    sId = ctx->sId;
 
+    qwReleaseAdmitTask(QW_FPARAMS(), ctx);
     qwFreeTaskCtx(ctx);
     QW_TASK_DLOG_E("task ctx freed");
     pIter = taosHashIterate(mgmt->ctxHash, pIter);
@@ -708,3 +719,318 @@ void qwClearExpiredSch(SQWorker *mgmt, SArray *pExpiredSch) {
     qwReleaseScheduler(QW_WRITE, mgmt);
   }
 }
+
+static void qwSetTaskAdmitStatus(QW_FPARAMS_DEF, int8_t admitState, int64_t queueTs, int64_t queueWaitMs) {
+  SQWSchStatus  *sch = NULL;
+  SQWTaskStatus *task = NULL;
+
+  if (qwAcquireScheduler(mgmt, sId, QW_READ, &sch)) {
+    return;
+  }
+
+  if (TSDB_CODE_SUCCESS == qwAcquireTaskStatus(QW_FPARAMS(), QW_WRITE, sch, &task)) {
+    task->admitState = admitState;
+    task->queueTs = queueTs;
+    task->queueWaitMs = queueWaitMs;
+    qwReleaseTaskStatus(QW_WRITE, sch);
+  }
+
+  qwReleaseScheduler(QW_READ, mgmt);
+}
+
+static bool qwIsHeavyTask(SQWTaskCtx *ctx) {
+  if (ctx->hasExchange) {
+    return false;
+  }
+
+  return ctx->estMemSize >= (int64_t)tsQueryHeavyTaskMemSize * 1048576 || ctx->estCpuCost >= QW_HEAVY_TASK_CPU_COST;
+}
+
+// called with gQwMgmt.admitLock held
+static bool qwTakeHeavySlot(int64_t memSize, bool *alone) {
+  int64_t budget = (int64_t)tsQueryHeavyMemBudget * 1048576;
+
+  *alone = false;
+  if (tsQueryMaxHeavyTasks > 0) {
+    if (gQwMgmt.heavyNum >= tsQueryMaxHeavyTasks) {
+      return false;
+    }
+
+    if (budget > 0 && gQwMgmt.heavyMemSize + memSize > budget) {
+      // a task over the whole budget runs alone, its operators spill the buffers beyond their memory size
+      if (gQwMgmt.heavyNum > 0) {
+        return false;
+      }
+      *alone = true;
+    }
+  }
+
+  gQwMgmt.heavyNum++;
+  gQwMgmt.heavyMemSize += memSize;
+  return true;
+}
+
+// called with gQwMgmt.admitLock held
+static void qwPutHeavySlot(int64_t memSize) {
+  gQwMgmt.heavyNum--;
+  gQwMgmt.heavyMemSize -= memSize;
+}
+
+static int32_t qwResumeAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int8_t admitState) {
+  int64_t waitMs = taosGetTimestampMs() - ctx->admitTs;
+
+  ctx->admitState = admitState;
+  qwSetTaskAdmitStatus(QW_FPARAMS(), admitState, ctx->admitTs, waitMs);
+
+  QW_TASK_DLOG("heavy task admitted %s after waiting %" PRId64 "ms, estMemSize:%" PRId64 ", estCpuCost:%" PRId64,
+               taskAdmitStateStr(admitState), waitMs, ctx->estMemSize, ctx->estCpuCost);
+
+  int32_t code = qwUpdateTaskStatus(QW_FPARAMS(), JOB_TASK_STATUS_EXEC, ctx->dynamicTask);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = qwBuildAndSendCQueryMsg(QW_FPARAMS(), &ctx->ctrlConnInfo);
+  }
+
+  if (TSDB_CODE_SUCCESS != code) {
+    QW_TASK_ELOG("resume admitted task failed, code:%x - %s", code, tstrerror(code));
+    QW_UPDATE_RSP_CODE(ctx, code);
+  }
+
+  return code;
+}
+
+/**
+ * Decide whether a new task runs now. Light tasks and the tasks reading exchange inputs always run, so short queries
+ * never wait behind the heavy ones and a merge task never waits for the slots of its own sources. A heavy task runs
+ * if a heavy task slot is free within the memory budget and no heavy task is waiting, otherwise it is deferred and
+ * queued by qwEnqueueAdmitTask once its query rsp is handled.
+ */
+int32_t qwAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *admitted) {
+  bool alone = false;
+
+  *admitted = true;
+  if (tsQueryMaxHeavyTasks <= 0 || !qwIsHeavyTask(ctx)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  ctx->admitTs = taosGetTimestampMs();
+
+  taosWLockLatch(&gQwMgmt.admitLock);
+  if (taosArrayGetSize(gQwMgmt.admitQueue) <= 0 && qwTakeHeavySlot(ctx->estMemSize, &alone)) {
+    ctx->admitSlot = QW_ADMIT_SLOT_HELD;
+    ctx->admitState = alone ? TASK_ADMIT_ALONE : TASK_ADMIT_DIRECT;
+  } else {
+    ctx->admitSlot = QW_ADMIT_SLOT_PENDING;
+    ctx->admitState = TASK_ADMIT_QUEUED;
+    *admitted = false;
+  }
+  int32_t heavyNum = gQwMgmt.heavyNum;
+  int64_t heavyMemSize = gQwMgmt.heavyMemSize;
+  taosWUnLockLatch(&gQwMgmt.admitLock);
+
+  if (!(*admitted)) {
+    // the task is put to the query queue by qwDispatchAdmitTasks, fetches must not continue it before that
+    atomic_store_8((int8_t *)&ctx->queryInQueue, 1);
+  }
+
+  if (TASK_ADMIT_DIRECT != ctx->admitState) {
+    qwSetTaskAdmitStatus(QW_FPARAMS(), ctx->admitState, ctx->admitTs, 0);
+  }
+
+  QW_TASK_DLOG("heavy task %s, estMemSize:%" PRId64 ", estCpuCost:%" PRId64 ", heavyNum:%d, heavyMemSize:%" PRId64,
+               taskAdmitStateStr(ctx->admitState), ctx->estMemSize, ctx->estCpuCost, heavyNum, heavyMemSize);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t qwEnqueueAdmitTask(QW_FPARAMS_DEF) {
+  SQWTaskCtx *ctx = NULL;
+  int32_t     code = TSDB_CODE_SUCCESS;
+  bool        resume = false;
+
+  QW_ERR_RET(qwAcquireTaskCtx(QW_FPARAMS(), &ctx));
+
+  SQWAdmitTask task = {.refId = mgmt->refId,
+                       .sId = sId,
+                       .qId = qId,
+                       .cId = cId,
+                       .tId = tId,
+                       .rId = rId,
+                       .eId = eId,
+                       .memSize = ctx->estMemSize,
+                       .cpuCost = ctx->estCpuCost,
+                       .queueTs = ctx->admitTs};
+
+  taosWLockLatch(&gQwMgmt.admitLock);
+  if (QW_ADMIT_SLOT_PENDING == ctx->admitSlot) {
+    if (NULL == gQwMgmt.admitQueue) {
+      gQwMgmt.admitQueue = taosArrayInit(16, sizeof(SQWAdmitTask));
+    }
+
+    int32_t num = taosArrayGetSize(gQwMgmt.admitQueue);
+    int32_t pos = num;
+    for (int32_t i = 0; i < num; ++i) {
+      SQWAdmitTask *pTask = taosArrayGet(gQwMgmt.admitQueue, i);
+      if (task.cpuCost < pTask->cpuCost) {
+        pos = i;
+        break;
+      }
+    }
+
+    if (NULL != gQwMgmt.admitQueue && NULL != taosArrayInsert(gQwMgmt.admitQueue, pos, &task)) {
+      ctx->admitSlot = QW_ADMIT_SLOT_QUEUED;
+    } else {
+      // run it over the limits rather than leave it waiting with nobody to resume it
+      gQwMgmt.heavyNum++;
+      gQwMgmt.heavyMemSize += ctx->estMemSize;
+      ctx->admitSlot = QW_ADMIT_SLOT_HELD;
+      resume = true;
+    }
+  }
+  taosWUnLockLatch(&gQwMgmt.admitLock);
+
+  if (resume) {
+    code = qwResumeAdmitTask(QW_FPARAMS(), ctx, TASK_ADMIT_WAITED);
+  }
+
+  qwReleaseTaskCtx(mgmt, ctx);
+
+  qwDispatchAdmitTasks();
+
+  QW_RET(code);
+}
+
+static void qwHandOverHeavySlot(SQWAdmitTask *pTask, bool alone) {
+  uint64_t    sId = pTask->sId;
+  uint64_t    qId = pTask->qId;
+  uint64_t    cId = pTask->cId;
+  uint64_t    tId = pTask->tId;
+  int64_t     rId = pTask->rId;
+  int32_t     eId = pTask->eId;
+  SQWTaskCtx *ctx = NULL;
+  bool        handed = false;
+
+  SQWorker *mgmt = qwAcquire(pTask->refId);
+  if (NULL != mgmt && TSDB_CODE_SUCCESS == qwAcquireTaskCtx(QW_FPARAMS(), &ctx)) {
+    taosWLockLatch(&gQwMgmt.admitLock);
+    if (QW_ADMIT_SLOT_QUEUED == ctx->admitSlot) {
+      ctx->admitSlot = QW_ADMIT_SLOT_HELD;
+      handed = true;
+    }
+    taosWUnLockLatch(&gQwMgmt.admitLock);
+  }
+
+  if (handed) {
+    (void)qwResumeAdmitTask(QW_FPARAMS(), ctx, alone ? TASK_ADMIT_ALONE : TASK_ADMIT_WAITED);
+  } else {
+    QW_TASK_DLOG_E("queued heavy task already dropped");
+
+    taosWLockLatch(&gQwMgmt.admitLock);
+    qwPutHeavySlot(pTask->memSize);
+    taosWUnLockLatch(&gQwMgmt.admitLock);
+  }
+
+  if (ctx) {
+    qwReleaseTaskCtx(mgmt, ctx);
+  }
+  if (mgmt) {
+    (void)qwRelease(pTask->refId);
+  }
+}
+
+/**
+ * Admit the queued heavy tasks while there are free heavy task slots. The cheaper tasks are admitted first, but none
+ * of them passes a task that has waited longer than QW_ADMIT_AGING_MSEC, so the big tasks are not starved.
+ */
+void qwDispatchAdmitTasks(void) {
+  while (true) {
+    SQWAdmitTask task = {0};
+    bool         found = false;
+    bool         alone = false;
+    int64_t      now = taosGetTimestampMs();
+
+    taosWLockLatch(&gQwMgmt.admitLock);
+    int32_t num = taosArrayGetSize(gQwMgmt.admitQueue);
+    for (int32_t i = 0; i < num; ++i) {
+      SQWAdmitTask *pTask = taosArrayGet(gQwMgmt.admitQueue, i);
+      if (qwTakeHeavySlot(pTask->memSize, &alone)) {
+        task = *pTask;
+        taosArrayRemove(gQwMgmt.admitQueue, i);
+        found = true;
+        break;
+      }
+
+      if (now - pTask->queueTs >= QW_ADMIT_AGING_MSEC) {
+        break;
+      }
+    }
+    taosWUnLockLatch(&gQwMgmt.admitLock);
+
+    if (!found) {
+      break;
+    }
+
+    qwHandOverHeavySlot(&task, alone);
+  }
+}
+
+void qwReleaseAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx) {
+  bool dispatch = false;
+
+  taosWLockLatch(&gQwMgmt.admitLock);
+  if (QW_ADMIT_SLOT_HELD == ctx->admitSlot) {
+    qwPutHeavySlot(ctx->estMemSize);
+    dispatch = true;
+  } else if (QW_ADMIT_SLOT_QUEUED == ctx->admitSlot) {
+    int32_t num = taosArrayGetSize(gQwMgmt.admitQueue);
+    for (int32_t i = 0; i < num; ++i) {
+      SQWAdmitTask *pTask = taosArrayGet(gQwMgmt.admitQueue, i);
+      if (pTask->refId == mgmt->refId && pTask->qId == qId && pTask->cId == cId && pTask->tId == tId &&
+          pTask->eId == eId) {
+        taosArrayRemove(gQwMgmt.admitQueue, i);
+        break;
+      }
+    }
+    dispatch = true;
+  }
+  ctx->admitSlot = QW_ADMIT_SLOT_NONE;
+  taosWUnLockLatch(&gQwMgmt.admitLock);
+
+  if (dispatch) {
+    QW_TASK_DLOG("heavy task admission released, estMemSize:%" PRId64, ctx->estMemSize);
+    qwDispatchAdmitTasks();
+  }
+}
+
+/**
+ * A heavy task paused on a full sink waits for its consumer, which may in turn wait for a sibling task queued behind
+ * it, e.g. a multiway merge needing a block from every source. The slot is lent to the queued tasks until the task
+ * continues.
+ */
+void qwYieldAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx) {
+  bool dispatch = false;
+
+  taosWLockLatch(&gQwMgmt.admitLock);
+  if (QW_ADMIT_SLOT_HELD == ctx->admitSlot) {
+    qwPutHeavySlot(ctx->estMemSize);
+    ctx->admitSlot = QW_ADMIT_SLOT_YIELDED;
+    dispatch = true;
+  }
+  taosWUnLockLatch(&gQwMgmt.admitLock);
+
+  if (dispatch) {
+    QW_TASK_DLOG("heavy task paused on full sink, slot yielded, estMemSize:%" PRId64, ctx->estMemSize);
+    qwDispatchAdmitTasks();
+  }
+}
+
+// the consumer is already waiting for the paused task, so it takes its slot back even over the limits, waiting here
+// could deadlock with the tasks it lent the slot to
+void qwReclaimAdmitTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx) {
+  taosWLockLatch(&gQwMgmt.admitLock);
+  if (QW_ADMIT_SLOT_YIELDED == ctx->admitSlot) {
+    gQwMgmt.heavyNum++;
+    gQwMgmt.heavyMemSize += ctx->estMemSize;
+    ctx->admitSlot = QW_ADMIT_SLOT_HELD;
+  }
+  taosWUnLockLatch(&gQwMgmt.admitLock);
+}
@@ -98,11 +98,32 @@ int32_t qwProcessHbLinkBroken(SQWorker *mgmt, SQWMsg *qwMsg, SSchedulerHbReq *re
   QW_RET(TSDB_CODE_SUCCESS);
 }
 
+static bool qwPhysiNodeHasExchange(SPhysiNode *pNode) {
+  if (NULL == pNode) {
+    return false;
+  }
+
+  if (QUERY_NODE_PHYSICAL_PLAN_EXCHANGE == nodeType(pNode)) {
+    return true;
+  }
+
+  SNode *pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) {
+    if (qwPhysiNodeHasExchange((SPhysiNode *)pChild)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 int32_t qwHandleTaskComplete(QW_FPARAMS_DEF, SQWTaskCtx *ctx) {
   qTaskInfo_t taskHandle = ctx->taskHandle;
 
   ctx->queryExecDone = true;
 
+  qwReleaseAdmitTask(QW_FPARAMS(), ctx);
+
   if (TASK_TYPE_TEMP == ctx->taskType && taskHandle) {
     if (ctx->explain && !ctx->explainRsped) {
       QW_ERR_RET(qwSendExplainResponse(QW_FPARAMS(), ctx));
@@ -151,7 +172,9 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
   if (NULL == pResList) {
     QW_ERR_RET(terrno);
   }
-  
+
+  qwReclaimAdmitTask(QW_FPARAMS(), ctx);
+
   while (true) {
     QW_TASK_DLOG("start to execTask, loopIdx:%d", i++);
 
@@ -226,6 +249,7 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
         *queryStop = true;
       }
 
+      qwYieldAdmitTask(QW_FPARAMS(), ctx);
       break;
     }
 
@@ -245,7 +269,11 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
 _return:
 
   taosArrayDestroy(pResList);
-  
+
+  if (TSDB_CODE_SUCCESS != code) {
+    qwReleaseAdmitTask(QW_FPARAMS(), ctx);
+  }
+
   QW_RET(code);
 }
 
@@ -291,6 +319,9 @@ int32_t qwGenerateSchHbRsp(SQWorker *mgmt, SQWSchStatus *sch, SQWHbInfo *hbInfo)
     QW_GET_QTID(key, status.queryId, status.clientId, status.taskId, status.execId);
     status.status = taskStatus->status;
     status.refId = taskStatus->refId;
+    status.admitState = taskStatus->admitState;
+    status.queueWaitMs = (TASK_ADMIT_QUEUED == taskStatus->admitState) ? (taosGetTimestampMs() - taskStatus->queueTs)
+                                                                         : taskStatus->queueWaitMs;
 
     if (NULL == taosArrayPush(hbInfo->rsp.taskStatus, &status)) {
       taosHashCancelIterate(sch->tasksHash, pIter);
@@ -324,6 +355,9 @@ int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen,
   *dataLen = 0;
   *pRawDataLen = 0;
 
+  // the blocks produced from now on are compressed in the format the requester asks for
+  dsSetCompressMode(ctx->sinkHandle, ctx->fetchColumnar ? BLOCK_COMPRESS_COLUMNAR : BLOCK_COMPRESS_LZ4);
+
   while (true) {
     dsGetDataLength(ctx->sinkHandle, &len, &rawLen, &queryEnd);
 
@@ -362,6 +396,14 @@ int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen,
       break;
     }
 
+    // all the blocks of one rsp share the compression format, the block left is returned by the next fetch
+    int8_t compressed = dsGetDataCompressed(ctx->sinkHandle);
+    if (pOutput->compressed && compressed && compressed != pOutput->compressed) {
+      QW_TASK_DLOG("task fetched blocks %d rows %" PRId64 ", next block compressed in another format %d",
+                   pOutput->numOfBlocks, pOutput->numOfRows, compressed);
+      break;
+    }
+
     // Got data from sink
     QW_TASK_DLOG("there are data in sink, dataLength:%" PRId64 "", len);
 
@@ -409,9 +451,11 @@ int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen,
       break;
     }
 
-    if (pOutput->numOfRows >= QW_MIN_RES_ROWS) {
-      QW_TASK_DLOG("task fetched blocks %d rows %" PRId64 " reaches the min rows", pOutput->numOfBlocks,
-                   pOutput->numOfRows);
+    // the requester may grant a larger credit to get more blocks per round trip
+    int64_t resRows = ctx->fetchCreditRows > 0 ? TMIN(ctx->fetchCreditRows, QW_MAX_RES_ROWS) : QW_MIN_RES_ROWS;
+    if (pOutput->numOfRows >= resRows) {
+      QW_TASK_DLOG("task fetched blocks %d rows %" PRId64 " reaches the credit rows %" PRId64, pOutput->numOfBlocks,
+                   pOutput->numOfRows, resRows);
       break;
     }
   }
@@ -765,6 +809,7 @@ int32_t qwProcessQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg, char *sql) {
   qTaskInfo_t    pTaskInfo = NULL;
   DataSinkHandle sinkHandle = NULL;
   SQWTaskCtx    *ctx = NULL;
+  bool           admitted = true;
 
   QW_ERR_JRET(qwHandlePrePhaseEvents(QW_FPARAMS(), QW_PHASE_PRE_QUERY, &input, NULL));
 
@@ -783,6 +828,10 @@ int32_t qwProcessQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg, char *sql) {
     QW_ERR_JRET(code);
   }
 
+  ctx->estMemSize = plan->estMemSize;
+  ctx->estCpuCost = plan->estCpuCost;
+  ctx->hasExchange = qwPhysiNodeHasExchange(plan->pNode);
+
   tsEnableRandErr = true;
   code = qCreateExecTask(qwMsg->node, mgmt->nodeId, tId, plan, &pTaskInfo, &sinkHandle, qwMsg->msgInfo.compressMsg, sql,
                          OPTR_EXEC_MODEL_BATCH);
@@ -809,7 +858,10 @@ int32_t qwProcessQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg, char *sql) {
   QW_ERR_JRET(qwSaveTbVersionInfo(pTaskInfo, ctx));
 
   if (!ctx->dynamicTask) {
-    QW_ERR_JRET(qwExecTask(QW_FPARAMS(), ctx, NULL));
+    QW_ERR_JRET(qwAdmitTask(QW_FPARAMS(), ctx, &admitted));
+    if (admitted) {
+      QW_ERR_JRET(qwExecTask(QW_FPARAMS(), ctx, NULL));
+    }
   } else {
     ctx->queryExecDone = true;
     ctx->queryEnd = true;
@@ -823,6 +875,11 @@ _return:
   input.msgType = qwMsg->msgType;
   code = qwHandlePostPhaseEvents(QW_FPARAMS(), QW_PHASE_POST_QUERY, &input, NULL);
 
+  // queued only after the post phase, so it can not be continued before its query rsp is handled
+  if (!admitted && TSDB_CODE_SUCCESS == code) {
+    code = qwEnqueueAdmitTask(QW_FPARAMS());
+  }
+
   QW_ERR_RET(qwQuickRspFetchReq(QW_FPARAMS(), ctx, qwMsg, code));
 
   QW_RET(TSDB_CODE_SUCCESS);
@@ -940,6 +997,8 @@ int32_t qwProcessFetch(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
   QW_ERR_JRET(qwGetTaskCtx(QW_FPARAMS(), &ctx));
 
   ctx->fetchMsgType = qwMsg->msgType;
+  ctx->fetchCreditRows = qwMsg->msgInfo.fetchCreditRows;
+  ctx->fetchColumnar = qwMsg->msgInfo.fetchColumnar;
   ctx->dataConnInfo = qwMsg->connInfo;
 
   if (qwMsg->msg) {
@@ -35,6 +35,7 @@
 #include "dataSinkMgt.h"
 #include "executor.h"
 #include "planner.h"
+#include "qwInt.h"
 #include "qworker.h"
 #include "stub.h"
 #include "taos.h"
@@ -405,6 +406,14 @@ void qwtGetDataLength(DataSinkHandle handle, int64_t *pLen, bool *pQueryEnd) {
   atomic_sub_fetch_32(&in, 1);
 }
 
+void qwtSetCompressMode(DataSinkHandle handle, int8_t compressMode) {
+  if (NULL == handle) {
+    assert(0);
+  }
+}
+
+int8_t qwtGetDataCompressed(DataSinkHandle handle) { return 1; }
+
 int32_t qwtGetDataBlock(DataSinkHandle handle, SOutputData *pOutput) {
   taosWLockLatch(&qwtTestSinkLock);
   if (qwtTestSinkLastLen > 0) {
@@ -664,6 +673,42 @@ void stubSetGetDataBlock() {
   }
 }
 
+void stubSetDataCompress() {
+  static Stub stub;
+  stub.set(dsSetCompressMode, qwtSetCompressMode);
+  stub.set(dsGetDataCompressed, qwtGetDataCompressed);
+  {
+#ifdef WINDOWS
+    AddrAny                       any;
+    std::map<std::string, void *> result;
+    any.get_func_addr("dsSetCompressMode", result);
+#endif
+#ifdef LINUX
+    AddrAny                       any("libexecutor.so");
+    std::map<std::string, void *> result;
+    any.get_global_func_addr_dynsym("^dsSetCompressMode$", result);
+#endif
+    for (const auto &f : result) {
+      stub.set(f.second, qwtSetCompressMode);
+    }
+  }
+  {
+#ifdef WINDOWS
+    AddrAny                       any;
+    std::map<std::string, void *> result;
+    any.get_func_addr("dsGetDataCompressed", result);
+#endif
+#ifdef LINUX
+    AddrAny                       any("libexecutor.so");
+    std::map<std::string, void *> result;
+    any.get_global_func_addr_dynsym("^dsGetDataCompressed$", result);
+#endif
+    for (const auto &f : result) {
+      stub.set(f.second, qwtGetDataCompressed);
+    }
+  }
+}
+
 void *queryThread(void *param) {
   SRpcMsg  queryRpc = {0};
   int32_t  code = 0;
@@ -884,6 +929,86 @@ void *fetchQueueThread(void *param) {
   return NULL;
 }
 
+int32_t qwtAdmitPutNum = 0;
+
+int32_t qwtAdmitPutToQueue(void *node, EQueueType qtype, struct SRpcMsg *pMsg) {
+  if (TDMT_SCH_QUERY_CONTINUE == pMsg->msgType) {
+    ++qwtAdmitPutNum;
+  }
+  rpcFreeCont(pMsg->pCont);
+  return 0;
+}
+
+SQWTaskCtx *qwtAdmitAddTask(SQWorker *mgmt, uint64_t tId, int64_t memSize, int64_t cpuCost, bool *admitted) {
+  uint64_t    sId = 1, qId = 1, cId = 1;
+  int64_t     rId = 0;
+  int32_t     eId = 0;
+  SQWTaskCtx *ctx = NULL;
+
+  if (qwAddTaskStatus(QW_FPARAMS(), JOB_TASK_STATUS_EXEC) || qwAddTaskCtx(QW_FPARAMS()) ||
+      qwGetTaskCtx(QW_FPARAMS(), &ctx)) {
+    return NULL;
+  }
+
+  ctx->estMemSize = memSize;
+  ctx->estCpuCost = cpuCost;
+  if (qwAdmitTask(QW_FPARAMS(), ctx, admitted)) {
+    return NULL;
+  }
+
+  return ctx;
+}
+
+int32_t qwtAdmitEnqueueTask(SQWorker *mgmt, uint64_t tId) {
+  uint64_t sId = 1, qId = 1, cId = 1;
+  int64_t  rId = 0;
+  int32_t  eId = 0;
+
+  return qwEnqueueAdmitTask(QW_FPARAMS());
+}
+
+int32_t qwtAdmitCompleteTask(SQWorker *mgmt, uint64_t tId, SQWTaskCtx *ctx) {
+  uint64_t sId = 1, qId = 1, cId = 1;
+  int64_t  rId = 0;
+  int32_t  eId = 0;
+
+  return qwHandleTaskComplete(QW_FPARAMS(), ctx);
+}
+
+int32_t qwtAdmitDropTask(SQWorker *mgmt, uint64_t tId) {
+  uint64_t sId = 1, qId = 1, cId = 1;
+  int64_t  rId = 0;
+  int32_t  eId = 0;
+
+  return qwDropTask(QW_FPARAMS());
+}
+
+void *qwtAdmitInit(void) {
+  void   *mgmt = NULL;
+  SMsgCb  msgCb = {0};
+
+  qwtInitLogFile();
+
+  msgCb.mgmt = (void *)0x1;
+  msgCb.putToQueueFp = (PutToQueueFp)qwtAdmitPutToQueue;
+  if (qWorkerInit(NODE_TYPE_VNODE, 1, &mgmt, &msgCb)) {
+    return NULL;
+  }
+
+  qwtAdmitPutNum = 0;
+  tsQueryMaxHeavyTasks = 1;
+  tsQueryHeavyMemBudget = 0;
+
+  return mgmt;
+}
+
+void qwtAdmitDestroy(void **mgmt) {
+  tsQueryMaxHeavyTasks = 0;
+  tsQueryHeavyMemBudget = 0;
+
+  qWorkerDestroy(mgmt);
+}
+
 }  // namespace
 
 TEST(seqTest, normalCase) {
@@ -911,6 +1036,7 @@ TEST(seqTest, normalCase) {
   stubSetEndPut();
   stubSetPutDataBlock();
   stubSetGetDataBlock();
+  stubSetDataCompress();
 
   SMsgCb msgCb = {0};
   msgCb.mgmt = (void *)mockPointer;
@@ -1053,6 +1179,7 @@ TEST(seqTest, multithreadRand) {
   stubSetEndPut();
   stubSetPutDataBlock();
   stubSetGetDataBlock();
+  stubSetDataCompress();
 
   taosSeedRand(taosGetTimestampSec());
 
@@ -1114,6 +1241,7 @@ TEST(rcTest, shortExecshortDelay) {
   stubSetEndPut();
   stubSetPutDataBlock();
   stubSetGetDataBlock();
+  stubSetDataCompress();
 
   taosSeedRand(taosGetTimestampSec());
   qwtTestStop = false;
@@ -1197,6 +1325,7 @@ TEST(rcTest, longExecshortDelay) {
   stubSetEndPut();
   stubSetPutDataBlock();
   stubSetGetDataBlock();
+  stubSetDataCompress();
 
   taosSeedRand(taosGetTimestampSec());
   qwtTestStop = false;
@@ -1280,6 +1409,7 @@ TEST(rcTest, shortExeclongDelay) {
   stubSetEndPut();
   stubSetPutDataBlock();
   stubSetGetDataBlock();
+  stubSetDataCompress();
 
   taosSeedRand(taosGetTimestampSec());
   qwtTestStop = false;
@@ -1363,6 +1493,7 @@ TEST(rcTest, dropTest) {
   stubSetEndPut();
   stubSetPutDataBlock();
   stubSetGetDataBlock();
+  stubSetDataCompress();
 
   taosSeedRand(taosGetTimestampSec());
 
@@ -1398,6 +1529,228 @@ TEST(rcTest, dropTest) {
   qWorkerDestroy(&mgmt);
 }
 
+TEST(fetchReqTest, creditRows) {
+  SResFetchReq req = {0};
+  req.header.vgId = 2;
+  req.sId = 1;
+  req.queryId = 2;
+  req.clientId = 3;
+  req.taskId = 4;
+  req.execId = 5;
+  req.creditRows = 65536;
+
+  int32_t msgSize = tSerializeSResFetchReq(NULL, 0, &req);
+  ASSERT_GT(msgSize, 0);
+  char *msg = (char *)taosMemoryCalloc(1, msgSize);
+  ASSERT_NE(msg, nullptr);
+  ASSERT_EQ(tSerializeSResFetchReq(msg, msgSize, &req), msgSize);
+
+  SResFetchReq res = {0};
+  ASSERT_EQ(tDeserializeSResFetchReq(msg, msgSize, &res), 0);
+  ASSERT_EQ(res.queryId, req.queryId);
+  ASSERT_EQ(res.clientId, req.clientId);
+  ASSERT_EQ(res.execId, req.execId);
+  ASSERT_EQ(res.creditRows, req.creditRows);
+
+  taosMemoryFree(msg);
+}
+
+TEST(admitTest, queueAndHandOver) {
+  void *mgmt = qwtAdmitInit();
+  ASSERT_NE(mgmt, nullptr);
+
+  bool        admitted = false;
+  SQWTaskCtx *ctx1 = qwtAdmitAddTask((SQWorker *)mgmt, 1, 0, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx1, nullptr);
+  ASSERT_TRUE(admitted);
+  ASSERT_EQ(ctx1->admitSlot, QW_ADMIT_SLOT_HELD);
+  ASSERT_EQ(ctx1->admitState, TASK_ADMIT_DIRECT);
+
+  // light tasks never wait
+  SQWTaskCtx *ctx2 = qwtAdmitAddTask((SQWorker *)mgmt, 2, 0, 1, &admitted);
+  ASSERT_NE(ctx2, nullptr);
+  ASSERT_TRUE(admitted);
+  ASSERT_EQ(ctx2->admitSlot, QW_ADMIT_SLOT_NONE);
+
+  SQWTaskCtx *ctx3 = qwtAdmitAddTask((SQWorker *)mgmt, 3, 0, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx3, nullptr);
+  ASSERT_FALSE(admitted);
+  ASSERT_EQ(ctx3->admitSlot, QW_ADMIT_SLOT_PENDING);
+  ASSERT_EQ(qwtAdmitEnqueueTask((SQWorker *)mgmt, 3), 0);
+  ASSERT_EQ(ctx3->admitSlot, QW_ADMIT_SLOT_QUEUED);
+  ASSERT_EQ(ctx3->admitState, TASK_ADMIT_QUEUED);
+
+  // the slot is handed over once the running task completes, not only when it is dropped
+  ASSERT_EQ(qwtAdmitCompleteTask((SQWorker *)mgmt, 1, ctx1), 0);
+  ASSERT_EQ(ctx1->admitSlot, QW_ADMIT_SLOT_NONE);
+  ASSERT_EQ(ctx3->admitSlot, QW_ADMIT_SLOT_HELD);
+  ASSERT_EQ(ctx3->admitState, TASK_ADMIT_WAITED);
+  ASSERT_EQ(qwtAdmitPutNum, 1);
+  ASSERT_EQ(taosArrayGetSize(gQwMgmt.admitQueue), 0);
+
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 1), 0);
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 2), 0);
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 3), 0);
+  ASSERT_EQ(gQwMgmt.heavyNum, 0);
+  ASSERT_EQ(gQwMgmt.heavyMemSize, 0);
+
+  qwtAdmitDestroy(&mgmt);
+}
+
+TEST(admitTest, yieldOnFullSink) {
+  void *mgmt = qwtAdmitInit();
+  ASSERT_NE(mgmt, nullptr);
+
+  // two heavy sibling scans of one query feeding a merge that needs a block from each of them
+  bool        admitted = false;
+  SQWTaskCtx *ctx1 = qwtAdmitAddTask((SQWorker *)mgmt, 1, 0, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx1, nullptr);
+  ASSERT_TRUE(admitted);
+
+  SQWTaskCtx *ctx2 = qwtAdmitAddTask((SQWorker *)mgmt, 2, 0, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx2, nullptr);
+  ASSERT_FALSE(admitted);
+  ASSERT_EQ(qwtAdmitEnqueueTask((SQWorker *)mgmt, 2), 0);
+  ASSERT_EQ(ctx2->admitSlot, QW_ADMIT_SLOT_QUEUED);
+
+  // the running task fills its sink and pauses, the queued sibling gets the slot
+  uint64_t sId = 1, qId = 1, cId = 1, tId = 1;
+  int64_t  rId = 0;
+  int32_t  eId = 0;
+  qwYieldAdmitTask((SQWorker *)mgmt, sId, qId, cId, tId, rId, eId, ctx1);
+  ASSERT_EQ(ctx1->admitSlot, QW_ADMIT_SLOT_YIELDED);
+  ASSERT_EQ(ctx2->admitSlot, QW_ADMIT_SLOT_HELD);
+  ASSERT_EQ(qwtAdmitPutNum, 1);
+  ASSERT_EQ(gQwMgmt.heavyNum, 1);
+
+  // continued by a fetch, it takes a slot back without waiting
+  qwReclaimAdmitTask((SQWorker *)mgmt, sId, qId, cId, tId, rId, eId, ctx1);
+  ASSERT_EQ(ctx1->admitSlot, QW_ADMIT_SLOT_HELD);
+  ASSERT_EQ(gQwMgmt.heavyNum, 2);
+
+  ASSERT_EQ(qwtAdmitCompleteTask((SQWorker *)mgmt, 1, ctx1), 0);
+  ASSERT_EQ(qwtAdmitCompleteTask((SQWorker *)mgmt, 2, ctx2), 0);
+  ASSERT_EQ(gQwMgmt.heavyNum, 0);
+
+  // a task dropped while paused gives nothing back
+  SQWTaskCtx *ctx3 = qwtAdmitAddTask((SQWorker *)mgmt, 3, 0, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx3, nullptr);
+  ASSERT_TRUE(admitted);
+  tId = 3;
+  qwYieldAdmitTask((SQWorker *)mgmt, sId, qId, cId, tId, rId, eId, ctx3);
+  ASSERT_EQ(gQwMgmt.heavyNum, 0);
+
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 1), 0);
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 2), 0);
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 3), 0);
+  ASSERT_EQ(gQwMgmt.heavyNum, 0);
+  ASSERT_EQ(gQwMgmt.heavyMemSize, 0);
+
+  qwtAdmitDestroy(&mgmt);
+}
+
+TEST(admitTest, dropQueued) {
+  void *mgmt = qwtAdmitInit();
+  ASSERT_NE(mgmt, nullptr);
+
+  bool        admitted = false;
+  SQWTaskCtx *ctx1 = qwtAdmitAddTask((SQWorker *)mgmt, 1, 0, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx1, nullptr);
+  ASSERT_TRUE(admitted);
+
+  SQWTaskCtx *ctx2 = qwtAdmitAddTask((SQWorker *)mgmt, 2, 0, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx2, nullptr);
+  ASSERT_FALSE(admitted);
+  ASSERT_EQ(qwtAdmitEnqueueTask((SQWorker *)mgmt, 2), 0);
+  ASSERT_EQ(taosArrayGetSize(gQwMgmt.admitQueue), 1);
+
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 2), 0);
+  ASSERT_EQ(taosArrayGetSize(gQwMgmt.admitQueue), 0);
+
+  // nothing is left to resume when the running task ends
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 1), 0);
+  ASSERT_EQ(qwtAdmitPutNum, 0);
+  ASSERT_EQ(gQwMgmt.heavyNum, 0);
+
+  qwtAdmitDestroy(&mgmt);
+}
+
+TEST(admitTest, exchangeNotQueued) {
+  void *mgmt = qwtAdmitInit();
+  ASSERT_NE(mgmt, nullptr);
+
+  bool        admitted = false;
+  SQWTaskCtx *ctx1 = qwtAdmitAddTask((SQWorker *)mgmt, 1, 0, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx1, nullptr);
+  ASSERT_TRUE(admitted);
+
+  // a merge task reading the results of the task holding the only slot must not wait for it
+  uint64_t    sId = 1, qId = 1, cId = 1, tId = 2;
+  int64_t     rId = 0;
+  int32_t     eId = 0;
+  SQWTaskCtx *ctx2 = NULL;
+  ASSERT_EQ(qwAddTaskStatus((SQWorker *)mgmt, sId, qId, cId, tId, rId, eId, JOB_TASK_STATUS_EXEC), 0);
+  ASSERT_EQ(qwAddTaskCtx((SQWorker *)mgmt, sId, qId, cId, tId, rId, eId), 0);
+  ASSERT_EQ(qwGetTaskCtx((SQWorker *)mgmt, sId, qId, cId, tId, rId, eId, &ctx2), 0);
+  ctx2->estCpuCost = QW_HEAVY_TASK_CPU_COST;
+  ctx2->hasExchange = true;
+  ASSERT_EQ(qwAdmitTask((SQWorker *)mgmt, sId, qId, cId, tId, rId, eId, ctx2, &admitted), 0);
+  ASSERT_TRUE(admitted);
+  ASSERT_EQ(ctx2->admitSlot, QW_ADMIT_SLOT_NONE);
+
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 1), 0);
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 2), 0);
+  ASSERT_EQ(gQwMgmt.heavyNum, 0);
+
+  qwtAdmitDestroy(&mgmt);
+}
+
+TEST(admitTest, aging) {
+  void *mgmt = qwtAdmitInit();
+  ASSERT_NE(mgmt, nullptr);
+
+  tsQueryMaxHeavyTasks = 4;
+  tsQueryHeavyMemBudget = 100;
+
+  bool        admitted = false;
+  SQWTaskCtx *ctx1 = qwtAdmitAddTask((SQWorker *)mgmt, 1, 50 * 1048576, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx1, nullptr);
+  ASSERT_TRUE(admitted);
+
+  // a big task that has waited past the aging time is ahead of the cheaper task
+  SQWTaskCtx *ctx2 = qwtAdmitAddTask((SQWorker *)mgmt, 2, 80 * 1048576, QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx2, nullptr);
+  ASSERT_FALSE(admitted);
+  ctx2->admitTs -= QW_ADMIT_AGING_MSEC;
+  ASSERT_EQ(qwtAdmitEnqueueTask((SQWorker *)mgmt, 2), 0);
+  ASSERT_EQ(ctx2->admitSlot, QW_ADMIT_SLOT_QUEUED);
+
+  // it fits in the budget, but can not pass the aged task
+  SQWTaskCtx *ctx3 = qwtAdmitAddTask((SQWorker *)mgmt, 3, 30 * 1048576, 2 * QW_HEAVY_TASK_CPU_COST, &admitted);
+  ASSERT_NE(ctx3, nullptr);
+  ASSERT_FALSE(admitted);
+  ASSERT_EQ(qwtAdmitEnqueueTask((SQWorker *)mgmt, 3), 0);
+  ASSERT_EQ(ctx3->admitSlot, QW_ADMIT_SLOT_QUEUED);
+  ASSERT_EQ(taosArrayGetSize(gQwMgmt.admitQueue), 2);
+
+  ASSERT_EQ(qwtAdmitCompleteTask((SQWorker *)mgmt, 1, ctx1), 0);
+  ASSERT_EQ(ctx2->admitSlot, QW_ADMIT_SLOT_HELD);
+  ASSERT_EQ(ctx3->admitSlot, QW_ADMIT_SLOT_QUEUED);
+  ASSERT_EQ(qwtAdmitPutNum, 1);
+
+  ASSERT_EQ(qwtAdmitCompleteTask((SQWorker *)mgmt, 2, ctx2), 0);
+  ASSERT_EQ(ctx3->admitSlot, QW_ADMIT_SLOT_HELD);
+  ASSERT_EQ(qwtAdmitPutNum, 2);
+
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 1), 0);
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 2), 0);
+  ASSERT_EQ(qwtAdmitDropTask((SQWorker *)mgmt, 3), 0);
+  ASSERT_EQ(gQwMgmt.heavyNum, 0);
+  ASSERT_EQ(gQwMgmt.heavyMemSize, 0);
+
+  qwtAdmitDestroy(&mgmt);
+}
+
 int main(int argc, char **argv) {
   taosSeedRand(taosGetTimestampSec());
   testing::InitGoogleTest(&argc, argv);
@@ -242,6 +242,8 @@ typedef struct SSchTask {
   char           *msg;             // operator tree
   int32_t         msgLen;          // msg length
   int8_t          status;          // task status
+  int8_t          admitState;      // admission state reported by the qworker hb, ETaskAdmitState
+  int64_t         queueWaitMs;     // admission queue wait time reported by the qworker hb
   int32_t         lastMsgType;     // last sent msg type
   int64_t         timeoutUsec;     // task timeout useconds before reschedule
   SQueryNodeAddr  succeedAddr;     // task executed success node address
@@ -1232,6 +1232,7 @@ int32_t schBuildAndSendMsg(SSchJob *pJob, SSchTask *pTask, SQueryNodeAddr *addr,
       req.clientId = pTask->clientId;
       req.taskId = pTask->taskId;
       req.execId = pTask->execId;
+      req.acceptColumnar = tsCompressMsgByColumn;
 
       msgSize = tSerializeSResFetchReq(NULL, 0, &req);
       if (msgSize < 0) {
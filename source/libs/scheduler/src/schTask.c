@@ -1012,6 +1012,9 @@ int32_t schProcessOnTaskStatusRsp(SQueryNodeEpId *pEpId, SArray *pStatusList) {
       continue;
     }
 
+    pTask->admitState = pStatus->admitState;
+    pTask->queueWaitMs = pStatus->queueWaitMs;
+
     if (pStatus->status == JOB_TASK_STATUS_FAIL) {
       // RECORD AND HANDLE ERROR!!!!
       schProcessOnCbEnd(pJob, pTask, 0);
@@ -1112,7 +1115,7 @@ int32_t schLaunchRemoteTask(SSchJob *pJob, SSchTask *pTask) {
       char   *msg = NULL;
       int32_t msgLen = 0;
       SCH_ERR_RET(qSubPlanToString(plan, &msg, &msgLen));
-      SCH_TASK_DLOGL("physical plan len:%d, %s", msgLen, msg);
+      SCH_TASK_DLOGL("physical plan len:%d, msg len:%d, %s", msgLen, pTask->msgLen, msg);
       taosMemoryFree(msg);
     }
   }
@@ -122,7 +122,16 @@ int32_t schedulerGetTasksStatus(int64_t jobId, SArray *pSub) {
 
       SQuerySubDesc subDesc = {0};
       subDesc.tid = pTask->taskId;
-      TAOS_STRCPY(subDesc.status, jobTaskStatusStr(pTask->status));
+      // no ',' or ':' in the status, show queries joins the sub status of the tasks as "tid:status,..."
+      if (TASK_ADMIT_QUEUED == pTask->admitState) {
+        (void)tsnprintf(subDesc.status, sizeof(subDesc.status), "%s(%" PRId64 "ms)",
+                        taskAdmitStateStr(pTask->admitState), pTask->queueWaitMs);
+      } else if (TASK_ADMIT_DIRECT != pTask->admitState) {
+        (void)tsnprintf(subDesc.status, sizeof(subDesc.status), "%s(%s %" PRId64 "ms)", jobTaskStatusStr(pTask->status),
+                        taskAdmitStateStr(pTask->admitState), pTask->queueWaitMs);
+      } else {
+        TAOS_STRCPY(subDesc.status, jobTaskStatusStr(pTask->status));
+      }
 
       if (NULL == taosArrayPush(pSub, &subDesc)) {
         qError("taosArrayPush task %d failed, error: %x, ", m, terrno);
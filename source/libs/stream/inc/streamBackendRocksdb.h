@@ -83,6 +83,12 @@ typedef struct {
   void*  pMeta;
   int8_t removeAllFiles;
 
+  // write batches handed over to the async state writer
+  int32_t asyncInflight;
+  int32_t asyncCode;
+  int64_t stateIoTime;     // time (us) spent by the executor in state read/write
+  int64_t stateStallTime;  // time (us) the executor waited for the async state writer
+
 } STaskDbWrapper;
 
 typedef struct SDbChkp {
@@ -252,6 +258,15 @@ int32_t streamStatePutBatchOptimize(SStreamState* pState, int32_t cfIdx, rocksdb
                                     void* val, int32_t vlen, int64_t ttl, void* tmpBuf);
 
 int32_t streamStatePutBatch_rocksdb(SStreamState* pState, void* pBatch);
+int32_t streamStatePutBatchAsync_rocksdb(SStreamState* pState, void* pBatch);
+int32_t streamStateMultiGet_rocksdb(SStreamState* pState, int32_t num, const SWinKey* pKeys, void** pVals,
+                                    int32_t* pVLens);
+void    streamStateAddIoTime(SStreamState* pState, int64_t us);
+
+int32_t streamStateAsyncWriterInit();
+void    streamStateAsyncWriterCleanup();
+int32_t taskDbWaitAsyncWrite(STaskDbWrapper* pDb);
+void    taskDbGetStateIoStat(void* arg, int64_t* pIoTime, int64_t* pStallTime);
 int32_t streamBackendTriggerChkp(void* pMeta, char* dst);
 
 int32_t streamBackendAddInUseChkp(void* arg, int64_t chkpId);
@@ -265,11 +280,14 @@ int32_t taskDbDoCheckpoint(void* arg, int64_t chkpId, int64_t processId);
 int32_t bkdMgtCreate(char* path, SBkdMgt** bm);
 int32_t bkdMgtAddChkp(SBkdMgt* bm, char* task, char* path);
 int32_t bkdMgtGetDelta(SBkdMgt* bm, char* taskId, int64_t chkpId, SArray* list, char* name);
+bool    bkdMgtHasChkp(SBkdMgt* bm, char* taskId);
+void    bkdMgtDropChkp(SBkdMgt* bm, char* taskId);
 int32_t bkdMgtDumpTo(SBkdMgt* bm, char* taskId, char* dname);
 void    bkdMgtDestroy(SBkdMgt* bm);
 
 int32_t taskDbGenChkpUploadData(void* arg, void* bkdMgt, int64_t chkpId, int8_t type, char** path, SArray* list,
-                                const char* id);
+                                bool* pBase, const char* id);
+void    taskDbResetChkpUploadData(void* arg, void* bkdMgt);
 int32_t remoteChkpGetDelFile(char* path, SArray* toDel);
 
 void* taskAcquireDb(int64_t refId);
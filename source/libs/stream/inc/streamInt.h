@@ -39,6 +39,11 @@ extern "C" {
 #define STREAM_TASK_KEY_LEN                ((sizeof(int64_t)) << 1)
 #define STREAM_TASK_QUEUE_CAPACITY         5120
 #define STREAM_TASK_QUEUE_CAPACITY_IN_SIZE (30)
+#define STREAM_EXEC_BATCH_DEFAULT_NUM      32
+#define STREAM_EXEC_BATCH_MAX_NUM          512
+#define STREAM_EXEC_LATENCY_BUDGET         (100 * 1000)   // 100ms, exec time budget of one batch in us
+#define STREAM_EXEC_SIZE_BUDGET            (8 * 1048576)  // 8MiB, input size budget of one batch
+#define STREAM_DISPATCH_COALESCE_SIZE      (4 * 1048576)  // 4MiB, max size of output blocks coalesced in one dispatch
 
 // clang-format off
 #define stFatal(...) do { if (stDebugFlag & DEBUG_FATAL) { taosPrintLog("STM FATAL ", DEBUG_FATAL, 255, __VA_ARGS__); }}     while(0)
@@ -114,6 +119,12 @@ typedef struct {
   int32_t sendCompleted;
 } STaskCheckpointReadyInfo;
 
+// the remote files no longer used since checkpointId, they are removed once checkpointId or a later one is committed
+typedef struct {
+  int64_t checkpointId;
+  SArray* pNames;  // file names or rsync patterns
+} SRemoteChkpDelFiles;
+
 typedef struct {
   int64_t sendTs;
   int64_t recvTs;
@@ -206,6 +217,10 @@ void              streamClearChkptReadyMsg(SActiveCheckpointInfo* pActiveInfo);
 EExtractDataCode  streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueItem** pInput, int32_t* numOfBlocks,
                                               int32_t* blockSize);
 int32_t           streamQueueItemGetSize(const SStreamQueueItem* pItem);
+int64_t           streamQueueItemGetTs(const SStreamQueueItem* pItem);
+int32_t           streamTaskGetInputQCredit(const SStreamTask* pTask);
+int32_t           streamTaskGetExecBatchLimit(const SStreamTask* pTask);
+void              streamTaskGetExecBatchStat(const SStreamTask* pTask, STaskStatusEntry* pEntry);
 void              streamQueueItemIncSize(const SStreamQueueItem* pItem, int32_t size);
 const char*       streamQueueItemGetTypeStr(int32_t type);
 int32_t           streamQueueMergeQueueItem(SStreamQueueItem* dst, SStreamQueueItem* pElem, SStreamQueueItem** pRes);
@@ -232,6 +247,7 @@ void    metaRefMgtRemove(int64_t* pRefId);
 ECHECKPOINT_BACKUP_TYPE streamGetCheckpointBackupType();
 
 int32_t streamTaskDownloadCheckpointData(const char* id, char* path, int64_t checkpointId);
+void    streamTaskClearRemoteDelFiles(SArray* pRemoteDel);
 int32_t streamTaskOnNormalTaskReady(SStreamTask* pTask);
 int32_t streamTaskOnScanHistoryTaskReady(SStreamTask* pTask);
 
@@ -15,6 +15,7 @@
 
 #include "streamBackendRocksdb.h"
 #include "lz4.h"
+#include "rsync.h"
 #include "streamInt.h"
 #include "tcommon.h"
 #include "tref.h"
@@ -152,6 +153,7 @@ void taskDbUnRefChkp(STaskDbWrapper* pTaskDb, int64_t chkp);
 
 int32_t chkpAddExtraInfo(char* pChkpIdDir, int64_t chkpId, int64_t processId);
 int32_t chkpLoadExtraInfo(char* pChkpIdDir, int64_t* chkpId, int64_t* processId);
+int32_t rebuildDataFromS3(char* chkpPath, int64_t chkpId);
 
 int32_t  copyFiles(const char* src, const char* dst);
 uint32_t nextPow2(uint32_t x);
@@ -287,7 +289,7 @@ int32_t remoteChkp_readMetaData(char* path, SSChkpMetaOnS3** pMeta) {
     return TSDB_CODE_OUT_OF_MEMORY;
   }
 
-  pFile = taosOpenFile(path, TD_FILE_READ);
+  pFile = taosOpenFile(taosIsDir(path) ? metaPath : path, TD_FILE_READ);
   if (pFile == NULL) {
     code = terrno;
     goto _EXIT;
@@ -441,6 +443,74 @@ int32_t createDirIfNotExist(const char* pPath) {
   }
 }
 
+// the CURRENT_xx/MANIFEST-xx_xx/META_xx of the other checkpoints in the remote data dir are not part of the rebuilt one
+static void removeOtherChkpMetaFiles(const char* path) {
+  TdDirPtr pDir = taosOpenDir(path);
+  if (pDir == NULL) {
+    return;
+  }
+
+  TdDirEntryPtr de = NULL;
+  while ((de = taosReadDir(pDir)) != NULL) {
+    char* name = taosGetDirEntryName(de);
+    if (taosDirEntryIsDir(de)) continue;
+
+    bool other = (strncmp(name, "CURRENT_", 8) == 0) || (strncmp(name, "META_", 5) == 0) ||
+                 (strncmp(name, "MANIFEST-", 9) == 0 && strchr(name, '_') != NULL);
+    if (other) {
+      char filename[PATH_MAX] = {0};
+      int32_t nBytes = snprintf(filename, sizeof(filename), "%s%s%s", path, TD_DIRSEP, name);
+      if (nBytes > 0 && nBytes < sizeof(filename)) {
+        TAOS_UNUSED(taosRemoveFile(filename));
+      }
+    }
+  }
+
+  TAOS_UNUSED(taosCloseDir(&pDir));
+}
+
+// The incremental checkpoints are merged into the data dir on the snode. Each of them comes with its own
+// CURRENT_xx/MANIFEST-xx_xx/META_xx, and the sst files are removed only after a later checkpoint is committed, so the
+// requested checkpoint is rebuilt from its own META_xx even if a later upload is partial or never committed. The plain
+// META of the latest upload is the fallback for the data uploaded without META_xx.
+static int32_t rebuildFromRemoteChkp_rsyncDelta(const char* key, char* checkpointPath, int64_t checkpointId) {
+  char src[PATH_MAX] = {0};
+  char dst[PATH_MAX] = {0};
+
+  int32_t code = taosMulMkDir(checkpointPath);
+  if (code != 0) {
+    return TAOS_SYSTEM_ERROR(errno);
+  }
+
+  code = downloadDeltaByRsync(key, checkpointPath);
+  if (code != 0) {
+    return code;
+  }
+
+  int32_t n1 = snprintf(src, sizeof(src), "%s%sMETA_%" PRId64, checkpointPath, TD_DIRSEP, checkpointId);
+  int32_t n2 = snprintf(dst, sizeof(dst), "%s%sMETA", checkpointPath, TD_DIRSEP);
+  if (n1 <= 0 || n1 >= sizeof(src) || n2 <= 0 || n2 >= sizeof(dst)) {
+    return TSDB_CODE_OUT_OF_RANGE;
+  }
+
+  if (taosCheckExistFile(src)) {
+    code = taosRenameFile(src, dst);
+    if (code != 0) {
+      return code;
+    }
+  }
+
+  code = rebuildDataFromS3(checkpointPath, checkpointId);
+  if (code != 0) {
+    stWarn("%s no incremental checkpoint data for checkpointId:%" PRId64 " in remote data dir, reason:%s", key,
+           checkpointId, tstrerror(code));
+    return code;
+  }
+
+  removeOtherChkpMetaFiles(checkpointPath);
+  return code;
+}
+
 int32_t rebuildFromRemoteChkp_rsync(const char* key, char* checkpointPath, int64_t checkpointId, char* defaultPath) {
   int32_t code = 0;
   if (taosIsDir(checkpointPath)) {
@@ -451,6 +521,17 @@ int32_t rebuildFromRemoteChkp_rsync(const char* key, char* checkpointPath, int64
   cleanDir(defaultPath, key);
   stDebug("clear local default dir before downloading checkpoint data:%s succ", defaultPath);
 
+  if (tsStreamIncrementalCheckpoint) {
+    code = rebuildFromRemoteChkp_rsyncDelta(key, checkpointPath, checkpointId);
+    if (code == 0) {
+      stDebug("rebuild checkpointId:%" PRId64 " from remote incremental checkpoint data, %s", checkpointId, key);
+      return backendCopyFiles(checkpointPath, defaultPath);
+    }
+
+    // try the checkpoint data dir that was uploaded as a whole
+    taosRemoveDir(checkpointPath);
+  }
+
   code = streamTaskDownloadCheckpointData(key, checkpointPath, checkpointId);
   if (code != 0) {
     stError("failed to download checkpoint data:%s", key);
@@ -479,9 +560,11 @@ int32_t rebuildDataFromS3(char* chkpPath, int64_t chkpId) {
     taosMemoryFree(pMeta);
     return code;
   }
+
+  int64_t processId = pMeta->processId;
   taosMemoryFree(pMeta);
 
-  return chkpAddExtraInfo(chkpPath, chkpId, pMeta->processId);
+  return chkpAddExtraInfo(chkpPath, chkpId, processId);
 }
 
 int32_t rebuildFromRemoteChkp_s3(const char* key, char* chkpPath, int64_t chkpId, char* defaultPath) {
@@ -1614,6 +1697,13 @@ int32_t taskDbDoCheckpoint(void* arg, int64_t chkpId, int64_t processId) {
     return code;
   }
 
+  // all window states handed to the async writer must be in the db before the checkpoint is generated
+  if ((code = taskDbWaitAsyncWrite(pTaskDb)) != 0) {
+    stError("stream backend:%p failed to do checkpoint, async state write failed, code:%s", pTaskDb, tstrerror(code));
+    taosReleaseRef(taskDbWrapperId, refId);
+    return code;
+  }
+
   char* pChkpDir = NULL;
   char* pChkpIdDir = NULL;
   if ((code = chkpPreBuildDir(pTaskDb->path, chkpId, &pChkpDir, &pChkpIdDir)) < 0) {
@@ -2616,6 +2706,7 @@ void taskDbDestroy(void* pDb, bool flush) {
   if (wrapper == NULL) return;
 
   streamMetaRemoveDB(wrapper->pMeta, wrapper->idstr);
+  TAOS_UNUSED(taskDbWaitAsyncWrite(wrapper));
 
   stDebug("succ to destroy stream backend:%p", wrapper);
 
@@ -2734,8 +2825,8 @@ int32_t taskDbGenChkpUploadData__rsync(STaskDbWrapper* pDb, int64_t chkpId, char
   return code;
 }
 
-int32_t taskDbGenChkpUploadData__s3(STaskDbWrapper* pDb, void* bkdChkpMgt, int64_t chkpId, char** path, SArray* list,
-                                    const char* idStr) {
+int32_t taskDbGenChkpUploadData__delta(STaskDbWrapper* pDb, void* bkdChkpMgt, int64_t chkpId, char** path,
+                                       SArray* list, bool* pBase, const char* idStr) {
   int32_t  code = 0;
   int32_t  cap = strlen(pDb->path) + 32;
   SBkdMgt* p = (SBkdMgt*)bkdChkpMgt;
@@ -2761,6 +2852,9 @@ int32_t taskDbGenChkpUploadData__s3(STaskDbWrapper* pDb, void* bkdChkpMgt, int64
     }
   }
 
+  // all sst files are dumped if no previous checkpoint of this task is tracked, which is the base of the following ones
+  *pBase = !bkdMgtHasChkp(p, pDb->idstr);
+
   code = bkdMgtGetDelta(p, pDb->idstr, chkpId, list, temp);
   *path = temp;
 
@@ -2768,21 +2862,30 @@ int32_t taskDbGenChkpUploadData__s3(STaskDbWrapper* pDb, void* bkdChkpMgt, int64
 }
 
 int32_t taskDbGenChkpUploadData(void* arg, void* mgt, int64_t chkpId, int8_t type, char** path, SArray* list,
-                                const char* idStr) {
+                                bool* pBase, const char* idStr) {
   int32_t                 code = -1;
   STaskDbWrapper*         pDb = arg;
   ECHECKPOINT_BACKUP_TYPE utype = type;
 
+  *pBase = true;
+
   taskDbRefChkp(pDb, chkpId);
-  if (utype == DATA_UPLOAD_RSYNC) {
+  if (utype == DATA_UPLOAD_RSYNC && !tsStreamIncrementalCheckpoint) {
     code = taskDbGenChkpUploadData__rsync(pDb, chkpId, path);
-  } else if (utype == DATA_UPLOAD_S3) {
-    code = taskDbGenChkpUploadData__s3(pDb, mgt, chkpId, path, list, idStr);
+  } else if (utype == DATA_UPLOAD_RSYNC || utype == DATA_UPLOAD_S3) {
+    code = taskDbGenChkpUploadData__delta(pDb, mgt, chkpId, path, list, pBase, idStr);
   }
   taskDbUnRefChkp(pDb, chkpId);
   return code;
 }
 
+void taskDbResetChkpUploadData(void* arg, void* mgt) {
+  STaskDbWrapper* pDb = arg;
+  if (mgt != NULL) {
+    bkdMgtDropChkp((SBkdMgt*)mgt, pDb->idstr);
+  }
+}
+
 int32_t taskDbOpenCfByKey(STaskDbWrapper* pDb, const char* key) {
   int32_t code = 0;
   char*   err = NULL;
@@ -3084,6 +3187,7 @@ rocksdb_iterator_t* streamStateIterCreate(SStreamState* pState, const char* cfKe
   *readOpt = rocksdb_readoptions_create();
 
   STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;
+  TAOS_UNUSED(taskDbWaitAsyncWrite(wrapper));
   if (snapshot != NULL) {
     *snapshot = (rocksdb_snapshot_t*)rocksdb_create_snapshot(wrapper->db);
     rocksdb_readoptions_set_snapshot(*readOpt, *snapshot);
@@ -3105,6 +3209,8 @@ rocksdb_iterator_t* streamStateIterCreate(SStreamState* pState, const char* cfKe
       break;                                                                                                      \
     }                                                                                                             \
     STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;                                                \
+    code = taskDbWaitAsyncWrite(wrapper);                                                                         \
+    if (code != 0) break;                                                                                         \
     TAOS_UNUSED(atomic_add_fetch_64(&wrapper->dataWritten, 1));                                                   \
     char toString[128] = {0};                                                                                     \
     if (stDebugFlag & DEBUG_TRACE) TAOS_UNUSED((ginitDict[i].toStrFunc((void*)key, toString)));                   \
@@ -3138,6 +3244,7 @@ rocksdb_iterator_t* streamStateIterCreate(SStreamState* pState, const char* cfKe
       break;                                                                                                          \
     }                                                                                                                 \
     STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;                                                    \
+    TAOS_UNUSED(taskDbWaitAsyncWrite(wrapper));                                                                       \
     char            toString[128] = {0};                                                                              \
     if (stDebugFlag & DEBUG_TRACE) TAOS_UNUSED((ginitDict[i].toStrFunc((void*)key, toString)));                       \
     int32_t                         klen = ginitDict[i].enFunc((void*)key, buf);                                      \
@@ -3182,6 +3289,8 @@ rocksdb_iterator_t* streamStateIterCreate(SStreamState* pState, const char* cfKe
       break;                                                                                                      \
     }                                                                                                             \
     STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;                                                \
+    code = taskDbWaitAsyncWrite(wrapper);                                                                         \
+    if (code != 0) break;                                                                                         \
     TAOS_UNUSED(atomic_add_fetch_64(&wrapper->dataWritten, 1));                                                   \
     char toString[128] = {0};                                                                                     \
     if (stDebugFlag & DEBUG_TRACE) TAOS_UNUSED(ginitDict[i].toStrFunc((void*)key, toString));                     \
@@ -3250,6 +3359,7 @@ int32_t streamStateClear_rocksdb(SStreamState* pState) {
   stDebug("streamStateClear_rocksdb");
 
   STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;
+  TAOS_UNUSED(taskDbWaitAsyncWrite(wrapper));
   TAOS_UNUSED(atomic_add_fetch_64(&wrapper->dataWritten, 1));
 
   char      sKeyStr[128] = {0};
@@ -4542,6 +4652,11 @@ int32_t streamStatePutBatchOptimize(SStreamState* pState, int32_t cfIdx, rocksdb
 int32_t streamStatePutBatch_rocksdb(SStreamState* pState, void* pBatch) {
   char*           err = NULL;
   STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;
+  int32_t         code = taskDbWaitAsyncWrite(wrapper);
+  if (code != 0) {
+    return code;
+  }
+
   TAOS_UNUSED(atomic_add_fetch_64(&wrapper->dataWritten, 1));
   rocksdb_write(wrapper->db, wrapper->writeOpt, (rocksdb_writebatch_t*)pBatch, &err);
   if (err != NULL) {
@@ -4553,6 +4668,301 @@ int32_t streamStatePutBatch_rocksdb(SStreamState* pState, void* pBatch) {
   }
   return 0;
 }
+/*
+ * Async state writer.
+ *
+ * Closed windows that are flushed out of the stream file state buffer are written to rocksdb by a single background
+ * thread, so that the executor is not blocked by the rocksdb write path. At most one batch per task db is in flight;
+ * any access to the task db (read, write, iterator, checkpoint, destroy) waits for the in-flight batch first, so the
+ * db is always observed in the same order as the writes were issued.
+ */
+typedef struct {
+  STaskDbWrapper*       pDb;
+  rocksdb_writebatch_t* pBatch;
+} SStateWriteJob;
+
+typedef struct {
+  TdThread      thread;
+  TdThreadMutex mutex;
+  TdThreadCond  notEmpty;
+  TdThreadCond  done;
+  SList*        pJobs;
+  int8_t        quit;
+  int8_t        init;
+} SStateAsyncWriter;
+
+static SStateAsyncWriter gStateWriter = {0};
+
+static void taskDbDoWriteBatch(STaskDbWrapper* pDb, rocksdb_writebatch_t* pBatch) {
+  char*   err = NULL;
+  int64_t st = taosGetTimestampUs();
+
+  rocksdb_write(pDb->db, pDb->writeOpt, pBatch, &err);
+  if (err != NULL) {
+    stError("%s failed to write state batch in async writer, err:%s", pDb->idstr, err);
+    taosMemoryFree(err);
+    TAOS_UNUSED(atomic_val_compare_exchange_32(&pDb->asyncCode, 0, TSDB_CODE_THIRDPARTY_ERROR));
+  } else {
+    stTrace("%s async write state batch, entries:%d, elapsed:%" PRId64 "us", pDb->idstr,
+            rocksdb_writebatch_count(pBatch), taosGetTimestampUs() - st);
+  }
+
+  rocksdb_writebatch_destroy(pBatch);
+}
+
+static void* streamStateAsyncWriterFn(void* param) {
+  setThreadName("stream-state-writer");
+
+  while (1) {
+    streamMutexLock(&gStateWriter.mutex);
+    while (!gStateWriter.quit && TD_DLIST_NELES(gStateWriter.pJobs) == 0) {
+      TAOS_UNUSED(taosThreadCondWait(&gStateWriter.notEmpty, &gStateWriter.mutex));
+    }
+
+    SListNode* pNode = tdListPopHead(gStateWriter.pJobs);
+    if (pNode == NULL) {  // quit and no pending jobs
+      streamMutexUnlock(&gStateWriter.mutex);
+      break;
+    }
+    streamMutexUnlock(&gStateWriter.mutex);
+
+    SStateWriteJob* pJob = (SStateWriteJob*)pNode->data;
+    taskDbDoWriteBatch(pJob->pDb, pJob->pBatch);
+
+    streamMutexLock(&gStateWriter.mutex);
+    pJob->pDb->asyncInflight -= 1;
+    TAOS_UNUSED(taosThreadCondBroadcast(&gStateWriter.done));
+    streamMutexUnlock(&gStateWriter.mutex);
+
+    taosMemoryFree(pNode);
+  }
+
+  return NULL;
+}
+
+int32_t streamStateAsyncWriterInit() {
+  int32_t code = 0;
+  if (gStateWriter.init) {
+    return code;
+  }
+
+  gStateWriter.pJobs = tdListNew(sizeof(SStateWriteJob));
+  if (gStateWriter.pJobs == NULL) {
+    return terrno;
+  }
+
+  code = taosThreadMutexInit(&gStateWriter.mutex, NULL);
+  if (code == 0) {
+    code = taosThreadCondInit(&gStateWriter.notEmpty, NULL);
+  }
+  if (code == 0) {
+    code = taosThreadCondInit(&gStateWriter.done, NULL);
+  }
+  if (code == 0) {
+    TdThreadAttr thAttr;
+    TAOS_UNUSED(taosThreadAttrInit(&thAttr));
+    TAOS_UNUSED(taosThreadAttrSetDetachState(&thAttr, PTHREAD_CREATE_JOINABLE));
+    code = taosThreadCreate(&gStateWriter.thread, &thAttr, streamStateAsyncWriterFn, NULL);
+    TAOS_UNUSED(taosThreadAttrDestroy(&thAttr));
+  }
+
+  if (code != 0) {
+    stError("failed to init stream state async writer, code:%s, write state synchronously", tstrerror(code));
+    gStateWriter.pJobs = tdListFree(gStateWriter.pJobs);
+    return code;
+  }
+
+  gStateWriter.quit = 0;
+  gStateWriter.init = 1;
+  stInfo("stream state async writer is started");
+  return code;
+}
+
+void streamStateAsyncWriterCleanup() {
+  if (!gStateWriter.init) {
+    return;
+  }
+
+  streamMutexLock(&gStateWriter.mutex);
+  gStateWriter.quit = 1;
+  TAOS_UNUSED(taosThreadCondBroadcast(&gStateWriter.notEmpty));
+  streamMutexUnlock(&gStateWriter.mutex);
+
+  TAOS_UNUSED(taosThreadJoin(gStateWriter.thread, NULL));
+  taosThreadClear(&gStateWriter.thread);
+
+  gStateWriter.init = 0;
+  gStateWriter.pJobs = tdListFree(gStateWriter.pJobs);
+  TAOS_UNUSED(taosThreadCondDestroy(&gStateWriter.notEmpty));
+  TAOS_UNUSED(taosThreadCondDestroy(&gStateWriter.done));
+  streamMutexDestroy(&gStateWriter.mutex);
+}
+
+int32_t taskDbWaitAsyncWrite(STaskDbWrapper* pDb) {
+  if (pDb == NULL) {
+    return 0;
+  }
+
+  if (gStateWriter.init && atomic_load_32(&pDb->asyncInflight) > 0) {
+    int64_t st = taosGetTimestampUs();
+
+    streamMutexLock(&gStateWriter.mutex);
+    while (pDb->asyncInflight > 0) {
+      TAOS_UNUSED(taosThreadCondWait(&gStateWriter.done, &gStateWriter.mutex));
+    }
+    streamMutexUnlock(&gStateWriter.mutex);
+
+    TAOS_UNUSED(atomic_add_fetch_64(&pDb->stateStallTime, taosGetTimestampUs() - st));
+  }
+
+  return atomic_load_32(&pDb->asyncCode);
+}
+
+int32_t streamStatePutBatchAsync_rocksdb(SStreamState* pState, void* pBatch) {
+  STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;
+
+  // backpressure: only one batch of each task db is allowed to be in flight
+  int32_t code = taskDbWaitAsyncWrite(wrapper);
+  if (code != 0) {
+    rocksdb_writebatch_destroy(pBatch);
+    return code;
+  }
+
+  TAOS_UNUSED(atomic_add_fetch_64(&wrapper->dataWritten, 1));
+
+  if (!gStateWriter.init) {
+    taskDbDoWriteBatch(wrapper, pBatch);
+    return atomic_load_32(&wrapper->asyncCode);
+  }
+
+  SStateWriteJob job = {.pDb = wrapper, .pBatch = pBatch};
+
+  streamMutexLock(&gStateWriter.mutex);
+  code = tdListAppend(gStateWriter.pJobs, &job);
+  if (code == 0) {
+    wrapper->asyncInflight += 1;
+    TAOS_UNUSED(taosThreadCondSignal(&gStateWriter.notEmpty));
+  }
+  streamMutexUnlock(&gStateWriter.mutex);
+
+  if (code != 0) {  // failed to enqueue, write it in current thread
+    taskDbDoWriteBatch(wrapper, pBatch);
+    return atomic_load_32(&wrapper->asyncCode);
+  }
+
+  stDebug("%s submit state batch to async writer", wrapper->idstr);
+  return code;
+}
+
+int32_t streamStateMultiGet_rocksdb(SStreamState* pState, int32_t num, const SWinKey* pKeys, void** pVals,
+                                    int32_t* pVLens) {
+  int32_t code = 0;
+  int32_t lino = 0;
+  int32_t cfIdx = streamStateGetCfIdx(pState, "state");
+  if (cfIdx < 0 || num <= 0) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;
+  TAOS_UNUSED(taskDbWaitAsyncWrite(wrapper));
+
+  char*   pKeyBuf = taosMemoryCalloc(num, 128);
+  char**  pKeyList = taosMemoryCalloc(num, sizeof(char*));
+  size_t* pKeyLen = taosMemoryCalloc(num, sizeof(size_t));
+  char**  pValList = taosMemoryCalloc(num, sizeof(char*));
+  size_t* pValLen = taosMemoryCalloc(num, sizeof(size_t));
+  char**  pErrs = taosMemoryCalloc(num, sizeof(char*));
+  void**  pCfs = taosMemoryCalloc(num, POINTER_BYTES);
+  if (pKeyBuf == NULL || pKeyList == NULL || pKeyLen == NULL || pValList == NULL || pValLen == NULL || pErrs == NULL ||
+      pCfs == NULL) {
+    code = terrno;
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  rocksdb_column_family_handle_t* pHandle = ((rocksdb_column_family_handle_t**)wrapper->pCf)[ginitDict[cfIdx].idx];
+  for (int32_t i = 0; i < num; ++i) {
+    SStateKey sKey = {.key = pKeys[i], .opNum = pState->number};
+    pKeyList[i] = pKeyBuf + i * 128;
+    pKeyLen[i] = ginitDict[cfIdx].enFunc(&sKey, pKeyList[i]);
+    pCfs[i] = pHandle;
+  }
+
+  rocksdb_multi_get_cf(wrapper->db, wrapper->readOpt, (const rocksdb_column_family_handle_t* const*)pCfs, num,
+                       (const char* const*)pKeyList, pKeyLen, pValList, pValLen, pErrs);
+
+  for (int32_t i = 0; i < num; ++i) {
+    pVals[i] = NULL;
+    pVLens[i] = 0;
+
+    if (pErrs[i] != NULL) {
+      stError("%s failed to multi-get state, err:%s", wrapper->idstr, pErrs[i]);
+      taosMemoryFreeClear(pErrs[i]);
+      continue;
+    }
+    if (pValList[i] == NULL || pValLen[i] == 0) {
+      continue;
+    }
+
+    char*   tVal = NULL;
+    int32_t tlen = ginitDict[cfIdx].deValueFunc(pValList[i], pValLen[i], NULL, &tVal);
+    if (tlen <= 0) {
+      taosMemoryFree(tVal);
+      continue;
+    }
+
+    if (pState->pResultRowStore.resultRowGet == NULL || pState->pExprSupp == NULL) {
+      pVals[i] = tVal;
+      pVLens[i] = tlen;
+    } else {
+      size_t len = 0;
+      code = (pState->pResultRowStore.resultRowGet)(pState->pExprSupp, tVal, tlen, (char**)&pVals[i], &len);
+      taosMemoryFree(tVal);
+      if (code != 0) {
+        pVals[i] = NULL;
+        code = 0;
+        continue;
+      }
+      pVLens[i] = (int32_t)len;
+    }
+  }
+
+_end:
+  if (pValList != NULL) {
+    for (int32_t i = 0; i < num; ++i) {
+      rocksdb_free(pValList[i]);
+    }
+  }
+  taosMemoryFree(pKeyBuf);
+  taosMemoryFree(pKeyList);
+  taosMemoryFree(pKeyLen);
+  taosMemoryFree(pValList);
+  taosMemoryFree(pValLen);
+  taosMemoryFree(pErrs);
+  taosMemoryFree(pCfs);
+  if (code != TSDB_CODE_SUCCESS) {
+    stError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
+void streamStateAddIoTime(SStreamState* pState, int64_t us) {
+  STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;
+  if (wrapper != NULL) {
+    TAOS_UNUSED(atomic_add_fetch_64(&wrapper->stateIoTime, us));
+  }
+}
+
+void taskDbGetStateIoStat(void* arg, int64_t* pIoTime, int64_t* pStallTime) {
+  STaskDbWrapper* pDb = arg;
+  if (pDb == NULL) {
+    *pIoTime = 0;
+    *pStallTime = 0;
+  } else {
+    *pIoTime = atomic_load_64(&pDb->stateIoTime);
+    *pStallTime = atomic_load_64(&pDb->stateStallTime);
+  }
+}
+
 uint32_t nextPow2(uint32_t x) {
   if (x <= 1) return 2;
   x = x - 1;
@@ -5177,6 +5587,25 @@ void bkdMgtDestroy(SBkdMgt* bm) {
 
   taosMemoryFree(bm);
 }
+bool bkdMgtHasChkp(SBkdMgt* bm, char* taskId) {
+  TAOS_UNUSED(taosThreadRwlockRdlock(&bm->rwLock));
+  bool exist = (taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId)) != NULL);
+  TAOS_UNUSED(taosThreadRwlockUnlock(&bm->rwLock));
+  return exist;
+}
+
+// the delta of the tracked checkpoint has not reached the remote side, drop it so the next upload will be a new base
+void bkdMgtDropChkp(SBkdMgt* bm, char* taskId) {
+  TAOS_UNUSED(taosThreadRwlockWrlock(&bm->rwLock));
+  SDbChkp** ppChkp = taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId));
+  if (ppChkp != NULL) {
+    SDbChkp* pChkp = *ppChkp;
+    TAOS_UNUSED(taosHashRemove(bm->pDbChkpTbl, taskId, strlen(taskId)));
+    dbChkpDestroy(pChkp);
+  }
+  TAOS_UNUSED(taosThreadRwlockUnlock(&bm->rwLock));
+}
+
 int32_t bkdMgtGetDelta(SBkdMgt* bm, char* taskId, int64_t chkpId, SArray* list, char* dname) {
   int32_t code = 0;
   TAOS_UNUSED(taosThreadRwlockWrlock(&bm->rwLock));
@@ -736,13 +736,155 @@ static int32_t getCheckpointDataMeta(const char* id, const char* path, SArray* l
   return 0;
 }
 
+static int64_t getCheckpointDataSize(const char* path) {
+  int64_t  total = 0;
+  TdDirPtr pDir = taosOpenDir(path);
+  if (pDir == NULL) {
+    return 0;
+  }
+
+  TdDirEntryPtr de = NULL;
+  while ((de = taosReadDir(pDir)) != NULL) {
+    char* name = taosGetDirEntryName(de);
+    if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0 || taosDirEntryIsDir(de)) continue;
+
+    char    filename[PATH_MAX] = {0};
+    int64_t size = 0;
+    int32_t nBytes = snprintf(filename, sizeof(filename), "%s%s%s", path, TD_DIRSEP, name);
+    if (nBytes > 0 && nBytes < sizeof(filename) && taosStatFile(filename, &size, NULL, NULL) == 0) {
+      total += size;
+    }
+  }
+
+  TAOS_UNUSED(taosCloseDir(&pDir));
+  return total;
+}
+
+static int32_t removeRedundantCheckpointFiles(const char* idStr, SArray* toDelFiles, bool viaRsync) {
+  int32_t code = 0;
+  int32_t size = taosArrayGetSize(toDelFiles);
+  stDebug("s-task:%s remove redundant %d files", idStr, size);
+
+  if (viaRsync) {
+    code = deleteFilesByRsync(idStr, toDelFiles);
+    if (code != 0) {
+      stDebug("s-task:%s failed to remove %d files, code:%s", idStr, size, tstrerror(code));
+    }
+    return code;
+  }
+
+  for (int i = 0; i < size; i++) {
+    char* pName = taosArrayGetP(toDelFiles, i);
+    code = deleteCheckpointFile(idStr, pName);
+    if (code != 0) {
+      stDebug("s-task:%s failed to remove file: %s", idStr, pName);
+      break;
+    }
+  }
+  return code;
+}
+
+// every incremental checkpoint ships its own META_xx next to its CURRENT_xx/MANIFEST-xx_xx, so any committed checkpoint
+// can be picked from the remote data dir, see rebuildFromRemoteChkp_rsyncDelta.
+static int32_t addCheckpointDataMetaCopy(const char* path, int64_t checkpointId) {
+  char src[PATH_MAX] = {0};
+  char dst[PATH_MAX] = {0};
+
+  int32_t nBytes = snprintf(src, sizeof(src), "%s%sMETA", path, TD_DIRSEP);
+  if (nBytes <= 0 || nBytes >= sizeof(src)) {
+    return TSDB_CODE_OUT_OF_RANGE;
+  }
+
+  nBytes = snprintf(dst, sizeof(dst), "%s%sMETA_%" PRId64, path, TD_DIRSEP, checkpointId);
+  if (nBytes <= 0 || nBytes >= sizeof(dst)) {
+    return TSDB_CODE_OUT_OF_RANGE;
+  }
+
+  if (taosCopyFile(src, dst) < 0) {
+    return terrno;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+void streamTaskClearRemoteDelFiles(SArray* pRemoteDel) {
+  int32_t size = taosArrayGetSize(pRemoteDel);
+  for (int32_t i = 0; i < size; ++i) {
+    SRemoteChkpDelFiles* p = taosArrayGet(pRemoteDel, i);
+    taosArrayDestroyP(p->pNames, taosMemoryFree);
+  }
+
+  taosArrayClear(pRemoteDel);
+}
+
+// The files dropped by checkpointId, including the CURRENT_xx/MANIFEST-xx_xx/META_xx of the previously merged
+// checkpoint, may still be used by the committed checkpoint. They are kept until checkpointId or a later one commits.
+static int32_t deferRemoteCheckpointFiles(SStreamTask* pTask, int64_t checkpointId, SArray** ppNames) {
+  SCheckpointInfo* pInfo = &pTask->chkInfo;
+  SArray*          pNames = *ppNames;
+  int64_t          prevId = pInfo->remoteChkpId;
+
+  if (prevId > 0 && prevId != checkpointId) {
+    const char* fmt[] = {"CURRENT_%" PRId64, "MANIFEST-*_%" PRId64, "META_%" PRId64};
+    for (int32_t i = 0; i < tListLen(fmt); ++i) {
+      char* pName = taosMemoryCalloc(1, TSDB_FILENAME_LEN);
+      if (pName == NULL) {
+        return terrno;
+      }
+
+      (void)snprintf(pName, TSDB_FILENAME_LEN, fmt[i], prevId);
+      if (taosArrayPush(pNames, &pName) == NULL) {
+        taosMemoryFree(pName);
+        return terrno;
+      }
+    }
+  }
+
+  if (pInfo->pRemoteDel == NULL) {
+    pInfo->pRemoteDel = taosArrayInit(4, sizeof(SRemoteChkpDelFiles));
+    if (pInfo->pRemoteDel == NULL) {
+      return terrno;
+    }
+  }
+
+  SRemoteChkpDelFiles item = {.checkpointId = checkpointId, .pNames = pNames};
+  if (taosArrayPush(pInfo->pRemoteDel, &item) == NULL) {
+    return terrno;
+  }
+
+  *ppNames = NULL;
+  pInfo->remoteChkpId = checkpointId;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void removeCommittedCheckpointFiles(SStreamTask* pTask) {
+  SCheckpointInfo* pInfo = &pTask->chkInfo;
+
+  while (taosArrayGetSize(pInfo->pRemoteDel) > 0) {
+    SRemoteChkpDelFiles* p = taosArrayGet(pInfo->pRemoteDel, 0);
+    if (p->checkpointId > pInfo->checkpointId) {
+      break;
+    }
+
+    // try it again after the next upload
+    if (removeRedundantCheckpointFiles(pTask->id.idStr, p->pNames, true) != 0) {
+      break;
+    }
+
+    taosArrayDestroyP(p->pNames, taosMemoryFree);
+    taosArrayRemove(pInfo->pRemoteDel, 0);
+  }
+}
+
 int32_t uploadCheckpointData(SStreamTask* pTask, int64_t checkpointId, int64_t dbRefId, ECHECKPOINT_BACKUP_TYPE type) {
   int32_t code = 0;
   char*   path = NULL;
+  bool    base = true;
 
   SStreamMeta* pMeta = pTask->pMeta;
   const char*  idStr = pTask->id.idStr;
   int64_t      now = taosGetTimestampMs();
+  bool         incRsync = (type == DATA_UPLOAD_RSYNC) && tsStreamIncrementalCheckpoint;
 
   SArray* toDelFiles = taosArrayInit(4, POINTER_BYTES);
   if (toDelFiles == NULL) {
@@ -750,7 +892,7 @@ int32_t uploadCheckpointData(SStreamTask* pTask, int64_t checkpointId, int64_t d
   }
 
   if ((code = taskDbGenChkpUploadData(pTask->pBackend, pMeta->bkdChkptMgt, checkpointId, type, &path, toDelFiles,
-                                      pTask->id.idStr)) != 0) {
+                                      &base, pTask->id.idStr)) != 0) {
     stError("s-task:%s failed to gen upload checkpoint:%" PRId64 ", reason:%s", idStr, checkpointId, tstrerror(code));
   }
 
@@ -761,8 +903,19 @@ int32_t uploadCheckpointData(SStreamTask* pTask, int64_t checkpointId, int64_t d
     }
   }
 
+  if (incRsync && code == TSDB_CODE_SUCCESS) {
+    code = addCheckpointDataMetaCopy(path, checkpointId);
+  }
+
+  int64_t bytes = (code == TSDB_CODE_SUCCESS) ? getCheckpointDataSize(path) : 0;
+
   if (code == TSDB_CODE_SUCCESS) {
-    code = streamTaskUploadCheckpoint(idStr, path, checkpointId);
+    if (incRsync) {
+      code = uploadDeltaByRsync(idStr, path, base);
+    } else {
+      code = streamTaskUploadCheckpoint(idStr, path, checkpointId);
+    }
+
     if (code == TSDB_CODE_SUCCESS) {
       stDebug("s-task:%s upload checkpointId:%" PRId64 " to remote succ", idStr, checkpointId);
     } else {
@@ -771,19 +924,15 @@ int32_t uploadCheckpointData(SStreamTask* pTask, int64_t checkpointId, int64_t d
     }
   }
 
-  if (code == TSDB_CODE_SUCCESS) {
-    int32_t size = taosArrayGetSize(toDelFiles);
-    stDebug("s-task:%s remove redundant %d files", idStr, size);
-
-    for (int i = 0; i < size; i++) {
-      char* pName = taosArrayGetP(toDelFiles, i);
-      code = deleteCheckpointFile(idStr, pName);
-      if (code != 0) {
-        stDebug("s-task:%s failed to remove file: %s", idStr, pName);
-        break;
-      }
+  if (code == TSDB_CODE_SUCCESS && incRsync) {
+    // the uploaded checkpoint is not committed yet, the last committed one must remain restorable
+    if (deferRemoteCheckpointFiles(pTask, checkpointId, &toDelFiles) != 0) {
+      stWarn("s-task:%s failed to keep the redundant files of checkpointId:%" PRId64 ", left in remote", idStr,
+             checkpointId);
     }
-
+    removeCommittedCheckpointFiles(pTask);
+  } else if (code == TSDB_CODE_SUCCESS) {
+    code = removeRedundantCheckpointFiles(idStr, toDelFiles, incRsync);
     stDebug("s-task:%s remove redundant files in uploading checkpointId:%" PRId64 " data", idStr, checkpointId);
   }
 
@@ -791,10 +940,18 @@ int32_t uploadCheckpointData(SStreamTask* pTask, int64_t checkpointId, int64_t d
   double el = (taosGetTimestampMs() - now) / 1000.0;
 
   if (code == TSDB_CODE_SUCCESS) {
-    stDebug("s-task:%s complete update checkpointId:%" PRId64 ", elapsed time:%.2fs remove local checkpoint data %s",
-            idStr, checkpointId, el, path);
+    bool incremental = (type == DATA_UPLOAD_S3 || incRsync) && !base;
+
+    pTask->chkInfo.latestSize = bytes;
+    pTask->chkInfo.remoteBackup = incremental ? TASK_CHKPT_BACKUP__INCREMENTAL : TASK_CHKPT_BACKUP__FULL;
+
+    stDebug("s-task:%s complete update checkpointId:%" PRId64 ", %s, size:%" PRId64
+            " bytes, elapsed time:%.2fs remove local checkpoint data %s",
+            idStr, checkpointId, incremental ? "incremental" : "full", bytes, el, path);
     taosRemoveDir(path);
   } else {
+    // the delta is lost if it is not shipped to remote, the next upload should start a new base.
+    taskDbResetChkpUploadData(pTask->pBackend, pMeta->bkdChkptMgt);
     stDebug("s-task:%s failed to upload checkpointId:%" PRId64 " keep local checkpoint data, elapsed time:%.2fs", idStr,
             checkpointId, el);
   }
@@ -887,9 +1044,15 @@ int32_t streamTaskBuildCheckpoint(SStreamTask* pTask) {
     stDebug("s-task:%s clear checkpoint flag since gen checkpoint failed, checkpointId:%" PRId64, id, ckId);
   }
 
-  double el = (taosGetTimestampMs() - startTs) / 1000.0;
-  stInfo("s-task:%s vgId:%d level:%d, checkpointId:%" PRId64 " ver:%" PRId64 " elapsed time:%.2fs, %s ", id,
-         pMeta->vgId, pTask->info.taskLevel, ckId, pTask->chkInfo.checkpointVer, el,
+  int64_t elapsed = taosGetTimestampMs() - startTs;
+  if (code == TSDB_CODE_SUCCESS) {
+    pTask->chkInfo.latestElapsed = elapsed;
+  }
+
+  double el = elapsed / 1000.0;
+  stInfo("s-task:%s vgId:%d level:%d, checkpointId:%" PRId64 " ver:%" PRId64 " elapsed time:%.2fs, backup size:%" PRId64
+         " bytes, %s ",
+         id, pMeta->vgId, pTask->info.taskLevel, ckId, pTask->chkInfo.checkpointVer, el, pTask->chkInfo.latestSize,
          (code == TSDB_CODE_SUCCESS) ? "succ" : "failed");
 
   return code;
@@ -253,6 +253,7 @@ int32_t streamQueueMergeQueueItem(SStreamQueueItem* dst, SStreamQueueItem* pElem
       return code;
     }
 
+    streamQueueItemIncSize((SStreamQueueItem*)pMerged, streamQueueItemGetSize(dst));
     streamQueueItemIncSize((SStreamQueueItem*)pMerged, streamQueueItemGetSize(pElem));
 
     code = streamMergeSubmit(pMerged, (SStreamDataSubmit*)dst);
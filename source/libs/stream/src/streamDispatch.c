@@ -44,6 +44,7 @@ static void initDispatchInfo(SDispatchMsgInfo* pInfo, int32_t msgId) {
   pInfo->startTs = taosGetTimestampMs();
   pInfo->rspTs = -1;
   pInfo->msgId = msgId;
+  pInfo->rspCredit = -1;
 }
 
 static void clearDispatchInfo(SDispatchMsgInfo* pInfo) {
@@ -784,6 +785,61 @@ int32_t streamSearchAndAddBlock(SStreamTask* pTask, SStreamDispatchReq* pReqs, S
   }
 }
 
+// the size limit of the output blocks coalesced into one dispatch msg, bounded by the credit of downstream tasks
+static int64_t getDispatchCoalesceSize(SStreamTask* pTask) {
+  int64_t limit = STREAM_DISPATCH_COALESCE_SIZE;
+
+  streamMutexLock(&pTask->msgInfo.lock);
+  int32_t credit = pTask->msgInfo.credit;
+  streamMutexUnlock(&pTask->msgInfo.lock);
+
+  if (credit >= 0) {
+    limit = TMIN(limit, credit * 1024LL);
+  }
+  return limit;
+}
+
+// merge the data blocks that are accumulated in the outputQ while waiting for the rsp of previous dispatch msg, so
+// each downstream task receives them in one dispatch msg, instead of one msg for each output block.
+static int32_t coalesceDispatchBlocks(SStreamTask* pTask, SStreamDataBlock* pBlock) {
+  SStreamQueue* pQueue = pTask->outputq.queue;
+  int64_t       limit = getDispatchCoalesceSize(pTask);
+  int32_t       numOfItems = 1;
+  int32_t       code = 0;
+
+  while (streamQueueItemGetSize((SStreamQueueItem*)pBlock) < limit) {
+    SStreamQueueItem* pNext = NULL;
+    streamQueueNextItem(pQueue, &pNext);
+    if (pNext == NULL) {
+      break;
+    }
+
+    if (pNext->type != STREAM_INPUT__DATA_BLOCK ||
+        streamQueueItemGetSize((SStreamQueueItem*)pBlock) + streamQueueItemGetSize(pNext) > limit) {
+      streamQueueProcessFail(pQueue);  // handle it in the next dispatch
+      break;
+    }
+
+    SStreamQueueItem* pRes = NULL;
+    code = streamQueueMergeQueueItem((SStreamQueueItem*)pBlock, pNext, &pRes);
+    if (code != TSDB_CODE_SUCCESS) {
+      stError("s-task:%s failed to coalesce output blocks, code:%s", pTask->id.idStr, tstrerror(code));
+      streamQueueProcessFail(pQueue);  // pNext is left intact, dispatch it in the next round
+      break;
+    }
+
+    numOfItems += 1;
+  }
+
+  if (numOfItems > 1) {
+    stDebug("s-task:%s coalesce %d output items into one dispatch, blocks:%d, size:%.2fKiB, limit:%.2fKiB",
+            pTask->id.idStr, numOfItems, (int32_t)taosArrayGetSize(pBlock->blocks),
+            SIZE_IN_KiB(streamQueueItemGetSize((SStreamQueueItem*)pBlock)), SIZE_IN_KiB(limit));
+  }
+
+  return code;
+}
+
 int32_t streamDispatchStreamBlock(SStreamTask* pTask) {
   const char*            id = pTask->id.idStr;
   int32_t                code = 0;
@@ -838,6 +894,13 @@ int32_t streamDispatchStreamBlock(SStreamTask* pTask) {
       return TSDB_CODE_INTERNAL_ERROR;
     }
 
+    if (type == STREAM_INPUT__DATA_BLOCK) {
+      code = coalesceDispatchBlocks(pTask, pBlock);
+      if (code != TSDB_CODE_SUCCESS) {  // the already merged blocks are still dispatched
+        code = 0;
+      }
+    }
+
     pTask->execInfo.dispatch += 1;
 
     streamMutexLock(&pTask->msgInfo.lock);
@@ -1673,6 +1736,10 @@ int32_t streamProcessDispatchRsp(SStreamTask* pTask, SStreamDispatchRsp* pRsp, i
     return TSDB_CODE_INVALID_MSG;
   }
 
+  if (code == TSDB_CODE_SUCCESS && pRsp->credit >= 0) {
+    pMsgInfo->rspCredit = (pMsgInfo->rspCredit < 0) ? pRsp->credit : TMIN(pMsgInfo->rspCredit, pRsp->credit);
+  }
+
   if (code != TSDB_CODE_SUCCESS) {
     // dispatch message failed: network error, or node not available.
     // in case of the input queue is full, the code will be TSDB_CODE_SUCCESS, the and pRsp->inputStatus will be set
@@ -1748,6 +1815,11 @@ int32_t streamProcessDispatchRsp(SStreamTask* pTask, SStreamDispatchRsp* pRsp, i
   // all msg rsp already, continue
   // we need to re-try send dispatch msg to downstream tasks
   if (allRsp && (numOfFailed == 0)) {
+    // the granted credits bound the size of next dispatch msg
+    streamMutexLock(&pMsgInfo->lock);
+    pMsgInfo->credit = pMsgInfo->rspCredit;
+    streamMutexUnlock(&pMsgInfo->lock);
+
     // trans-state msg has been sent to downstream successfully. let's transfer the fill-history task state
     if (pMsgInfo->dispatchMsgType == STREAM_INPUT__TRANS_STATE) {
       stDebug("s-task:%s dispatch trans-state msgId:%d to downstream successfully, start to prepare transfer state", id,
@@ -1795,6 +1867,7 @@ static int32_t buildDispatchRsp(const SStreamTask* pTask, const SStreamDispatchR
   pDispatchRsp->upstreamTaskId = htonl(pReq->upstreamTaskId);
   pDispatchRsp->downstreamNodeId = htonl(pTask->info.nodeId);
   pDispatchRsp->downstreamTaskId = htonl(pTask->id.taskId);
+  pDispatchRsp->credit = htonl(streamTaskGetInputQCredit(pTask));
 
   return TSDB_CODE_SUCCESS;
 }
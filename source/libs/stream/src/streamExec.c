@@ -15,13 +15,12 @@
 
 #include "streamInt.h"
 
-// maximum allowed processed block batches. One block may include several submit blocks
-#define MAX_STREAM_EXEC_BATCH_NUM         32
 #define STREAM_RESULT_DUMP_THRESHOLD      300
 #define STREAM_RESULT_DUMP_SIZE_THRESHOLD (1048576 * 1)  // 1MiB result data
 #define STREAM_SCAN_HISTORY_TIMESLICE     1000           // 1000 ms
 #define MIN_INVOKE_INTERVAL               50             // 50ms
 #define FILL_HISTORY_TASK_EXEC_INTERVAL   5000           // 5 sec
+#define STREAM_EXEC_HIST_WINDOW           10000          // halve the histograms when so many batches are recorded
 
 static int32_t streamTransferStateDoPrepare(SStreamTask* pTask);
 static int32_t streamTaskExecImpl(SStreamTask* pTask, SStreamQueueItem* pItem, int64_t* totalSize,
@@ -649,10 +648,109 @@ static void doRecordThroughput(STaskExecStatisInfo* pInfo, int64_t totalBlocks,
   }
 }
 
+int32_t streamTaskGetExecBatchLimit(const SStreamTask* pTask) {
+  int32_t limit = pTask->execInfo.batch.limit;
+  return (limit <= 0) ? STREAM_EXEC_BATCH_DEFAULT_NUM : limit;
+}
+
+static int32_t getHistBucket(int64_t val, int32_t numOfBuckets) {
+  int32_t index = 0;
+  while (val > 1 && index < numOfBuckets - 1) {
+    val >>= 1;
+    index += 1;
+  }
+  return index;
+}
+
+static void addToHist(int64_t* pHist, int32_t numOfBuckets, int64_t val) {
+  int64_t total = 0;
+  for (int32_t i = 0; i < numOfBuckets; ++i) {
+    total += pHist[i];
+  }
+
+  // decay the old records, so the histogram follows the recent workload
+  if (total >= STREAM_EXEC_HIST_WINDOW) {
+    for (int32_t i = 0; i < numOfBuckets; ++i) {
+      pHist[i] >>= 1;
+    }
+  }
+
+  pHist[getHistBucket(val, numOfBuckets)] += 1;
+}
+
+// the upper bound of the bucket that the percentile falls in
+static int64_t getHistPercentile(const int64_t* pHist, int32_t numOfBuckets, double percent) {
+  int64_t total = 0;
+  for (int32_t i = 0; i < numOfBuckets; ++i) {
+    total += pHist[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  int64_t threshold = (int64_t)ceil(total * percent);
+  int64_t sum = 0;
+  for (int32_t i = 0; i < numOfBuckets; ++i) {
+    sum += pHist[i];
+    if (sum >= threshold) {
+      return (i == numOfBuckets - 1) ? (1LL << i) : (1LL << (i + 1)) - 1;
+    }
+  }
+
+  return (1LL << (numOfBuckets - 1));
+}
+
+// adjust the limit of input blocks in one batch, so that one batch is completed in the latency budget
+static void streamTaskUpdateExecBatch(SStreamTask* pTask, int32_t numOfBlocks, int64_t startUs) {
+  SStreamExecBatchInfo* pBatch = &pTask->execInfo.batch;
+  int64_t               now = taosGetTimestampUs();
+  if (numOfBlocks <= 0) {
+    return;
+  }
+
+  double cost = (now - startUs) / (double)numOfBlocks;
+  if (pBatch->costPerBlock <= 0) {
+    pBatch->costPerBlock = cost;
+    pBatch->avgBlocks = numOfBlocks;
+  } else {
+    pBatch->costPerBlock = pBatch->costPerBlock * 0.8 + cost * 0.2;
+    pBatch->avgBlocks = pBatch->avgBlocks * 0.8 + numOfBlocks * 0.2;
+  }
+
+  int32_t limit = streamTaskGetExecBatchLimit(pTask);
+  int64_t target = (pBatch->costPerBlock < 1) ? STREAM_EXEC_BATCH_MAX_NUM
+                                               : (int64_t)(STREAM_EXEC_LATENCY_BUDGET / pBatch->costPerBlock);
+
+  // grow at most twice of the current limit each time to avoid latency spikes, but shrink immediately
+  target = TMIN(target, ((int64_t)limit) << 1);
+  target = TMAX(TMIN(target, STREAM_EXEC_BATCH_MAX_NUM), 1);
+  if (target != limit) {
+    stDebug("s-task:%s exec batch limit %d -> %" PRId64 ", cost per block:%.2fus", pTask->id.idStr, limit, target,
+            pBatch->costPerBlock);
+    pBatch->limit = (int32_t)target;
+  }
+
+  addToHist(pBatch->batchHist, STREAM_EXEC_BATCH_HIST_BUCKETS, numOfBlocks);
+  if (pBatch->inputTs > 0 && now >= pBatch->inputTs) {
+    addToHist(pBatch->lagHist, STREAM_EXEC_LAG_HIST_BUCKETS, (now - pBatch->inputTs) / 1000);
+  }
+}
+
+void streamTaskGetExecBatchStat(const SStreamTask* pTask, STaskStatusEntry* pEntry) {
+  const SStreamExecBatchInfo* pBatch = &pTask->execInfo.batch;
+
+  pEntry->execBatchLimit = streamTaskGetExecBatchLimit(pTask);
+  pEntry->execBatchAvg = pBatch->avgBlocks;
+  pEntry->execBatchP99 = (int32_t)getHistPercentile(pBatch->batchHist, STREAM_EXEC_BATCH_HIST_BUCKETS, 0.99);
+  pEntry->execLagP50 = getHistPercentile(pBatch->lagHist, STREAM_EXEC_LAG_HIST_BUCKETS, 0.5);
+  pEntry->execLagP99 = getHistPercentile(pBatch->lagHist, STREAM_EXEC_LAG_HIST_BUCKETS, 0.99);
+}
+
 static int32_t doStreamTaskExecImpl(SStreamTask* pTask, SStreamQueueItem* pBlock, int32_t num) {
   const char*      id = pTask->id.idStr;
   int32_t          blockSize = 0;
   int64_t          st = taosGetTimestampMs();
+  int64_t          stUs = taosGetTimestampUs();
   SCheckpointInfo* pInfo = &pTask->chkInfo;
   int64_t          ver = pInfo->processedVer;
   int64_t          totalSize = 0;
@@ -673,6 +771,7 @@ static int32_t doStreamTaskExecImpl(SStreamTask* pTask, SStreamQueueItem* pBlock
   }
 
   doRecordThroughput(&pTask->execInfo, totalBlocks, totalSize, blockSize, st, pTask->id.idStr);
+  streamTaskUpdateExecBatch(pTask, num, stUs);
 
   // update the currentVer if processing the submitted blocks.
   if (!(pInfo->checkpointVer <= pInfo->nextProcessVer && ver >= pInfo->checkpointVer)) {
@@ -842,6 +941,7 @@ static int32_t doStreamExecTask(SStreamTask* pTask) {
       }
 
       int64_t st = taosGetTimestampMs();
+      int64_t stUs = taosGetTimestampUs();
 
       // here only handle the data block sink operation
       if (type == STREAM_INPUT__DATA_BLOCK) {
@@ -859,6 +959,7 @@ static int32_t doStreamExecTask(SStreamTask* pTask) {
           pTask->execInfo.procsThroughput = (blockSize / el);
         }
 
+        streamTaskUpdateExecBatch(pTask, numOfBlocks, stUs);
         continue;
       }
     }
@@ -60,6 +60,13 @@ static void streamMetaEnvInit() {
   if (code) {
     stError("failed to init stream meta env, start failed");
   }
+
+  if (tsStreamStateAsyncFlush) {
+    code = streamStateAsyncWriterInit();
+    if (code) {
+      stWarn("failed to init stream state async writer, code:%s", tstrerror(code));
+    }
+  }
 }
 
 void streamMetaInit() {
@@ -70,6 +77,8 @@ void streamMetaInit() {
 }
 
 void streamMetaCleanup() {
+  streamStateAsyncWriterCleanup();
+
   taosCloseRef(streamBackendId);
   taosCloseRef(streamBackendCfWrapperId);
   taosCloseRef(streamMetaRefPool);
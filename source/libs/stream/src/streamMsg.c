@@ -499,6 +499,35 @@ int32_t tEncodeStreamHbMsg(SEncoder* pEncoder, const SStreamHbMsg* pReq) {
 
   TAOS_CHECK_EXIT(tEncodeI32(pEncoder, pReq->msgId));
   TAOS_CHECK_EXIT(tEncodeI64(pEncoder, pReq->ts));
+
+  for (int32_t i = 0; i < pReq->numOfTasks; ++i) {
+    STaskStatusEntry* ps = taosArrayGet(pReq->pTaskStatus, i);
+    if (ps == NULL) {
+      TAOS_CHECK_EXIT(terrno);
+    }
+    TAOS_CHECK_EXIT(tEncodeI64(pEncoder, ps->checkpointInfo.latestElapsed));
+  }
+
+  for (int32_t i = 0; i < pReq->numOfTasks; ++i) {
+    STaskStatusEntry* ps = taosArrayGet(pReq->pTaskStatus, i);
+    if (ps == NULL) {
+      TAOS_CHECK_EXIT(terrno);
+    }
+    TAOS_CHECK_EXIT(tEncodeI64(pEncoder, ps->stateIoTime));
+    TAOS_CHECK_EXIT(tEncodeI64(pEncoder, ps->stateStallTime));
+  }
+
+  for (int32_t i = 0; i < pReq->numOfTasks; ++i) {
+    STaskStatusEntry* ps = taosArrayGet(pReq->pTaskStatus, i);
+    if (ps == NULL) {
+      TAOS_CHECK_EXIT(terrno);
+    }
+    TAOS_CHECK_EXIT(tEncodeI32(pEncoder, ps->execBatchLimit));
+    TAOS_CHECK_EXIT(tEncodeDouble(pEncoder, ps->execBatchAvg));
+    TAOS_CHECK_EXIT(tEncodeI32(pEncoder, ps->execBatchP99));
+    TAOS_CHECK_EXIT(tEncodeI64(pEncoder, ps->execLagP50));
+    TAOS_CHECK_EXIT(tEncodeI64(pEncoder, ps->execLagP99));
+  }
   tEndEncode(pEncoder);
 
 _exit:
@@ -579,6 +608,41 @@ int32_t tDecodeStreamHbMsg(SDecoder* pDecoder, SStreamHbMsg* pReq) {
 
   TAOS_CHECK_EXIT(tDecodeI32(pDecoder, &pReq->msgId));
   TAOS_CHECK_EXIT(tDecodeI64(pDecoder, &pReq->ts));
+
+  if (!tDecodeIsEnd(pDecoder)) {
+    for (int32_t i = 0; i < pReq->numOfTasks; ++i) {
+      STaskStatusEntry* ps = taosArrayGet(pReq->pTaskStatus, i);
+      if (ps == NULL) {
+        TAOS_CHECK_EXIT(terrno);
+      }
+      TAOS_CHECK_EXIT(tDecodeI64(pDecoder, &ps->checkpointInfo.latestElapsed));
+    }
+  }
+
+  if (!tDecodeIsEnd(pDecoder)) {
+    for (int32_t i = 0; i < pReq->numOfTasks; ++i) {
+      STaskStatusEntry* ps = taosArrayGet(pReq->pTaskStatus, i);
+      if (ps == NULL) {
+        TAOS_CHECK_EXIT(terrno);
+      }
+      TAOS_CHECK_EXIT(tDecodeI64(pDecoder, &ps->stateIoTime));
+      TAOS_CHECK_EXIT(tDecodeI64(pDecoder, &ps->stateStallTime));
+    }
+  }
+
+  if (!tDecodeIsEnd(pDecoder)) {
+    for (int32_t i = 0; i < pReq->numOfTasks; ++i) {
+      STaskStatusEntry* ps = taosArrayGet(pReq->pTaskStatus, i);
+      if (ps == NULL) {
+        TAOS_CHECK_EXIT(terrno);
+      }
+      TAOS_CHECK_EXIT(tDecodeI32(pDecoder, &ps->execBatchLimit));
+      TAOS_CHECK_EXIT(tDecodeDouble(pDecoder, &ps->execBatchAvg));
+      TAOS_CHECK_EXIT(tDecodeI32(pDecoder, &ps->execBatchP99));
+      TAOS_CHECK_EXIT(tDecodeI64(pDecoder, &ps->execLagP50));
+      TAOS_CHECK_EXIT(tDecodeI64(pDecoder, &ps->execLagP99));
+    }
+  }
   tEndDecode(pDecoder);
 
 _exit:
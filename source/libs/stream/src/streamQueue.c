@@ -15,7 +15,6 @@
 
 #include "streamInt.h"
 
-#define MAX_STREAM_EXEC_BATCH_NUM 32
 #define MAX_SMOOTH_BURST_RATIO    5  // 5 sec
 
 // todo refactor:
@@ -153,6 +152,11 @@ int32_t streamQueueItemGetSize(const SStreamQueueItem* pItem) {
   return p->dataSize;
 }
 
+int64_t streamQueueItemGetTs(const SStreamQueueItem* pItem) {
+  STaosQnode* p = (STaosQnode*)((char*)pItem - sizeof(STaosQnode));
+  return p->timestamp;
+}
+
 void streamQueueItemIncSize(const SStreamQueueItem* pItem, int32_t size) {
   STaosQnode* p = (STaosQnode*)((char*)pItem - sizeof(STaosQnode));
   p->dataSize += size;
@@ -175,6 +179,7 @@ EExtractDataCode streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueIte
                                              int32_t* blockSize) {
   const char* id = pTask->id.idStr;
   int32_t     taskLevel = pTask->info.taskLevel;
+  int32_t     limit = streamTaskGetExecBatchLimit(pTask);
 
   *pInput = NULL;
   *numOfBlocks = 0;
@@ -236,6 +241,7 @@ EExtractDataCode streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueIte
     } else {
       if (*pInput == NULL) {
         *pInput = qItem;
+        pTask->execInfo.batch.inputTs = streamQueueItemGetTs(qItem);
       } else { // merge current block failed, let's handle the already merged blocks.
         void*   newRet = NULL;
         int32_t code = streamQueueMergeQueueItem(*pInput, qItem, (SStreamQueueItem**)&newRet);
@@ -260,10 +266,11 @@ EExtractDataCode streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueIte
       *numOfBlocks += 1;
       streamQueueProcessSuccess(pTask->inputq.queue);
 
-      if (*numOfBlocks >= MAX_STREAM_EXEC_BATCH_NUM) {
-        stDebug("s-task:%s batch size limit:%d reached, start to process blocks", id, MAX_STREAM_EXEC_BATCH_NUM);
+      *blockSize = streamQueueItemGetSize(*pInput);
+      if (*numOfBlocks >= limit || *blockSize >= STREAM_EXEC_SIZE_BUDGET) {
+        stDebug("s-task:%s batch limit reached, blocks:%d limit:%d, size:%.2fKiB, start to process blocks", id,
+                *numOfBlocks, limit, SIZE_IN_KiB(*blockSize));
 
-        *blockSize = streamQueueItemGetSize(*pInput);
         if (taskLevel == TASK_LEVEL__SINK) {
           streamTaskConsumeQuota(pTask->outputInfo.pTokenBucket, *blockSize);
         }
@@ -408,6 +415,18 @@ _err:
   return code;
 }
 
+// the free capacity of the inputQ in KiB, which is granted to the upstream tasks in the dispatch rsp.
+int32_t streamTaskGetInputQCredit(const SStreamTask* pTask) {
+  const SStreamQueue* pQueue = pTask->inputq.queue;
+  if (pQueue == NULL || streamQueueIsFull(pQueue)) {
+    return 0;
+  }
+
+  int64_t cap = STREAM_TASK_QUEUE_CAPACITY_IN_SIZE * 1048576LL;
+  int64_t used = taosQueueMemorySize(pQueue->pQueue);
+  return (used >= cap) ? 0 : (int32_t)((cap - used) / 1024);
+}
+
 // the result should be put into the outputQ in any cases, the result may be lost otherwise.
 int32_t streamTaskPutDataIntoOutputQ(SStreamTask* pTask, SStreamDataBlock* pBlock) {
   STaosQueue* pQueue = pTask->outputq.queue->pQueue;
@@ -214,6 +214,10 @@ bool streamStateCheck(SStreamState* pState, const SWinKey* key) {
   return hasRowBuff(pState->pFileState, (void*)key, sizeof(SWinKey));
 }
 
+int32_t streamStatePrefetch(SStreamState* pState, const SWinKey* pKeys, int32_t num) {
+  return streamFileStatePrefetch(pState->pFileState, pKeys, num);
+}
+
 int32_t streamStateGetByPos(SStreamState* pState, void* pos, void** pVal) {
   int32_t code = getRowBuffByPos(pState->pFileState, pos, pVal);
   streamStateReleaseBuf(pState, pos, false);
@@ -321,6 +321,10 @@ void tFreeStreamTask(void* pParam) {
   streamTaskDestroyActiveChkptInfo(pTask->chkInfo.pActiveInfo);
   pTask->chkInfo.pActiveInfo = NULL;
 
+  streamTaskClearRemoteDelFiles(pTask->chkInfo.pRemoteDel);
+  taosArrayDestroy(pTask->chkInfo.pRemoteDel);
+  pTask->chkInfo.pRemoteDel = NULL;
+
   taosMemoryFree(pTask);
   stDebug("s-task:0x%x free task completed", taskId);
 }
@@ -456,6 +460,9 @@ int32_t streamTaskInit(SStreamTask* pTask, SStreamMeta* pMeta, SMsgCb* pMsgCb, i
     return terrno;
   }
 
+  pTask->msgInfo.credit = -1;
+  pTask->msgInfo.rspCredit = -1;
+
   code = taosThreadMutexInit(&pTask->msgInfo.lock, NULL);
   if (code) {
     stError("s-task:0x%x failed to init msgInfo mutex, code:%s", pTask->id.taskId, tstrerror(code));
@@ -974,6 +981,13 @@ void streamTaskStatusCopy(STaskStatusEntry* pDst, const STaskStatusEntry* pSrc)
 
   pDst->startTime = pSrc->startTime;
   pDst->hTaskId = pSrc->hTaskId;
+  pDst->stateIoTime = pSrc->stateIoTime;
+  pDst->stateStallTime = pSrc->stateStallTime;
+  pDst->execBatchLimit = pSrc->execBatchLimit;
+  pDst->execBatchAvg = pSrc->execBatchAvg;
+  pDst->execBatchP99 = pSrc->execBatchP99;
+  pDst->execLagP50 = pSrc->execLagP50;
+  pDst->execLagP99 = pSrc->execLagP99;
 }
 
 STaskStatusEntry streamTaskGetStatusEntry(SStreamTask* pTask) {
@@ -991,8 +1005,9 @@ STaskStatusEntry streamTaskGetStatusEntry(SStreamTask* pTask) {
       .checkpointInfo.latestId = pTask->chkInfo.checkpointId,
       .checkpointInfo.latestVer = pTask->chkInfo.checkpointVer,
       .checkpointInfo.latestTime = pTask->chkInfo.checkpointTime,
-      .checkpointInfo.latestSize = 0,
-      .checkpointInfo.remoteBackup = 0,
+      .checkpointInfo.latestSize = pTask->chkInfo.latestSize,
+      .checkpointInfo.remoteBackup = pTask->chkInfo.remoteBackup,
+      .checkpointInfo.latestElapsed = pTask->chkInfo.latestElapsed,
       .checkpointInfo.consensusChkptId = 0,
       .checkpointInfo.consensusTs = 0,
       .hTaskId = pTask->hTaskInfo.id.taskId,
@@ -1003,6 +1018,9 @@ STaskStatusEntry streamTaskGetStatusEntry(SStreamTask* pTask) {
       .startCheckpointId = pExecInfo->startCheckpointId,
       .startCheckpointVer = pExecInfo->startCheckpointVer,
   };
+
+  taskDbGetStateIoStat(pTask->pBackend, &entry.stateIoTime, &entry.stateStallTime);
+  streamTaskGetExecBatchStat(pTask, &entry);
   return entry;
 }
 
@@ -32,6 +32,7 @@
 #define MAX_GROUP_ID_NUM               200000
 #define NUM_OF_CACHE_WIN               64
 #define MAX_NUM_OF_CACHE_WIN           128
+#define MAX_NUM_OF_PREFETCH_WIN        256
 
 #define TASK_KEY               "streamFileState"
 #define STREAM_STATE_INFO_NAME "StreamStateCheckPoint"
@@ -634,7 +635,9 @@ int32_t addRowBuffIfNotExist(SStreamFileState* pFileState, void* pKey, int32_t k
   if (!isDeteled(pFileState, ts) && isFlushedState(pFileState, ts, 0)) {
     int32_t len = 0;
     void*   p = NULL;
+    int64_t st = taosGetTimestampUs();
     (*pWinCode) = pFileState->stateFileGetFn(pFileState, pKey, &p, &len);
+    streamStateAddIoTime(pFileState->pFileStore, taosGetTimestampUs() - st);
     qDebug("===stream===get %" PRId64 " from disc, res %d", ts, (*pWinCode));
     if ((*pWinCode) == TSDB_CODE_SUCCESS) {
       memcpy(pNewPos->pRowBuff, p, len);
@@ -770,6 +773,23 @@ SStreamSnapshot* getSnapshot(SStreamFileState* pFileState) {
   return pFileState->usedBuffs;
 }
 
+static int32_t flushStateBatch(SStreamFileState* pFileState, void** ppBatch, bool async) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (!async) {
+    code = streamStatePutBatch_rocksdb(pFileState->pFileStore, *ppBatch);
+    streamStateClearBatch(*ppBatch);
+    return code;
+  }
+
+  // the async writer takes the ownership of the batch
+  code = streamStatePutBatchAsync_rocksdb(pFileState->pFileStore, *ppBatch);
+  *ppBatch = streamStateCreateBatch();
+  if (*ppBatch == NULL && code == TSDB_CODE_SUCCESS) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+  }
+  return code;
+}
+
 void flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, bool flushState) {
   int32_t   code = TSDB_CODE_SUCCESS;
   int32_t   lino = 0;
@@ -778,9 +798,13 @@ void flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, boo
 
   const int32_t BATCH_LIMIT = 256;
 
-  int64_t    st = taosGetTimestampMs();
+  int64_t    st = taosGetTimestampUs();
   SListNode* pNode = NULL;
 
+  // the checkpoint flush must be persisted before the checkpoint is generated, while the flush for buffer eviction
+  // can be overlapped with the following computing.
+  bool async = tsStreamStateAsyncFlush && !flushState;
+
   int idx = streamStateGetCfIdx(pFileState->pFileStore, pFileState->cfName);
 
   int32_t len = (pFileState->rowSize + sizeof(uint64_t) + sizeof(int32_t) + 64) * 2;
@@ -806,8 +830,7 @@ void flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, boo
 
     qDebug("===stream===flushed start:%" PRId64, pFileState->getTs(pPos->pKey));
     if (streamStateGetBatchSize(batch) >= BATCH_LIMIT) {
-      code = streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
-      streamStateClearBatch(batch);
+      code = flushStateBatch(pFileState, &batch, async);
       QUERY_CHECK_CODE(code, lino, _end);
     }
 
@@ -825,19 +848,18 @@ void flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, boo
 
   int32_t numOfElems = streamStateGetBatchSize(batch);
   if (numOfElems > 0) {
-    code = streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
+    code = flushStateBatch(pFileState, &batch, async);
     QUERY_CHECK_CODE(code, lino, _end);
   } else {
     goto _end;
   }
 
-  streamStateClearBatch(batch);
-
   clearSearchBuff(pFileState);
 
-  int64_t elapsed = taosGetTimestampMs() - st;
-  qDebug("%s flush to disk in batch model completed, rows:%d, batch size:%d, elapsed time:%" PRId64 "ms",
-         pFileState->id, numOfElems, BATCH_LIMIT, elapsed);
+  int64_t elapsed = taosGetTimestampUs() - st;
+  streamStateAddIoTime(pFileState->pFileStore, elapsed);
+  qDebug("%s flush to disk in batch model completed, rows:%d, batch size:%d, async:%d, elapsed time:%" PRId64 "us",
+         pFileState->id, numOfElems, BATCH_LIMIT, async, elapsed);
 
   if (flushState) {
     void*   valBuf = NULL;
@@ -1142,7 +1164,9 @@ int32_t getRowBuff(SStreamFileState* pFileState, void* pKey, int32_t keyLen, voi
   if (!isDeteled(pFileState, ts) && isFlushedState(pFileState, ts, 0)) {
     int32_t len = 0;
     void*   p = NULL;
+    int64_t st = taosGetTimestampUs();
     (*pWinCode) = pFileState->stateFileGetFn(pFileState, pKey, &p, &len);
+    streamStateAddIoTime(pFileState->pFileStore, taosGetTimestampUs() - st);
     qDebug("===stream===get %" PRId64 " from disc, res %d", ts, (*pWinCode));
     if ((*pWinCode) == TSDB_CODE_SUCCESS) {
       SRowBuffPos* pNewPos = getNewRowPosForWrite(pFileState);
@@ -1171,6 +1195,95 @@ _end:
   return code;
 }
 
+int32_t streamFileStatePrefetch(SStreamFileState* pFileState, const SWinKey* pKeys, int32_t num) {
+  int32_t  code = TSDB_CODE_SUCCESS;
+  int32_t  lino = 0;
+  void**   pVals = NULL;
+  int32_t* pVLens = NULL;
+  SArray*  pMissKeys = NULL;
+
+  // only the interval state is stored by SWinKey in the state cf
+  if (pFileState->stateFileGetFn != intervalFileGetFn || num <= 0) {
+    return code;
+  }
+
+  // do not evict the windows in buffer for the prefetched ones
+  int64_t capacity = listNEles(pFileState->freeBuffs) + (int64_t)(pFileState->maxRowCount - pFileState->curRowCount);
+  capacity = TMIN(capacity, MAX_NUM_OF_PREFETCH_WIN);
+  if (capacity <= 0) {
+    return code;
+  }
+
+  pMissKeys = taosArrayInit(TMIN(num, capacity), sizeof(SWinKey));
+  QUERY_CHECK_NULL(pMissKeys, code, lino, _end, terrno);
+
+  for (int32_t i = 0; i < num && taosArrayGetSize(pMissKeys) < capacity; ++i) {
+    const SWinKey* pKey = &pKeys[i];
+    if (tSimpleHashGet(pFileState->rowStateBuff, pKey, sizeof(SWinKey)) != NULL) {
+      continue;
+    }
+    TSKEY ts = pFileState->getTs((void*)pKey);
+    if (isDeteled(pFileState, ts) || !isFlushedState(pFileState, ts, 0)) {
+      continue;
+    }
+    void* tmp = taosArrayPush(pMissKeys, pKey);
+    QUERY_CHECK_NULL(tmp, code, lino, _end, terrno);
+  }
+
+  int32_t numOfMiss = taosArrayGetSize(pMissKeys);
+  if (numOfMiss == 0) {
+    goto _end;
+  }
+
+  pVals = taosMemoryCalloc(numOfMiss, POINTER_BYTES);
+  QUERY_CHECK_NULL(pVals, code, lino, _end, terrno);
+  pVLens = taosMemoryCalloc(numOfMiss, sizeof(int32_t));
+  QUERY_CHECK_NULL(pVLens, code, lino, _end, terrno);
+
+  int64_t st = taosGetTimestampUs();
+  code = streamStateMultiGet_rocksdb(pFileState->pFileStore, numOfMiss, pMissKeys->pData, pVals, pVLens);
+  streamStateAddIoTime(pFileState->pFileStore, taosGetTimestampUs() - st);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  int32_t numOfLoaded = 0;
+  for (int32_t i = 0; i < numOfMiss; ++i) {
+    if (pVals[i] == NULL) {
+      continue;
+    }
+
+    SRowBuffPos* pNewPos = getNewRowPos(pFileState);
+    QUERY_CHECK_NULL(pNewPos, code, lino, _end, TSDB_CODE_OUT_OF_MEMORY);
+
+    // same as the disk content, no need to be flushed again until it is updated
+    pNewPos->beUsed = false;
+    pNewPos->beFlushed = true;
+    pNewPos->needFree = false;
+    pNewPos->beUpdated = false;
+
+    memcpy(pNewPos->pKey, taosArrayGet(pMissKeys, i), sizeof(SWinKey));
+    memcpy(pNewPos->pRowBuff, pVals[i], TMIN(pVLens[i], pFileState->rowSize));
+    code = tSimpleHashPut(pFileState->rowStateBuff, pNewPos->pKey, sizeof(SWinKey), &pNewPos, POINTER_BYTES);
+    QUERY_CHECK_CODE(code, lino, _end);
+    numOfLoaded++;
+  }
+
+  qDebug("%s prefetch window states, required:%d, miss:%d, loaded:%d", pFileState->id, num, numOfMiss, numOfLoaded);
+
+_end:
+  if (pVals != NULL) {
+    for (int32_t i = 0; i < taosArrayGetSize(pMissKeys); ++i) {
+      taosMemoryFree(pVals[i]);
+    }
+  }
+  taosMemoryFree(pVals);
+  taosMemoryFree(pVLens);
+  taosArrayDestroy(pMissKeys);
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 int32_t streamFileStateGroupPut(SStreamFileState* pFileState, int64_t groupId, void* value, int32_t vLen) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t lino = 0;
@@ -437,7 +437,9 @@ TEST_F(BackendEnv, checkOpen) {
 
   code = bkdMgtCreate((char *)path, &mgt);
   SArray *result = taosArrayInit(4, sizeof(void *));
+  ASSERT(!bkdMgtHasChkp(mgt, p->pTdbState->idstr));
   bkdMgtGetDelta(mgt, p->pTdbState->idstr, 3, result, (char *)dump);
+  ASSERT(bkdMgtHasChkp(mgt, p->pTdbState->idstr));
 
   code = taskDbDoCheckpoint(p->pTdbState->pOwner->pBackend, 4, 0);
   ASSERT(code == 0);
@@ -446,6 +448,13 @@ TEST_F(BackendEnv, checkOpen) {
   code = bkdMgtGetDelta(mgt, p->pTdbState->idstr, 4, result, (char *)dump);
   ASSERT(code == 0);
 
+  // a failed upload drops the tracked checkpoint, the next delta is a new base
+  bkdMgtDropChkp(mgt, p->pTdbState->idstr);
+  ASSERT(!bkdMgtHasChkp(mgt, p->pTdbState->idstr));
+  code = bkdMgtGetDelta(mgt, p->pTdbState->idstr, 4, result, (char *)dump);
+  ASSERT(code == 0);
+  ASSERT(bkdMgtHasChkp(mgt, p->pTdbState->idstr));
+
   bkdMgtDestroy(mgt);
   streamStateClose((SStreamState *)p, true);
   // {
@@ -457,6 +466,70 @@ TEST_F(BackendEnv, checkOpen) {
   // streamStateClose((SStreamState *)p, true);
 }
 
+TEST_F(BackendEnv, asyncWriteBatch) {
+  streamMetaInit();
+  const char   *path = "/tmp/backend_async";
+  SStreamState *p = stateCreate(path);
+  ASSERT(p != NULL);
+
+  int32_t cfIdx = streamStateGetCfIdx(p, "state");
+  ASSERT(cfIdx >= 0);
+
+  int32_t              size = 64;
+  int64_t              ts = taosGetTimestampMs();
+  std::vector<SWinKey> keys;
+  for (int32_t round = 0; round < 2; round++) {
+    void *pBatch = streamStateCreateBatch();
+    for (int32_t i = 0; i < size / 2; i++) {
+      SWinKey key = {0};
+      key.groupId = (uint64_t)(i % 4);
+      key.ts = ts + round * size + i;
+      keys.push_back(key);
+
+      SStateKey sKey = {0};
+      sKey.key = key;
+      sKey.opNum = p->number;
+
+      char val[32] = {0};
+      sprintf(val, "val_%" PRId64, key.ts);
+      int32_t code = streamStatePutBatchOptimize(p, cfIdx, (rocksdb_writebatch_t *)pBatch, (void *)&sKey, (void *)val,
+                                                 (int32_t)(strlen(val)), 0, NULL);
+      ASSERT(code == 0);
+    }
+
+    // the second batch waits for the first one, and the writer owns the batch afterwards
+    int32_t code = streamStatePutBatchAsync_rocksdb(p, pBatch);
+    ASSERT(code == 0);
+  }
+
+  SWinKey miss = {0};
+  miss.groupId = 1024;
+  miss.ts = ts;
+  keys.push_back(miss);
+
+  int32_t              num = keys.size();
+  std::vector<void *>  vals(num, nullptr);
+  std::vector<int32_t> vLens(num, 0);
+  int32_t              code = streamStateMultiGet_rocksdb(p, num, keys.data(), vals.data(), vLens.data());
+  ASSERT(code == 0);
+
+  for (int32_t i = 0; i < num - 1; i++) {
+    char val[32] = {0};
+    sprintf(val, "val_%" PRId64, keys[i].ts);
+    ASSERT(vals[i] != NULL);
+    ASSERT(vLens[i] == strlen(val));
+    ASSERT(memcmp(vals[i], val, vLens[i]) == 0);
+    taosMemoryFree(vals[i]);
+  }
+  ASSERT(vals[num - 1] == NULL);
+
+  code = taskDbDoCheckpoint(p->pTdbState->pOwner->pBackend, 1, 0);
+  ASSERT(code == 0);
+
+  streamStateClose((SStreamState *)p, true);
+  taosRemoveDir(path);
+}
+
 TEST_F(BackendEnv, backendChkp) { const char *path = "/tmp"; }
 
 typedef struct BdKV {
@@ -740,9 +740,16 @@ static int32_t walInitWriteFile(SWal *pWal) {
   TAOS_RETURN(TSDB_CODE_SUCCESS);
 }
 
+void walGetWriteStat(SWal *pWal, SWalWriteStat *pStat) {
+  pStat->appendNum = atomic_load_64(&pWal->writeStat.appendNum);
+  pStat->appendBytes = atomic_load_64(&pWal->writeStat.appendBytes);
+  pStat->appendUs = atomic_load_64(&pWal->writeStat.appendUs);
+}
+
 int32_t walAppendLog(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
                      int32_t bodyLen) {
   int32_t code = 0, lino = 0;
+  int64_t startUs = tsEnableWriteStat ? taosGetTimestampUs() : 0;
 
   TAOS_UNUSED(taosThreadRwlockWrlock(&pWal->mutex));
 
@@ -764,6 +771,12 @@ _exit:
   }
 
   TAOS_UNUSED(taosThreadRwlockUnlock(&pWal->mutex));
+
+  if (startUs > 0) {
+    (void)atomic_add_fetch_64(&pWal->writeStat.appendNum, 1);
+    (void)atomic_add_fetch_64(&pWal->writeStat.appendBytes, bodyLen);
+    (void)atomic_add_fetch_64(&pWal->writeStat.appendUs, taosGetTimestampUs() - startUs);
+  }
   return code;
 }
 
@@ -4,12 +4,17 @@
 #include "tcompression.h"
 #include "tlog.h"
 #include "tsimplehash.h"
+#include "tworker.h"
 
 #define GET_PAYLOAD_DATA(_p)           ((char*)(_p)->pData + POINTER_BYTES)
 #define BUF_PAGE_IN_MEM(_p)            ((_p)->pData != NULL)
 #define CLEAR_BUF_PAGE_IN_MEM_FLAG(_p) ((_p)->pData = NULL)
 #define HAS_DATA_IN_DISK(_p)           ((_p)->offset >= 0)
 #define NO_IN_MEM_AVAILABLE_PAGES(_b)  (listNEles((_b)->lruList) >= (_b)->inMemPages)
+#define MAX_DISK_PAGE_SIZE(_b)         ((_b)->pageSize + (int32_t)sizeof(SFilePage) + 1)  // 1 byte compress flag
+
+#define SPILL_BATCH_PAGES      16    // evicted pages collected before they are handed to the query job pool
+#define READ_AHEAD_PAGES  16  // pages loaded in one read when pages are accessed sequentially
 
 typedef struct SPageDiskInfo {
   int64_t offset;
@@ -26,6 +31,43 @@ struct SPageInfo {
   bool       dirty : 1;  // set current buffer page is dirty or not
 };
 
+typedef struct SSpillEntry {
+  int64_t offset;
+  int32_t length;
+  int32_t pos;  // position in the batch buffer
+} SSpillEntry;
+
+typedef struct SSpillBatch {
+  char*   pData;
+  int32_t size;
+  int32_t capacity;
+  SArray* pEntries;  // SSpillEntry
+  int64_t minOffset;
+  int64_t maxEnd;
+} SSpillBatch;
+
+/*
+ * Evicted pages are copied into the active batch, and a full batch is handed over to the query job pool, while the
+ * query thread continues to fill the other one. The batch buffers are only modified by the query thread when they are
+ * swapped, so a page that is still on its way to disk can always be loaded from the batches without lock.
+ */
+typedef struct SSpillWriter {
+  TdThreadMutex lock;
+  TdThreadCond  cond;
+  SSpillBatch   batch[2];
+  int32_t       active;    // index of the batch that collects the evicted pages
+  bool          inflight;  // the other batch is being written in the query job pool
+  int32_t       code;      // error code of the batch in flight
+} SSpillWriter;
+
+typedef struct SReadAheadBuf {
+  char*   pData;
+  int32_t capacity;
+  int32_t len;
+  int64_t offset;
+  int64_t lastLoadEnd;  // end of the last loaded page in file, used to detect the sequential access
+} SReadAheadBuf;
+
 struct SDiskbasedBuf {
   int32_t    numOfPages;
   int64_t    totalBufSize;
@@ -44,8 +86,12 @@ struct SDiskbasedBuf {
   void*      assistBuf;         // assistant buffer for compress/decompress data
   SArray*    pFree;             // free area in file
   bool       comp;              // compressed before flushed to disk
+  bool       asyncFlush;        // flush the evicted pages in the query job pool
   uint64_t   nextPos;           // next page flush position
 
+  SSpillWriter* pWriter;
+  SReadAheadBuf readAhead;
+
   char*               id;           // for debug purpose
   bool                printStatis;  // Print statistics info when closing this buffer.
   SDiskbasedBufStatis statis;
@@ -70,33 +116,278 @@ static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
   return TSDB_CODE_SUCCESS;
 }
 
-static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
+// the compressed data is kept in the assist buffer, since it may be one byte longer than the source data.
+static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {
   if (!pBuf->comp) {
     *dst = srcSize;
     return data;
   }
 
-  *dst = tsCompressString(data, srcSize, 1, pBuf->assistBuf, srcSize, ONE_STAGE_COMP, NULL, 0);
-
-  memcpy(data, pBuf->assistBuf, *dst);
-  return data;
+  *dst = tsCompressString(data, srcSize, 1, pBuf->assistBuf, srcSize + 1, ONE_STAGE_COMP, NULL, 0);
+  return pBuf->assistBuf;
 }
 
-static int32_t doDecompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  int32_t code = 0;
+static int32_t doDecompressData(const char* pSrc, int32_t srcSize, void* data, SDiskbasedBuf* pBuf) {
   if (!pBuf->comp) {
-    *dst = srcSize;
-    return code;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t len = tsDecompressString((void*)pSrc, srcSize, 1, data, pBuf->pageSize + sizeof(SFilePage), ONE_STAGE_COMP,
+                                   NULL, 0);
+  if (len < 0) {
+    return len;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static void resetSpillBatch(SSpillBatch* pBatch) {
+  pBatch->size = 0;
+  pBatch->minOffset = INT64_MAX;
+  pBatch->maxEnd = -1;
+  taosArrayClear(pBatch->pEntries);
+}
+
+static void invalidateReadAhead(SDiskbasedBuf* pBuf, int64_t start, int64_t end) {
+  SReadAheadBuf* pRa = &pBuf->readAhead;
+  if (pRa->len > 0 && start < pRa->offset + pRa->len && end > pRa->offset) {
+    pRa->len = 0;
+  }
+}
+
+static int32_t writeSpillBatch(SDiskbasedBuf* pBuf, SSpillBatch* pBatch) {
+  int32_t num = taosArrayGetSize(pBatch->pEntries);
+  for (int32_t i = 0; i < num; ++i) {
+    SSpillEntry* pEntry = taosArrayGet(pBatch->pEntries, i);
+    int64_t      ret = taosPWriteFile(pBuf->pFile, pBatch->pData + pEntry->pos, pEntry->length, pEntry->offset);
+    if (ret != pEntry->length) {
+      return terrno != 0 ? terrno : TSDB_CODE_FAILED;
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+// the batch in flight is the inactive one, and the active one is not switched before the batch is done.
+static void spillBatchFp(void* param) {
+  SDiskbasedBuf* pBuf = param;
+  SSpillWriter*  pWriter = pBuf->pWriter;
+
+  int32_t code = writeSpillBatch(pBuf, &pWriter->batch[1 - pWriter->active]);
+
+  // the buffer may be destroyed as soon as the batch is done, it is not touched after the unlock.
+  (void)taosThreadMutexLock(&pWriter->lock);
+  if (code != TSDB_CODE_SUCCESS && pWriter->code == TSDB_CODE_SUCCESS) {
+    pWriter->code = code;
+  }
+  pWriter->inflight = false;
+  (void)taosThreadCondBroadcast(&pWriter->cond);
+  (void)taosThreadMutexUnlock(&pWriter->lock);
+}
+
+// wait for the query job pool to finish the batch in flight, the waiting time is the stall time of the query thread.
+static int32_t waitSpillBatchDone(SDiskbasedBuf* pBuf) {
+  SSpillWriter* pWriter = pBuf->pWriter;
+  if (pWriter->inflight) {
+    int64_t st = taosGetTimestampUs();
+    while (pWriter->inflight) {
+      (void)taosThreadCondWait(&pWriter->cond, &pWriter->lock);
+    }
+    pBuf->statis.stallTime += taosGetTimestampUs() - st;
   }
+  return pWriter->code;
+}
+
+static int32_t submitSpillBatch(SDiskbasedBuf* pBuf) {
+  SSpillWriter* pWriter = pBuf->pWriter;
+  if (pWriter->batch[pWriter->active].size == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  (void)taosThreadMutexLock(&pWriter->lock);
+  int32_t code = waitSpillBatchDone(pBuf);
+  if (code == TSDB_CODE_SUCCESS) {
+    // the previous batch is on disk now, the data loaded ahead before it was written may be stale.
+    SSpillBatch* pDone = &pWriter->batch[1 - pWriter->active];
+    invalidateReadAhead(pBuf, pDone->minOffset, pDone->maxEnd);
+    resetSpillBatch(pDone);
+
+    pWriter->active = 1 - pWriter->active;
+    pWriter->inflight = true;
+  }
+  (void)taosThreadMutexUnlock(&pWriter->lock);
+
+  if (code == TSDB_CODE_SUCCESS) {
+    if (tQueryJobSubmit(spillBatchFp, pBuf) != TSDB_CODE_SUCCESS) {
+      // the query job pool is stopped, write the batch in the query thread
+      code = writeSpillBatch(pBuf, &pWriter->batch[1 - pWriter->active]);
+
+      (void)taosThreadMutexLock(&pWriter->lock);
+      pWriter->inflight = false;
+      (void)taosThreadMutexUnlock(&pWriter->lock);
+    }
+  }
+
+  return code;
+}
+
+static int32_t drainSpillWriter(SDiskbasedBuf* pBuf) {
+  SSpillWriter* pWriter = pBuf->pWriter;
+  if (pWriter == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = submitSpillBatch(pBuf);
 
-  *dst = tsDecompressString(data, srcSize, 1, pBuf->assistBuf, pBuf->pageSize, ONE_STAGE_COMP, NULL, 0);
-  if (*dst > 0) {
-    memcpy(data, pBuf->assistBuf, *dst);
-  } else if (*dst < 0) {
+  (void)taosThreadMutexLock(&pWriter->lock);
+  int32_t ret = waitSpillBatchDone(pBuf);
+  (void)taosThreadMutexUnlock(&pWriter->lock);
+
+  for (int32_t i = 0; i < tListLen(pWriter->batch); ++i) {
+    invalidateReadAhead(pBuf, pWriter->batch[i].minOffset, pWriter->batch[i].maxEnd);
+    resetSpillBatch(&pWriter->batch[i]);
+  }
+  return code != TSDB_CODE_SUCCESS ? code : ret;
+}
+
+static void destroySpillWriter(SDiskbasedBuf* pBuf) {
+  SSpillWriter* pWriter = pBuf->pWriter;
+  if (pWriter == NULL) {
+    return;
+  }
+
+  // the batch in flight still refers to the buffer
+  (void)taosThreadMutexLock(&pWriter->lock);
+  (void)waitSpillBatchDone(pBuf);
+  (void)taosThreadMutexUnlock(&pWriter->lock);
+
+  for (int32_t i = 0; i < tListLen(pWriter->batch); ++i) {
+    taosMemoryFreeClear(pWriter->batch[i].pData);
+    taosArrayDestroy(pWriter->batch[i].pEntries);
+  }
+
+  (void)taosThreadCondDestroy(&pWriter->cond);
+  (void)taosThreadMutexDestroy(&pWriter->lock);
+  taosMemoryFreeClear(pBuf->pWriter);
+}
+
+static int32_t createSpillWriter(SDiskbasedBuf* pBuf) {
+  int32_t       code = TSDB_CODE_SUCCESS;
+  SSpillWriter* pWriter = taosMemoryCalloc(1, sizeof(SSpillWriter));
+  if (pWriter == NULL) {
     return terrno;
   }
+
+  pBuf->pWriter = pWriter;
+  (void)taosThreadMutexInit(&pWriter->lock, NULL);
+  (void)taosThreadCondInit(&pWriter->cond, NULL);
+
+  for (int32_t i = 0; i < tListLen(pWriter->batch); ++i) {
+    SSpillBatch* pBatch = &pWriter->batch[i];
+    pBatch->capacity = MAX_DISK_PAGE_SIZE(pBuf) * SPILL_BATCH_PAGES;
+    pBatch->pData = taosMemoryMalloc(pBatch->capacity);
+    pBatch->pEntries = taosArrayInit(SPILL_BATCH_PAGES, sizeof(SSpillEntry));
+    if (pBatch->pData == NULL || pBatch->pEntries == NULL) {
+      code = terrno;
+      goto _error;
+    }
+    resetSpillBatch(pBatch);
+  }
+
   return code;
-  ;
+
+_error:
+  destroySpillWriter(pBuf);
+  return code;
+}
+
+static int32_t addToSpillBatch(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
+  SSpillWriter* pWriter = pBuf->pWriter;
+  SSpillBatch*  pBatch = &pWriter->batch[pWriter->active];
+
+  if (pBatch->size + size > pBatch->capacity) {
+    int32_t code = submitSpillBatch(pBuf);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    pBatch = &pWriter->batch[pWriter->active];
+  }
+
+  SSpillEntry entry = {.offset = offset, .length = size, .pos = pBatch->size};
+  if (taosArrayPush(pBatch->pEntries, &entry) == NULL) {
+    return terrno;
+  }
+
+  memcpy(pBatch->pData + pBatch->size, pData, size);
+  pBatch->size += size;
+  pBatch->minOffset = TMIN(pBatch->minOffset, offset);
+  pBatch->maxEnd = TMAX(pBatch->maxEnd, offset + size);
+  return TSDB_CODE_SUCCESS;
+}
+
+// the page data that has not been written to disk yet, the newest one wins.
+static bool loadPageFromSpillBatch(SDiskbasedBuf* pBuf, SPageInfo* pg, char* pDst) {
+  SSpillWriter* pWriter = pBuf->pWriter;
+  if (pWriter == NULL) {
+    return false;
+  }
+
+  int32_t index[2] = {pWriter->active, 1 - pWriter->active};
+  for (int32_t i = 0; i < tListLen(index); ++i) {
+    SSpillBatch* pBatch = &pWriter->batch[index[i]];
+    if (pg->offset < pBatch->minOffset || pg->offset >= pBatch->maxEnd) {
+      continue;
+    }
+
+    for (int32_t j = taosArrayGetSize(pBatch->pEntries) - 1; j >= 0; --j) {
+      SSpillEntry* pEntry = taosArrayGet(pBatch->pEntries, j);
+      if (pEntry->offset == pg->offset && pEntry->length == pg->length) {
+        memcpy(pDst, pBatch->pData + pEntry->pos, pg->length);
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+static int32_t readPageData(SDiskbasedBuf* pBuf, SPageInfo* pg, char* pDst) {
+  SReadAheadBuf* pRa = &pBuf->readAhead;
+  int64_t        end = pg->offset + pg->length;
+
+  if (pRa->len > 0 && pg->offset >= pRa->offset && end <= pRa->offset + pRa->len) {
+    memcpy(pDst, pRa->pData + (pg->offset - pRa->offset), pg->length);
+    pBuf->statis.readAheadPages += 1;
+    pRa->lastLoadEnd = end;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // pages are loaded one after another in the order of file position, e.g., the merge stage of the external sort.
+  if (pg->offset == pRa->lastLoadEnd) {
+    if (pRa->pData == NULL) {
+      pRa->capacity = MAX_DISK_PAGE_SIZE(pBuf) * READ_AHEAD_PAGES;
+      pRa->pData = taosMemoryMalloc(pRa->capacity);
+      if (pRa->pData == NULL) {
+        return terrno;
+      }
+    }
+
+    int64_t ret = taosPReadFile(pBuf->pFile, pRa->pData, pRa->capacity, pg->offset);
+    if (ret >= pg->length) {
+      pRa->offset = pg->offset;
+      pRa->len = (int32_t)ret;
+      memcpy(pDst, pRa->pData, pg->length);
+      pRa->lastLoadEnd = end;
+      return TSDB_CODE_SUCCESS;
+    }
+    pRa->len = 0;
+  }
+
+  int64_t ret = taosPReadFile(pBuf->pFile, pDst, pg->length, pg->offset);
+  if (ret != pg->length) {
+    return terrno != 0 ? terrno : TSDB_CODE_FAILED;
+  }
+
+  pRa->lastLoadEnd = end;
+  return TSDB_CODE_SUCCESS;
 }
 
 static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
@@ -134,14 +425,17 @@ static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
 static FORCE_INLINE size_t getAllocPageSize(int32_t pageSize) { return pageSize + POINTER_BYTES + sizeof(SFilePage); }
 
 static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
-  int64_t ret = taosLSeekFile(pBuf->pFile, offset, SEEK_SET);
-  if (ret < 0) {
-    return terrno;
-  }
-
-  ret = (int32_t)taosWriteFile(pBuf->pFile, pData, size);
-  if (ret != size) {
-    return terrno;
+  if (pBuf->pWriter != NULL) {
+    int32_t code = addToSpillBatch(pBuf, offset, pData, size);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  } else {
+    int64_t ret = taosPWriteFile(pBuf->pFile, pData, size, offset);
+    if (ret != size) {
+      return terrno;
+    }
+    invalidateReadAhead(pBuf, offset, offset + size);
   }
 
   // extend the file
@@ -174,6 +468,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
       terrno = TSDB_CODE_INVALID_PARA;
       return NULL;
     }
+    pBuf->statis.rawFlushBytes += pBuf->pageSize + sizeof(SFilePage);
   }
 
   // this page is flushed to disk for the first time
@@ -184,6 +479,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
 
       int32_t code = doFlushBufPageImpl(pBuf, offset, t, size);
       if (code != TSDB_CODE_SUCCESS) {
+        terrno = code;
         return NULL;
       }
     } else {
@@ -202,6 +498,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
 
       int32_t code = doFlushBufPageImpl(pBuf, offset, t, size);
       if (code != TSDB_CODE_SUCCESS) {
+        terrno = code;
         return NULL;
       }
     }
@@ -229,6 +526,11 @@ static char* flushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
       terrno = ret;
       return NULL;
     }
+
+    // spill in the synchronous way if failed to create the spill writer
+    if (pBuf->asyncFlush && (ret = createSpillWriter(pBuf)) != TSDB_CODE_SUCCESS) {
+      uWarn("failed to create spill writer, flush pages synchronously, code:%s, %s", tstrerror(ret), pBuf->id);
+    }
   }
 
   char* p = doFlushBufPage(pBuf, pg);
@@ -245,24 +547,21 @@ static int32_t loadPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg) {
     return TSDB_CODE_INVALID_PARA;
   }
 
-  int64_t ret = taosLSeekFile(pBuf->pFile, pg->offset, SEEK_SET);
-  if (ret < 0) {
-    ret = terrno;
-    return ret;
-  }
-
+  // the compressed page is loaded into the assist buffer first, and then decompressed into the page.
   void* pPage = (void*)GET_PAYLOAD_DATA(pg);
-  ret = taosReadFile(pBuf->pFile, pPage, pg->length);
-  if (ret != pg->length) {
-    ret = terrno;
-    return ret;
+  char* pDst = pBuf->comp ? pBuf->assistBuf : pPage;
+
+  if (!loadPageFromSpillBatch(pBuf, pg, pDst)) {
+    int32_t code = readPageData(pBuf, pg, pDst);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
   }
 
   pBuf->statis.loadBytes += pg->length;
   pBuf->statis.loadPages += 1;
 
-  int32_t fullSize = 0;
-  return doDecompressData(pPage, pg->length, &fullSize, pBuf);
+  return doDecompressData(pDst, pg->length, pPage, pBuf);
 }
 
 static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
@@ -365,6 +664,7 @@ int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMem
     goto _error;
   }
   pPBuf->fileSize = 0;
+  pPBuf->readAhead.lastLoadEnd = -1;
   pPBuf->pFree = taosArrayInit(4, sizeof(SFreeListItem));
   pPBuf->freePgList = tdListNew(POINTER_BYTES);
   if (pPBuf->pFree == NULL || pPBuf->freePgList == NULL) {
@@ -610,6 +910,9 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
 
   dBufPrintStatis(pBuf);
 
+  // the pending pages are of no use any more, just wait for the batch in flight.
+  destroySpillWriter(pBuf);
+
   bool needRemoveFile = false;
   if (pBuf->pFile != NULL) {
     needRemoveFile = true;
@@ -669,6 +972,7 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
 
   taosMemoryFreeClear(pBuf->id);
   taosMemoryFreeClear(pBuf->assistBuf);
+  taosMemoryFreeClear(pBuf->readAhead.pData);
   taosMemoryFreeClear(pBuf);
 }
 
@@ -692,13 +996,21 @@ void setBufPageDirty(void* pPage, bool dirty) {
 }
 
 int32_t setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp) {
-  pBuf->comp = comp;
   if (comp && (pBuf->assistBuf == NULL)) {
-    pBuf->assistBuf = taosMemoryMalloc(pBuf->pageSize + 2);  // EXTRA BYTES
-    if (pBuf->assistBuf) {
+    pBuf->assistBuf = taosMemoryMalloc(MAX_DISK_PAGE_SIZE(pBuf));
+    if (pBuf->assistBuf == NULL) {
       return terrno;
     }
   }
+  pBuf->comp = comp;
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t setBufPageAsyncFlush(SDiskbasedBuf* pBuf, bool async) {
+  if (pBuf->pFile != NULL) {  // the spill writer is created when the disk file is created
+    return TSDB_CODE_SUCCESS;
+  }
+  pBuf->asyncFlush = async;
   return TSDB_CODE_SUCCESS;
 }
 
@@ -752,6 +1064,13 @@ void dBufPrintStatis(const SDiskbasedBuf* pBuf) {
 }
 
 void clearDiskbasedBuf(SDiskbasedBuf* pBuf) {
+  int32_t code = drainSpillWriter(pBuf);
+  if (code != TSDB_CODE_SUCCESS) {
+    uWarn("failed to flush the pending pages when clearing buf, code:%s, %s", tstrerror(code), pBuf->id);
+  }
+  pBuf->readAhead.len = 0;
+  pBuf->readAhead.lastLoadEnd = -1;
+
   size_t n = taosArrayGetSize(pBuf->pIdList);
   for (int32_t i = 0; i < n; ++i) {
     SPageInfo* pi = taosArrayGetP(pBuf->pIdList, i);
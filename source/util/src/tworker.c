@@ -1065,3 +1065,115 @@ static int32_t tQueryAutoQWorkerRecoverFromBlocking(void *p) {
   if (pPool->exit) return TSDB_CODE_QRY_QWORKER_QUIT;
   return TSDB_CODE_SUCCESS;
 }
+
+#define QUERY_JOB_POOL_MAX_THREADS 16  // threads shared by the background jobs of all queries of the process
+
+typedef struct SQueryJob {
+  FQueryJob fp;
+  void     *param;
+} SQueryJob;
+
+static TdThreadOnce          queryJobPoolInit = PTHREAD_ONCE_INIT;
+static TdThreadRwlock        queryJobPoolLock;
+static SQueryAutoQWorkerPool queryJobPool = {0};
+static STaosQueue           *queryJobQueue = NULL;
+static threadlocal bool      queryJobInWorker = false;
+
+static void tQueryJobProcess(SQueueInfo *pInfo, void *pItem) {
+  SQueryJob *pJob = pItem;
+  queryJobInWorker = (pInfo != NULL);
+  pJob->fp(pJob->param);
+  queryJobInWorker = false;
+  taosFreeQitem(pItem);
+}
+
+// the jobs still queued are run by the thread that cleans up the pool, nobody waits for a job that is dropped
+static void tQueryJobPoolCleanup() {
+  (void)taosThreadRwlockWrlock(&queryJobPoolLock);
+  STaosQueue *queue = queryJobQueue;
+  queryJobQueue = NULL;
+  (void)taosThreadRwlockUnlock(&queryJobPoolLock);
+  if (queue == NULL) {
+    return;
+  }
+
+  tQueryAutoQWorkerCleanup(&queryJobPool);
+
+  void *pItem = NULL;
+  while (taosReadQitem(queue, &pItem), pItem != NULL) {
+    tQueryJobProcess(NULL, pItem);
+    pItem = NULL;
+  }
+  tQueryAutoQWorkerFreeQueue(&queryJobPool, queue);
+}
+
+static void tQueryJobPoolInit() {
+  (void)taosThreadRwlockInit(&queryJobPoolLock, NULL);
+
+  int32_t numOfThreads = TMIN(TMAX((int32_t)tsNumOfCores / 2, 1), QUERY_JOB_POOL_MAX_THREADS);
+  queryJobPool.name = "query-job";
+  queryJobPool.min = numOfThreads;
+  queryJobPool.max = numOfThreads;
+  if (tQueryAutoQWorkerInit(&queryJobPool) != TSDB_CODE_SUCCESS) {
+    uError("failed to init query job pool since %s", tstrerror(terrno));
+    return;
+  }
+
+  queryJobQueue = tQueryAutoQWorkerAllocQueue(&queryJobPool, NULL, tQueryJobProcess);
+  if (queryJobQueue == NULL) {
+    uError("failed to alloc query job queue since %s", tstrerror(terrno));
+    tQueryAutoQWorkerCleanup(&queryJobPool);
+    return;
+  }
+
+  (void)atexit(tQueryJobPoolCleanup);
+}
+
+int32_t tQueryJobSubmit(FQueryJob fp, void *param) {
+  (void)taosThreadOnce(&queryJobPoolInit, tQueryJobPoolInit);
+
+  SQueryJob *pJob = NULL;
+  int32_t    code = taosAllocateQitem(sizeof(SQueryJob), DEF_QITEM, 0, (void **)&pJob);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+  pJob->fp = fp;
+  pJob->param = param;
+
+  (void)taosThreadRwlockRdlock(&queryJobPoolLock);
+  code = (queryJobQueue != NULL) ? taosWriteQitem(queryJobQueue, pJob) : TSDB_CODE_APP_IS_STOPPING;
+  (void)taosThreadRwlockUnlock(&queryJobPoolLock);
+
+  if (code != TSDB_CODE_SUCCESS) {
+    taosFreeQitem(pJob);
+  }
+  return code;
+}
+
+int32_t tQueryJobPending() {
+  (void)taosThreadOnce(&queryJobPoolInit, tQueryJobPoolInit);
+
+  (void)taosThreadRwlockRdlock(&queryJobPoolLock);
+  int32_t num = (queryJobQueue != NULL) ? taosQueueItemSize(queryJobQueue) : 0;
+  (void)taosThreadRwlockUnlock(&queryJobPoolLock);
+  return num;
+}
+
+int32_t tQueryJobThreads() {
+  (void)taosThreadOnce(&queryJobPoolInit, tQueryJobPoolInit);
+  return queryJobPool.max;
+}
+
+int32_t tQueryJobBeforeBlocking() {
+  if (!queryJobInWorker) {
+    return TSDB_CODE_SUCCESS;
+  }
+  return queryJobPool.pCb->beforeBlocking(queryJobPool.pCb->pPool);
+}
+
+int32_t tQueryJobAfterBlocking() {
+  if (!queryJobInWorker) {
+    return TSDB_CODE_SUCCESS;
+  }
+  return queryJobPool.pCb->afterRecoverFromBlocking(queryJobPool.pCb->pPool);
+}
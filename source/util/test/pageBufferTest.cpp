@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "taos.h"
 #include "tpagedbuf.h"
@@ -220,6 +221,90 @@ void testFlushAndReadBackBuffer() {
   taosMemoryFree(rowData);
 }
 
+// pages are flushed by the spill pool and compressed, read them back both randomly and sequentially
+void asyncCompressFlushTest(bool comp, bool async) {
+  SDiskbasedBuf* pBuf = NULL;
+  int32_t        pageSize = 1024;
+  int32_t        numOfPages = 200;
+  int32_t        code = createDiskbasedBuf(&pBuf, pageSize, 4 * pageSize, "1", TD_TMP_DIR_PATH);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(setBufPageCompressOnDisk(pBuf, comp), 0);
+  ASSERT_EQ(setBufPageAsyncFlush(pBuf, async), 0);
+
+  std::vector<int32_t> pageIds(numOfPages);
+  std::vector<char>    shadow(numOfPages * pageSize);
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    SFilePage* pPg = static_cast<SFilePage*>(getNewBufPage(pBuf, &pageIds[i]));
+    ASSERT_TRUE(pPg != NULL);
+    for (int32_t k = 0; k < pageSize; ++k) {
+      pPg->data[k] = (taosRand() % 8 == 0) ? (char)taosRand() : (char)(k / 64);
+    }
+    memcpy(&shadow[i * pageSize], pPg->data, pageSize);
+    setBufPageDirty(pPg, true);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  for (int32_t r = 0; r < numOfPages * 10; ++r) {
+    int32_t    i = (r % 3 == 0) ? taosRand() % numOfPages : (r / 3) % numOfPages;
+    SFilePage* pPg = static_cast<SFilePage*>(getBufPage(pBuf, pageIds[i]));
+    ASSERT_TRUE(pPg != NULL);
+    ASSERT_EQ(memcmp(pPg->data, &shadow[i * pageSize], pageSize), 0);
+
+    if (r % 5 == 0) {  // update the page, and it is flushed again
+      int32_t offset = taosRand() % (pageSize - 16);
+      memset(pPg->data + offset, (char)r, 16);
+      memcpy(&shadow[i * pageSize + offset], pPg->data + offset, 16);
+      setBufPageDirty(pPg, true);
+    }
+    releaseBufPage(pBuf, pPg);
+  }
+
+  SDiskbasedBufStatis st = getDBufStatis(pBuf);
+  ASSERT_GT(st.flushPages, 0);
+  if (comp) {
+    ASSERT_LT(st.flushBytes, st.rawFlushBytes);
+  } else {
+    ASSERT_EQ(st.flushBytes, st.rawFlushBytes);
+  }
+  destroyDiskbasedBuf(pBuf);
+}
+
+// more buffers than the spill pool threads are spilling at the same time
+void sharedSpillPoolTest() {
+  int32_t                     pageSize = 1024;
+  int32_t                     numOfBufs = 16;
+  int32_t                     numOfPages = 64;
+  std::vector<SDiskbasedBuf*> bufs(numOfBufs, nullptr);
+  std::vector<int32_t>        pageIds(numOfBufs * numOfPages);
+
+  for (int32_t b = 0; b < numOfBufs; ++b) {
+    ASSERT_EQ(createDiskbasedBuf(&bufs[b], pageSize, 4 * pageSize, "1", TD_TMP_DIR_PATH), 0);
+    ASSERT_EQ(setBufPageAsyncFlush(bufs[b], true), 0);
+  }
+
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    for (int32_t b = 0; b < numOfBufs; ++b) {
+      SFilePage* pPg = static_cast<SFilePage*>(getNewBufPage(bufs[b], &pageIds[b * numOfPages + i]));
+      ASSERT_TRUE(pPg != NULL);
+      memset(pPg->data, (char)(b * numOfPages + i), pageSize);
+      setBufPageDirty(pPg, true);
+      releaseBufPage(bufs[b], pPg);
+    }
+  }
+
+  for (int32_t b = 0; b < numOfBufs; ++b) {
+    for (int32_t i = 0; i < numOfPages; ++i) {
+      SFilePage* pPg = static_cast<SFilePage*>(getBufPage(bufs[b], pageIds[b * numOfPages + i]));
+      ASSERT_TRUE(pPg != NULL);
+      ASSERT_EQ(pPg->data[0], (char)(b * numOfPages + i));
+      ASSERT_EQ(pPg->data[pageSize - 1], (char)(b * numOfPages + i));
+      releaseBufPage(bufs[b], pPg);
+    }
+    ASSERT_GT(getDBufStatis(bufs[b]).flushPages, 0);
+    destroyDiskbasedBuf(bufs[b]);
+  }
+}
+
 }  // namespace
 
 TEST(testCase, resultBufferTest) {
@@ -230,4 +315,13 @@ TEST(testCase, resultBufferTest) {
   testFlushAndReadBackBuffer();
 }
 
+TEST(testCase, asyncCompressFlushTest) {
+  taosSeedRand(taosGetTimestampSec());
+  asyncCompressFlushTest(false, false);
+  asyncCompressFlushTest(true, false);
+  asyncCompressFlushTest(false, true);
+  asyncCompressFlushTest(true, true);
+  sharedSpillPoolTest();
+}
+
 #pragma GCC diagnostic pop